@@ -552,6 +552,23 @@ CREATE TABLE `mail_items` (
 ) ENGINE=InnoDB AUTO_INCREMENT=644 DEFAULT CHARSET=utf8;
 /*!40101 SET character_set_client = @saved_cs_client */;
 
+--
+-- Table structure for table `mon_aggro_culling`
+--
+
+DROP TABLE IF EXISTS `mon_aggro_culling`;
+/*!40101 SET @saved_cs_client     = @@character_set_client */;
+/*!40101 SET character_set_client = utf8 */;
+CREATE TABLE `mon_aggro_culling` (
+  `id` int(10) unsigned NOT NULL AUTO_INCREMENT,
+  `time` int(10) unsigned NOT NULL,
+  `checked_pairs` bigint(20) unsigned NOT NULL,
+  `culled_pairs` bigint(20) unsigned NOT NULL,
+  `skipped_visits` bigint(20) unsigned NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8;
+/*!40101 SET character_set_client = @saved_cs_client */;
+
 --
 -- Table structure for table `mon_classes`
 --
@@ -568,6 +585,41 @@ CREATE TABLE `mon_classes` (
 ) ENGINE=MyISAM AUTO_INCREMENT=3645712 DEFAULT CHARSET=utf8;
 /*!40101 SET character_set_client = @saved_cs_client */;
 
+--
+-- Table structure for table `mon_logs_buffer`
+--
+
+DROP TABLE IF EXISTS `mon_logs_buffer`;
+/*!40101 SET @saved_cs_client     = @@character_set_client */;
+/*!40101 SET character_set_client = utf8 */;
+CREATE TABLE `mon_logs_buffer` (
+  `id` int(10) unsigned NOT NULL AUTO_INCREMENT,
+  `time` int(10) unsigned NOT NULL,
+  `written_rows` bigint(20) unsigned NOT NULL,
+  `statements` bigint(20) unsigned NOT NULL,
+  `deferred_flushes` bigint(20) unsigned NOT NULL,
+  `dropped_rows` bigint(20) unsigned NOT NULL,
+  `peak_bytes` bigint(20) unsigned NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8;
+/*!40101 SET character_set_client = @saved_cs_client */;
+
+--
+-- Table structure for table `mon_los_cache`
+--
+
+DROP TABLE IF EXISTS `mon_los_cache`;
+/*!40101 SET @saved_cs_client     = @@character_set_client */;
+/*!40101 SET character_set_client = utf8 */;
+CREATE TABLE `mon_los_cache` (
+  `id` int(10) unsigned NOT NULL AUTO_INCREMENT,
+  `time` int(10) unsigned NOT NULL,
+  `hits` bigint(20) unsigned NOT NULL,
+  `misses` bigint(20) unsigned NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8;
+/*!40101 SET character_set_client = @saved_cs_client */;
+
 --
 -- Table structure for table `mon_maps`
 --
@@ -584,6 +636,23 @@ CREATE TABLE `mon_maps` (
 ) ENGINE=MyISAM AUTO_INCREMENT=6076186 DEFAULT CHARSET=utf8;
 /*!40101 SET character_set_client = @saved_cs_client */;
 
+--
+-- Table structure for table `mon_movement`
+--
+
+DROP TABLE IF EXISTS `mon_movement`;
+/*!40101 SET @saved_cs_client     = @@character_set_client */;
+/*!40101 SET character_set_client = utf8 */;
+CREATE TABLE `mon_movement` (
+  `id` int(10) unsigned NOT NULL AUTO_INCREMENT,
+  `time` int(10) unsigned NOT NULL,
+  `band` tinyint(3) unsigned NOT NULL,
+  `sent` bigint(20) unsigned NOT NULL,
+  `coalesced` bigint(20) unsigned NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8;
+/*!40101 SET character_set_client = @saved_cs_client */;
+
 --
 -- Table structure for table `mon_players`
 --
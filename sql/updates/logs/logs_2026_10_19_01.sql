@@ -0,0 +1,8 @@
+CREATE TABLE IF NOT EXISTS `mon_movement` (
+  `id` INT(10) UNSIGNED NOT NULL AUTO_INCREMENT,
+  `time` INT(10) UNSIGNED NOT NULL,
+  `band` TINYINT(3) UNSIGNED NOT NULL,
+  `sent` BIGINT(20) UNSIGNED NOT NULL,
+  `coalesced` BIGINT(20) UNSIGNED NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MYISAM DEFAULT CHARSET=utf8;
@@ -0,0 +1,7 @@
+CREATE TABLE IF NOT EXISTS `mon_los_cache` (
+  `id` INT(10) UNSIGNED NOT NULL AUTO_INCREMENT,
+  `time` INT(10) UNSIGNED NOT NULL,
+  `hits` BIGINT(20) UNSIGNED NOT NULL,
+  `misses` BIGINT(20) UNSIGNED NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MYISAM DEFAULT CHARSET=utf8;
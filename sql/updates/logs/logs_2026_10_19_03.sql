@@ -0,0 +1,8 @@
+CREATE TABLE IF NOT EXISTS `mon_aggro_culling` (
+  `id` INT(10) UNSIGNED NOT NULL AUTO_INCREMENT,
+  `time` INT(10) UNSIGNED NOT NULL,
+  `checked_pairs` BIGINT(20) UNSIGNED NOT NULL,
+  `culled_pairs` BIGINT(20) UNSIGNED NOT NULL,
+  `skipped_visits` BIGINT(20) UNSIGNED NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MYISAM DEFAULT CHARSET=utf8;
@@ -0,0 +1,10 @@
+CREATE TABLE IF NOT EXISTS `mon_logs_buffer` (
+  `id` INT(10) UNSIGNED NOT NULL AUTO_INCREMENT,
+  `time` INT(10) UNSIGNED NOT NULL,
+  `written_rows` BIGINT(20) UNSIGNED NOT NULL,
+  `statements` BIGINT(20) UNSIGNED NOT NULL,
+  `deferred_flushes` BIGINT(20) UNSIGNED NOT NULL,
+  `dropped_rows` BIGINT(20) UNSIGNED NOT NULL,
+  `peak_bytes` BIGINT(20) UNSIGNED NOT NULL,
+  PRIMARY KEY (`id`)
+) ENGINE=MYISAM DEFAULT CHARSET=utf8;
@@ -24,12 +24,14 @@
 #include <G3D/AABox.h>
 
 #include "Define.h"
+#include "RayPacket.h"
 
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstring>
 
 #define MAX_STACK_SIZE 64
 
@@ -256,6 +258,149 @@ public:
         }
     }
 
+    /**
+    Occlusion query for a packet of rays. intersectCallback is called as
+        RayPacket::Mask intersectCallback(RayPacket const& packet, RayPacket::Mask active, uint32 entry)
+    and returns the active rays hitting entry, those rays are not tested against other entries anymore.
+    Unlike intersectRay the nodes are not visited front to back, any hit ends a ray.
+    Returns the rays of active which hit something.
+    */
+    template<typename PacketCallback>
+    RayPacket::Mask intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, PacketCallback& intersectCallback) const
+    {
+        using namespace RayPacketMath;
+
+        struct PacketStackNode
+        {
+            alignas(16) float tnear[RayPacket::MAX_RAYS];
+            alignas(16) float tfar[RayPacket::MAX_RAYS];
+            uint32 node;
+            RayPacket::Mask mask;
+        };
+
+        alignas(16) float tnear[RayPacket::MAX_RAYS];
+        alignas(16) float tfar[RayPacket::MAX_RAYS];
+        RayPacket::Mask mask = packet.intersectBox(bounds, active, tnear, tfar);
+        RayPacket::Mask hits = 0;
+
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        uint32 node = 0;
+
+        while (mask)
+        {
+            uint32 tn = tree[node];
+            uint32 axis = (tn & (3 << 30)) >> 30;
+            bool BVH2 = (tn & (1 << 29)) != 0;
+            uint32 offset = tn & ~(7 << 29);
+            if (!BVH2 && axis < 3)
+            {
+                // "normal" interior node, left child is below the left clip plane and right child above the right one
+                Float4 clipLeft = Set(intBitsToFloat(tree[node + 1]));
+                Float4 clipRight = Set(intBitsToFloat(tree[node + 2]));
+                PacketStackNode& right = stack[stackPos];
+                RayPacket::Mask leftMask = 0;
+                RayPacket::Mask rightMask = 0;
+                for (uint32 first = 0; first < RayPacket::MAX_RAYS; first += RayPacket::LANES)
+                {
+                    if (!RayPacket::hasLanes(mask, first))
+                        continue;
+
+                    Float4 o = Load(&packet.org[axis][first]);
+                    Float4 inv = Load(&packet.invDir[axis][first]);
+                    Bool4 positive = LessEqual(Set(0.0f), inv);
+                    Float4 near = Load(&tnear[first]);
+                    Float4 far = Load(&tfar[first]);
+                    Float4 tLeft = Mul(Sub(clipLeft, o), inv);
+                    Float4 tRight = Mul(Sub(clipRight, o), inv);
+
+                    Float4 rightNear = Select(positive, Max(tRight, near), near);
+                    Float4 rightFar = Select(positive, far, Min(tRight, far));
+                    Store(&right.tnear[first], rightNear);
+                    Store(&right.tfar[first], rightFar);
+                    rightMask |= MoveMask(LessEqual(rightNear, rightFar)) << first;
+
+                    Float4 leftNear = Select(positive, near, Max(tLeft, near));
+                    Float4 leftFar = Select(positive, Min(tLeft, far), far);
+                    Store(&tnear[first], leftNear);
+                    Store(&tfar[first], leftFar);
+                    leftMask |= MoveMask(LessEqual(leftNear, leftFar)) << first;
+                }
+
+                // at most one push per level, and subdivide() stops at depth MAX_STACK_SIZE
+                rightMask &= mask;
+                if (rightMask)
+                {
+                    right.node = offset + 3;
+                    right.mask = rightMask;
+                    ++stackPos;
+                }
+
+                mask &= leftMask;
+                node = offset;
+                if (mask)
+                    continue;
+            }
+            else if (!BVH2)
+            {
+                // leaf - test some objects
+                uint32 n = tree[node + 1];
+                while (n > 0 && mask)
+                {
+                    RayPacket::Mask hit = intersectCallback(packet, mask, objects[offset]) & mask;
+                    hits |= hit;
+                    mask &= ~hit;
+                    --n;
+                    ++offset;
+                }
+            }
+            else
+            {
+                if (axis > 2)
+                    return hits; // should not happen
+
+                // BVH2 node (empty space cut off left and right)
+                Float4 clipLow = Set(intBitsToFloat(tree[node + 1]));
+                Float4 clipHigh = Set(intBitsToFloat(tree[node + 2]));
+                RayPacket::Mask childMask = 0;
+                for (uint32 first = 0; first < RayPacket::MAX_RAYS; first += RayPacket::LANES)
+                {
+                    if (!RayPacket::hasLanes(mask, first))
+                        continue;
+
+                    Float4 o = Load(&packet.org[axis][first]);
+                    Float4 inv = Load(&packet.invDir[axis][first]);
+                    Bool4 positive = LessEqual(Set(0.0f), inv);
+                    Float4 tLow = Mul(Sub(clipLow, o), inv);
+                    Float4 tHigh = Mul(Sub(clipHigh, o), inv);
+                    Float4 near = Max(Select(positive, tLow, tHigh), Load(&tnear[first]));
+                    Float4 far = Min(Select(positive, tHigh, tLow), Load(&tfar[first]));
+                    Store(&tnear[first], near);
+                    Store(&tfar[first], far);
+                    childMask |= MoveMask(LessEqual(near, far)) << first;
+                }
+
+                mask &= childMask;
+                node = offset;
+                if (mask)
+                    continue;
+            }
+
+            // move back up the stack, dropping the rays which already hit something
+            mask = 0;
+            while (!mask && stackPos > 0)
+            {
+                --stackPos;
+                mask = stack[stackPos].mask & ~hits;
+                node = stack[stackPos].node;
+                memcpy(tnear, stack[stackPos].tnear, sizeof(tnear));
+                memcpy(tfar, stack[stackPos].tfar, sizeof(tfar));
+            }
+        }
+
+        return hits;
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
     {
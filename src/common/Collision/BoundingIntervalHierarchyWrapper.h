@@ -47,6 +47,16 @@ class BIHWrap
             return false;
         }
 
+        /// Intersect ray packet
+        RayPacket::Mask operator() (RayPacket const& packet, RayPacket::Mask active, uint32 idx)
+        {
+            if (idx >= objects_size)
+                return 0;
+            if (const T* obj = objects[idx])
+                return _callback(packet, active, *obj);
+            return 0;
+        }
+
         /// Intersect point
         void operator() (const G3D::Vector3& p, uint32 idx)
         {
@@ -107,6 +117,14 @@ public:
         m_tree.intersectRay(ray, temp_cb, maxDist, true);
     }
 
+    template<typename PacketCallback>
+    RayPacket::Mask intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, PacketCallback& intersectCallback)
+    {
+        balance();
+        MDLCallback<PacketCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
+        return m_tree.intersectRayPacket(packet, active, temp_cb);
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
@@ -242,6 +242,87 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+struct DynamicTreePacketCallback
+{
+    uint32 phase_mask;
+    DynamicTreePacketCallback(uint32 phasemask) : phase_mask(phasemask) { }
+    RayPacket::Mask operator()(RayPacket const& packet, RayPacket::Mask active, GameObjectModel const& obj)
+    {
+        return obj.intersectRayPacket(packet, active, phase_mask, VMAP::ModelIgnoreFlags::Nothing);
+    }
+};
+
+void DynamicMapTree::isInLineOfSight(G3D::Vector3 const* startPos, G3D::Vector3 const* endPos, uint32 count, bool* results, uint32 phasemask) const
+{
+    if (impl->empty())
+        return;
+
+    // rays of a packet visit every grid cell of the packet bounds, past 2x2 cells single rays are cheaper
+    uint32 const maxPacketCells = 4;
+
+    DynamicTreePacketCallback callback(phasemask);
+    RayPacket packet;
+    uint32 packetRays[RayPacket::MAX_RAYS];
+    DynTreeImpl::Cell low = { 0, 0 }, high = { 0, 0 };
+
+    auto flush = [&]()
+    {
+        RayPacket::Mask hits = 0;
+        if (uint32(high.x - low.x + 1) * uint32(high.y - low.y + 1) <= maxPacketCells)
+            hits = impl->intersectRayPacket(packet, packet.allRays(), callback, low, high);
+        else
+        {
+            for (uint32 i = 0; i < packet.size(); ++i)
+            {
+                G3D::Vector3 const& start = startPos[packetRays[i]];
+                G3D::Vector3 const& end = endPos[packetRays[i]];
+                if (!isInLineOfSight(start.x, start.y, start.z, end.x, end.y, end.z, phasemask))
+                    hits |= RayPacket::Mask(1) << i;
+            }
+        }
+
+        for (uint32 i = 0; i < packet.size(); ++i)
+            if (hits & (RayPacket::Mask(1) << i))
+                results[packetRays[i]] = false;
+        packet = RayPacket();
+    };
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (!results[i])
+            continue;
+
+        float maxDist = (endPos[i] - startPos[i]).magnitude();
+        if (!G3D::fuzzyGt(maxDist, 0))
+            continue;
+
+        // the grid walk of the single ray version ignores rays starting out of the grid
+        DynTreeImpl::Cell startCell = DynTreeImpl::Cell::ComputeCell(startPos[i].x, startPos[i].y);
+        if (!startCell.isValid())
+            continue;
+
+        DynTreeImpl::Cell endCell = DynTreeImpl::Cell::ComputeCell(endPos[i].x, endPos[i].y);
+        if (!packet.size())
+        {
+            low = startCell;
+            high = startCell;
+        }
+
+        low.x = std::min({ low.x, startCell.x, endCell.x });
+        low.y = std::min({ low.y, startCell.y, endCell.y });
+        high.x = std::max({ high.x, startCell.x, endCell.x });
+        high.y = std::max({ high.y, startCell.y, endCell.y });
+
+        packetRays[packet.size()] = i;
+        packet.add(startPos[i], (endPos[i] - startPos[i]) / maxDist, maxDist);
+        if (packet.full())
+            flush();
+    }
+
+    if (packet.size())
+        flush();
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     G3D::Vector3 v(x, y, z);
@@ -24,6 +24,12 @@ public:
 
     bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2,
                          float z2, uint32 phasemask) const;
+    /**
+    Batched isInLineOfSight. Segments with results[i] == false are skipped,
+    the others get results[i] = false if a gameobject is in the way.
+    */
+    void isInLineOfSight(G3D::Vector3 const* startPos, G3D::Vector3 const* endPos, uint32 count,
+                         bool* results, uint32 phasemask) const;
 
     bool getIntersectionTime(uint32 phasemask, const G3D::Ray& ray,
                              const G3D::Vector3& endPos, float& maxDist) const;
@@ -25,6 +25,11 @@
 #include "ModelIgnoreFlags.h"
 #include "Common.h"
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -94,6 +99,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            /**
+            Batched isInLineOfSight for segments from startPos[i] to endPos[i] (map coordinates).
+            Segments with results[i] == false are skipped, the others get results[i] = false if a model is in the way.
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* startPos, G3D::Vector3 const* endPos, uint32 count, bool* results, ModelIgnoreFlags ignoreFlags) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             virtual float getCeil(unsigned int /*pMapId*/, float /*x*/, float /*y*/, float /*z*/, float /*maxSearchDist*/) { return VMAP_INVALID_CEIL_VALUE; }
 
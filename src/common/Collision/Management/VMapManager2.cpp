@@ -181,6 +181,37 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, Vector3 const* startPos, Vector3 const* endPos, uint32 count, bool* results, ModelIgnoreFlags ignoreFlags)
+    {
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        // convert by chunks of one packet, the tree batches them the same way
+        Vector3 pos1[RayPacket::MAX_RAYS];
+        Vector3 pos2[RayPacket::MAX_RAYS];
+        bool chunkResults[RayPacket::MAX_RAYS];
+        for (uint32 first = 0; first < count; first += RayPacket::MAX_RAYS)
+        {
+            uint32 chunkSize = std::min(count - first, RayPacket::MAX_RAYS);
+            for (uint32 i = 0; i < chunkSize; ++i)
+            {
+                pos1[i] = convertPositionToInternalRep(startPos[first + i].x, startPos[first + i].y, startPos[first + i].z);
+                pos2[i] = convertPositionToInternalRep(endPos[first + i].x, endPos[first + i].y, endPos[first + i].z);
+                chunkResults[i] = results[first + i] && pos1[i] != pos2[i];
+            }
+
+            instanceTree->second->isInLineOfSight(pos1, pos2, chunkSize, chunkResults, ignoreFlags);
+
+            for (uint32 i = 0; i < chunkSize; ++i)
+                if (results[first + i] && pos1[i] != pos2[i])
+                    results[first + i] = chunkResults[i];
+        }
+    }
+
     /* same as getObjectHitPos but a bit more gentle, will try from a bit higher and return collision from there if it gets further */
     bool VMapManager2::getLeapHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist)
     {
@@ -51,6 +51,19 @@ namespace VMAP
         ModelIgnoreFlags flags;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val, ModelIgnoreFlags ignoreFlags) : prims(val), flags(ignoreFlags) { }
+            RayPacket::Mask operator()(RayPacket const& packet, RayPacket::Mask active, uint32 entry)
+            {
+                return prims[entry].intersectRayPacket(packet, active, flags);
+            }
+        protected:
+            ModelInstance* prims;
+            ModelIgnoreFlags flags;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -207,6 +220,49 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, uint32 count, bool* results, ModelIgnoreFlags ignoreFlags) const
+    {
+        MapRayPacketCallback intersectionCallBack(iTreeValues, ignoreFlags);
+        RayPacket packet;
+        uint32 packetRays[RayPacket::MAX_RAYS];
+
+        auto flush = [&]()
+        {
+            RayPacket::Mask hits = iTree.intersectRayPacket(packet, packet.allRays(), intersectionCallBack);
+            for (uint32 i = 0; i < packet.size(); ++i)
+                if (hits & (RayPacket::Mask(1) << i))
+                    results[packetRays[i]] = false;
+            packet = RayPacket();
+        };
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!results[i])
+                continue;
+
+            // same checks as the single ray version
+            float maxDist = (pos2[i] - pos1[i]).magnitude();
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            if (maxDist < 1e-10f)
+                continue;
+
+            packetRays[packet.size()] = i;
+            packet.add(pos1[i], (pos2[i] - pos1[i]) / maxDist, maxDist);
+            if (packet.full())
+                flush();
+        }
+
+        if (packet.size())
+            flush();
+    }
+
+    //=========================================================
+
     bool StaticMapTree::getObjectHitPos(const Vector3& pPos1, const Vector3& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result=false;
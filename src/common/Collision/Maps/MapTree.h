@@ -60,6 +60,11 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             /**
+            Batched isInLineOfSight, rays are traversed together as packets of RayPacket::MAX_RAYS.
+            Segments with results[i] == false are skipped, the others get results[i] = false if something is in the way.
+            */
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, uint32 count, bool* results, ModelIgnoreFlags ignoreFlags) const;
+            /**
             When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
             Return the hit pos or the original dest pos
             */
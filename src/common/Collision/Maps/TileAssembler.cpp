@@ -21,9 +21,14 @@
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
-#include <iomanip>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -35,6 +40,30 @@ template<> struct BoundsTrait<VMAP::ModelSpawn*>
     static void getBounds(const VMAP::ModelSpawn* const &obj, G3D::AABox& out) { out = obj->getBounds(); }
 };
 
+namespace
+{
+    // call work(i) once for each i in [0, count), on up to threads threads (the calling one included)
+    template<class Work>
+    void ParallelFor(uint32 threads, size_t count, Work work)
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count; i = next++)
+                work(i);
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < threads && i < count; ++i)
+            workers.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : workers)
+            thread.join();
+    }
+}
+
 namespace VMAP
 {
     bool readChunk(FILE* rf, char *dest, const char *compare, uint32 len)
@@ -64,145 +93,203 @@ namespace VMAP
         //delete iCoordModelMapping;
     }
 
-    bool TileAssembler::convertWorld2()
+    bool TileAssembler::convertWorld2(uint32 threads)
     {
         bool success = readMapSpawns();
         if (!success)
             return false;
 
+        threads = std::max(threads, 1u);
+        printf("Using %u threads\n", threads);
+
+        // biggest maps first, a continent started last would leave the other workers idle at the end
+        std::vector<std::pair<uint32, MapSpawns*>> maps(mapData.begin(), mapData.end());
+        std::stable_sort(maps.begin(), maps.end(), [](std::pair<uint32, MapSpawns*> const& a, std::pair<uint32, MapSpawns*> const& b)
+        {
+            return a.second->UniqueEntries.size() > b.second->UniqueEntries.size();
+        });
+        mapData.clear();
+
         // export Map data
-        for (auto map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        std::atomic<bool> failed(false);
+        std::mutex modelFilesLock;
+        ParallelFor(threads, maps.size(), [&](size_t i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+            if (failed)
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+                delete maps[i].second;
+                return;
             }
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
-
-            try
+            std::set<std::string> modelFiles;
+            if (!convertMap(maps[i].first, maps[i].second, modelFiles))
             {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-            }
-            catch (std::exception& e)
-            {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
-                return false;
+                failed = true;
+                return;
             }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+            std::lock_guard<std::mutex> lock(modelFilesLock);
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
+        });
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
-            {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
-            }
+        if (failed)
+            return false;
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (auto glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects, each model file once whatever the number of spawns using it
+        std::cout << "\nConverting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        ParallelFor(threads, modelFiles.size(), [&](size_t i)
+        {
+            if (failed)
+                return;
+
+            printf("Converting %s\n", modelFiles[i].c_str());
+            if (!convertRawFile(modelFiles[i]))
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                printf("error converting %s\n", modelFiles[i].c_str());
+                failed = true;
             }
+        });
 
-            fclose(mapfile);
+        return !failed;
+    }
 
-            // <====
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns* spawns, std::set<std::string>& modelFiles)
+    {
+        // the MapSpawns are freed once the files are written, whatever happens
+        std::unique_ptr<MapSpawns> spawnsGuard(spawns);
+        bool success = true;
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+
+        // M2 models are spawned many times, read each raw file once for all its spawns
+        std::map<std::string, std::vector<ModelSpawn*>> m2Spawns;
+        for (entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
+            if (entry->second.flags & MOD_M2)
+                m2Spawns[entry->second.name].push_back(&entry->second);
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        std::set<std::string> unreadableModels;
+        for (auto const& model : m2Spawns)
+        {
+            WorldModel_Raw raw_model;
+            if (!raw_model.Read((iSrcDir + "/" + model.first).c_str()))
             {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(3) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
-                {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    // write tile spawns
-                    for (uint32 s=0; s<nSpawns; ++s)
-                    {
-                        if (s)
-                            ++tile;
-                        const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        auto nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    }
-                    fclose(tilefile);
-                }
+                unreadableModels.insert(model.first);
+                continue;
             }
-            // break; //test, extract only first map; TODO: remvoe this line
+
+            for (ModelSpawn* spawn : model.second)
+                calculateTransformedBound(*spawn, raw_model);
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (const auto & spawnedModelFile : spawnedModelFiles)
+        for (entry = spawns->UniqueEntries.begin(); entry != spawns->UniqueEntries.end(); ++entry)
         {
-            std::cout << "Converting " << spawnedModelFile << std::endl;
-            if (!convertRawFile(spawnedModelFile))
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                std::cout << "error converting " << spawnedModelFile << std::endl;
-                success = false;
-                break;
+                if (unreadableModels.count(entry->second.name))
+                    continue;
             }
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
+            {
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
+            }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
+
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
+
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
         }
 
-        //cleanup:
-        for (auto & map_iter : mapData)
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
         {
-            delete map_iter.second;
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
         }
+
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns->TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (auto glob=globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::writeToFile(mapfile, spawns->UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns->TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn &spawn = spawns->UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(3) << mapId << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+            {
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+                // write tile spawns
+                for (uint32 s=0; s<nSpawns; ++s)
+                {
+                    if (s)
+                        ++tile;
+                    const ModelSpawn &spawn2 = spawns->UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    auto nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
+                }
+                fclose(tilefile);
+            }
+        }
+
         return success;
     }
 
@@ -253,29 +340,35 @@ namespace VMAP
         modelFilename.push_back('/');
         modelFilename.append(spawn.name);
 
+        WorldModel_Raw raw_model;
+        if (!raw_model.Read(modelFilename.c_str()))
+            return false;
+
+        calculateTransformedBound(spawn, raw_model);
+        return true;
+    }
+
+    void TileAssembler::calculateTransformedBound(ModelSpawn &spawn, WorldModel_Raw const& raw_model)
+    {
         ModelPosition modelPosition;
         modelPosition.iDir = spawn.iRot;
         modelPosition.iScale = spawn.iScale;
         modelPosition.init();
 
-        WorldModel_Raw raw_model;
-        if (!raw_model.Read(modelFilename.c_str()))
-            return false;
-
         uint32 groups = raw_model.groupsArray.size();
         if (groups != 1)
-            printf("Warning: '%s' does not seem to be a M2 model!\n", modelFilename.c_str());
+            printf("Warning: '%s' does not seem to be a M2 model!\n", spawn.name.c_str());
 
         AABox modelBound;
         bool boundEmpty=true;
 
         for (uint32 g=0; g<groups; ++g) // should be only one for M2 files...
         {
-            std::vector<Vector3>& vertices = raw_model.groupsArray[g].vertexArray;
+            std::vector<Vector3> const& vertices = raw_model.groupsArray[g].vertexArray;
 
             if (vertices.empty())
             {
-                std::cout << "error: model '" << spawn.name << "' has no geometry!" << std::endl;
+                printf("error: model '%s' has no geometry!\n", spawn.name.c_str());
                 continue;
             }
 
@@ -292,7 +385,6 @@ namespace VMAP
         }
         spawn.iBound = modelBound + spawn.iPos;
         spawn.flags |= MOD_HAS_BOUND;
-        return true;
     }
 
     struct WMOLiquidHeader
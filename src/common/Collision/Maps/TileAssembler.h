@@ -101,11 +101,16 @@ namespace VMAP
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
 
+            // build and write the tree and tiles of one map, then free its spawns. Thread safe for different maps.
+            bool convertMap(uint32 mapId, MapSpawns* spawns, std::set<std::string>& modelFiles);
+            static void calculateTransformedBound(ModelSpawn &spawn, WorldModel_Raw const& raw_model);
+
         public:
             TileAssembler(std::string  pSrcDirName, std::string  pDestDirName);
             virtual ~TileAssembler();
 
-            bool convertWorld2();
+            // maps, then model files, are converted on threads workers
+            bool convertWorld2(uint32 threads = 1);
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
             void exportGameobjectModels();
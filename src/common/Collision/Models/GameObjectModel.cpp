@@ -172,6 +172,23 @@ bool GameObjectModel::intersectRay(const G3D::Ray& ray, float& MaxDist, bool Sto
     return hit;
 }
 
+RayPacket::Mask GameObjectModel::intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!(phasemask & ph_mask) || !owner->IsSpawned())
+        return 0;
+
+    alignas(16) float tnear[RayPacket::MAX_RAYS];
+    alignas(16) float tfar[RayPacket::MAX_RAYS];
+    active = packet.intersectBox(iBound, active, tnear, tfar);
+    if (!active)
+        return 0;
+
+    // child bounds are defined in object space:
+    RayPacket modPacket;
+    packet.transform(modPacket, iInvRot, iPos, iInvScale);
+    return iModel->IntersectRayPacket(modPacket, active, ignoreFlags);
+}
+
 bool GameObjectModel::UpdatePosition()
 {
     if (!iModel)
@@ -26,6 +26,7 @@
 #include <G3D/Vector3.h>
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
+#include "RayPacket.h"
 
 namespace VMAP
 {
@@ -67,6 +68,7 @@ public:
     bool isEnabled() const { return phasemask != 0; }
 
     bool intersectRay(const G3D::Ray& Ray, float& MaxDist, bool StopAtFirstHit, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    RayPacket::Mask intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, uint32 ph_mask, VMAP::ModelIgnoreFlags ignoreFlags) const;
 
     static GameObjectModel* Create(std::unique_ptr<GameObjectModelOwnerBase> modelOwner, std::string const& dataPath);
 
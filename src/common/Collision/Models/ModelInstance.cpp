@@ -65,6 +65,23 @@ namespace VMAP
         return hit;
     }
 
+    RayPacket::Mask ModelInstance::intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, ModelIgnoreFlags ignoreFlags) const
+    {
+        if (!iModel)
+            return 0;
+
+        alignas(16) float tnear[RayPacket::MAX_RAYS];
+        alignas(16) float tfar[RayPacket::MAX_RAYS];
+        active = packet.intersectBox(iBound, active, tnear, tfar);
+        if (!active)
+            return 0;
+
+        // child bounds are defined in object space:
+        RayPacket modPacket;
+        packet.transform(modPacket, iInvRot, iPos, iInvScale);
+        return iModel->IntersectRayPacket(modPacket, active, ignoreFlags);
+    }
+
     void ModelInstance::intersectPoint(const G3D::Vector3& p, AreaInfo &info) const
     {
         if (!iModel)
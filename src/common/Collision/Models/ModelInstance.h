@@ -25,6 +25,7 @@
 #include <G3D/Vector3.h>
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
+#include "RayPacket.h"
 
 namespace VMAP
 {
@@ -68,6 +69,7 @@ namespace VMAP
             ModelInstance(ModelSpawn spawn, WorldModel* model);
             void setUnloaded() { iModel = 0; }
             bool intersectRay(const G3D::Ray& pRay, float& pMaxDist, bool pStopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
+            RayPacket::Mask intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, ModelIgnoreFlags ignoreFlags) const;
             void intersectPoint(const G3D::Vector3& p, AreaInfo &info) const;
             bool isUnderModel(const G3D::Vector3& p, float* outDist = nullptr, float* inDist = nullptr) const;
             bool GetLocationInfo(const G3D::Vector3& p, LocationInfo &info) const;
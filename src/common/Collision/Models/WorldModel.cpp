@@ -65,6 +65,48 @@ namespace VMAP
         return false;
     }
 
+    // IntersectTriangle for 4 rays of a packet at once, returns the lanes hitting tri before their max distance
+    uint32 IntersectTrianglePacket(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, RayPacket const& packet, uint32 first)
+    {
+        using namespace RayPacketMath;
+        static const float EPS = 1e-5f;
+
+        const Vector3 v0 = points[tri.idx0];
+        const Vector3 e1 = points[tri.idx1] - v0;
+        const Vector3 e2 = points[tri.idx2] - v0;
+
+        Float4 dx = Load(&packet.dir[0][first]), dy = Load(&packet.dir[1][first]), dz = Load(&packet.dir[2][first]);
+        Float4 e1x = Set(e1.x), e1y = Set(e1.y), e1z = Set(e1.z);
+        Float4 e2x = Set(e2.x), e2y = Set(e2.y), e2z = Set(e2.z);
+
+        // p = dir x e2, a = e1 . p
+        Float4 px = Sub(Mul(dy, e2z), Mul(dz, e2y));
+        Float4 py = Sub(Mul(dz, e2x), Mul(dx, e2z));
+        Float4 pz = Sub(Mul(dx, e2y), Mul(dy, e2x));
+        Float4 a = Add(Add(Mul(e1x, px), Mul(e1y, py)), Mul(e1z, pz));
+        Float4 f = Div(Set(1.0f), a);
+
+        // s = origin - v0, u = f * (s . p)
+        Float4 sx = Sub(Load(&packet.org[0][first]), Set(v0.x));
+        Float4 sy = Sub(Load(&packet.org[1][first]), Set(v0.y));
+        Float4 sz = Sub(Load(&packet.org[2][first]), Set(v0.z));
+        Float4 u = Mul(f, Add(Add(Mul(sx, px), Mul(sy, py)), Mul(sz, pz)));
+
+        // q = s x e1, v = f * (dir . q), t = f * (e2 . q)
+        Float4 qx = Sub(Mul(sy, e1z), Mul(sz, e1y));
+        Float4 qy = Sub(Mul(sz, e1x), Mul(sx, e1z));
+        Float4 qz = Sub(Mul(sx, e1y), Mul(sy, e1x));
+        Float4 v = Mul(f, Add(Add(Mul(dx, qx), Mul(dy, qy)), Mul(dz, qz)));
+        Float4 t = Mul(f, Add(Add(Mul(e2x, qx), Mul(e2y, qy)), Mul(e2z, qz)));
+
+        Float4 zero = Set(0.0f), one = Set(1.0f);
+        Bool4 hit = LessEqual(Set(EPS), Abs(a));
+        hit = And(hit, And(LessEqual(zero, u), LessEqual(u, one)));
+        hit = And(hit, And(LessEqual(zero, v), LessEqual(Add(u, v), one)));
+        hit = And(hit, And(Less(zero, t), Less(t, Load(&packet.maxDist[first]))));
+        return MoveMask(hit);
+    }
+
     class TriBoundFunc
     {
         public:
@@ -372,6 +414,31 @@ namespace VMAP
         return callback.hit;
     }
 
+    struct GModelRayPacketCallback
+    {
+        GModelRayPacketCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
+            vertices(vert.begin()), triangles(tris.begin()) { }
+        RayPacket::Mask operator()(RayPacket const& packet, RayPacket::Mask active, uint32 entry)
+        {
+            RayPacket::Mask hit = 0;
+            for (uint32 first = 0; first < RayPacket::MAX_RAYS; first += RayPacket::LANES)
+                if (RayPacket::hasLanes(active, first))
+                    hit |= IntersectTrianglePacket(triangles[entry], vertices, packet, first) << first;
+            return hit & active;
+        }
+        std::vector<Vector3>::const_iterator vertices;
+        std::vector<MeshTriangle>::const_iterator triangles;
+    };
+
+    RayPacket::Mask GroupModel::IntersectRayPacket(RayPacket const& packet, RayPacket::Mask active) const
+    {
+        if (triangles.empty())
+            return 0;
+
+        GModelRayPacketCallback callback(triangles, vertices);
+        return meshTree.intersectRayPacket(packet, active, callback);
+    }
+
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
         if (triangles.empty() || !iBound.contains(pos))
@@ -501,6 +568,31 @@ namespace VMAP
         return isc.hit;
     }
 
+    struct WModelRayPacketCallBack
+    {
+        WModelRayPacketCallBack(const std::vector<GroupModel> &mod): models(mod.begin()) { }
+        RayPacket::Mask operator()(RayPacket const& packet, RayPacket::Mask active, uint32 entry)
+        {
+            return models[entry].IntersectRayPacket(packet, active);
+        }
+        std::vector<GroupModel>::const_iterator models;
+    };
+
+    RayPacket::Mask WorldModel::IntersectRayPacket(RayPacket const& packet, RayPacket::Mask active, ModelIgnoreFlags ignoreFlags) const
+    {
+        if ((ignoreFlags & ModelIgnoreFlags::M2) != ModelIgnoreFlags::Nothing)
+        {
+            if (Flags & MOD_M2)
+                return 0;
+        }
+
+        if (groupModels.size() == 1)
+            return groupModels[0].IntersectRayPacket(packet, active);
+
+        WModelRayPacketCallBack isc(groupModels);
+        return groupTree.intersectRayPacket(packet, active, isc);
+    }
+
     class WModelAreaCallback {
         public:
             WModelAreaCallback(const std::vector<GroupModel> &vals, const Vector3 &down):
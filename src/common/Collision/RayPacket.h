@@ -0,0 +1,207 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RAYPACKET_H
+#define _RAYPACKET_H
+
+#include "Define.h"
+#include <G3D/AABox.h>
+#include <G3D/Matrix3.h>
+#include <G3D/Vector3.h>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+4 wide float operations used by ray packets, SSE2 when available.
+The scalar fallback follows the SSE semantics: Min(a, b) is a < b ? a : b and Max(a, b) is a > b ? a : b,
+so both return b when a is NaN. Packet traversal relies on this to never cull a ray because of a NaN.
+*/
+namespace RayPacketMath
+{
+#ifdef __SSE2__
+    typedef __m128 Float4;
+    typedef __m128 Bool4;
+
+    inline Float4 Load(float const* p) { return _mm_load_ps(p); }
+    inline void Store(float* p, Float4 v) { _mm_store_ps(p, v); }
+    inline Float4 Set(float f) { return _mm_set1_ps(f); }
+    inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+    inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+    inline Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+    inline Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+    inline Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+    inline Float4 Abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline Bool4 Less(Float4 a, Float4 b) { return _mm_cmplt_ps(a, b); }
+    inline Bool4 LessEqual(Float4 a, Float4 b) { return _mm_cmple_ps(a, b); }
+    inline Bool4 And(Bool4 a, Bool4 b) { return _mm_and_ps(a, b); }
+    inline Float4 Select(Bool4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    inline uint32 MoveMask(Bool4 mask) { return uint32(_mm_movemask_ps(mask)); }
+#else
+    struct Float4 { float v[4]; };
+    struct Bool4 { bool v[4]; };
+
+    #define RAYPACKET_LANES(expr) for (int i = 0; i < 4; ++i) r.v[i] = (expr); return r
+
+    inline Float4 Load(float const* p) { Float4 r; RAYPACKET_LANES(p[i]); }
+    inline void Store(float* p, Float4 v) { for (int i = 0; i < 4; ++i) p[i] = v.v[i]; }
+    inline Float4 Set(float f) { Float4 r; RAYPACKET_LANES(f); }
+    inline Float4 Add(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] + b.v[i]); }
+    inline Float4 Sub(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] - b.v[i]); }
+    inline Float4 Mul(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] * b.v[i]); }
+    inline Float4 Div(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] / b.v[i]); }
+    inline Float4 Min(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+    inline Float4 Max(Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+    inline Float4 Abs(Float4 a) { Float4 r; RAYPACKET_LANES(std::fabs(a.v[i])); }
+    inline Bool4 Less(Float4 a, Float4 b) { Bool4 r; RAYPACKET_LANES(a.v[i] < b.v[i]); }
+    inline Bool4 LessEqual(Float4 a, Float4 b) { Bool4 r; RAYPACKET_LANES(a.v[i] <= b.v[i]); }
+    inline Bool4 And(Bool4 a, Bool4 b) { Bool4 r; RAYPACKET_LANES(a.v[i] && b.v[i]); }
+    inline Float4 Select(Bool4 mask, Float4 a, Float4 b) { Float4 r; RAYPACKET_LANES(mask.v[i] ? a.v[i] : b.v[i]); }
+    inline uint32 MoveMask(Bool4 mask) { return uint32(mask.v[0]) | uint32(mask.v[1]) << 1 | uint32(mask.v[2]) << 2 | uint32(mask.v[3]) << 3; }
+
+    #undef RAYPACKET_LANES
+#endif
+}
+
+/**
+Up to MAX_RAYS line of sight segments tested together against the same trees.
+Rays are stored as structure of arrays and every ray-box and ray-triangle test runs on 4 rays at once.
+Packets are only used for occlusion queries: they tell which rays hit something closer than their max distance, not where.
+*/
+struct RayPacket
+{
+    static constexpr uint32 MAX_RAYS = 16;
+    static constexpr uint32 LANES = 4;
+    typedef uint32 Mask; // bit i set for ray i
+
+    RayPacket();
+
+    // Add a ray with a direction of length 1. Returns false if the packet is full.
+    bool add(G3D::Vector3 const& origin, G3D::Vector3 const& direction, float distance);
+    uint32 size() const { return count; }
+    bool full() const { return count == MAX_RAYS; }
+    Mask allRays() const { return (Mask(1) << count) - 1; }
+
+    // Rays of active crossing box before their max distance, tnear/tfar (MAX_RAYS aligned floats) receive the part of each ray inside box
+    Mask intersectBox(G3D::AABox const& box, Mask active, float* tnear, float* tfar) const;
+    // Same rays in the space of a model placed at pos, as ModelInstance::intersectRay does for a single ray
+    void transform(RayPacket& out, G3D::Matrix3 const& invRot, G3D::Vector3 const& pos, float invScale) const;
+
+    static bool hasLanes(Mask mask, uint32 firstRay) { return ((mask >> firstRay) & 0xF) != 0; }
+
+    alignas(16) float org[3][MAX_RAYS];
+    alignas(16) float dir[3][MAX_RAYS];
+    alignas(16) float invDir[3][MAX_RAYS];
+    alignas(16) float maxDist[MAX_RAYS];
+    uint32 count;
+};
+
+inline RayPacket::RayPacket() : count(0)
+{
+    // unused rays are never active, they only need to hold finite values
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        for (uint32 i = 0; i < MAX_RAYS; ++i)
+        {
+            org[axis][i] = 0.0f;
+            dir[axis][i] = 1.0f;
+            invDir[axis][i] = 1.0f;
+        }
+    }
+
+    for (uint32 i = 0; i < MAX_RAYS; ++i)
+        maxDist[i] = 0.0f;
+}
+
+inline bool RayPacket::add(G3D::Vector3 const& origin, G3D::Vector3 const& direction, float distance)
+{
+    if (full())
+        return false;
+
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        org[axis][count] = origin[axis];
+        dir[axis][count] = direction[axis];
+        invDir[axis][count] = 1.0f / direction[axis];
+    }
+
+    maxDist[count] = distance;
+    ++count;
+    return true;
+}
+
+inline RayPacket::Mask RayPacket::intersectBox(G3D::AABox const& box, Mask active, float* tnear, float* tfar) const
+{
+    using namespace RayPacketMath;
+
+    Mask result = 0;
+    for (uint32 first = 0; first < MAX_RAYS; first += LANES)
+    {
+        if (!hasLanes(active, first))
+            continue;
+
+        Float4 tn = Set(0.0f);
+        Float4 tf = Load(&maxDist[first]);
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            Float4 o = Load(&org[axis][first]);
+            Float4 inv = Load(&invDir[axis][first]);
+            Bool4 positive = LessEqual(Set(0.0f), inv);
+            Float4 tLow = Mul(Sub(Set(box.low()[axis]), o), inv);
+            Float4 tHigh = Mul(Sub(Set(box.high()[axis]), o), inv);
+            tn = Max(Select(positive, tLow, tHigh), tn);
+            tf = Min(Select(positive, tHigh, tLow), tf);
+        }
+
+        Store(&tnear[first], tn);
+        Store(&tfar[first], tf);
+        result |= MoveMask(LessEqual(tn, tf)) << first;
+    }
+
+    return result & active;
+}
+
+inline void RayPacket::transform(RayPacket& out, G3D::Matrix3 const& invRot, G3D::Vector3 const& pos, float invScale) const
+{
+    using namespace RayPacketMath;
+
+    out.count = count;
+    Float4 scale = Set(invScale);
+    for (uint32 first = 0; first < count; first += LANES)
+    {
+        Float4 o[3], d[3];
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            o[axis] = Sub(Load(&org[axis][first]), Set(pos[axis]));
+            d[axis] = Load(&dir[axis][first]);
+        }
+
+        for (uint32 row = 0; row < 3; ++row)
+        {
+            Float4 m0 = Set(invRot[row][0]), m1 = Set(invRot[row][1]), m2 = Set(invRot[row][2]);
+            Float4 newDir = Add(Add(Mul(m0, d[0]), Mul(m1, d[1])), Mul(m2, d[2]));
+            Store(&out.org[row][first], Mul(Add(Add(Mul(m0, o[0]), Mul(m1, o[1])), Mul(m2, o[2])), scale));
+            Store(&out.dir[row][first], newDir);
+            Store(&out.invDir[row][first], Div(Set(1.0f), newDir));
+        }
+
+        Store(&out.maxDist[first], Mul(Load(&maxDist[first]), scale));
+    }
+}
+
+#endif // _RAYPACKET_H
@@ -21,8 +21,10 @@
 #include "Errors.h"
 #include "IteratorPair.h"
 #include <G3D/Ray.h>
+#include "RayPacket.h"
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
+#include <algorithm>
 #include <unordered_map>
 
 template<class Node>
@@ -208,6 +210,18 @@ public:
         } while (cell.isValid());
     }
 
+    // Packet version of intersectRay. Instead of walking the cells of each ray, every cell from low to high is visited once for the whole packet.
+    template<typename PacketCallback>
+    RayPacket::Mask intersectRayPacket(RayPacket const& packet, RayPacket::Mask active, PacketCallback& intersectCallback, Cell const& low, Cell const& high)
+    {
+        RayPacket::Mask hits = 0;
+        for (int x = std::max(low.x, 0); x <= std::min<int>(high.x, CELL_NUMBER - 1); ++x)
+            for (int y = std::max(low.y, 0); y <= std::min<int>(high.y, CELL_NUMBER - 1); ++y)
+                if (Node* node = nodes[x][y])
+                    hits |= node->intersectRayPacket(packet, active & ~hits, intersectCallback);
+        return hits;
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
@@ -22,68 +22,55 @@
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
+#include <boost/iostreams/device/mapped_file.hpp>
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
-
-bool DBCFileLoader::Load(char const* filename, char const* fmt)
+namespace
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
+    uint32 const DBCHeaderSize = 5 * sizeof(uint32);
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    uint32 ReadHeaderField(char const* header, uint32 index)
     {
-        fclose(f);
-        return false;
+        uint32 value;
+        memcpy(&value, header + index * sizeof(uint32), sizeof(uint32));
+        EndianConvert(value);
+        return value;
     }
+}
 
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
 
-    EndianConvert(header);
+bool DBCFileLoader::Load(char const* filename, char const* fmt)
+{
+    data = nullptr;
+    stringTable = nullptr;
+    file.reset();
+    delete[] fieldsOffset;
+    fieldsOffset = nullptr;
 
-    if (header != 0x43424457)                                //'WDBC'
+    std::unique_ptr<boost::iostreams::mapped_file> mapping = std::make_unique<boost::iostreams::mapped_file>();
+    try
     {
-        fclose(f);
-        return false;
+        mapping->open(filename, boost::iostreams::mapped_file::priv);
     }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    catch (std::exception const& /*e*/)
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (mapping->size() < DBCHeaderSize)
         return false;
-    }
 
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    char* header = mapping->data();
+    if (ReadHeaderField(header, 0) != 0x43424457)           //'WDBC'
         return false;
-    }
 
-    EndianConvert(recordSize);
+    recordCount = ReadHeaderField(header, 1);
+    fieldCount = ReadHeaderField(header, 2);
+    recordSize = ReadHeaderField(header, 3);
+    stringSize = ReadHeaderField(header, 4);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (!fieldCount || mapping->size() < DBCHeaderSize + uint64(recordSize) * recordCount + stringSize)
         return false;
-    }
-
-    EndianConvert(stringSize);
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -96,27 +83,22 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize*recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
+    file = std::move(mapping);
+    data = reinterpret_cast<unsigned char*>(header + DBCHeaderSize);
+    stringTable = data + recordSize * recordCount;
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
+size_t DBCFileLoader::GetMappedSize() const
+{
+    return file ? file->size() : 0;
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -168,6 +150,39 @@ uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::CanUseRecordsInPlace(char const* format) const
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    (void)format;
+    return false;
+#else
+    if (strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    // struct fields must match the file ones, trailing unused fields are just not part of the struct
+    bool unusedFields = false;
+    for (uint32 x = 0; x < fieldCount; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+                if (unusedFields)
+                    return false;
+                break;
+            case FT_NA:
+                unusedFields = true;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+#endif
+}
+
 char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**& indexTable)
 {
     /*
@@ -211,6 +226,20 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (CanUseRecordsInPlace(format))
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            if (i >= 0)
+                indexTable[getRecord(y).getUInt(i)] = record;
+            else
+                indexTable[y] = record;
+        }
+
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -260,14 +289,12 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
-        return nullptr;
-
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+        return false;
 
+    bool used = false;
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -292,8 +319,8 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
+                        used = true;
                     }
                     offset += sizeof(char*);
                     break;
@@ -312,5 +339,5 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return used;
 }
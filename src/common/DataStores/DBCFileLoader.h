@@ -22,6 +22,15 @@
 #include "Define.h"
 #include "Utilities/ByteConverter.h"
 #include <cassert>
+#include <memory>
+
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file;
+    }
+}
 
 enum DbcFieldFormat
 {
@@ -44,6 +53,8 @@ class TC_COMMON_API DBCFileLoader
         DBCFileLoader();
         ~DBCFileLoader();
 
+        // Maps the file (private, copy on write). Records and strings produced from it point into the mapping,
+        // the loader must outlive them.
         bool Load(const char *filename, const char *fmt);
 
         class Record
@@ -95,10 +106,16 @@ class TC_COMMON_API DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        size_t GetMappedSize() const;
+        // True if records can be used as is: only 4 byte int/float fields, followed by unused ones
+        bool CanUseRecordsInPlace(char const* fmt) const;
+        // Returns the converted records, or nullptr if CanUseRecordsInPlace (indexTable then points into the mapping)
         char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-        char* AutoProduceStrings(char const* fmt, char* dataTable);
+        // Points the strings not filled yet to this file's string table. Returns true if at least one was.
+        bool AutoProduceStrings(char const* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = nullptr);
     private:
+        std::unique_ptr<boost::iostreams::mapped_file> file;
 
         uint32 recordSize;
         uint32 recordCount;
@@ -17,6 +17,7 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -33,6 +34,14 @@ void EventMap::SetPhase(uint8 phase)
         _phase = uint8(1 << (phase - 1));
 }
 
+void EventMap::Insert(uint32 time, uint32 data)
+{
+    // first event planned at or before time, inserting there puts the new event after the others with the same time
+    EventStore::iterator itr = std::lower_bound(_eventMap.begin(), _eventMap.end(), time,
+        [](Event const& event, uint32 eventTime) { return event.Time > eventTime; });
+    _eventMap.insert(itr, { time, data });
+}
+
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds const& minTime, Milliseconds const& maxTime, uint32 group /*= 0*/, uint32 phase /*= 0*/)
 {
     ScheduleEvent(eventId, urand(uint32(minTime.count()), uint32(maxTime.count())), group, phase);
@@ -46,7 +55,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    Insert(_time + time, eventId);
 }
 
 void EventMap::RescheduleEvent(uint32 eventId, Milliseconds const& minTime, Milliseconds const& maxTime, uint32 group /*= 0*/, uint32 phase /*= 0*/)
@@ -63,19 +72,17 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
+        Event const event = _eventMap.back();
 
-        if (itr->first > _time)
+        if (event.Time > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
-        else
-        {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
-            return eventId;
-        }
+
+        _eventMap.pop_back();
+        if (_phase && (event.Data & 0xFF000000) && !((event.Data >> 24) & _phase))
+            continue;
+
+        _lastEvent = event.Data; // include phase/group
+        return (event.Data & 0x0000FFFF);
     }
 
     return 0;
@@ -88,18 +95,19 @@ void EventMap::DelayEvents(uint32 delay, uint32 group)
 
     EventStore delayed;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    EventStore::iterator end = std::remove_if(_eventMap.begin(), _eventMap.end(), [&](Event const& event)
     {
-        if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
-    }
+        if (!(event.Data & (1 << (group + 15))))
+            return false;
+
+        delayed.push_back({ event.Time + delay, event.Data });
+        return true;
+    });
+    _eventMap.erase(end, _eventMap.end());
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    // reinsert in execution order
+    for (EventStore::reverse_iterator itr = delayed.rbegin(); itr != delayed.rend(); ++itr)
+        Insert(itr->Time, itr->Data);
 }
 
 void EventMap::SetMinimalDelay(uint32 eventId, uint32 delay)
@@ -107,20 +115,20 @@ void EventMap::SetMinimalDelay(uint32 eventId, uint32 delay)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    EventStore delayed;
+
+    EventStore::iterator end = std::remove_if(_eventMap.begin(), _eventMap.end(), [&](Event const& event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-        {
-            if (itr->first < delay)
-            {
-                _eventMap.insert(EventStore::value_type(delay, itr->second));
-                itr = _eventMap.erase(itr);
-                continue;
-            }
-
-        }
-        itr++;
-    }
+        if (eventId != (event.Data & 0x0000FFFF) || event.Time >= delay)
+            return false;
+
+        delayed.push_back({ delay, event.Data });
+        return true;
+    });
+    _eventMap.erase(end, _eventMap.end());
+
+    for (EventStore::reverse_iterator itr = delayed.rbegin(); itr != delayed.rend(); ++itr)
+        Insert(itr->Time, itr->Data);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -128,13 +136,10 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](Event const& event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return eventId == (event.Data & 0x0000FFFF);
+    }), _eventMap.end());
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -142,13 +147,10 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [group](Event const& event)
     {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return (event.Data & (1 << (group + 15))) != 0;
+    }), _eventMap.end());
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -156,18 +158,18 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
     if (Empty())
         return 0;
 
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first;
+    for (EventStore::const_reverse_iterator itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->Data & 0x0000FFFF))
+            return itr->Time;
 
     return 0;
 }
 
 uint32 EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first - _time;
+    for (EventStore::const_reverse_iterator itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->Data & 0x0000FFFF))
+            return itr->Time - _time;
 
     return std::numeric_limits<uint32>::max();
 }
@@ -20,14 +20,14 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <vector>
 
 class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as uint32 when the event should occur.
-    * Value: The event data as uint32.
+    * Time: Time as uint32 when the event should occur.
+    * Data: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -35,7 +35,19 @@ class TC_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    struct Event
+    {
+        uint32 Time;
+        uint32 Data;
+    };
+
+    /**
+    * Events sorted by descending time, the next event to execute is at the back.
+    * Events with the same time are executed in scheduling order.
+    * AIs only ever have a handful of events, a contiguous vector is a lot cheaper
+    * to walk than a tree and never allocates once it reached its working size.
+    */
+    typedef std::vector<Event> EventStore;
 
 public:
     EventMap() : _time(0), _phase(0), _lastEvent(0) { }
@@ -201,7 +213,7 @@ public:
     */
     void Repeat(uint32 time)
     {
-        _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+        Insert(_time + time, _lastEvent);
     }
 
     /**
@@ -303,7 +315,7 @@ public:
     */
     uint32 GetNextEventTime() const
     {
-        return Empty() ? 0 : _eventMap.begin()->first;
+        return Empty() ? 0 : _eventMap.back().Time;
     }
 
     /**
@@ -326,6 +338,12 @@ public:
     uint32 GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name Insert
+    * @brief Inserts event data in the store, after the events already planned at the same time.
+    */
+    void Insert(uint32 time, uint32 data);
+
     /**
     * @name _time
     * @brief Internal timer.
@@ -20,6 +20,7 @@ void BasicEvent::SetAborted()
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_sequence = 0;
     m_aborting = false;
 }
 
@@ -34,12 +35,12 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().Time <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        std::pop_heap(m_events.begin(), m_events.end(), &EventProcessor::ExecutesAfter);
+        BasicEvent* event = m_events.back().Event;
+        m_events.pop_back();
 
         if (event->IsRunning())
         {
@@ -76,34 +77,32 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    auto kept = m_events.begin();
+    for (QueuedEvent& queued : m_events)
     {
+        BasicEvent* event = queued.Event;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        if (!force && !event->IsDeletable())
         {
-            ++itr;
+            *kept++ = queued;
             continue;
         }
 
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    // keep memory, only drop deleted entries and restore heap order for the remaining ones
+    m_events.erase(kept, m_events.end());
+    std::make_heap(m_events.begin(), m_events.end(), &EventProcessor::ExecutesAfter);
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -111,21 +110,26 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     if (set_addtime)
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    PushEvent(Event, e_time);
 }
 
-void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 newTime)
+void EventProcessor::PushEvent(BasicEvent* Event, uint64 e_time)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    m_events.push_back({ e_time, m_sequence++, Event });
+    std::push_heap(m_events.begin(), m_events.end(), &EventProcessor::ExecutesAfter);
+}
 
-        Event->m_execTime = newTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime, Event));
-        break;
-    }
+void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 newTime)
+{
+    auto itr = std::find_if(m_events.begin(), m_events.end(), [Event](QueuedEvent const& queued) { return queued.Event == Event; });
+    if (itr == m_events.end())
+        return;
+
+    Event->m_execTime = newTime;
+    // same as a remove + insert, the event goes after the other ones planned at newTime
+    itr->Time = newTime;
+    itr->Sequence = m_sequence++;
+    std::make_heap(m_events.begin(), m_events.end(), &EventProcessor::ExecutesAfter);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
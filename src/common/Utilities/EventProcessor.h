@@ -21,7 +21,8 @@
 
 #include "Define.h"
 
-#include <map>
+#include <algorithm>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
@@ -66,12 +67,21 @@ private:
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
 class TC_COMMON_API EventProcessor
 {
     friend class TestCase; //allow testCase to affect the events list
 
+    struct QueuedEvent
+    {
+        uint64 Time;
+        uint64 Sequence;                                    // insertion order, events planned at the same time execute in that order
+        BasicEvent* Event;
+    };
+
+    // Events are kept in a binary min heap stored in a single vector, so that once the vector has
+    // grown to its working size, adding and executing events doesn't allocate anymore
+    typedef std::vector<QueuedEvent> EventList;
+
     public:
         EventProcessor();
         ~EventProcessor();
@@ -85,6 +95,26 @@ class TC_COMMON_API EventProcessor
     protected:
         uint64 m_time;
         EventList m_events;
+        uint64 m_sequence;
         bool m_aborting;
+
+    private:
+        // heap ordering, top of the heap is the next event to execute
+        static bool ExecutesAfter(QueuedEvent const& left, QueuedEvent const& right)
+        {
+            if (left.Time != right.Time)
+                return left.Time > right.Time;
+            return left.Sequence > right.Sequence;
+        }
+
+        void PushEvent(BasicEvent* Event, uint64 e_time);
+
+        // Remove from queue (without deleting them) all events matching predicate
+        template<class Predicate>
+        void RemoveEventsIf(Predicate pred)
+        {
+            m_events.erase(std::remove_if(m_events.begin(), m_events.end(), [&](QueuedEvent const& queued) { return pred(queued.Event); }), m_events.end());
+            std::make_heap(m_events.begin(), m_events.end(), &EventProcessor::ExecutesAfter);
+        }
 };
 #endif
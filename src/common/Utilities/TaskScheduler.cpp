@@ -68,7 +68,7 @@ TaskScheduler& TaskScheduler::CancelGroupsOf(std::vector<group_t> const& groups)
 
 TaskScheduler& TaskScheduler::InsertTask(TaskContainer task)
 {
-    _task_holder.Push(std::move(task));
+    _task_holder.Push(task);
     return *this;
 }
 
@@ -96,10 +96,17 @@ void TaskScheduler::Dispatch(success_t const& callback)
 
         // Perfect forward the context to the handler
         // Use weak references to catch destruction before callbacks.
-        TaskContext context(_task_holder.Pop(), std::weak_ptr<TaskScheduler>(self_reference));
+        TaskContainer const task = _task_holder.Pop();
+        TaskContext context(task, std::weak_ptr<TaskScheduler>(self_reference));
 
         // Invoke the context
+        task->_running = true;
+        task->_consumed = false;
         context.Invoke();
+        task->_running = false;
+
+        // Give the task back to the pool unless it was repeated
+        _task_holder.Release(task);
 
         // If the validation failed abort the dispatching here.
         if (!_predicate())
@@ -110,50 +117,61 @@ void TaskScheduler::Dispatch(success_t const& callback)
     callback();
 }
 
-void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
+auto TaskScheduler::TaskQueue::Allocate() -> TaskContainer
 {
-    container.insert(task);
+    if (freeTasks.empty())
+    {
+        chunks.emplace_back(new Task[CHUNK_SIZE]);
+        for (size_t i = CHUNK_SIZE; i > 0; --i)
+            freeTasks.push_back(&chunks.back()[i - 1]);
+    }
+
+    TaskContainer task = freeTasks.back();
+    freeTasks.pop_back();
+    return task;
 }
 
-auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
+void TaskScheduler::TaskQueue::Release(TaskContainer task)
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
-    return result;
+    if (task->_queued || task->_running)
+        return;
+
+    task->_task.Reset();
+    task->_group = boost::none;
+    freeTasks.push_back(task);
 }
 
-auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
+void TaskScheduler::TaskQueue::Push(TaskContainer task)
 {
-    return *container.begin();
+    task->_sequence = sequence++;
+    task->_queued = true;
+    container.push_back(task);
+    std::push_heap(container.begin(), container.end(), Compare());
 }
 
-void TaskScheduler::TaskQueue::Clear()
+auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    container.clear();
+    std::pop_heap(container.begin(), container.end(), Compare());
+    TaskContainer result = container.back();
+    container.pop_back();
+    result->_queued = false;
+    return result;
 }
 
-void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
+auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-            itr = container.erase(itr);
-        else
-            ++itr;
+    return container.front();
 }
 
-void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
+void TaskScheduler::TaskQueue::Clear()
 {
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-            ++itr;
+    for (TaskContainer task : container)
+    {
+        task->_queued = false;
+        Release(task);
+    }
 
-    container.insert(cache.begin(), cache.end());
+    container.clear();
 }
 
 bool TaskScheduler::TaskQueue::IsEmpty() const
@@ -161,14 +179,6 @@ bool TaskScheduler::TaskQueue::IsEmpty() const
     return container.empty();
 }
 
-TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
-{
-    if (auto const owner = _owner.lock())
-        apply(*owner);
-
-    return *this;
-}
-
 bool TaskContext::IsExpired() const
 {
     return _owner.expired();
@@ -198,32 +208,44 @@ TaskScheduler::repeated_t TaskContext::GetRepeatCounter() const
 
 TaskContext& TaskContext::Async(std::function<void()> const& callable)
 {
-    return Dispatch(std::bind(&TaskScheduler::Async, std::placeholders::_1, callable));
+    return Dispatch([&callable](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        return scheduler.Async(callable);
+    });
 }
 
 TaskContext& TaskContext::CancelAll()
 {
-    return Dispatch(std::mem_fn(&TaskScheduler::CancelAll));
+    return Dispatch([](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        return scheduler.CancelAll();
+    });
 }
 
 TaskContext& TaskContext::CancelGroup(TaskScheduler::group_t const group)
 {
-    return Dispatch(std::bind(&TaskScheduler::CancelGroup, std::placeholders::_1, group));
+    return Dispatch([group](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        return scheduler.CancelGroup(group);
+    });
 }
 
 TaskContext& TaskContext::CancelGroupsOf(std::vector<TaskScheduler::group_t> const& groups)
 {
-    return Dispatch(std::bind(&TaskScheduler::CancelGroupsOf, std::placeholders::_1, std::cref(groups)));
+    return Dispatch([&groups](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        return scheduler.CancelGroupsOf(groups);
+    });
 }
 
 void TaskContext::AssertOnConsumed() const
 {
     // This was adapted to TC to prevent static analysis tools from complaining.
     // If you encounter this assertion check if you repeat a TaskContext more then 1 time!
-    ASSERT(!(*_consumed) && "Bad task logic, task context was consumed already!");
+    ASSERT((_task && !_task->_consumed) && "Bad task logic, task context was consumed already!");
 }
 
 void TaskContext::Invoke()
 {
-    _task->_task(*this);
+    _task->_task.Invoke(*this);
 }
@@ -23,11 +23,13 @@
 #include "Random.h"
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <vector>
 #include <queue>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
-#include <set>
 
 class TaskContext;
 
@@ -44,6 +46,8 @@ class TaskContext;
 /// with the same duration or a new one.
 /// It also provides access to the repeat counter which is useful for task that repeat itself often
 /// but behave different every time (spoken event dialogs for example).
+/// Tasks live in a pool owned by the scheduler and callables are stored inline in them,
+/// so scheduling, repeating and cancelling tasks don't allocate once the pool is warm.
 class TC_COMMON_API TaskScheduler
 {
     friend class TaskContext;
@@ -57,13 +61,70 @@ class TC_COMMON_API TaskScheduler
     typedef uint32 group_t;
     // Task repeated type
     typedef uint32 repeated_t;
-    // Task handle type
+    // Task handle type, any callable with this signature is accepted by Schedule
     typedef std::function<void(TaskContext)> task_handler_t;
     // Predicate type
     typedef std::function<bool()> predicate_t;
     // Success handle type
     typedef std::function<void()> success_t;
 
+    /// Type erased void(TaskContext) callable. Callables up to INLINE_SIZE bytes
+    /// (pretty much every lambda and std::function) are stored in place, bigger ones on the heap.
+    class TaskHandler
+    {
+        static size_t const INLINE_SIZE = 64;
+
+        typedef void(*invoke_t)(void*, TaskContext&);
+        typedef void(*destroy_t)(void*);
+
+        typename std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type _storage;
+        void* _callable;
+        invoke_t _invoke;
+        destroy_t _destroy;
+
+        template<typename C, typename F>
+        void Construct(F&& callable, std::true_type /*inlined*/)
+        {
+            _callable = new (&_storage) C(std::forward<F>(callable));
+            _destroy = [](void* c) { static_cast<C*>(c)->~C(); };
+        }
+
+        template<typename C, typename F>
+        void Construct(F&& callable, std::false_type /*inlined*/)
+        {
+            _callable = new C(std::forward<F>(callable));
+            _destroy = [](void* c) { delete static_cast<C*>(c); };
+        }
+
+    public:
+        TaskHandler() : _callable(nullptr), _invoke(nullptr), _destroy(nullptr) { }
+        ~TaskHandler() { Reset(); }
+
+        TaskHandler(TaskHandler const&) = delete;
+        TaskHandler& operator= (TaskHandler const&) = delete;
+
+        template<typename F>
+        void Emplace(F&& callable)
+        {
+            typedef typename std::decay<F>::type C;
+            Reset();
+            Construct<C>(std::forward<F>(callable), std::integral_constant<bool, sizeof(C) <= INLINE_SIZE && alignof(C) <= alignof(std::max_align_t)>());
+            _invoke = [](void* c, TaskContext& context) { (*static_cast<C*>(c))(context); };
+        }
+
+        void Reset()
+        {
+            if (_callable)
+                _destroy(_callable);
+            _callable = nullptr;
+        }
+
+        void Invoke(TaskContext& context) const
+        {
+            _invoke(_callable, context);
+        }
+    };
+
     class Task
     {
         friend class TaskContext;
@@ -73,42 +134,36 @@ class TC_COMMON_API TaskScheduler
         duration_t _duration;
         Optional<group_t> _group;
         repeated_t _repeated;
-        task_handler_t _task;
+        uint64 _sequence;   // insertion order, tasks ending at the same time are executed in that order
+        bool _queued;       // in the task queue
+        bool _running;      // callback is being executed, the task must not be released until it returns
+        bool _consumed;     // repeated from the current execution context
+        TaskHandler _task;
 
     public:
-        // All Argument construct
-        Task(timepoint_t const& end, duration_t const& duration, Optional<group_t> const& group,
-            repeated_t const repeated, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(group), _repeated(repeated), _task(task) { }
-
-        // Minimal Argument construct
-        Task(timepoint_t const& end, duration_t const& duration, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(boost::none), _repeated(0), _task(task) { }
+        Task() : _end(), _duration(), _group(boost::none), _repeated(0), _sequence(0),
+            _queued(false), _running(false), _consumed(false) { }
 
         // Copy construct
         Task(Task const&) = delete;
         // Move construct
         Task(Task&&) = delete;
         // Copy Assign
-        Task& operator= (Task const&) = default;
+        Task& operator= (Task const&) = delete;
         // Move Assign
         Task& operator= (Task&& right) = delete;
 
         // Order tasks by its end
         inline bool operator< (Task const& other) const
         {
-            return _end < other._end;
+            if (_end != other._end)
+                return _end < other._end;
+            return _sequence < other._sequence;
         }
 
         inline bool operator> (Task const& other) const
         {
-            return _end > other._end;
-        }
-
-        // Compare tasks with its end
-        inline bool operator== (Task const& other)
-        {
-            return _end == other._end;
+            return other < *this;
         }
 
         // Returns true if the task is in the given group
@@ -118,35 +173,74 @@ class TC_COMMON_API TaskScheduler
         }
     };
 
-    typedef std::shared_ptr<Task> TaskContainer;
+    typedef Task* TaskContainer;
 
-    /// Container which provides Task order, insert and reschedule operations.
+    /// Heap ordering, the top of the heap is the next task to execute.
     struct Compare
     {
-        bool operator() (TaskContainer const& left, TaskContainer const& right)
+        bool operator() (TaskContainer const& left, TaskContainer const& right) const
         {
-            return (*left.get()) < (*right.get());
+            return (*left) > (*right);
         };
     };
 
+    /// Binary min heap of tasks, the tasks themselves are allocated from a pool owned by the queue
     class TC_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        static size_t const CHUNK_SIZE = 16;
+
+        std::vector<TaskContainer> container;
+        std::vector<std::unique_ptr<Task[]>> chunks;
+        std::vector<TaskContainer> freeTasks;
+        uint64 sequence = 0;
 
     public:
+        TaskQueue() = default;
+        TaskQueue(TaskQueue const&) = delete;
+        TaskQueue& operator= (TaskQueue const&) = delete;
+
+        /// Gets an unused task from the pool
+        TaskContainer Allocate();
+
+        /// Returns the task to the pool if it isn't queued or running anymore
+        void Release(TaskContainer task);
+
         // Pushes the task in the container
-        void Push(TaskContainer&& task);
+        void Push(TaskContainer task);
 
-        /// Pops the task out of the container
+        /// Pops the task out of the container, the task stays owned by the caller until released
         TaskContainer Pop();
 
         TaskContainer const& First() const;
 
         void Clear();
 
-        void RemoveIf(std::function<bool(TaskContainer const&)> const& filter);
+        template<typename F>
+        void RemoveIf(F const& filter)
+        {
+            auto const end = std::remove_if(container.begin(), container.end(), [&](TaskContainer const& task) -> bool
+            {
+                if (!filter(task))
+                    return false;
 
-        void ModifyIf(std::function<bool(TaskContainer const&)> const& filter);
+                task->_queued = false;
+                Release(task);
+                return true;
+            });
+            container.erase(end, container.end());
+            std::make_heap(container.begin(), container.end(), Compare());
+        }
+
+        template<typename F>
+        void ModifyIf(F const& filter)
+        {
+            // Modified tasks go after the ones already queued at the same time, like a remove + push would
+            for (TaskContainer const& task : container)
+                if (filter(task))
+                    task->_sequence = sequence++;
+
+            std::make_heap(container.begin(), container.end(), Compare());
+        }
 
         bool IsEmpty() const;
     };
@@ -226,39 +320,39 @@ public:
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        task_handler_t const& task)
+        F&& task)
     {
-        return ScheduleAt(_now, time, task);
+        return ScheduleAt(_now, time, std::forward<F>(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        group_t const group, F&& task)
     {
-        return ScheduleAt(_now, time, group, task);
+        return ScheduleAt(_now, time, group, std::forward<F>(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename F>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-        std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t const& task)
+        std::chrono::duration<_RepRight, _PeriodRight> const& max, F&& task)
     {
-        return Schedule(RandomDurationBetween(min, max), task);
+        return Schedule(RandomDurationBetween(min, max), std::forward<F>(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename F>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
         std::chrono::duration<_RepRight, _PeriodRight> const& max, group_t const group,
-        task_handler_t const& task)
+        F&& task)
     {
-        return Schedule(RandomDurationBetween(min, max), group, task);
+        return Schedule(RandomDurationBetween(min, max), group, std::forward<F>(task));
     }
 
     /// Cancels all tasks.
@@ -371,22 +465,27 @@ private:
     /// Insert a new task to the enqueued tasks.
     TaskScheduler& InsertTask(TaskContainer task);
 
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
-        std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
+        std::chrono::duration<_Rep, _Period> const& time, F&& task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, task)));
+        return ScheduleAt(end, time, Optional<group_t>(), std::forward<F>(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
         std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        Optional<group_t> const& group, F&& task)
     {
-        static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, task)));
+        TaskContainer container = _task_holder.Allocate();
+        container->_end = end + time;
+        container->_duration = time;
+        container->_group = group;
+        container->_repeated = 0;
+        container->_task.Emplace(std::forward<F>(task));
+        return InsertTask(container);
     }
 
     // Returns a random duration between min and max
@@ -410,50 +509,53 @@ class TC_COMMON_API TaskContext
 {
     friend class TaskScheduler;
 
-    /// Associated task
+    /// Associated task. It belongs to the owner task pool and is only guaranteed
+    /// to be valid while the task callback is running, don't keep contexts around.
     TaskScheduler::TaskContainer _task;
 
     /// Owner
     std::weak_ptr<TaskScheduler> _owner;
 
-    /// Marks the task as consumed
-    std::shared_ptr<bool> _consumed;
-
     /// Dispatches an action safe on the TaskScheduler
-    TaskContext& Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply);
+    template<typename F>
+    TaskContext& Dispatch(F const& apply)
+    {
+        if (auto const owner = _owner.lock())
+            apply(*owner);
+
+        return *this;
+    }
 
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(nullptr), _owner() { }
 
     // Construct from task and owner
-    explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(task), _owner(owner), _consumed(std::make_shared<bool>(false)) { }
+    explicit TaskContext(TaskScheduler::TaskContainer task, std::weak_ptr<TaskScheduler>&& owner)
+        : _task(task), _owner(owner) { }
 
     // Copy construct
     TaskContext(TaskContext const& right)
-        : _task(right._task), _owner(right._owner), _consumed(right._consumed) { }
+        : _task(right._task), _owner(right._owner) { }
 
     // Move construct
     TaskContext(TaskContext&& right)
-        : _task(std::move(right._task)), _owner(std::move(right._owner)), _consumed(std::move(right._consumed)) { }
+        : _task(right._task), _owner(std::move(right._owner)) { }
 
     // Copy assign
     TaskContext& operator= (TaskContext const& right)
     {
         _task = right._task;
         _owner = right._owner;
-        _consumed = right._consumed;
         return *this;
     }
 
     // Move assign
     TaskContext& operator= (TaskContext&& right)
     {
-        _task = std::move(right._task);
+        _task = right._task;
         _owner = std::move(right._owner);
-        _consumed = std::move(right._consumed);
         return *this;
     }
 
@@ -479,14 +581,22 @@ public:
     template<class _Rep, class _Period>
     TaskContext& Repeat(std::chrono::duration<_Rep, _Period> const& duration)
     {
+        // The task went away with its owner
+        if (IsExpired())
+            return *this;
+
         AssertOnConsumed();
 
         // Set new duration, in-context timing and increment repeat counter
         _task->_duration = duration;
         _task->_end += duration;
         _task->_repeated += 1;
-        (*_consumed) = true;
-        return Dispatch(std::bind(&TaskScheduler::InsertTask, std::placeholders::_1, _task));
+        _task->_consumed = true;
+        TaskScheduler::TaskContainer const task = _task;
+        return Dispatch([task](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTask(task);
+        });
     }
 
     /// Repeats the event with the same duration.
@@ -494,6 +604,9 @@ public:
     /// from the same task context!
     TaskContext& Repeat()
     {
+        if (IsExpired())
+            return *this;
+
         return Repeat(_task->_duration);
     }
 
@@ -516,53 +629,51 @@ public:
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        TaskScheduler::task_handler_t const& task)
+        F&& task)
     {
-        auto const end = _task->_end;
-        return Dispatch([end, time, task](TaskScheduler& scheduler) -> TaskScheduler&
-        {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, task);
-        });
+        if (auto const owner = _owner.lock())
+            owner->ScheduleAt(_task->_end, time, std::forward<F>(task));
+
+        return *this;
     }
 
     /// Schedule an event with a fixed rate from within the context.
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename F>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        TaskScheduler::group_t const group, TaskScheduler::task_handler_t const& task)
+        TaskScheduler::group_t const group, F&& task)
     {
-        auto const end = _task->_end;
-        return Dispatch([end, time, group, task](TaskScheduler& scheduler) -> TaskScheduler&
-        {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, group, task);
-        });
+        if (auto const owner = _owner.lock())
+            owner->ScheduleAt(_task->_end, time, group, std::forward<F>(task));
+
+        return *this;
     }
 
     /// Schedule an event with a randomized rate between min and max rate from within the context.
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename F>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-        std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::task_handler_t const& task)
+        std::chrono::duration<_RepRight, _PeriodRight> const& max, F&& task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), std::forward<F>(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate from within the context.
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename F>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
         std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::group_t const group,
-        TaskScheduler::task_handler_t const& task)
+        F&& task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, std::forward<F>(task));
     }
 
     /// Cancels all tasks from within the context.
@@ -579,7 +690,10 @@ public:
     template<class _Rep, class _Period>
     TaskContext& DelayAll(std::chrono::duration<_Rep, _Period> const& duration)
     {
-        return Dispatch(std::bind(&TaskScheduler::DelayAll<_Rep, _Period>, std::placeholders::_1, duration));
+        return Dispatch([&duration](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.DelayAll(duration);
+        });
     }
 
     /// Delays all tasks with a random duration between min and max from within the context.
@@ -594,7 +708,10 @@ public:
     template<class _Rep, class _Period>
     TaskContext& DelayGroup(TaskScheduler::group_t const group, std::chrono::duration<_Rep, _Period> const& duration)
     {
-        return Dispatch(std::bind(&TaskScheduler::DelayGroup<_Rep, _Period>, std::placeholders::_1, group, duration));
+        return Dispatch([group, &duration](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.DelayGroup(group, duration);
+        });
     }
 
     /// Delays all tasks of a group with a random duration between min and max from within the context.
@@ -610,7 +727,10 @@ public:
     template<class _Rep, class _Period>
     TaskContext& RescheduleAll(std::chrono::duration<_Rep, _Period> const& duration)
     {
-        return Dispatch(std::bind(&TaskScheduler::RescheduleAll, std::placeholders::_1, duration));
+        return Dispatch([&duration](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.RescheduleAll(duration);
+        });
     }
 
     /// Reschedule all tasks with a random duration between min and max.
@@ -625,7 +745,10 @@ public:
     template<class _Rep, class _Period>
     TaskContext& RescheduleGroup(TaskScheduler::group_t const group, std::chrono::duration<_Rep, _Period> const& duration)
     {
-        return Dispatch(std::bind(&TaskScheduler::RescheduleGroup<_Rep, _Period>, std::placeholders::_1, group, duration));
+        return Dispatch([group, &duration](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.RescheduleGroup(group, duration);
+        });
     }
 
     /// Reschedule all tasks of a group with a random duration between min and max.
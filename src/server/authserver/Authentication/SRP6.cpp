@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SRP6.h"
+#include "Errors.h"
+#include "SHA1.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    uint32 const SRP_6_V = 0x20;
+    uint32 const SRP_6_S = 0x20;
+}
+
+BigNumber SRP6::GetN()
+{
+    BigNumber N;
+    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+    return N;
+}
+
+BigNumber SRP6::GetG()
+{
+    return BigNumber(7);
+}
+
+SRP6::ChallengeResult SRP6::Challenge(std::string const& passwordHash, std::string const& databaseV, std::string const& databaseS)
+{
+    BigNumber N = GetN();
+    BigNumber g = GetG();
+    ChallengeResult result;
+
+    // multiply with 2 since bytes are stored as hexstring
+    if (databaseV.size() != size_t(SRP_6_V) * 2 || databaseS.size() != size_t(SRP_6_S) * 2)
+    {
+        // Make the SRP6 calculation from hash in dB
+        result.s.SetRand(int32(SRP_6_S) * 8);
+
+        BigNumber I;
+        I.SetHexStr(passwordHash.c_str());
+
+        // In case of leading zeros in the rI hash, restore them
+        uint8 mDigest[SHA_DIGEST_LENGTH];
+        memcpy(mDigest, I.AsByteArray(SHA_DIGEST_LENGTH).get(), SHA_DIGEST_LENGTH);
+
+        std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
+
+        SHA1Hash sha;
+        sha.UpdateData(result.s.AsByteArray(SRP_6_S).get(), SRP_6_S);
+        sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+        result.v = g.ModExp(x, N);
+        result.NewVerifier = true;
+    }
+    else
+    {
+        result.s.SetHexStr(databaseS.c_str());
+        result.v.SetHexStr(databaseV.c_str());
+    }
+
+    result.b.SetRand(19 * 8);
+    BigNumber gmod = g.ModExp(result.b, N);
+    result.B = ((result.v * 3) + gmod) % N;
+
+    ASSERT(gmod.GetNumBytes() <= 32);
+
+    return result;
+}
+
+SRP6::ProofResult SRP6::Proof(std::string const& login, uint8 const* clientA, BigNumber B, BigNumber b, BigNumber s, BigNumber v)
+{
+    BigNumber N = GetN();
+
+    BigNumber A;
+    A.SetBinary(clientA, 32);
+
+    // SRP safeguard: abort if A == 0
+    if ((A % N).IsZero())
+        return ProofResult();
+
+    SHA1Hash sha;
+    sha.UpdateBigNumbers(&A, &B, NULL);
+    sha.Finalize();
+    BigNumber u;
+    u.SetBinary(sha.GetDigest(), 20);
+    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+
+    return ProofFromSecret(login, s, A, B, S);
+}
+
+SRP6::ProofResult SRP6::ProofFromSecret(std::string const& login, BigNumber s, BigNumber A, BigNumber B, BigNumber S)
+{
+    BigNumber N = GetN();
+    BigNumber g = GetG();
+    ProofResult result;
+    SHA1Hash sha;
+
+    uint8 t[32];
+    uint8 t1[16];
+    uint8 vK[40];
+    memcpy(t, S.AsByteArray(32).get(), 32);
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2] = sha.GetDigest()[i];
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2 + 1];
+
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2 + 1] = sha.GetDigest()[i];
+
+    result.K.SetBinary(vK, 40);
+
+    uint8 hash[20];
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&N, NULL);
+    sha.Finalize();
+    memcpy(hash, sha.GetDigest(), 20);
+    sha.Initialize();
+    sha.UpdateBigNumbers(&g, NULL);
+    sha.Finalize();
+
+    for (int i = 0; i < 20; ++i)
+        hash[i] ^= sha.GetDigest()[i];
+
+    BigNumber t3;
+    t3.SetBinary(hash, 20);
+
+    sha.Initialize();
+    sha.UpdateData(login);
+    sha.Finalize();
+    uint8 t4[SHA_DIGEST_LENGTH];
+    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&t3, NULL);
+    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+    sha.UpdateBigNumbers(&s, &A, &B, &result.K, NULL);
+    sha.Finalize();
+    BigNumber M;
+    M.SetBinary(sha.GetDigest(), sha.GetLength());
+    memcpy(result.M, M.AsByteArray(sha.GetLength()).get(), SHA_DIGEST_LENGTH);
+
+    // Finish SRP6, the final result sent to the client if M matches
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &M, &result.K, NULL);
+    sha.Finalize();
+    memcpy(result.M2, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    result.Valid = true;
+    return result;
+}
@@ -0,0 +1,53 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SRP6_H
+#define _SRP6_H
+
+#include "BigNumber.h"
+#include <openssl/sha.h>
+#include <string>
+
+// Server side SRP6 math of the logon, free of socket and database access so it can run on the login crypto pool
+namespace SRP6
+{
+    BigNumber GetN();
+    BigNumber GetG();
+
+    struct ChallengeResult
+    {
+        BigNumber s, v;
+        bool NewVerifier = false; // s and v were generated from the password hash and must be saved
+        BigNumber b, B;
+    };
+
+    // passwordHash is account.sha_pass_hash, databaseV and databaseS the stored verifier (hex strings, may be empty)
+    ChallengeResult Challenge(std::string const& passwordHash, std::string const& databaseV, std::string const& databaseS);
+
+    struct ProofResult
+    {
+        bool Valid = false; // false if A was rejected, the connection must be dropped
+        BigNumber K;
+        uint8 M[SHA_DIGEST_LENGTH];
+        uint8 M2[SHA_DIGEST_LENGTH]; // server proof, only meaningful if M matches the client proof
+    };
+
+    ProofResult Proof(std::string const& login, uint8 const* A, BigNumber B, BigNumber b, BigNumber s, BigNumber v);
+
+    // Session key and proofs from the shared secret S, the part both sides compute the same way
+    ProofResult ProofFromSecret(std::string const& login, BigNumber s, BigNumber A, BigNumber B, BigNumber S);
+}
+
+#endif
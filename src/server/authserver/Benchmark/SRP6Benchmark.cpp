@@ -0,0 +1,147 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    Measures the SRP6 logons per second the authserver crypto can sustain, per thread and for all threads.
+    Each logon runs the server challenge and proof plus the client side math, and checks the proofs match.
+    usage: authserver-benchmark [threads] [seconds]
+*/
+
+#include "SRP6.h"
+#include "SHA1.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::string const Login = "BENCHMARK";
+    std::string const PasswordHash = "D567D6953D5E47068AB708004B6B4E3B78D69292"; // SHA1("BENCHMARK:BENCHMARK")
+
+    // client side: x = H(s, H(I:P)), as in SRP6::Challenge
+    BigNumber ComputeX(BigNumber s)
+    {
+        BigNumber I;
+        I.SetHexStr(PasswordHash.c_str());
+        uint8 digest[SHA_DIGEST_LENGTH];
+        memcpy(digest, I.AsByteArray(SHA_DIGEST_LENGTH).get(), SHA_DIGEST_LENGTH);
+        std::reverse(digest, digest + SHA_DIGEST_LENGTH);
+
+        SHA1Hash sha;
+        sha.UpdateData(s.AsByteArray(32).get(), 32);
+        sha.UpdateData(digest, SHA_DIGEST_LENGTH);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+        return x;
+    }
+
+    bool RunLogon(std::string const& databaseV, std::string const& databaseS, BigNumber& x)
+    {
+        BigNumber N = SRP6::GetN();
+        BigNumber g = SRP6::GetG();
+
+        SRP6::ChallengeResult challenge = SRP6::Challenge(PasswordHash, databaseV, databaseS);
+
+        // client: A = g^a, S = (B - 3 * g^x) ^ (a + u * x)
+        // BigNumber::AsByteArray pads short numbers on the wrong side, keep A a full 32 bytes as it is sent on the wire
+        BigNumber a, A;
+        do
+        {
+            a.SetRand(19 * 8);
+            A = g.ModExp(a, N);
+        } while (A.GetNumBytes() < 32);
+
+        SHA1Hash sha;
+        sha.UpdateBigNumbers(&A, &challenge.B, NULL);
+        sha.Finalize();
+        BigNumber u;
+        u.SetBinary(sha.GetDigest(), 20);
+
+        BigNumber base = ((challenge.B + (N * 3)) - (g.ModExp(x, N) * 3)) % N;
+        BigNumber S = base.ModExp(a + (u * x), N);
+        SRP6::ProofResult client = SRP6::ProofFromSecret(Login, challenge.s, A, challenge.B, S);
+
+        SRP6::ProofResult server = SRP6::Proof(Login, A.AsByteArray(32).get(), challenge.B, challenge.b, challenge.s, challenge.v);
+        return server.Valid && !memcmp(server.M, client.M, SHA_DIGEST_LENGTH) && !memcmp(server.M2, client.M2, SHA_DIGEST_LENGTH);
+    }
+
+    double Measure(uint32 threadCount, uint32 seconds, std::string const& databaseV, std::string const& databaseS, BigNumber const& x)
+    {
+        std::atomic<uint64> logons(0);
+        std::atomic<bool> failed(false);
+        auto const end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+
+        std::vector<std::thread> threads;
+        for (uint32 i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                BigNumber threadX = x;
+                uint64 count = 0;
+                while (std::chrono::steady_clock::now() < end)
+                {
+                    if (!RunLogon(databaseV, databaseS, threadX))
+                        failed = true;
+                    ++count;
+                }
+                logons += count;
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        if (failed)
+        {
+            printf("SRP6 proofs did not match, results are meaningless\n");
+            exit(1);
+        }
+
+        return double(logons) / seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 maxThreads = argc > 1 ? uint32(atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+    uint32 seconds = argc > 2 ? uint32(atoi(argv[2])) : 5;
+    maxThreads = std::max(1u, maxThreads);
+    seconds = std::max(1u, seconds);
+
+    // the usual case, the verifier is already stored in the account table
+    SRP6::ChallengeResult account = SRP6::Challenge(PasswordHash, "", "");
+    std::string databaseV = account.v.AsHexStr();
+    std::string databaseS = account.s.AsHexStr();
+    databaseV.insert(0, 64 - std::min<size_t>(64, databaseV.size()), '0');
+    databaseS.insert(0, 64 - std::min<size_t>(64, databaseS.size()), '0');
+    BigNumber x = ComputeX(account.s);
+
+    printf("%8s %14s %20s\n", "threads", "logons/s", "logons/s/thread");
+    // powers of two, then maxThreads itself
+    for (uint32 threadCount = 1; threadCount <= maxThreads; threadCount = threadCount == maxThreads ? maxThreads + 1 : std::min(threadCount * 2, maxThreads))
+    {
+        double rate = Measure(threadCount, seconds, databaseV, databaseS, x);
+        printf("%8u %14.0f %20.0f\n", threadCount, rate, rate / threadCount);
+    }
+
+    return 0;
+}
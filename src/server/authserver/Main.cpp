@@ -7,6 +7,7 @@
 */
 
 #include "AuthSocketMgr.h"
+#include "LoginCryptoPool.h"
 #include "Banner.h"
 #include "Common.h"
 #include "DatabaseEnv.h"
@@ -139,6 +140,10 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // SRP6 math of logons runs on its own threads, they must outlive the sessions so the pool stops after the network
+    sLoginCryptoPool->Start(sConfigMgr->GetIntDefault("LoginCrypto.Threads", 2), sConfigMgr->GetIntDefault("LoginCrypto.MaxQueued", 5000));
+    std::shared_ptr<void> sLoginCryptoPoolHandle(nullptr, [](void*) { sLoginCryptoPool->Stop(); });
+
     // Start the listening port (acceptor) for auth connections
     int32 port = sConfigMgr->GetIntDefault("RealmServerPort", 3724);
     if (port < 0 || port > 0xFFFF)
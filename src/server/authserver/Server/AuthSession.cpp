@@ -8,7 +8,11 @@
 #include "openssl/crypto.h"
 #include "Configuration/Config.h"
 #include "RealmList.h"
+#include "LoginCryptoPool.h"
+#include "RealmListPacketCache.h"
 #include <boost/lexical_cast.hpp>
+#include <array>
+#include <future>
 
 
 using boost::asio::ip::tcp;
@@ -133,10 +137,10 @@ void AccountInfo::LoadResult(Field* fields)
 }
 
 AuthSession::AuthSession(tcp::socket&& socket) : Socket(std::move(socket)),
-_status(STATUS_CHALLENGE), _build(0), _expversion(0)
+_status(STATUS_CHALLENGE), _build(0), _expversion(0), _characterCountsTime(0)
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
+    N = SRP6::GetN();
+    g = SRP6::GetG();
 }
 
 void AuthSession::Start()
@@ -157,10 +161,60 @@ bool AuthSession::Update()
         return false;
 
     _queryProcessor.ProcessReadyQueries();
+    ProcessCryptoResult();
 
     return true;
 }
 
+template<typename Result>
+bool AuthSession::RunCrypto(std::function<Result()>&& compute, std::function<void(Result&)>&& callback, bool newLogon)
+{
+    // one task at a time, the client has no reason to send anything before getting its answer
+    if (_pendingCrypto)
+        return false;
+
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(compute));
+    auto future = std::make_shared<std::future<Result>>(task->get_future());
+
+    uint32 position = sLoginCryptoPool->Enqueue([task]() { (*task)(); }, newLogon);
+    if (!position)
+        return false;
+
+    TC_LOG_DEBUG("server.authserver", "'%s:%d' SRP6 queued at position %u", GetRemoteIpAddress().to_string().c_str(), GetRemotePort(), position);
+    _status = STATUS_WAITING_FOR_CRYPTO;
+
+    _pendingCrypto = [future, callback]() -> bool
+    {
+        if (future->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        Result result = future->get();
+        callback(result);
+        return true;
+    };
+
+    // without crypto threads the result is already there
+    ProcessCryptoResult();
+    return true;
+}
+
+void AuthSession::ProcessCryptoResult()
+{
+    if (!_pendingCrypto)
+        return;
+
+    // the callback may queue the next step, so release the current one first
+    std::function<bool()> pending = std::move(_pendingCrypto);
+    _pendingCrypto = nullptr;
+    // like packet handlers, callbacks set the next status themselves
+    _status = STATUS_CLOSED;
+    if (!pending())
+    {
+        _pendingCrypto = std::move(pending);
+        _status = STATUS_WAITING_FOR_CRYPTO;
+    }
+}
+
 void AuthSession::CheckIpCallback(PreparedQueryResult result)
 {
     if (result)
@@ -364,24 +418,41 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
 
     TC_LOG_DEBUG("network", "database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-    // multiply with 2 since bytes are stored as hexstring
-    if (databaseV.size() != size_t(BufferSizes::SRP_6_V) * 2 || databaseS.size() != size_t(BufferSizes::SRP_6_S) * 2)
-        SetVSFields(rI);
-    else
+    _tokenKey = fields[9].GetString();
+
+    if (!RunCrypto<SRP6::ChallengeResult>([rI, databaseV, databaseS]() { return SRP6::Challenge(rI, databaseV, databaseS); },
+        [this](SRP6::ChallengeResult& result) { LogonChallengeCryptoCallback(result); }, true))
     {
-        s.SetHexStr(databaseS.c_str());
-        v.SetHexStr(databaseV.c_str());
+        pkt << uint8(WOW_FAIL_DB_BUSY);
+        SendPacket(pkt);
+        TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s refused, login crypto queue is full", ipAddress.c_str(), port, _accountInfo.Login.c_str());
     }
+}
 
-    b.SetRand(19 * 8);
-    BigNumber gmod = g.ModExp(b, N);
-    B = ((v * 3) + gmod) % N;
+void AuthSession::LogonChallengeCryptoCallback(SRP6::ChallengeResult& result)
+{
+    s = result.s;
+    v = result.v;
+    b = result.b;
+    B = result.B;
 
-    ASSERT(gmod.GetNumBytes() <= 32);
+    if (result.NewVerifier)
+    {
+        // No SQL injection (username escaped)
+        PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_VS);
+        stmt->setString(0, v.AsHexStr());
+        stmt->setString(1, s.AsHexStr());
+        stmt->setString(2, _accountInfo.Login);
+        LoginDatabase.Execute(stmt);
+    }
 
     BigNumber unk3;
     unk3.SetRand(16 * 8);
 
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
+
     // Fill the response packet with the result
     if (AuthHelper::IsAcceptedClientBuild(_build))
     {
@@ -401,7 +472,6 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
     uint8 securityFlags = 0;
 
     // Check if token is used
-    _tokenKey = fields[9].GetString();
     if (!_tokenKey.empty())
         securityFlags = 4;
 
@@ -426,7 +496,7 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         pkt << uint8(1);
 
     TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s is using '%s' locale (%u)",
-        ipAddress.c_str(), port, _accountInfo.Login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
+        GetRemoteIpAddress().to_string().c_str(), GetRemotePort(), _accountInfo.Login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
     SendPacket(pkt);
 }
@@ -448,88 +518,56 @@ bool AuthSession::HandleLogonProof()
         return false;
     }
 
-    // Continue the SRP6 calculation based on data received from the client
-    BigNumber A;
-
-    A.SetBinary(logonProof->A, 32);
-
-    // SRP safeguard: abort if A == 0
-    if ((A % N).IsZero())
-        return false;
-
-    SHA1Hash sha;
-    sha.UpdateBigNumbers(&A, &B, NULL);
-    sha.Finalize();
-    BigNumber u;
-    u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
-
-    uint8 t[32];
-    uint8 t1[16];
-    uint8 vK[40];
-    memcpy(t, S.AsByteArray(32).get(), 32);
-
-    for (int i = 0; i < 16; ++i)
-        t1[i] = t[i * 2];
-
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-
-    for (int i = 0; i < 20; ++i)
-        vK[i * 2] = sha.GetDigest()[i];
-
-    for (int i = 0; i < 16; ++i)
-        t1[i] = t[i * 2 + 1];
-
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-
-    for (int i = 0; i < 20; ++i)
-        vK[i * 2 + 1] = sha.GetDigest()[i];
-
-    K.SetBinary(vK, 40);
-
-    uint8 hash[20];
-
-    sha.Initialize();
-    sha.UpdateBigNumbers(&N, NULL);
-    sha.Finalize();
-    memcpy(hash, sha.GetDigest(), 20);
-    sha.Initialize();
-    sha.UpdateBigNumbers(&g, NULL);
-    sha.Finalize();
+    // Token is read now, the read buffer moves on once this handler returns
+    std::string token;
+    if ((logonProof->securityFlags & 0x04) || !_tokenKey.empty())
+    {
+        uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
+        token.assign(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
+        GetReadBuffer().ReadCompleted(sizeof(size) + size);
+    }
 
-    for (int i = 0; i < 20; ++i)
-        hash[i] ^= sha.GetDigest()[i];
+    // Continue the SRP6 calculation based on data received from the client
+    std::array<uint8, 32> clientA;
+    std::array<uint8, 20> clientM;
+    memcpy(clientA.data(), logonProof->A, clientA.size());
+    memcpy(clientM.data(), logonProof->M1, clientM.size());
+    uint8 securityFlags = logonProof->securityFlags;
+
+    std::string login = _accountInfo.Login;
+    BigNumber proofB = B, proofb = b, proofs = s, proofv = v;
+    if (!RunCrypto<SRP6::ProofResult>([login, clientA, proofB, proofb, proofs, proofv]() { return SRP6::Proof(login, clientA.data(), proofB, proofb, proofs, proofv); },
+        [this, clientM, securityFlags, token](SRP6::ProofResult& result) { LogonProofCryptoCallback(result, clientM.data(), securityFlags, token); }, false))
+    {
+        ByteBuffer packet;
+        packet << uint8(AUTH_LOGON_PROOF);
+        packet << uint8(WOW_FAIL_DB_BUSY);
+        packet << uint8(3);
+        packet << uint8(0);
+        SendPacket(packet);
+        TC_LOG_DEBUG("server.authserver", "'%s:%d' [AuthChallenge] account %s proof refused, login crypto queue is full",
+            GetRemoteIpAddress().to_string().c_str(), GetRemotePort(), _accountInfo.Login.c_str());
+    }
 
-    BigNumber t3;
-    t3.SetBinary(hash, 20);
+    return true;
+}
 
-    sha.Initialize();
-    sha.UpdateData(_accountInfo.Login);
-    sha.Finalize();
-    uint8 t4[SHA_DIGEST_LENGTH];
-    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+void AuthSession::LogonProofCryptoCallback(SRP6::ProofResult& result, uint8 const* clientM, uint8 securityFlags, std::string const& token)
+{
+    if (!result.Valid)
+    {
+        CloseSocket();
+        return;
+    }
 
-    sha.Initialize();
-    sha.UpdateBigNumbers(&t3, NULL);
-    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
-    sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
-    sha.Finalize();
-    BigNumber M;
-    M.SetBinary(sha.GetDigest(), sha.GetLength());
+    K = result.K;
 
     // Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(sha.GetLength()).get(), logonProof->M1, 20))
+    if (!memcmp(result.M, clientM, 20))
     {
         // Check auth token
-        if ((logonProof->securityFlags & 0x04) || !_tokenKey.empty())
+        if ((securityFlags & 0x04) || !_tokenKey.empty())
         {
-            uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
-            std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
-            GetReadBuffer().ReadCompleted(sizeof(size) + size);
             uint32 validToken = TOTP::GenerateToken(_tokenKey.c_str());
             _tokenKey.clear();
             uint32 incomingToken = atoi(token.c_str());
@@ -541,7 +579,7 @@ bool AuthSession::HandleLogonProof()
                 packet << uint8(3);
                 packet << uint8(0);
                 SendPacket(packet);
-                return true;
+                return;
             }
         }
 
@@ -560,15 +598,11 @@ bool AuthSession::HandleLogonProof()
         LoginDatabase.DirectExecute(stmt);
 
         // Finish SRP6 and send the final result to the client
-        sha.Initialize();
-        sha.UpdateBigNumbers(&A, &M, &K, NULL);
-        sha.Finalize();
-
         ByteBuffer packet;
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
         {
             sAuthLogonProof_S proof;
-            memcpy(proof.M2, sha.GetDigest(), 20);
+            memcpy(proof.M2, result.M2, 20);
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.AccountFlags = 0x00800000;    // 0x01 = GM, 0x08 = Trial, 0x00800000 = Pro pass (arena tournament)
@@ -581,7 +615,7 @@ bool AuthSession::HandleLogonProof()
         else
         {
             sAuthLogonProof_S_Old proof;
-            memcpy(proof.M2, sha.GetDigest(), 20);
+            memcpy(proof.M2, result.M2, 20);
             proof.cmd = AUTH_LOGON_PROOF;
             proof.error = 0;
             proof.unk2 = 0x00;
@@ -653,8 +687,6 @@ bool AuthSession::HandleLogonProof()
             }
         }
     }
-
-    return true;
 }
 
 bool AuthSession::HandleReconnectChallenge()
@@ -758,6 +790,14 @@ bool AuthSession::HandleRealmList()
 {
     TC_LOG_DEBUG("server.authserver", "Entering _HandleRealmList");
 
+    // clients ask for the list every few seconds while it is open, character counts are reused for a while
+    uint32 cacheTime = sConfigMgr->GetIntDefault("RealmsCharacterCountsCacheTime", 30);
+    if (_characterCountsTime && time(nullptr) < _characterCountsTime + time_t(cacheTime))
+    {
+        SendRealmList();
+        return true;
+    }
+
     PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALM_CHARACTER_COUNTS);
     stmt->setUInt32(0, _accountInfo.Id);
 
@@ -768,18 +808,72 @@ bool AuthSession::HandleRealmList()
 
 void AuthSession::RealmListCallback(PreparedQueryResult result)
 {
-    std::map<uint32, uint8> characterCounts;
+    _characterCounts.clear();
     if (result)
     {
         do
         {
             Field* fields = result->Fetch();
-            characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+            _characterCounts[fields[0].GetUInt32()] = fields[1].GetUInt8();
         } while (result->NextRow());
     }
 
+    _characterCountsTime = time(nullptr);
+
+    SendRealmList();
+
+    _status = STATUS_AUTHED;
+}
+
+void AuthSession::SendRealmList()
+{
+    boost::asio::ip::address clientAddress = GetRemoteIpAddress();
+    auto build = std::bind(&AuthSession::BuildRealmList, this, std::placeholders::_1);
+
+    // loopback clients get their own address for local realms, and the mask can only tell apart 64 realms
+    std::shared_ptr<RealmListPacketCache::Packet const> packet;
+    RealmList::RealmMap const& realms = sRealmList->GetRealms();
+    if (!clientAddress.is_loopback() && realms.size() <= 64)
+    {
+        RealmListPacketCache::Key key;
+        key.Build = _build;
+        key.ExpVersion = _expversion;
+        key.SecurityLevel = uint8(_accountInfo.SecurityLevel);
+        key.LocalAddressMask = 0;
+
+        uint32 index = 0;
+        for (RealmList::RealmMap::value_type const& i : realms)
+        {
+            if (i.second.GetAddressForClient(clientAddress).address() != *i.second.ExternalAddress)
+                key.LocalAddressMask |= UI64LIT(1) << index;
+            ++index;
+        }
+
+        packet = sRealmListPacketCache->Get(key, build);
+    }
+    else
+    {
+        auto uncached = std::make_shared<RealmListPacketCache::Packet>();
+        build(*uncached);
+        packet = std::move(uncached);
+    }
+
+    ByteBuffer hdr(packet->Data);
+    for (std::pair<size_t, uint32> const& characterCount : packet->CharacterCounts)
+    {
+        auto itr = _characterCounts.find(characterCount.second);
+        if (itr != _characterCounts.end())
+            hdr.put<uint8>(characterCount.first, itr->second);
+    }
+
+    SendPacket(hdr);
+}
+
+void AuthSession::BuildRealmList(RealmListPacketCache::Packet& packet)
+{
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
+    std::vector<std::pair<size_t, uint32>> characterCounts;
 
     size_t RealmListSize = 0;
     for (RealmList::RealmMap::value_type const& i : sRealmList->GetRealms())
@@ -819,7 +913,8 @@ void AuthSession::RealmListCallback(PreparedQueryResult result)
         pkt << name;
         pkt << boost::lexical_cast<std::string>(realm.GetAddressForClient(GetRemoteIpAddress()));
         pkt << float(realm.PopulationLevel);
-        pkt << uint8(characterCounts[realm.Id.Realm]);
+        characterCounts.emplace_back(pkt.wpos(), realm.Id.Realm);
+        pkt << uint8(0);                                    // characters of the account, written per session
         pkt << uint8(realm.Timezone);                       // realm category
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
             pkt << uint8(realm.Id.Realm);
@@ -856,43 +951,14 @@ void AuthSession::RealmListCallback(PreparedQueryResult result)
     else
         RealmListSizeBuffer << uint32(RealmListSize);
 
-    ByteBuffer hdr;
+    ByteBuffer& hdr = packet.Data;
     hdr << uint8(REALM_LIST);
     hdr << uint16(pkt.size() + RealmListSizeBuffer.size());
     hdr.append(RealmListSizeBuffer);                        // append RealmList's size buffer
-    hdr.append(pkt);                                        // append realms in the realmlist
-    SendPacket(hdr);
-
-    _status = STATUS_AUTHED;
-}
-
-// Make the SRP6 calculation from hash in dB
-void AuthSession::SetVSFields(const std::string& rI)
-{
-    s.SetRand(int32(BufferSizes::SRP_6_S) * 8);
 
-    BigNumber I;
-    I.SetHexStr(rI.c_str());
-
-    // In case of leading zeros in the rI hash, restore them
-    uint8 mDigest[SHA_DIGEST_LENGTH];
-    memcpy(mDigest, I.AsByteArray(SHA_DIGEST_LENGTH).get(), SHA_DIGEST_LENGTH);
-
-    std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
-
-    SHA1Hash sha;
-    sha.UpdateData(s.AsByteArray(uint32(BufferSizes::SRP_6_S)).get(), (uint32(BufferSizes::SRP_6_S)));
-    sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
-    sha.Finalize();
-    BigNumber x;
-    x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
-
-    // No SQL injection (username escaped)
+    size_t const realmsOffset = hdr.wpos();
+    hdr.append(pkt);                                        // append realms in the realmlist
 
-    PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_VS);
-    stmt->setString(0, v.AsHexStr());
-    stmt->setString(1, s.AsHexStr());
-    stmt->setString(2, _accountInfo.Login);
-    LoginDatabase.Execute(stmt);
+    for (std::pair<size_t, uint32> const& characterCount : characterCounts)
+        packet.CharacterCounts.emplace_back(realmsOffset + characterCount.first, characterCount.second);
 }
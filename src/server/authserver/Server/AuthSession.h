@@ -7,6 +7,9 @@
 #include "Socket.h"
 #include "BigNumber.h"
 #include "QueryCallbackProcessor.h"
+#include "RealmListPacketCache.h"
+#include "SRP6.h"
+#include <functional>
 #include <memory>
 #include <boost/asio/ip/tcp.hpp>
 
@@ -22,6 +25,7 @@ enum AuthStatus
 	STATUS_RECONNECT_PROOF,
 	STATUS_AUTHED,
     STATUS_WAITING_FOR_REALM_LIST,
+    STATUS_WAITING_FOR_CRYPTO,                  // no packet accepted until the crypto callback sets the next status
 	STATUS_CLOSED
 };
 
@@ -69,8 +73,16 @@ private:
     void LogonChallengeCallback(PreparedQueryResult result);
     void ReconnectChallengeCallback(PreparedQueryResult result);
     void RealmListCallback(PreparedQueryResult result);
+    void SendRealmList();
+    void BuildRealmList(RealmListPacketCache::Packet& packet);
 
-    void SetVSFields(const std::string& rI);
+    void LogonChallengeCryptoCallback(SRP6::ChallengeResult& result);
+    void LogonProofCryptoCallback(SRP6::ProofResult& result, uint8 const* clientM, uint8 securityFlags, std::string const& token);
+
+    // Run compute on the login crypto pool then callback from Update. Returns false if a new logon was refused.
+    template<typename Result>
+    bool RunCrypto(std::function<Result()>&& compute, std::function<void(Result&)>&& callback, bool newLogon);
+    void ProcessCryptoResult();
 
     BigNumber N, s, g, v;
     BigNumber b, B;
@@ -86,7 +98,11 @@ private:
     uint16 _build;
     uint8 _expversion;
 
+    std::map<uint32 /*realmId*/, uint8> _characterCounts;
+    time_t _characterCountsTime;
+
     QueryCallbackProcessor _queryProcessor;
+    std::function<bool()> _pendingCrypto;  // returns true once the result was handled
 };
 
 #pragma pack(push, 1)
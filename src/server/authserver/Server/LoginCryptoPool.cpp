@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoginCryptoPool.h"
+#include "Log.h"
+
+LoginCryptoPool* LoginCryptoPool::instance()
+{
+    static LoginCryptoPool instance;
+    return &instance;
+}
+
+void LoginCryptoPool::Start(uint32 threadCount, uint32 maxQueued)
+{
+    _maxQueued = maxQueued;
+    _stopped = false;
+
+    for (uint32 i = 0; i < threadCount; ++i)
+        _threads.emplace_back(&LoginCryptoPool::WorkerThread, this);
+
+    TC_LOG_INFO("server.authserver", "Login crypto pool started with %u thread(s), admitting up to %u queued logons", threadCount, maxQueued);
+}
+
+void LoginCryptoPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stopped = true;
+    }
+    _condition.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+    _threads.clear();
+
+    // sessions are gone as well, their futures will never be read
+    _queue.clear();
+}
+
+uint32 LoginCryptoPool::Enqueue(std::function<void()>&& task, bool newLogon)
+{
+    if (_threads.empty())
+    {
+        task();
+        return 1;
+    }
+
+    size_t position;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_maxQueued && _queue.size() >= (newLogon ? _maxQueued : _maxQueued * size_t(2)))
+            return 0;
+
+        _queue.push_back(std::move(task));
+        position = _queue.size();
+
+        // logged on every doubling of the peak, enough to size LoginCrypto.MaxQueued without flooding the log
+        if (position > 64 && position >= _peakQueued * 2)
+        {
+            _peakQueued = position;
+            TC_LOG_INFO("server.authserver", "Login crypto pool: " SZFMTD " logons waiting", position);
+        }
+    }
+    _condition.notify_one();
+
+    return uint32(position);
+}
+
+void LoginCryptoPool::WorkerThread()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _condition.wait(guard, [this] { return _stopped || !_queue.empty(); });
+            if (_stopped)
+                return;
+
+            task = std::move(_queue.front());
+            _queue.pop_front();
+            if (_queue.empty())
+                _peakQueued = 0;
+        }
+
+        task();
+    }
+}
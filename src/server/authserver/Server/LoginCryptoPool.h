@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LoginCryptoPool_h__
+#define LoginCryptoPool_h__
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+    Worker threads running the SRP6 math of logons, so the network thread keeps accepting and reading sockets
+    during a reconnect wave.
+    Tasks run in arrival order. New logons (challenges) are only admitted while fewer than maxQueued tasks are
+    waiting. Proofs count against the same queue but get twice that room, so a started logon is only turned down
+    when the queue is flooded.
+    Without worker threads, tasks run right away on the calling thread.
+*/
+class LoginCryptoPool
+{
+public:
+    static LoginCryptoPool* instance();
+
+    void Start(uint32 threadCount, uint32 maxQueued);
+    void Stop();
+
+    // Returns the 1-based position of task in the queue, or 0 if it was refused because the queue is full
+    uint32 Enqueue(std::function<void()>&& task, bool newLogon);
+
+private:
+    LoginCryptoPool() : _maxQueued(0), _stopped(false), _peakQueued(0) { }
+
+    void WorkerThread();
+
+    std::vector<std::thread> _threads;
+    std::deque<std::function<void()>> _queue;
+    std::mutex _lock;
+    std::condition_variable _condition;
+    uint32 _maxQueued;
+    bool _stopped;
+    size_t _peakQueued;
+};
+
+#define sLoginCryptoPool LoginCryptoPool::instance()
+
+#endif // LoginCryptoPool_h__
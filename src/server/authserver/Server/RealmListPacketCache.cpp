@@ -0,0 +1,44 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RealmListPacketCache.h"
+#include "RealmList.h"
+
+RealmListPacketCache* RealmListPacketCache::instance()
+{
+    static RealmListPacketCache instance;
+    return &instance;
+}
+
+std::shared_ptr<RealmListPacketCache::Packet const> RealmListPacketCache::Get(Key const& key, std::function<void(Packet&)> const& build)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (_generation != sRealmList->GetGeneration())
+    {
+        _packets.clear();
+        _generation = sRealmList->GetGeneration();
+    }
+
+    std::shared_ptr<Packet const>& cached = _packets[key];
+    if (!cached)
+    {
+        auto packet = std::make_shared<Packet>();
+        build(*packet);
+        cached = std::move(packet);
+    }
+
+    return cached;
+}
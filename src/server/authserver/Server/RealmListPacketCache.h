@@ -0,0 +1,69 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RealmListPacketCache_h__
+#define RealmListPacketCache_h__
+
+#include "ByteBuffer.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+/**
+    REALM_LIST packets only depend on the client build, the account security level and which address (local or
+    external) each realm gives to the client. They are built once per combination and reused until
+    RealmList::UpdateRealms changes the realm list, only the character counts are written per account.
+*/
+class RealmListPacketCache
+{
+public:
+    struct Key
+    {
+        uint16 Build;
+        uint8 ExpVersion;
+        uint8 SecurityLevel;
+        uint64 LocalAddressMask; // bit i set if the i-th realm gives its local address to the client
+
+        bool operator<(Key const& right) const
+        {
+            return std::tie(Build, ExpVersion, SecurityLevel, LocalAddressMask) < std::tie(right.Build, right.ExpVersion, right.SecurityLevel, right.LocalAddressMask);
+        }
+    };
+
+    struct Packet
+    {
+        ByteBuffer Data;                                        // complete packet, with character counts set to 0
+        std::vector<std::pair<size_t, uint32>> CharacterCounts; // position of the character count in Data, realm id
+    };
+
+    static RealmListPacketCache* instance();
+
+    // Return the cached packet for key, or build and cache it
+    std::shared_ptr<Packet const> Get(Key const& key, std::function<void(Packet&)> const& build);
+
+private:
+    RealmListPacketCache() : _generation(0) { }
+
+    std::mutex _lock;
+    std::map<Key, std::shared_ptr<Packet const>> _packets;
+    uint32 _generation;
+};
+
+#define sRealmListPacketCache RealmListPacketCache::instance()
+
+#endif // RealmListPacketCache_h__
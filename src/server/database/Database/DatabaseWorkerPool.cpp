@@ -30,6 +30,7 @@
 #include "QueryHolder.h"
 #include "QueryResult.h"
 #include "SQLOperation.h"
+#include "SyncQueryTracker.h"
 #include "Transaction.h"
 #ifdef _WIN32 // hack for broken mysql.h not including the correct winsock header for SOCKET definition, fixed in 5.7
 #include <winsock2.h>
@@ -171,6 +172,7 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
 template <class T>
 QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= nullptr*/)
 {
+    SyncQueryTracker::Watch watch(GetDatabaseName(), sql);
     if (!connection)
         connection = GetFreeConnection();
 
@@ -188,6 +190,7 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement* stmt)
 {
+    SyncQueryTracker::Watch watch(GetDatabaseName(), stmt->GetIndex());
     auto connection = GetFreeConnection();
     PreparedResultSet* ret = connection->Query(stmt);
     connection->Unlock();
@@ -266,6 +269,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction transaction)
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction& transaction)
 {
+    SyncQueryTracker::Watch watch(GetDatabaseName(), "transaction");
     T* connection = GetFreeConnection();
     int errorCode = connection->ExecuteTransaction(transaction);
     if (!errorCode)
@@ -434,6 +438,7 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
     if (Trinity::IsFormatEmptyOrNull(sql))
         return;
 
+    SyncQueryTracker::Watch watch(GetDatabaseName(), sql);
     T* connection = GetFreeConnection();
     connection->Execute(sql);
     connection->Unlock();
@@ -442,6 +447,7 @@ void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement* stmt)
 {
+    SyncQueryTracker::Watch watch(GetDatabaseName(), stmt->GetIndex());
     T* connection = GetFreeConnection();
     connection->Execute(stmt);
     connection->Unlock();
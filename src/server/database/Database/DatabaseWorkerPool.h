@@ -211,6 +211,12 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Number of operations waiting for an async worker thread.
+        size_t QueueSize() const
+        {
+            return _queue->Size();
+        }
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -525,10 +525,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_REP_CALENDAR_INVITE,
     CHAR_DEL_CALENDAR_INVITE,
     */
-    CHAR_SEL_PET_AURA,
     CHAR_DEL_PET_AURAS,
     CHAR_INS_PET_AURA,
-    CHAR_SEL_PET_SPELL_COOLDOWN,
     CHAR_DEL_PET_SPELL_COOLDOWNS,
     CHAR_INS_PET_SPELL_COOLDOWN,
     /*
@@ -542,11 +540,11 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_CHAR_PET_DECLINEDNAME_BY_OWNER,
     CHAR_SEL_CHAR_PET_BY_ENTRY_AND_SLOT,
     */
-    CHAR_SEL_PET_SLOTS,
-    CHAR_SEL_PET_SLOTS_DETAIL,
-    CHAR_SEL_PET_ENTRY,
-    CHAR_SEL_PET_SLOT_BY_ID,
-    CHAR_SEL_PET_CURRENT,
+    CHAR_SEL_OWNER_PETS,
+    CHAR_SEL_OWNER_PET_SPELLS,
+    CHAR_SEL_OWNER_PET_SPELL_COOLDOWNS,
+    CHAR_SEL_OWNER_PET_AURAS,
+    CHAR_SEL_OWNER_PET_DECLINED_NAMES,
     /*
     CHAR_SEL_PET_SPELL_LIST,
     CHAR_SEL_CHAR_PET,
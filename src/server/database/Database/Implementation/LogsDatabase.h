@@ -16,25 +16,15 @@ enum LogsDatabaseStatements
     LOGS_INS_BOSS_DOWN,
     LOGS_INS_BG_STATS,
     LOGS_INS_CHAR_DELETE,
-    LOGS_INS_CHAR_CHAT,
     LOGS_INS_CHAR_GUILD_MONEY,
     LOGS_INS_CHAR_ITEM_DELETE,
     LOGS_INS_CHAR_ITEM_GUILD_BANK,
-    LOGS_INS_MAIL,
-    LOGS_INS_MAIL_ITEMS,
     LOGS_INS_CHAR_RENAME,
     LOGS_SEL_CHAR_TRADE_MAX_ID,
-    LOGS_INS_CHAR_TRADE,
-    LOGS_INS_CHAR_TRADE_ITEMS,
-    LOGS_INS_GM_COMMAND,
     LOGS_SEL_SANCTION_MUTE_ACCOUNT,
     LOGS_INS_SANCTION,
     LOGS_INS_SANCTION_REMOVE,
     LOGS_INS_CHAR_ENCHANT,
-    LOGS_INS_CHAR_AUCTION_WON,
-    LOGS_INS_CHAR_AUCTION_CREATE,
-    LOGS_INS_CHAR_ITEM_VENDOR, //TODO: buy
-    LOGS_INS_ACCOUNT_IP,
 
     LOGS_INS_ANTICHEAT_MOVEMENT,
 
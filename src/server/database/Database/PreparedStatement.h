@@ -83,6 +83,8 @@ class TC_DATABASE_API PreparedStatement
         PreparedStatement(uint32 index, uint8 capacity);
         ~PreparedStatement();
 
+        uint32 GetIndex() const { return m_index; }
+
         void setNull(const uint8 index);
         void setBool(const uint8 index, const bool value);
         void setUInt8(const uint8 index, const uint8 value);
@@ -20,6 +20,7 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "QuerySnapshot.h"
 #ifdef _WIN32 // hack for broken mysql.h not including the correct winsock header for SOCKET definition, fixed in 5.7
 #include <winsock2.h>
 #endif
@@ -123,7 +124,9 @@ ResultSet::ResultSet(MYSQL_RES *result, MYSQL_FIELD *fields, uint64 rowCount, ui
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotCursor(nullptr),
+_snapshotRowsLeft(0)
 {
     _currentRow = new Field[_fieldCount];
 #ifdef TRINITY_DEBUG
@@ -132,6 +135,19 @@ _fields(fields)
 #endif
 }
 
+ResultSet::ResultSet(std::shared_ptr<void const> storage, char const* rows, std::vector<DatabaseFieldTypes> fieldTypes, uint64 rowCount) :
+_rowCount(rowCount),
+_fieldCount(uint32(fieldTypes.size())),
+_result(nullptr),
+_fields(nullptr),
+_snapshotStorage(std::move(storage)),
+_snapshotCursor(rows),
+_snapshotRowsLeft(rowCount),
+_snapshotFieldTypes(std::move(fieldTypes))
+{
+    _currentRow = new Field[_fieldCount];
+}
+
 PreparedResultSet::PreparedResultSet(MYSQL_STMT* stmt, MYSQL_RES *result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -279,6 +295,9 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshotStorage)
+        return NextSnapshotRow();
+
     if (!_result)
         return false;
 
@@ -303,6 +322,34 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextSnapshotRow()
+{
+    if (!_snapshotRowsLeft)
+    {
+        CleanUp();
+        return false;
+    }
+
+    --_snapshotRowsLeft;
+    // rows were validated when the snapshot was opened, see QuerySnapshot::Load
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length;
+        memcpy(&length, _snapshotCursor, sizeof(length));
+        _snapshotCursor += sizeof(length);
+        if (length == QuerySnapshot::NULL_FIELD_LENGTH)
+        {
+            _currentRow[i].SetStructuredValue(nullptr, _snapshotFieldTypes[i], 0);
+            continue;
+        }
+
+        _currentRow[i].SetStructuredValue(const_cast<char*>(_snapshotCursor), _snapshotFieldTypes[i], length);
+        _snapshotCursor += length + 1;
+    }
+
+    return true;
+}
+
 bool PreparedResultSet::NextRow()
 {
     /// Only updates the m_rowPosition so upper level code knows in which element
@@ -337,6 +384,9 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    _snapshotStorage.reset();
+    _snapshotCursor = nullptr;
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -21,12 +21,17 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
+enum class DatabaseFieldTypes : uint8;
+
 class TC_DATABASE_API ResultSet
 {
     public:
         ResultSet(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // Rows read from a query snapshot (see QuerySnapshot.h), storage keeps rows memory alive
+        ResultSet(std::shared_ptr<void const> storage, char const* rows, std::vector<DatabaseFieldTypes> fieldTypes, uint64 rowCount);
         ~ResultSet();
 
         bool NextRow();
@@ -43,9 +48,15 @@ class TC_DATABASE_API ResultSet
 
     private:
         void CleanUp();
+        bool NextSnapshotRow();
         MYSQL_RES* _result;
         MYSQL_FIELD* _fields;
 
+        std::shared_ptr<void const> _snapshotStorage;
+        char const* _snapshotCursor;
+        uint64 _snapshotRowsLeft;
+        std::vector<DatabaseFieldTypes> _snapshotFieldTypes;
+
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
 };
@@ -0,0 +1,213 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QuerySnapshot.h"
+#include "Field.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    // bump when the file layout or the row encoding changes
+    uint32 const SNAPSHOT_VERSION = 1;
+    char const SNAPSHOT_MAGIC[4] = { 'T', 'C', 'Q', 'S' };
+
+    // file layout: header, query text, field types (one byte each), rows
+    // row encoding: for each field an uint32 length (or NULL_FIELD_LENGTH) followed by length bytes and a null terminator
+    #pragma pack(push, 1)
+    struct SnapshotHeader
+    {
+        char Magic[4];
+        uint32 Version;
+        uint64 SourceChecksum;
+        uint64 RowCount;
+        uint64 RowsSize;
+        uint32 FieldCount;
+        uint32 SqlLength;
+    };
+    #pragma pack(pop)
+
+    // Check every field of every row stays within [rows, rowsEnd) and is null terminated, so NextRow does not need to
+    bool ValidateRows(char const* rows, char const* rowsEnd, uint64 rowCount, uint32 fieldCount)
+    {
+        char const* cursor = rows;
+        for (uint64 row = 0; row < rowCount; ++row)
+        {
+            for (uint32 field = 0; field < fieldCount; ++field)
+            {
+                uint32 length;
+                if (size_t(rowsEnd - cursor) < sizeof(length))
+                    return false;
+
+                memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                if (length == QuerySnapshot::NULL_FIELD_LENGTH)
+                    continue;
+
+                if (size_t(rowsEnd - cursor) <= length || cursor[length] != '\0')
+                    return false;
+
+                cursor += length + 1;
+            }
+        }
+
+        return cursor == rowsEnd;
+    }
+
+    template<typename T>
+    void Append(std::vector<char>& buffer, T const& value)
+    {
+        char const* bytes = reinterpret_cast<char const*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+QueryResult QuerySnapshot::Load(std::string const& fileName, std::string const& sql, uint64 sourceChecksum)
+{
+    boost::system::error_code error;
+    if (!boost::filesystem::exists(fileName, error))
+        return QueryResult(nullptr);
+
+    auto file = std::make_shared<boost::iostreams::mapped_file_source>();
+    try
+    {
+        file->open(fileName);
+    }
+    catch (std::exception const& e)
+    {
+        TC_LOG_ERROR("sql.sql", "QuerySnapshot: could not map %s: %s", fileName.c_str(), e.what());
+        return QueryResult(nullptr);
+    }
+
+    char const* data = file->data();
+    char const* end = data + file->size();
+
+    SnapshotHeader header;
+    if (file->size() < sizeof(header))
+        return QueryResult(nullptr);
+
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic)) || header.Version != SNAPSHOT_VERSION)
+        return QueryResult(nullptr);
+
+    if (header.SourceChecksum != sourceChecksum || !header.RowCount || !header.FieldCount)
+        return QueryResult(nullptr);
+
+    char const* cursor = data + sizeof(header);
+    if (uint64(end - cursor) != uint64(header.SqlLength) + header.FieldCount + header.RowsSize)
+        return QueryResult(nullptr);
+
+    if (sql.size() != header.SqlLength || memcmp(cursor, sql.data(), header.SqlLength))
+        return QueryResult(nullptr);
+
+    cursor += header.SqlLength;
+
+    std::vector<DatabaseFieldTypes> fieldTypes(header.FieldCount);
+    for (uint32 i = 0; i < header.FieldCount; ++i)
+        fieldTypes[i] = DatabaseFieldTypes(uint8(*cursor++));
+
+    if (!ValidateRows(cursor, end, header.RowCount, header.FieldCount))
+    {
+        TC_LOG_ERROR("sql.sql", "QuerySnapshot: %s is corrupted, ignored.", fileName.c_str());
+        return QueryResult(nullptr);
+    }
+
+    QueryResult result = std::make_shared<ResultSet>(std::move(file), cursor, std::move(fieldTypes), header.RowCount);
+    if (!result->NextRow())
+        return QueryResult(nullptr);
+
+    return result;
+}
+
+QueryResult QuerySnapshot::Store(std::string const& fileName, std::string const& sql, uint64 sourceChecksum, QueryResult result)
+{
+    if (!result)
+        return result;
+
+    uint32 const fieldCount = result->GetFieldCount();
+    auto buffer = std::make_shared<std::vector<char>>();
+    buffer->reserve(sizeof(SnapshotHeader) + sql.size() + fieldCount + size_t(result->GetRowCount()) * fieldCount * 8);
+    buffer->resize(sizeof(SnapshotHeader));
+    buffer->insert(buffer->end(), sql.begin(), sql.end());
+
+    Field* fields = result->Fetch();
+    for (uint32 i = 0; i < fieldCount; ++i)
+        buffer->push_back(char(fields[i].data.type));
+
+    size_t const rowsOffset = buffer->size();
+    uint64 rowCount = 0;
+    do
+    {
+        fields = result->Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            if (fields[i].IsNull())
+            {
+                Append(*buffer, NULL_FIELD_LENGTH);
+                continue;
+            }
+
+            uint32 const length = fields[i].data.length;
+            char const* value = static_cast<char const*>(fields[i].data.value);
+            Append(*buffer, length);
+            buffer->insert(buffer->end(), value, value + length);
+            buffer->push_back('\0');
+        }
+        ++rowCount;
+    } while (result->NextRow());
+
+    result.reset();
+
+    SnapshotHeader header;
+    memcpy(header.Magic, SNAPSHOT_MAGIC, sizeof(header.Magic));
+    header.Version = SNAPSHOT_VERSION;
+    header.SourceChecksum = sourceChecksum;
+    header.RowCount = rowCount;
+    header.RowsSize = buffer->size() - rowsOffset;
+    header.FieldCount = fieldCount;
+    header.SqlLength = uint32(sql.size());
+    memcpy(buffer->data(), &header, sizeof(header));
+
+    // write aside then rename, a crash while writing must not leave a truncated snapshot behind
+    std::string const tempFileName = fileName + ".tmp";
+    {
+        std::ofstream out(tempFileName, std::ios::binary | std::ios::trunc);
+        out.write(buffer->data(), buffer->size());
+        if (!out)
+            TC_LOG_ERROR("sql.sql", "QuerySnapshot: could not write %s", tempFileName.c_str());
+    }
+
+    boost::system::error_code error;
+    boost::filesystem::rename(tempFileName, fileName, error);
+    if (error)
+    {
+        TC_LOG_ERROR("sql.sql", "QuerySnapshot: could not rename %s to %s: %s", tempFileName.c_str(), fileName.c_str(), error.message().c_str());
+        boost::filesystem::remove(tempFileName, error);
+    }
+
+    std::vector<DatabaseFieldTypes> fieldTypes(fieldCount);
+    for (uint32 i = 0; i < fieldCount; ++i)
+        fieldTypes[i] = DatabaseFieldTypes(uint8((*buffer)[sizeof(SnapshotHeader) + sql.size() + i]));
+
+    char const* rows = buffer->data() + rowsOffset;
+    QueryResult snapshotResult = std::make_shared<ResultSet>(std::move(buffer), rows, std::move(fieldTypes), rowCount);
+    snapshotResult->NextRow();
+    return snapshotResult;
+}
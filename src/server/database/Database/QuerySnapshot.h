@@ -0,0 +1,44 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _QUERYSNAPSHOT_H
+#define _QUERYSNAPSHOT_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <string>
+
+/**
+    Ad hoc query results saved to disk, so a large static table can be read back in bulk instead of being transferred
+    and parsed again from the MySQL server.
+
+    A snapshot file holds the query text, a checksum of its source tables (computed by the caller, for example with
+    CHECKSUM TABLE) and the rows in text protocol format. It is memory mapped on load and only used if the format
+    version, the query and the source checksum all match, callers then fall back to the database.
+    Rows read from a snapshot behave exactly like a ResultSet fetched with ad hoc queries.
+*/
+class TC_DATABASE_API QuerySnapshot
+{
+    public:
+        static constexpr uint32 NULL_FIELD_LENGTH = 0xFFFFFFFF;
+
+        // Open fileName and return its rows positioned on the first one (as DatabaseWorkerPool::Query does), or nullptr if the file is missing, stale or corrupted
+        static QueryResult Load(std::string const& fileName, std::string const& sql, uint64 sourceChecksum);
+
+        // Write all remaining rows of result to fileName then return them again from the written data. result must be positioned on its first row.
+        static QueryResult Store(std::string const& fileName, std::string const& sql, uint64 sourceChecksum, QueryResult result);
+};
+
+#endif
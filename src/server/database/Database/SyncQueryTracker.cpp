@@ -0,0 +1,177 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyncQueryTracker.h"
+#include "Errors.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+#include <execinfo.h>
+#endif
+
+#if COMPILER == TRINITY_COMPILER_GNU
+#define SYNC_QUERY_NOINLINE __attribute__((noinline))
+#else
+#define SYNC_QUERY_NOINLINE
+#endif
+
+namespace
+{
+    // Record, Watch::~Watch and the DatabaseWorkerPool method come first in the stack
+    int const SKIPPED_FRAMES = 3;
+    int const SITE_FRAMES = 5;
+    size_t const SAMPLE_LENGTH = 200;
+
+    std::atomic<uint8> Mode(SYNC_QUERY_TRACKER_DISABLED);
+    std::atomic<uint32> TickBudgetUs(0);
+
+    std::mutex SitesLock;
+    std::unordered_map<size_t, SyncQueryTracker::Site> Sites;
+
+    thread_local SyncQueryThread CurrentThread = SYNC_QUERY_THREAD_NONE;
+    thread_local uint64 TickUs = 0;
+    thread_local bool TickReported = false;
+
+    SYNC_QUERY_NOINLINE void Record(char const* database, char const* sql, uint32 statementIndex, uint64 us)
+    {
+        void* frames[SKIPPED_FRAMES + SITE_FRAMES];
+        int frameCount = 0;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+        frameCount = std::max(0, backtrace(frames, SKIPPED_FRAMES + SITE_FRAMES) - SKIPPED_FRAMES);
+#endif
+
+        size_t key = std::hash<uint32>()(CurrentThread) ^ (std::hash<std::string>()(database) << 1);
+        if (frameCount)
+        {
+            for (int i = 0; i < frameCount; ++i)
+                key = key * 31 + std::hash<void*>()(frames[SKIPPED_FRAMES + i]);
+        }
+        else
+            key = key * 31 + (sql ? std::hash<std::string>()(sql) : std::hash<uint32>()(statementIndex));
+
+        {
+            std::lock_guard<std::mutex> lock(SitesLock);
+            auto itr = Sites.find(key);
+            if (itr == Sites.end())
+            {
+                itr = Sites.emplace(key, SyncQueryTracker::Site()).first;
+                SyncQueryTracker::Site& site = itr->second;
+                site.Thread = CurrentThread;
+                site.Database = database;
+                site.Sample = sql ? std::string(sql, strnlen(sql, SAMPLE_LENGTH)) : Trinity::StringFormat("prepared statement %u", statementIndex);
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+                if (char** symbols = backtrace_symbols(frames + SKIPPED_FRAMES, frameCount))
+                {
+                    site.Stack.assign(symbols, symbols + frameCount);
+                    free(symbols);
+                }
+#endif
+            }
+
+            ++itr->second.Count;
+            itr->second.TotalUs += us;
+            itr->second.MaxUs = std::max(itr->second.MaxUs, us);
+        }
+
+        TickUs += us;
+        uint32 const budget = TickBudgetUs.load(std::memory_order_relaxed);
+        if (!budget || TickUs <= budget || TickReported)
+            return;
+
+        TickReported = true;
+        std::string const last = sql ? std::string(sql, strnlen(sql, SAMPLE_LENGTH)) : Trinity::StringFormat("prepared statement %u", statementIndex);
+        TC_LOG_WARN("sql.sync", "%s thread spent " UI64FMTD " ms in synchronous queries this tick (budget %u ms), last one took " UI64FMTD " us on %s: %s",
+            SyncQueryTracker::GetThreadName(CurrentThread), TickUs / 1000, budget / 1000, us, database, last.c_str());
+
+        if (Mode.load(std::memory_order_relaxed) == SYNC_QUERY_TRACKER_ASSERT)
+            ASSERT(false, "Synchronous query budget exceeded on %s thread, see sql.sync log", SyncQueryTracker::GetThreadName(CurrentThread));
+    }
+}
+
+SyncQueryTracker::Watch::Watch(char const* database, char const* sql)
+    : _database(database), _sql(sql), _statementIndex(0),
+    _active(CurrentThread != SYNC_QUERY_THREAD_NONE && Mode.load(std::memory_order_relaxed) != SYNC_QUERY_TRACKER_DISABLED)
+{
+    if (_active)
+        _start = std::chrono::steady_clock::now();
+}
+
+SyncQueryTracker::Watch::Watch(char const* database, uint32 statementIndex)
+    : _database(database), _sql(nullptr), _statementIndex(statementIndex),
+    _active(CurrentThread != SYNC_QUERY_THREAD_NONE && Mode.load(std::memory_order_relaxed) != SYNC_QUERY_TRACKER_DISABLED)
+{
+    if (_active)
+        _start = std::chrono::steady_clock::now();
+}
+
+SyncQueryTracker::Watch::~Watch()
+{
+    if (!_active)
+        return;
+
+    uint64 us = uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+    Record(_database, _sql, _statementIndex, us);
+}
+
+void SyncQueryTracker::Configure(SyncQueryTrackerMode mode, uint32 tickBudgetMs)
+{
+    Mode = mode;
+    TickBudgetUs = tickBudgetMs * 1000;
+}
+
+void SyncQueryTracker::BeginTick(SyncQueryThread thread)
+{
+    CurrentThread = thread;
+    TickUs = 0;
+    TickReported = false;
+}
+
+std::vector<SyncQueryTracker::Site> SyncQueryTracker::GetReport()
+{
+    std::vector<Site> report;
+    {
+        std::lock_guard<std::mutex> lock(SitesLock);
+        report.reserve(Sites.size());
+        for (auto const& itr : Sites)
+            report.push_back(itr.second);
+    }
+
+    std::sort(report.begin(), report.end(), [](Site const& left, Site const& right) { return left.TotalUs > right.TotalUs; });
+    return report;
+}
+
+void SyncQueryTracker::Reset()
+{
+    std::lock_guard<std::mutex> lock(SitesLock);
+    Sites.clear();
+}
+
+char const* SyncQueryTracker::GetThreadName(SyncQueryThread thread)
+{
+    switch (thread)
+    {
+        case SYNC_QUERY_THREAD_WORLD: return "world";
+        case SYNC_QUERY_THREAD_MAP:   return "map";
+        default:                      return "untracked";
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SYNCQUERYTRACKER_H
+#define _SYNCQUERYTRACKER_H
+
+#include "Define.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Threads whose synchronous queries are tracked, tagged by SyncQueryTracker::BeginTick
+enum SyncQueryThread : uint8
+{
+    SYNC_QUERY_THREAD_NONE  = 0, // not tracked: startup loaders, cli, database workers...
+    SYNC_QUERY_THREAD_WORLD = 1,
+    SYNC_QUERY_THREAD_MAP   = 2,
+
+    SYNC_QUERY_THREAD_MAX
+};
+
+enum SyncQueryTrackerMode : uint8
+{
+    SYNC_QUERY_TRACKER_DISABLED = 0,
+    SYNC_QUERY_TRACKER_LOG      = 1, // record queries, log once per tick when a thread goes over budget
+    SYNC_QUERY_TRACKER_ASSERT   = 2, // record queries, assert when a thread goes over budget
+};
+
+/**
+    Records the synchronous queries (Query, PQuery, DirectExecute, DirectCommitTransaction) issued from world and map threads.
+    Queries are aggregated per thread type and calling site (a few frames of the caller stack, or the query text where
+    backtraces are not available), with their count and latency. Each tagged thread also gets a time budget per tick.
+    Only costs a thread local read per query while disabled or on untagged threads.
+*/
+class TC_DATABASE_API SyncQueryTracker
+{
+    public:
+        struct Site
+        {
+            SyncQueryThread Thread;
+            std::string Database;
+            std::string Sample; // first query seen at this site
+            std::vector<std::string> Stack;
+            uint64 Count;
+            uint64 TotalUs;
+            uint64 MaxUs;
+        };
+
+        // Time one synchronous query of the calling thread, from construction to destruction
+        class Watch
+        {
+            public:
+                Watch(char const* database, char const* sql);
+                Watch(char const* database, uint32 statementIndex);
+                ~Watch();
+
+            private:
+                char const* _database;
+                char const* _sql; // nullptr for prepared statements
+                uint32 _statementIndex;
+                bool _active;
+                std::chrono::steady_clock::time_point _start;
+        };
+
+        static void Configure(SyncQueryTrackerMode mode, uint32 tickBudgetMs);
+        // Tag the calling thread and start a new tick for its budget
+        static void BeginTick(SyncQueryThread thread);
+
+        // All sites recorded since the last reset, most total time first
+        static std::vector<Site> GetReport();
+        static void Reset();
+
+        static char const* GetThreadName(SyncQueryThread thread);
+};
+
+#endif
@@ -16,6 +16,7 @@ class TC_GAME_API AggressorAI : public CreatureAI
         explicit AggressorAI(Creature* c) : CreatureAI(c) {}
 
         void UpdateAI(const uint32);
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_DEFAULT; }
         static int Permissible(const Creature*);
 };
 
@@ -89,6 +90,7 @@ struct VehicleAI : public CreatureAI
 
         void UpdateAI(const uint32 diff);
         void MoveInLineOfSight(Unit*) {}
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_IGNORED; }
         void AttackStart(Unit*) {}
         void OnCharmed(bool apply);
 
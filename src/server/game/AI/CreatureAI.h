@@ -84,6 +84,17 @@ class TC_GAME_API CreatureAI : public UnitAI
 		// Called if IsVisible(Unit* who) is true at each who move, reaction at visibility zone enter
 		void MoveInLineOfSight_Safe(Unit* who);
 
+        enum MoveInLineOfSightMode
+        {
+            MOVE_IN_LOS_SCRIPTED, // MoveInLineOfSight may react to any unit
+            MOVE_IN_LOS_DEFAULT,  // CreatureAI::MoveInLineOfSight (and script hooks that do not care about the unit), never reacts to friendly units
+            MOVE_IN_LOS_IGNORED,  // MoveInLineOfSight does nothing
+        };
+
+        /* What MoveInLineOfSight does, used by relocation notifiers to skip creature/unit pairs that cannot trigger anything, see Creature::GetAggroFlags.
+        AIs overriding MoveInLineOfSight must override this as well if they want to be culled, the default is conservative. */
+        virtual MoveInLineOfSightMode GetMoveInLineOfSightMode() const { return MOVE_IN_LOS_SCRIPTED; }
+
         // Called for reaction at stopping attack at no attackers or targets
         virtual void EnterEvadeMode(EvadeReason why = EVADE_REASON_OTHER);
 
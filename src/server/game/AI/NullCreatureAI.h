@@ -11,6 +11,7 @@ class TC_GAME_API PassiveAI : public CreatureAI
         ~PassiveAI() override {}
 
         void MoveInLineOfSight(Unit *) override {}
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_IGNORED; }
         void AttackStart(Unit *) override {}
 
         void UpdateAI(const uint32) override;
@@ -36,6 +36,7 @@ class TC_GAME_API PetAI : public CreatureAI
 
         void MoveInLineOfSight(Unit* /*who*/) override { } // CreatureAI interferes with returning pets
         void MoveInLineOfSight_Safe(Unit* /*who*/) { } // CreatureAI interferes with returning pets
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_IGNORED; }
 
     private:
         bool _needToStop(void) const;
@@ -14,6 +14,7 @@ class TC_GAME_API ReactorAI : public CreatureAI
         explicit ReactorAI(Creature* c) : CreatureAI(c) {}
 
         void MoveInLineOfSight(Unit*) override  {}
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_IGNORED; }
         void UpdateAI(const uint32 diff) override;
 
         static int Permissible(const Creature*);
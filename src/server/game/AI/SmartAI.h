@@ -87,6 +87,8 @@ class TC_GAME_API SmartAI : public CreatureAI
 
         // Called at each *who move, reaction at visibility zone enter
         void MoveInLineOfSight(Unit* who) override;
+        // Default unless the script has line of sight events
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return mScript.HasLineOfSightEvents() ? MOVE_IN_LOS_SCRIPTED : MOVE_IN_LOS_DEFAULT; }
 
         // Called when hit by a spell
         void SpellHit(Unit* unit, const SpellInfo*) override;
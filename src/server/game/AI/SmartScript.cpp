@@ -3998,6 +3998,10 @@ void SmartScript::InstallEvents()
             mEvents.push_back(mInstallEvent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+
+        // installed events may react to line of sight
+        if (me)
+            me->InvalidateAggroFlags();
     }
 }
 
@@ -4206,6 +4210,19 @@ void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
     ProcessEventsFor(SMART_EVENT_AI_INIT);
     InstallEvents();
     ProcessEventsFor(SMART_EVENT_JUST_CREATED);
+
+    if (me)
+        me->InvalidateAggroFlags();
+}
+
+bool SmartScript::HasLineOfSightEvents() const
+{
+    for (SmartAIEventList const* list : { &mEvents, &mInstallEvents })
+        for (SmartScriptHolder const& e : *list)
+            if (e.GetEventType() == SMART_EVENT_OOC_LOS || e.GetEventType() == SMART_EVENT_IC_LOS)
+                return true;
+
+    return false;
 }
 
 void SmartScript::OnMoveInLineOfSight(Unit* who)
@@ -91,6 +91,8 @@ class TC_GAME_API SmartScript
 
         void OnUpdate(const uint32 diff);
         void OnMoveInLineOfSight(Unit* who);
+        // true if an installed or pending event reacts to units in line of sight
+        bool HasLineOfSightEvents() const;
 
         Unit* DoSelectLowestHpFriendly(float range, uint32 MinHPDiff);
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
@@ -14,6 +14,7 @@
 #include "CreatureTextMgr.h"
 #include "SmartScriptMgr.h"
 #include "WaypointDefines.h"
+#include "WorldSnapshot.h"
 
 WaypointPath const* SmartWaypointMgr::GetPath(uint32 id)
 {
@@ -93,14 +94,14 @@ void SmartAIMgr::LoadSmartAIFromDB()
     for (auto & i : mEventMap)
         i.clear();  //Drop Existing SmartAI List
 
-    QueryResult result = WorldDatabase.Query("SELECT entryorguid, source_type, id, link, event_type, \
+    QueryResult result = WorldSnapshot::Query("smart_scripts", "SELECT entryorguid, source_type, id, link, event_type, \
                                              event_phase_mask, event_chance, event_flags, event_param1, \
                                              event_param2, event_param3, event_param4, event_param5, action_type, \
                                              action_param1, action_param2, action_param3, action_param4, \
                                              action_param5, action_param6, target_type, target_flags, \
                                              target_param1, target_param2, target_param3, target_x, \
                                              target_y, target_z, target_o FROM smart_scripts \
-                                             ORDER BY entryorguid, source_type, id, link");
+                                             ORDER BY entryorguid, source_type, id, link", { "smart_scripts" });
 
     if (!result)
     {
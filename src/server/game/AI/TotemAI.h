@@ -15,6 +15,7 @@ class TC_GAME_API TotemAI : public CreatureAI
         ~TotemAI() override;
 
         void MoveInLineOfSight(Unit *) override;
+        MoveInLineOfSightMode GetMoveInLineOfSightMode() const override { return MOVE_IN_LOS_IGNORED; }
         void AttackStart(Unit *) override;
         void EnterEvadeMode(EvadeReason /* why */) override;
 
@@ -6,12 +6,478 @@
 #include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace
 {
-    std::unordered_map<uint64, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    /* Epoch based reclamation. Readers announce the epoch they started reading in, the writer bumps the epoch each time it
+       retires something and only reuses what was retired before the oldest epoch still announced. */
+    std::atomic<uint64> _epoch(1);
+
+    struct ReaderSlot
+    {
+        std::atomic<uint64> epoch{ 0 };                         // 0 when not reading
+        std::atomic<bool> used{ false };
+        ReaderSlot* next = nullptr;
+    };
+
+    // Slots are never freed, slots of exited threads are reused by new ones
+    std::atomic<ReaderSlot*> _readers(nullptr);
+
+    struct ThreadReader
+    {
+        ReaderSlot* slot = nullptr;
+        uint32 depth = 0;
+
+        ~ThreadReader()
+        {
+            if (slot)
+                slot->used.store(false, std::memory_order_release);
+        }
+
+        ReaderSlot* GetSlot()
+        {
+            if (slot)
+                return slot;
+
+            for (ReaderSlot* free = _readers.load(std::memory_order_acquire); free; free = free->next)
+            {
+                bool used = false;
+                if (!free->used.load(std::memory_order_relaxed) && free->used.compare_exchange_strong(used, true, std::memory_order_acquire))
+                    return slot = free;
+            }
+
+            ReaderSlot* added = new ReaderSlot();
+            added->used.store(true, std::memory_order_relaxed);
+            added->next = _readers.load(std::memory_order_relaxed);
+            while (!_readers.compare_exchange_weak(added->next, added, std::memory_order_release, std::memory_order_relaxed));
+            return slot = added;
+        }
+    };
+
+    thread_local ThreadReader _threadReader;
+
+    void BeginRead()
+    {
+        if (_threadReader.depth++)
+            return;
+
+        _threadReader.GetSlot()->epoch.store(_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        // the writer either sees this epoch or the reader sees everything retired before it as unpublished
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void EndRead()
+    {
+        if (!--_threadReader.depth)
+            _threadReader.slot->epoch.store(0, std::memory_order_release);
+    }
+
+    struct ReadSection
+    {
+        ReadSection() { BeginRead(); }
+        ~ReadSection() { EndRead(); }
+    };
+
+    // Writer only. Objects retired before the returned epoch can't be seen by any reader anymore.
+    uint64 GetOldestReadEpoch()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64 oldest = _epoch.load(std::memory_order_seq_cst);
+        for (ReaderSlot* reader = _readers.load(std::memory_order_acquire); reader; reader = reader->next)
+        {
+            uint64 epoch = reader->epoch.load(std::memory_order_seq_cst);
+            if (epoch && epoch < oldest)
+                oldest = epoch;
+        }
+        return oldest;
+    }
+
+    // Writer only. Holds unpublished objects until no reader can see them, then hands them to reuse.
+    template<class T>
+    class RetiredList
+    {
+    public:
+        void Retire(T* object) { _retired.push_back({ _epoch.fetch_add(1, std::memory_order_seq_cst), object }); }
+
+        template<class Reuse>
+        void Reclaim(Reuse const& reuse)
+        {
+            if (_retired.empty())
+                return;
+
+            uint64 const oldest = GetOldestReadEpoch();
+            while (!_retired.empty() && _retired.front().first < oldest)
+            {
+                reuse(_retired.front().second);
+                _retired.pop_front();
+            }
+        }
+
+    private:
+        std::deque<std::pair<uint64 /*epoch*/, T*>> _retired;
+    };
+
+    // Names are packed back to back (null terminated) in big blocks that are never freed or moved.
+    // Replaced names are reused for names of the same size or a few bytes smaller.
+    class NameArena
+    {
+    public:
+        char const* Intern(std::string const& name)
+        {
+            size_t const size = name.size() + 1;
+            _retired.Reclaim([this](char* str) { _free[strlen(str) + 1].push_back(str); });
+            for (size_t freeSize = size; freeSize < _free.size() && freeSize < size + REUSE_SLACK; ++freeSize)
+            {
+                if (_free[freeSize].empty())
+                    continue;
+
+                char* str = _free[freeSize].back();
+                _free[freeSize].pop_back();
+                memcpy(str, name.c_str(), size);
+                return str;
+            }
+
+            if (_blocks.empty() || _used + size > _blockSize)
+            {
+                _blockSize = std::max(BLOCK_SIZE, size);
+                _blocks.emplace_back(new char[_blockSize]);
+                _used = 0;
+                _allocated += _blockSize;
+            }
+
+            char* str = _blocks.back().get() + _used;
+            memcpy(str, name.c_str(), size);
+            _used += size;
+            return str;
+        }
+
+        void Retire(char const* name) { _retired.Retire(const_cast<char*>(name)); }
+
+        size_t GetAllocatedSize() const { return _allocated; }
+
+    private:
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+        static constexpr size_t REUSE_SLACK = 4;
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        RetiredList<char> _retired;
+        std::array<std::vector<char*>, 64> _free;               // by size, names are at most MAX_PLAYER_NAME utf8 characters
+        size_t _blockSize = 0;
+        size_t _used = 0;
+        size_t _allocated = 0;
+    };
+
+    // Fixed size records allocated contiguously. Old versions of updated records are kept until no reader holds them.
+    class RecordArena
+    {
+    public:
+        // Make sure the next count allocations are contiguous
+        void Reserve(size_t count)
+        {
+            if (_blocks.empty() || _used + count > _blockSize)
+                NewBlock(std::max(BLOCK_SIZE, count));
+        }
+
+        CharacterCacheEntry* Allocate()
+        {
+            _retired.Reclaim([this](CharacterCacheEntry* entry) { _free.push_back(entry); });
+            if (!_free.empty())
+            {
+                CharacterCacheEntry* entry = _free.back();
+                _free.pop_back();
+                return entry;
+            }
+
+            Reserve(1);
+            return &_blocks.back()[_used++];
+        }
+
+        void Retire(CharacterCacheEntry const* entry) { _retired.Retire(const_cast<CharacterCacheEntry*>(entry)); }
+
+        size_t GetAllocatedSize() const { return _allocated * sizeof(CharacterCacheEntry); }
+
+    private:
+        void NewBlock(size_t size)
+        {
+            _blocks.emplace_back(new CharacterCacheEntry[size]);
+            _blockSize = size;
+            _used = 0;
+            _allocated += size;
+        }
+
+        static constexpr size_t BLOCK_SIZE = 4096;
+
+        std::vector<std::unique_ptr<CharacterCacheEntry[]>> _blocks;
+        RetiredList<CharacterCacheEntry> _retired;
+        std::vector<CharacterCacheEntry*> _free;
+        size_t _blockSize = 0;
+        size_t _used = 0;
+        size_t _allocated = 0;
+    };
+
+    // Low guid -> current record version. Two levels so that growing never moves anything a reader could be looking at.
+    class GuidIndex
+    {
+    public:
+        GuidIndex()
+        {
+            for (auto& page : _pages)
+                page.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~GuidIndex()
+        {
+            for (auto& page : _pages)
+                delete[] page.load(std::memory_order_relaxed);
+        }
+
+        CharacterCacheEntry const* Find(ObjectGuid::LowType guid) const
+        {
+            if (!CanStore(guid))
+                return nullptr;
+
+            Slot const* page = _pages[guid >> PAGE_BITS].load(std::memory_order_acquire);
+            if (!page)
+                return nullptr;
+
+            return page[guid & PAGE_MASK].load(std::memory_order_acquire);
+        }
+
+        static bool CanStore(ObjectGuid::LowType guid) { return (guid >> PAGE_BITS) < MAX_PAGES; }
+
+        // Writer only, guid must be storable
+        void Publish(ObjectGuid::LowType guid, CharacterCacheEntry const* entry)
+        {
+            ASSERT(CanStore(guid));
+
+            std::atomic<Slot*>& pageRef = _pages[guid >> PAGE_BITS];
+            Slot* page = pageRef.load(std::memory_order_relaxed);
+            if (!page)
+            {
+                if (!entry)
+                    return;
+
+                page = new Slot[PAGE_SIZE];
+                for (uint32 i = 0; i < PAGE_SIZE; ++i)
+                    page[i].store(nullptr, std::memory_order_relaxed);
+                pageRef.store(page, std::memory_order_release);
+                _allocatedPages++;
+            }
+
+            page[guid & PAGE_MASK].store(entry, std::memory_order_release);
+        }
+
+        size_t GetAllocatedSize() const { return sizeof(_pages) + _allocatedPages * PAGE_SIZE * sizeof(Slot); }
+
+    private:
+        typedef std::atomic<CharacterCacheEntry const*> Slot;
+
+        static constexpr uint32 PAGE_BITS = 12;
+        static constexpr uint32 PAGE_SIZE = 1 << PAGE_BITS;
+        static constexpr uint32 PAGE_MASK = PAGE_SIZE - 1;
+        static constexpr uint32 MAX_PAGES = 1 << 14; // up to 64M characters
+
+        std::atomic<Slot*> _pages[MAX_PAGES];
+        uint32 _allocatedPages = 0;
+    };
+
+    uint32 HashName(char const* name, size_t length)
+    {
+        // FNV-1a, high bit forced so that a used slot never stores a null hash
+        uint32 hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= uint8(name[i]);
+            hash *= 16777619u;
+        }
+        return hash | 0x80000000;
+    }
+
+    /* Open addressing name -> low guid table. Slots store (hash << 32 | guidLow), 0 means empty and a null guid means deleted.
+       Lookups are always checked against the current record name, so a reader racing with a rename can't get a wrong character. */
+    class NameIndex
+    {
+    public:
+        explicit NameIndex(uint32 capacity) : _mask(capacity - 1), _slots(new std::atomic<uint64>[capacity])
+        {
+            for (uint32 i = 0; i < capacity; ++i)
+                _slots[i].store(0, std::memory_order_relaxed);
+        }
+
+        template<class Check>
+        ObjectGuid::LowType Find(uint32 hash, Check const& check) const
+        {
+            for (uint32 i = hash & _mask; ; i = (i + 1) & _mask)
+            {
+                uint64 slot = _slots[i].load(std::memory_order_acquire);
+                if (!slot)
+                    return 0;
+
+                ObjectGuid::LowType guid = ObjectGuid::LowType(slot);
+                if (guid && uint32(slot >> 32) == hash && check(guid))
+                    return guid;
+            }
+        }
+
+        // Writer only. Returns false if the table is too loaded and must be grown first.
+        bool Insert(uint32 hash, ObjectGuid::LowType guid)
+        {
+            if ((_used + 1) * 4 > Capacity() * 3)
+                return false;
+
+            for (uint32 i = hash & _mask; ; i = (i + 1) & _mask)
+            {
+                uint64 slot = _slots[i].load(std::memory_order_relaxed);
+                if (slot && ObjectGuid::LowType(slot))
+                    continue;
+
+                if (!slot)
+                    ++_used; // tombstones are already counted
+                _slots[i].store((uint64(hash) << 32) | guid, std::memory_order_release);
+                return true;
+            }
+        }
+
+        // Writer only
+        void Remove(uint32 hash, ObjectGuid::LowType guid)
+        {
+            uint64 const value = (uint64(hash) << 32) | guid;
+            for (uint32 i = hash & _mask; ; i = (i + 1) & _mask)
+            {
+                uint64 slot = _slots[i].load(std::memory_order_relaxed);
+                if (!slot)
+                    return;
+
+                if (slot == value)
+                {
+                    _slots[i].store(uint64(hash) << 32, std::memory_order_release);
+                    return;
+                }
+            }
+        }
+
+        // Writer only, copy live entries to a table at least twice as big
+        NameIndex* Grow() const
+        {
+            NameIndex* index = new NameIndex(Capacity() * 2);
+            for (uint32 i = 0; i < Capacity(); ++i)
+            {
+                uint64 slot = _slots[i].load(std::memory_order_relaxed);
+                if (ObjectGuid::LowType(slot))
+                    index->Insert(uint32(slot >> 32), ObjectGuid::LowType(slot));
+            }
+            return index;
+        }
+
+        uint32 Capacity() const { return _mask + 1; }
+
+    private:
+        uint32 _mask;
+        std::unique_ptr<std::atomic<uint64>[]> _slots;
+        uint32 _used = 0;
+    };
+
+    std::mutex _writeLock;
+    NameArena _nameArena;
+    RecordArena _recordArena;
+    GuidIndex _guidIndex;
+    std::atomic<NameIndex*> _nameIndex(nullptr);
+    std::vector<std::unique_ptr<NameIndex>> _nameIndexes; // current one and retired ones, readers may still be walking those
+
+    uint32 NextPowerOfTwo(uint64 value)
+    {
+        uint32 result = 1024;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    // Writer only
+    void InsertName(char const* name, ObjectGuid::LowType guid)
+    {
+        uint32 hash = HashName(name, strlen(name));
+        NameIndex* index = _nameIndex.load(std::memory_order_relaxed);
+        if (!index)
+        {
+            index = new NameIndex(NextPowerOfTwo(0));
+            _nameIndexes.emplace_back(index);
+            _nameIndex.store(index, std::memory_order_release);
+        }
+
+        while (!index->Insert(hash, guid))
+        {
+            index = index->Grow();
+            _nameIndexes.emplace_back(index);
+            _nameIndex.store(index, std::memory_order_release);
+        }
+    }
+
+    // Writer only
+    void RemoveName(char const* name, ObjectGuid::LowType guid)
+    {
+        _nameIndex.load(std::memory_order_relaxed)->Remove(HashName(name, strlen(name)), guid);
+    }
+
+    CharacterCacheEntry const* FindByName(std::string const& name)
+    {
+        NameIndex const* index = _nameIndex.load(std::memory_order_acquire);
+        if (!index)
+            return nullptr;
+
+        CharacterCacheEntry const* found = nullptr;
+        index->Find(HashName(name.c_str(), name.size()), [&](ObjectGuid::LowType guid)
+        {
+            CharacterCacheEntry const* entry = _guidIndex.Find(guid);
+            if (!entry || name.compare(entry->name) != 0)
+                return false;
+
+            found = entry;
+            return true;
+        });
+        return found;
+    }
+
+    // Writer only. Publish a modified copy of the current entry, readers keep seeing the old one until then.
+    template<class Modifier>
+    bool UpdateEntry(ObjectGuid::LowType guid, Modifier const& modifier)
+    {
+        CharacterCacheEntry const* current = _guidIndex.Find(guid);
+        if (!current)
+            return false;
+
+        CharacterCacheEntry* copy = _recordArena.Allocate();
+        *copy = *current;
+        modifier(*copy);
+        _guidIndex.Publish(guid, copy);
+        _recordArena.Retire(current);
+        return true;
+    }
+}
+
+CharacterCacheEntryRef& CharacterCacheEntryRef::operator=(CharacterCacheEntryRef&& other)
+{
+    if (this != &other)
+    {
+        if (_entry)
+            EndRead();
+        _entry = other._entry;
+        other._entry = nullptr;
+    }
+    return *this;
+}
+
+CharacterCacheEntryRef::~CharacterCacheEntryRef()
+{
+    if (_entry)
+        EndRead();
 }
 
 CharacterCache::CharacterCache()
@@ -32,7 +498,6 @@ void CharacterCache::LoadCharacterCacheStorage()
 {
     uint32 oldMSTime = GetMSTime();
 
-    _characterCacheStore.clear();
     QueryResult result = CharacterDatabase.Query("SELECT guid, account, name, gender, race, class, level FROM characters WHERE deleteDate IS NULL");
     if (!result)
     {
@@ -40,6 +505,18 @@ void CharacterCache::LoadCharacterCacheStorage()
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(_writeLock);
+        // Size everything once, so that the whole realm ends up in one record block and the name index never grows while loading
+        _recordArena.Reserve(result->GetRowCount());
+        if (!_nameIndex.load(std::memory_order_relaxed))
+        {
+            NameIndex* index = new NameIndex(NextPowerOfTwo(result->GetRowCount() * 2));
+            _nameIndexes.emplace_back(index);
+            _nameIndex.store(index, std::memory_order_release);
+        }
+    }
+
     uint32 count = 0;
 
     do
@@ -60,57 +537,94 @@ void CharacterCache::LoadCharacterCacheStorage()
         ++count;
     } while (result->NextRow());
 
-    TC_LOG_INFO("server.loading", ">> Loaded %d Players data in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Loaded %d Players data in %u ms (records: %u KB, names: %u KB, index: %u KB)", count, GetMSTimeDiffToNow(oldMSTime),
+        uint32(_recordArena.GetAllocatedSize() / 1024), uint32(_nameArena.GetAllocatedSize() / 1024), uint32(_guidIndex.GetAllocatedSize() / 1024));
 }
 
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid::LowType guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, /* uint16 mailCount, */ uint32 guildId)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
-
-    data.guidLow = guid;
-    data.accountId = accountId;
-    data.name = name;
-    data.level = level;
-    data.race = race;
-    data.playerClass = playerClass;
-    data.gender = gender;
-    //data.mailCount = mailCount;
-    data.guildId = guildId;
-    //data.groupId = 0;
-    data.arenaTeamId[0] = 0;
-    data.arenaTeamId[1] = 0;
-    data.arenaTeamId[2] = 0;
+    if (!GuidIndex::CanStore(guid))
+    {
+        TC_LOG_ERROR("misc", "CharacterCache: guid %u is too high to be cached, character %s will be unknown to the cache", guid, name.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    CharacterCacheEntry* data = _recordArena.Allocate();
+
+    data->guidLow = guid;
+    data->accountId = accountId;
+    data->name = _nameArena.Intern(name);
+    data->level = level;
+    data->race = race;
+    data->playerClass = playerClass;
+    data->gender = gender;
+    //data->mailCount = mailCount;
+    data->guildId = guildId;
+    //data->groupId = 0;
+    data->arenaTeamId[0] = 0;
+    data->arenaTeamId[1] = 0;
+    data->arenaTeamId[2] = 0;
+
+    CharacterCacheEntry const* previous = _guidIndex.Find(guid);
+    if (previous)
+        RemoveName(previous->name, guid);
+
+    _guidIndex.Publish(guid, data);
+    if (previous)
+    {
+        _nameArena.Retire(previous->name);
+        _recordArena.Retire(previous);
+    }
 
     // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
+    InsertName(data->name, guid);
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid::LowType guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid::LowType guid, std::string const& /*name*/)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    std::lock_guard<std::mutex> lock(_writeLock);
+
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid);
+    if (!entry)
+        return;
+
+    RemoveName(entry->name, guid);
+    _guidIndex.Publish(guid, nullptr);
+    _nameArena.Retire(entry->name);
+    _recordArena.Retire(entry);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid::LowType guid, uint8 mask, std::string const& name, uint8 gender, uint8 race, uint8 playerClass)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    if (mask & PLAYER_UPDATE_DATA_RACE)
-        itr->second.race = race;
-    if (mask & PLAYER_UPDATE_DATA_CLASS)
-        itr->second.playerClass = playerClass;
-    if (mask & PLAYER_UPDATE_DATA_GENDER)
-        itr->second.gender = gender;
-    if (mask & PLAYER_UPDATE_DATA_NAME)
     {
-        std::string oldName = itr->second.name;
-        itr->second.name = name;
-
-        // Correct name -> pointer storage
-        _characterCacheByNameStore.erase(oldName);
-        _characterCacheByNameStore[name] = &itr->second;
+        std::lock_guard<std::mutex> lock(_writeLock);
+
+        CharacterCacheEntry const* current = _guidIndex.Find(guid);
+        if (!current)
+            return;
+
+        char const* oldName = current->name;
+        bool updated = UpdateEntry(guid, [&](CharacterCacheEntry& entry)
+        {
+            if (mask & PLAYER_UPDATE_DATA_RACE)
+                entry.race = race;
+            if (mask & PLAYER_UPDATE_DATA_CLASS)
+                entry.playerClass = playerClass;
+            if (mask & PLAYER_UPDATE_DATA_GENDER)
+                entry.gender = gender;
+            if (mask & PLAYER_UPDATE_DATA_NAME)
+                entry.name = _nameArena.Intern(name);
+        });
+
+        if (updated && (mask & PLAYER_UPDATE_DATA_NAME))
+        {
+            // Correct name -> guid storage
+            RemoveName(oldName, guid);
+            InsertName(_guidIndex.Find(guid)->name, guid);
+            _nameArena.Retire(oldName);
+        }
     }
 
     WorldPacket data(SMSG_INVALIDATE_PLAYER, 8);
@@ -120,163 +634,162 @@ void CharacterCache::UpdateCharacterData(ObjectGuid::LowType guid, uint8 mask, s
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid::LowType const& guid, uint8 level)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    itr->second.level = level;
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid, [level](CharacterCacheEntry& entry) { entry.level = level; });
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    itr->second.accountId = accountId;
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid.GetCounter(), [accountId](CharacterCacheEntry& entry) { entry.accountId = accountId; });
 }
 
 /*
 void CharacterCache::UpdateCharacterMails(ObjectGuid::LowType guid, int16 count, bool add)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    if (!add)
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid, [count, add](CharacterCacheEntry& entry)
     {
-        itr->second.mailCount = count;
-        return;
-    }
-
-    int16 icount = (int16)itr->second.mailCount;
-    if (count < 0 && abs(count) > icount)
-        count = -icount;
-    itr->second.mailCount = uint16(icount + count); // addition or subtraction
+        if (!add)
+        {
+            entry.mailCount = count;
+            return;
+        }
+
+        int16 icount = (int16)entry.mailCount;
+        if (count < 0 && abs(count) > icount)
+            count = -icount;
+        entry.mailCount = uint16(icount + count); // addition or subtraction
+    });
 }
 */
 
 void CharacterCache::UpdateCharacterGuildId(ObjectGuid::LowType guid, uint32 guildId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    itr->second.guildId = guildId;
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid, [guildId](CharacterCacheEntry& entry) { entry.guildId = guildId; });
 }
 
 /*
 void CharacterCache::UpdateCharacterGroup(ObjectGuid::LowType guid, uint32 groupId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    itr->second.groupId = groupId;
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid, [groupId](CharacterCacheEntry& entry) { entry.groupId = groupId; });
 }
 */
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid::LowType guid, uint8 slot, uint32 arenaTeamId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
-
-    itr->second.arenaTeamId[slot] = arenaTeamId;
+    std::lock_guard<std::mutex> lock(_writeLock);
+    UpdateEntry(guid, [slot, arenaTeamId](CharacterCacheEntry& entry) { entry.arenaTeamId[slot] = arenaTeamId; });
 }
 
 bool CharacterCache::HasCharacterCacheEntry(ObjectGuid::LowType guid) const
 {
-    return _characterCacheStore.find(guid) != _characterCacheStore.end();
+    return _guidIndex.Find(guid) != nullptr; // not dereferenced
 }
 
-CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid::LowType guid) const
+CharacterCacheEntryRef CharacterCache::GetCharacterCacheByGuid(ObjectGuid::LowType guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr != _characterCacheStore.end())
-        return &itr->second;
+    BeginRead();
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid);
+    if (!entry)
+    {
+        EndRead();
+        return CharacterCacheEntryRef();
+    }
 
-    return nullptr;
+    return CharacterCacheEntryRef(entry);
 }
 
-CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
+CharacterCacheEntryRef CharacterCache::GetCharacterCacheByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second;
+    BeginRead();
+    CharacterCacheEntry const* entry = FindByName(name);
+    if (!entry)
+    {
+        EndRead();
+        return CharacterCacheEntryRef();
+    }
 
-    return nullptr;
+    return CharacterCacheEntryRef(entry);
 }
 
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return ObjectGuid(HighGuid::Player, itr->second->guidLow);
+    ReadSection section;
+    if (CharacterCacheEntry const* entry = FindByName(name))
+        return ObjectGuid(HighGuid::Player, entry->guidLow);
 
     return ObjectGuid::Empty;
 }
 
 bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return false;
 
-    name = itr->second.name;
+    name = entry->name;
     return true;
 }
 
 uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return 0;
 
-    return Player::TeamForRace(itr->second.race);
+    return Player::TeamForRace(entry->race);
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return 0;
 
-    return itr->second.accountId;
+    return entry->accountId;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second->accountId;
+    ReadSection section;
+    if (CharacterCacheEntry const* entry = FindByName(name))
+        return entry->accountId;
 
     return 0;
 }
 
 uint8 CharacterCache::GetCharacterLevelByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return 0;
 
-    return itr->second.level;
+    return entry->level;
 }
 
 ObjectGuid::LowType CharacterCache::GetCharacterGuildIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return 0;
 
-    return itr->second.guildId;
+    return entry->guildId;
 }
 
 uint32 CharacterCache::GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    ReadSection section;
+    CharacterCacheEntry const* entry = _guidIndex.Find(guid.GetCounter());
+    if (!entry)
         return 0;
 
-    return itr->second.arenaTeamId[ArenaTeam::GetSlotByType(type)];
+    return entry->arenaTeamId[ArenaTeam::GetSlotByType(type)];
 }
@@ -1,15 +1,18 @@
 #ifndef CharacterCache_h__
 #define CharacterCache_h__
- 
+
 #include "ArenaTeam.h"
 #include "Define.h"
 #include <string>
 
+/* Entries are immutable once published: updates store a modified copy and swap it in.
+   Entries are read through CharacterCacheEntryRef, replaced entries and names are only reused once no ref can see them.
+   name points into the cache string arena and is null terminated. */
 struct CharacterCacheEntry
 {
     uint32 guidLow;
     uint32 accountId;
-    std::string name;
+    char const* name;
     uint8 race;
     uint8 playerClass;
     uint8 gender;
@@ -20,6 +23,33 @@ struct CharacterCacheEntry
     uint32 arenaTeamId[MAX_ARENA_SLOT];
 };
 
+/* Entry handed out by the cache. While it is alive, the entry and its name can't be reused (it may become outdated though).
+   Cheap to hold, but don't keep it past the current function nor hand it to another thread: nothing the cache retires
+   meanwhile can be reused. */
+class TC_GAME_API CharacterCacheEntryRef
+{
+public:
+    CharacterCacheEntryRef() : _entry(nullptr) { }
+    CharacterCacheEntryRef(CharacterCacheEntryRef&& other) : _entry(other._entry) { other._entry = nullptr; }
+    CharacterCacheEntryRef& operator=(CharacterCacheEntryRef&& other);
+    CharacterCacheEntryRef(CharacterCacheEntryRef const&) = delete;
+    CharacterCacheEntryRef& operator=(CharacterCacheEntryRef const&) = delete;
+    ~CharacterCacheEntryRef();
+
+    CharacterCacheEntry const* get() const { return _entry; }
+    CharacterCacheEntry const* operator->() const { return _entry; }
+    CharacterCacheEntry const& operator*() const { return *_entry; }
+    explicit operator bool() const { return _entry != nullptr; }
+
+private:
+    friend class CharacterCache;
+    // Takes over the read section the entry was found in
+    explicit CharacterCacheEntryRef(CharacterCacheEntry const* entry) : _entry(entry) { }
+
+    CharacterCacheEntry const* _entry;
+};
+
+/* Getters are lock free and may be used from any thread, updates are serialized internally. */
 class TC_GAME_API CharacterCache
 {
 public:
@@ -39,8 +69,8 @@ public:
     //NYI void UpdateCharacterGroup(ObjectGuid::LowType guid, uint32 groupId);
     void UpdateCharacterArenaTeamId(ObjectGuid::LowType guid, uint8 slot, uint32 arenaTeamId);
 
-    CharacterCacheEntry const* GetCharacterCacheByGuid(ObjectGuid::LowType guid) const;
-    CharacterCacheEntry const* GetCharacterCacheByName(std::string const& name) const;
+    CharacterCacheEntryRef GetCharacterCacheByGuid(ObjectGuid::LowType guid) const;
+    CharacterCacheEntryRef GetCharacterCacheByName(std::string const& name) const;
 	bool HasCharacterCacheEntry(ObjectGuid::LowType guidLow) const;
 
     ObjectGuid GetCharacterGuidByName(std::string const& name) const;
@@ -137,6 +137,9 @@ void Channel::Join(ObjectGuid p, const char *pass)
     pinfo.flags = 0;
     pinfo.invisible = (plr ? plr->GetSession()->GetSecurity() > SEC_PLAYER : false) && sWorld->getConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL);
     players[p] = pinfo;
+    // only with JoinedChannel above, so that Player::CleanupChannels removes it at logout
+    if (plr)
+        AddMemberSession(plr);
 
     MakeYouJoined(&data);
     SendToOne(&data, p);
@@ -178,6 +181,7 @@ void Channel::Leave(ObjectGuid p, bool send)
         bool changeowner = players[p].IsOwner();
 
         players.erase(p);
+        RemoveMemberSession(p);
         if(m_announce && (!plr || plr->GetSession()->GetSecurity() == SEC_PLAYER || !sWorld->getConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL) ) && this->GetName() != "world" && this->GetName() != "pvp") //announce auto-deactivated for the world & pvp channel
         {
             WorldPacket data;
@@ -249,6 +253,7 @@ void Channel::KickOrBan(ObjectGuid good, std::string const& badname, bool ban)
             if (GetName() != "world")
                 SendToAll(&data);
             players.erase(bad->GetGUID());
+            RemoveMemberSession(bad->GetGUID());
             bad->LeftChannel(this);
 
             if(changeowner)
@@ -707,30 +712,48 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
+void Channel::AddMemberSession(Player* player)
+{
+    m_memberSessions.push_back({ player->GetGUID(), player });
+}
+
+void Channel::RemoveMemberSession(ObjectGuid guid)
 {
-    for(auto & player : players)
+    for (auto itr = m_memberSessions.begin(); itr != m_memberSessions.end(); ++itr)
     {
-        Player *plr = ObjectAccessor::FindPlayer(player.first);
-        if(plr)
+        if (itr->guid == guid)
         {
-            if(!p || !plr->GetSocial()->HasIgnore(p.GetCounter()))
-                plr->SendDirectMessage(data);
+            // order does not matter, swap with last to keep the array packed
+            *itr = m_memberSessions.back();
+            m_memberSessions.pop_back();
+            return;
         }
     }
 }
 
-void Channel::SendToAllButOne(WorldPacket *data, ObjectGuid who)
+void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
 {
-    for(auto & player : players)
+    // the packet is built once by the caller, each session only queues it
+    // members not in world (loading screen) are skipped, as ObjectAccessor::FindPlayer used to
+    if (!p)
     {
-        if(player.first != who)
-        {
-            Player *plr = ObjectAccessor::FindPlayer(player.first);
-            if(plr)
-                plr->SendDirectMessage(data);
-        }
+        for (MemberSession const& member : m_memberSessions)
+            if (member.player->IsInWorld())
+                member.player->SendDirectMessage(data);
+        return;
     }
+
+    ObjectGuid::LowType const sender = p.GetCounter();
+    for (MemberSession const& member : m_memberSessions)
+        if (member.player->IsInWorld() && !member.player->GetSocial()->HasIgnore(sender))
+            member.player->SendDirectMessage(data);
+}
+
+void Channel::SendToAllButOne(WorldPacket *data, ObjectGuid who)
+{
+    for (MemberSession const& member : m_memberSessions)
+        if (member.guid != who && member.player->IsInWorld())
+            member.player->SendDirectMessage(data);
 }
 
 void Channel::SendToOne(WorldPacket *data, ObjectGuid who)
@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 enum ChatNotify
 {
@@ -128,6 +129,16 @@ class Channel
 
     typedef     std::map<ObjectGuid, PlayerInfo> PlayerList;
     PlayerList  players;
+
+    // Online members, kept in sync with players on join and leave (logout leaves through Player::CleanupChannels).
+    // Broadcasts walk this array instead of looking up every member in ObjectAccessor.
+    struct MemberSession
+    {
+        ObjectGuid guid;
+        Player* player;
+    };
+    typedef     std::vector<MemberSession> MemberSessionList;
+    MemberSessionList m_memberSessions;
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     typedef     std::map<uint64, uint64> GMBannedList;      // Banned by .chanban, <AccountGUID, Expiration date>
@@ -181,6 +192,9 @@ class Channel
         void MakeVoiceOn(WorldPacket *data, ObjectGuid guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket *data, ObjectGuid guid);                      //+ 0x23
 
+        void AddMemberSession(Player* player);
+        void RemoveMemberSession(ObjectGuid guid);
+
         void SendToAllButOne(WorldPacket *data, ObjectGuid who);
         void SendToOne(WorldPacket *data, ObjectGuid who);
 
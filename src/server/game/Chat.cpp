@@ -287,6 +287,8 @@ std::vector<ChatCommand> const& ChatHandler::getCommandTable()
         { "getarmor",       SEC_GAMEMASTER3,  false, &ChatHandler::HandleDebugGetArmorCommand,         "" },
         { "spawnbatchobjects",SEC_SUPERADMIN, false, &ChatHandler::HandleSpawnBatchObjects,            "" },
         { "boundary",      SEC_GAMEMASTER3,   false, &ChatHandler::HandleDebugBoundaryCommand,         "" },
+        { "syncqueries",   SEC_GAMEMASTER3,   true,  &ChatHandler::HandleDebugSyncQueriesCommand,      "" },
+        { "objectpools",   SEC_GAMEMASTER3,   true,  &ChatHandler::HandleDebugObjectPoolsCommand,      "" },
     };
 
     static std::vector<ChatCommand> eventCommandTable =
@@ -5,6 +5,8 @@
 #include "BattleGroundMgr.h"
 #include "ChannelMgr.h"
 #include "GossipDef.h"
+#include "SyncQueryTracker.h"
+#include "MapObjectAllocator.h"
 
 //FIXME: not working for float values
 void FillSnapshotValues(WorldObject* target, std::vector<uint32>& values)
@@ -1484,6 +1486,63 @@ bool ChatHandler::HandleDebugBoundaryCommand(char const* args)
     return true;
 }
 
+/* Show the synchronous queries issued from world and map threads, see Database.SyncQueryTracker.Mode
+Syntax: .debug syncqueries [count|reset]
+    count: number of sites to show, most total time first (default 10)
+    reset: forget all recorded queries
+*/
+bool ChatHandler::HandleDebugSyncQueriesCommand(const char* args)
+{
+    char* arg = args ? strtok((char*)args, " ") : nullptr;
+    if (arg && stricmp(arg, "reset") == 0)
+    {
+        SyncQueryTracker::Reset();
+        SendSysMessage("Synchronous query report cleared.");
+        return true;
+    }
+
+    if (!sWorld->getIntConfig(CONFIG_SYNC_QUERY_TRACKER_MODE))
+        SendSysMessage("Database.SyncQueryTracker.Mode is disabled, nothing new is recorded.");
+
+    uint32 count = arg ? uint32(atoi(arg)) : 10;
+    std::vector<SyncQueryTracker::Site> report = SyncQueryTracker::GetReport();
+    PSendSysMessage("%u synchronous query sites recorded.", uint32(report.size()));
+    for (uint32 i = 0; i < report.size() && i < count; ++i)
+    {
+        SyncQueryTracker::Site const& site = report[i];
+        PSendSysMessage("#%u %s thread, %s: " UI64FMTD " queries, " UI64FMTD " ms total, " UI64FMTD " us avg, " UI64FMTD " us max",
+            i + 1, SyncQueryTracker::GetThreadName(site.Thread), site.Database.c_str(), site.Count, site.TotalUs / 1000, site.TotalUs / site.Count, site.MaxUs);
+        PSendSysMessage("    %s", site.Sample.c_str());
+        for (std::string const& frame : site.Stack)
+            PSendSysMessage("    at %s", frame.c_str());
+    }
+
+    return true;
+}
+
+/* Show the memory pools creatures, gameobjects, dynamic objects, auras and spells are allocated from, see ObjectPools.Enable
+Syntax: .debug objectpools
+*/
+bool ChatHandler::HandleDebugObjectPoolsCommand(const char* /*args*/)
+{
+    if (!MapObjectAllocator::IsEnabled())
+        SendSysMessage("ObjectPools.Enable is disabled, new objects are not allocated from the pools.");
+
+    std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> stats = MapObjectAllocator::GetStats();
+    PSendSysMessage("Object pools of %u threads:", MapObjectAllocator::GetThreadCount());
+    uint64 totalBytes = 0;
+    for (uint8 type = 0; type < MAX_MAP_OBJECT_POOLS; ++type)
+    {
+        MapObjectPoolStats const& pool = stats[type];
+        totalBytes += pool.Bytes;
+        PSendSysMessage("%s: " UI64FMTD " live / " UI64FMTD " slots (" UI64FMTD " KB), " UI64FMTD " allocations, " UI64FMTD " freed from another thread",
+            MapObjectAllocator::GetPoolName(MapObjectPoolType(type)), pool.Live, pool.Capacity, pool.Bytes / 1024, pool.Allocations, pool.RemoteFrees);
+    }
+    PSendSysMessage("Total: " UI64FMTD " KB", totalBytes / 1024);
+
+    return true;
+}
+
 
 /* Spawn a bunch of gameobjects objects from given file. This command will check wheter a close object is found on this server and ignore the new one if one is found.
 A preview gobject is spawned.
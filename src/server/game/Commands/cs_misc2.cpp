@@ -1143,7 +1143,7 @@ bool ChatHandler::HandleRenameArenaTeamCommand(const char* args)
         return true;
     }
 
-    CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(targetGUID.GetCounter());
+    CharacterCacheEntryRef playerData = sCharacterCache->GetCharacterCacheByGuid(targetGUID.GetCounter());
     if (!playerData)
     {
         SendSysMessage(LANG_PLAYER_NOT_FOUND);
@@ -463,6 +463,7 @@ bool ChatHandler::HandleReloadSpellAffectCommand(const char*)
 bool ChatHandler::HandleReloadSpellAreaCommand(const char*)
 {
     TC_LOG_INFO("command", "Re-Loading spell_area...");
+    sSpellMgr->LoadSpellAreaAttributes();
     sSpellMgr->LoadSpellAreas();
     SendGlobalGMSysMessage("DB table `spell_area` reloaded.");
     return true;
@@ -852,6 +853,7 @@ bool ChatHandler::HandleReloadSpellTemplates(const char* args)
     //also reload those tables as they can alter spell info too
     sSpellMgr->LoadSpellLinked();
     sSpellMgr->LoadSpellAffects();
+    sSpellMgr->LoadSpellAreaAttributes();
     sSpellMgr->LoadSpellTalentRanks();
 
     SendGlobalGMSysMessage("DB table `spell_template` (spell definitions) reloaded.");
@@ -18,9 +18,9 @@ void ChatHandler::SendTicket(GM_Ticket const* ticket, time_t currentTime, bool s
     std::string gmname;
     std::stringstream ss;
     ss << PGetParseString(LANG_COMMAND_TICKETLISTGUID, ticket->guid);
-    CharacterCacheEntry const* data = sCharacterCache->GetCharacterCacheByGuid(ticket->playerGuid);
+    CharacterCacheEntryRef data = sCharacterCache->GetCharacterCacheByGuid(ticket->playerGuid);
 
-    ss << PGetParseString(LANG_COMMAND_TICKETLISTNAME, data ? data->name.c_str() : "<name not found>", data ? data->name.c_str() : "<name not found>");
+    ss << PGetParseString(LANG_COMMAND_TICKETLISTNAME, data ? data->name : "<name not found>", data ? data->name : "<name not found>");
     if (showAge)
     {
         ss << PGetParseString(LANG_COMMAND_TICKETLISTAGECREATE, (secsToTimeString(time(nullptr) - ticket->createtime, true, false)).c_str());
@@ -29,7 +29,7 @@ void ChatHandler::SendTicket(GM_Ticket const* ticket, time_t currentTime, bool s
     if (showAssign)
     {
         data = sCharacterCache->GetCharacterCacheByGuid(ticket->assignedToGM);
-        ss << PGetParseString(LANG_COMMAND_TICKETLISTASSIGNEDTO, data ? data->name.c_str() : "<name not found>");
+        ss << PGetParseString(LANG_COMMAND_TICKETLISTASSIGNEDTO, data ? data->name : "<name not found>");
     }
     if (showMessage)
         ss << PGetParseString(LANG_COMMAND_TICKETLISTMESSAGE, ticket->message.c_str());
@@ -772,6 +772,47 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
+bool CompiledConditions::Meets(ConditionSourceInfo& sourceInfo) const
+{
+    // only unloaded conditions, see ConditionMgr::IsObjectMeetToConditionList
+    if (_groupEnds.empty())
+        return Conditions.empty();
+
+    uint32 i = 0;
+    for (uint32 groupEnd : _groupEnds)
+    {
+        for (; i < groupEnd; ++i)
+        {
+            Step const& step = _steps[i];
+            if (step.Reference ? !step.Reference->Meets(sourceInfo) : !step.Cond->Meets(sourceInfo))
+                break;
+        }
+
+        if (i == groupEnd)
+            return true;
+
+        i = groupEnd;
+    }
+
+    return false;
+}
+
+void CompiledConditions::Clear()
+{
+    Conditions.clear();
+    _steps.clear();
+    _groupEnds.clear();
+    _compiled = false;
+}
+
+namespace
+{
+    inline uint64 MakeConditionStoreKey(uint32 first, uint32 second)
+    {
+        return uint64(first) << 32 | second;
+    }
+}
+
 ConditionMgr::ConditionMgr() { }
 
 ConditionMgr::~ConditionMgr()
@@ -784,7 +825,7 @@ ConditionContainer ConditionMgr::GetConditionReferences(uint32 refId)
     ConditionContainer conditions;
     ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(refId);
     if (ref != ConditionReferenceStore.end())
-        conditions = (*ref).second;
+        conditions = ref->second.Conditions;
     return conditions;
 }
 
@@ -810,7 +851,7 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
         {
             ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
             ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
-            ElseGroupStore[condition->ElseGroup] &= GetSearcherTypeMaskForConditionList((*ref).second);
+            ElseGroupStore[condition->ElseGroup] &= GetSearcherTypeMaskForConditionList(ref->second.Conditions);
         }
         else // handle normal condition
         {
@@ -850,7 +891,7 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
                 ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
                 if (ref != ConditionReferenceStore.end())
                 {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
+                    if (!IsObjectMeetToConditionList(sourceInfo, ref->second.Conditions))
                         ElseGroupStore[condition->ElseGroup] = false;
                 }
                 else
@@ -933,11 +974,11 @@ bool ConditionMgr::IsObjectMeetingNotGroupedConditions(ConditionSourceType sourc
 {
     if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
     {
-        ConditionsByEntryMap::const_iterator i = ConditionStore[sourceType].find(entry);
-        if (i != ConditionStore[sourceType].end())
+        ConditionsByTypeAndEntryMap::const_iterator i = ConditionStore.find(MakeConditionStoreKey(sourceType, entry));
+        if (i != ConditionStore.end())
         {
             TC_LOG_DEBUG("condition", "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sourceType), entry);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
+            return i->second.Meets(sourceInfo);
         }
     }
 
@@ -947,7 +988,7 @@ bool ConditionMgr::IsObjectMeetingNotGroupedConditions(ConditionSourceType sourc
 bool ConditionMgr::HasConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
 {
     if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
-        if (ConditionStore[sourceType].find(entry) != ConditionStore[sourceType].end())
+        if (ConditionStore.find(MakeConditionStoreKey(sourceType, entry)) != ConditionStore.end())
             return true;
 
     return false;
@@ -956,81 +997,127 @@ bool ConditionMgr::HasConditionsForNotGroupedEntry(ConditionSourceType sourceTyp
 
 bool ConditionMgr::IsObjectMeetingSpellClickConditions(uint32 creatureId, uint32 spellId, WorldObject* clicker, WorldObject* target) const
 {
-    ConditionEntriesByCreatureIdMap::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
-    if (itr != SpellClickEventConditionStore.end())
+    ConditionsByGroupAndEntryMap::const_iterator i = SpellClickEventConditionStore.find(MakeConditionStoreKey(creatureId, spellId));
+    if (i != SpellClickEventConditionStore.end())
     {
-        ConditionsByEntryMap::const_iterator i = itr->second.find(spellId);
-        if (i != itr->second.end())
-        {
-            TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for SpellClickEvent entry %u spell %u", creatureId, spellId);
-            ConditionSourceInfo sourceInfo(clicker, target);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
-        }
+        TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for SpellClickEvent entry %u spell %u", creatureId, spellId);
+        ConditionSourceInfo sourceInfo(clicker, target);
+        return i->second.Meets(sourceInfo);
     }
     return true;
 }
 
 ConditionContainer const* ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const
 {
-    ConditionEntriesByCreatureIdMap::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
-    if (itr != SpellClickEventConditionStore.end())
+    ConditionsByGroupAndEntryMap::const_iterator i = SpellClickEventConditionStore.find(MakeConditionStoreKey(creatureId, spellId));
+    if (i != SpellClickEventConditionStore.end())
     {
-        ConditionsByEntryMap::const_iterator i = itr->second.find(spellId);
-        if (i != itr->second.end())
-        {
-            TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for SpellClickEvent entry %u spell %u", creatureId, spellId);
-            return &i->second;
-        }
+        TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for SpellClickEvent entry %u spell %u", creatureId, spellId);
+        return &i->second.Conditions;
     }
     return nullptr;
 }
 
 bool ConditionMgr::IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint32 spellId, Player* player, Unit* vehicle) const
 {
-    ConditionEntriesByCreatureIdMap::const_iterator itr = VehicleSpellConditionStore.find(creatureId);
-    if (itr != VehicleSpellConditionStore.end())
+    ConditionsByGroupAndEntryMap::const_iterator i = VehicleSpellConditionStore.find(MakeConditionStoreKey(creatureId, spellId));
+    if (i != VehicleSpellConditionStore.end())
     {
-        ConditionsByEntryMap::const_iterator i = itr->second.find(spellId);
-        if (i != itr->second.end())
-        {
-            TC_LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-            ConditionSourceInfo sourceInfo(player, vehicle);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
-        }
+        TC_LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
+        ConditionSourceInfo sourceInfo(player, vehicle);
+        return i->second.Meets(sourceInfo);
     }
     return true;
 }
 
 bool ConditionMgr::IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const
 {
-    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
-    if (itr != SmartEventConditionStore.end())
+    SmartEventConditionContainer::const_iterator i = SmartEventConditionStore.find({ entryOrGuid, sourceType, eventId + 1 });
+    if (i != SmartEventConditionStore.end())
     {
-        ConditionsByEntryMap::const_iterator i = itr->second.find(eventId + 1);
-        if (i != itr->second.end())
-        {
-            TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %d eventId %u", entryOrGuid, eventId);
-            ConditionSourceInfo sourceInfo(unit, baseObject);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
-        }
+        TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %d eventId %u", entryOrGuid, eventId);
+        ConditionSourceInfo sourceInfo(unit, baseObject);
+        return i->second.Meets(sourceInfo);
     }
     return true;
 }
 
 bool ConditionMgr::IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const
 {
-    ConditionEntriesByCreatureIdMap::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
-    if (itr != NpcVendorConditionContainerStore.end())
+    ConditionsByGroupAndEntryMap::const_iterator i = NpcVendorConditionContainerStore.find(MakeConditionStoreKey(creatureId, itemId));
+    if (i != NpcVendorConditionContainerStore.end())
     {
-        ConditionsByEntryMap::const_iterator i = (*itr).second.find(itemId);
-        if (i != (*itr).second.end())
+        TC_LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry %u item %u", creatureId, itemId);
+        ConditionSourceInfo sourceInfo(player, vendor);
+        return i->second.Meets(sourceInfo);
+    }
+    return true;
+}
+
+void ConditionMgr::CompileConditions(CompiledConditions& conditions)
+{
+    if (conditions._compiled)
+        return;
+
+    conditions._compiled = true;
+
+    ConditionContainer sorted;
+    sorted.reserve(conditions.Conditions.size());
+    for (Condition* condition : conditions.Conditions)
+        if (condition->isLoaded())
+            sorted.push_back(condition);
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](Condition const* left, Condition const* right)
+    {
+        return left->ElseGroup < right->ElseGroup;
+    });
+
+    conditions._steps.reserve(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        Condition* condition = sorted[i];
+        if (!condition->ReferenceId)
+            conditions._steps.push_back({ condition, nullptr });
+        else
         {
-            TC_LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry %u item %u", creatureId, itemId);
-            ConditionSourceInfo sourceInfo(player, vendor);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
+            // a missing reference doesn't fail its group, checked at loading anyway
+            ConditionReferenceContainer::iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
+            if (ref != ConditionReferenceStore.end())
+            {
+                CompileConditions(ref->second);
+                conditions._steps.push_back({ condition, &ref->second });
+            }
         }
+
+        if (i + 1 == sorted.size() || sorted[i + 1]->ElseGroup != condition->ElseGroup)
+            conditions._groupEnds.push_back(uint32(conditions._steps.size()));
     }
-    return true;
+}
+
+void ConditionMgr::CompileAllConditions()
+{
+    for (auto& itr : ConditionReferenceStore)
+        CompileConditions(itr.second);
+
+    for (auto& itr : ConditionStore)
+        CompileConditions(itr.second);
+
+    for (auto& itr : VehicleSpellConditionStore)
+        CompileConditions(itr.second);
+
+    for (auto& itr : SpellClickEventConditionStore)
+        CompileConditions(itr.second);
+
+    for (auto& itr : NpcVendorConditionContainerStore)
+        CompileConditions(itr.second);
+
+    for (auto& itr : SmartEventConditionStore)
+        CompileConditions(itr.second);
+
+    for (CompiledConditions* conditions : ExternalConditionStore)
+        CompileConditions(*conditions);
+
+    ExternalConditionStore.clear();
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -1140,12 +1227,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (ConditionReferenceStore.find(uRefId) == ConditionReferenceStore.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionContainer mCondList;
-                ConditionReferenceStore[uRefId] = mCondList;
-            }
-            ConditionReferenceStore[uRefId].push_back(cond);//add to reference storage
+            ConditionReferenceStore[uRefId].Conditions.push_back(cond);//add to reference storage
             count++;
             continue;
         }//end of reference templates
@@ -1234,7 +1316,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    SpellClickEventConditionStore[MakeConditionStoreKey(cond->SourceGroup, cond->SourceEntry)].Conditions.push_back(cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1245,7 +1327,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
                     /*
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    VehicleSpellConditionStore[MakeConditionStoreKey(cond->SourceGroup, cond->SourceEntry)].Conditions.push_back(cond);
                     */
                     valid = true;
                     ++count;
@@ -1253,16 +1335,15 @@ void ConditionMgr::LoadConditions(bool isReload)
                 }
                 case CONDITION_SOURCE_TYPE_SMART_EVENT:
                 {
-                    //! TODO: PAIR_32 ?
-                    std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    SmartEventConditionKey key = { cond->SourceEntry, cond->SourceId, cond->SourceGroup };
+                    SmartEventConditionStore[key].Conditions.push_back(cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    NpcVendorConditionContainerStore[MakeConditionStoreKey(cond->SourceGroup, cond->SourceEntry)].Conditions.push_back(cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1286,15 +1367,17 @@ void ConditionMgr::LoadConditions(bool isReload)
 
         //handle not grouped conditions
         //add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        ConditionStore[MakeConditionStoreKey(cond->SourceType, cond->SourceEntry)].Conditions.push_back(cond);
         ++count;
     }
     while (result->NextRow());
 
+    CompileAllConditions();
+
     TC_LOG_INFO("server.loading", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
-bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot) const
+bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot)
 {
     if (!loot)
     {
@@ -1302,14 +1385,17 @@ bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot) const
         return false;
     }
 
-    if (loot->addConditionItem(cond))
+    if (CompiledConditions* conditions = loot->addConditionItem(cond))
+    {
+        ExternalConditionStore.push_back(conditions);
         return true;
+    }
 
     TC_LOG_ERROR("sql.sql", "%s Item %u not found in LootTemplate %u.", cond->ToString().c_str(), cond->SourceEntry, cond->SourceGroup);
     return false;
 }
 
-bool ConditionMgr::addToGossipMenus(Condition* cond) const
+bool ConditionMgr::addToGossipMenus(Condition* cond)
 {
     GossipMenusMapBoundsNonConst pMenuBounds = sObjectMgr->GetGossipMenusMapBoundsNonConst(cond->SourceGroup);
 
@@ -1319,7 +1405,8 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
         {
             if ((*itr).second.entry == cond->SourceGroup && (*itr).second.text_id == uint32(cond->SourceEntry))
             {
-                (*itr).second.conditions.push_back(cond);
+                (*itr).second.conditions.Conditions.push_back(cond);
+                ExternalConditionStore.push_back(&(*itr).second.conditions);
                 return true;
             }
         }
@@ -1329,7 +1416,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
     return false;
 }
 
-bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
+bool ConditionMgr::addToGossipMenuItems(Condition* cond)
 {
     GossipMenuItemsMapBoundsNonConst pMenuItemBounds = sObjectMgr->GetGossipMenuItemsMapBoundsNonConst(cond->SourceGroup);
     if (pMenuItemBounds.first != pMenuItemBounds.second)
@@ -1338,7 +1425,8 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
         {
             if ((*itr).second.MenuId == cond->SourceGroup && (*itr).second.OptionIndex == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                (*itr).second.Conditions.Conditions.push_back(cond);
+                ExternalConditionStore.push_back(&(*itr).second.Conditions);
                 return true;
             }
         }
@@ -1348,7 +1436,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
     return false;
 }
 
-bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
+bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond)
 {
     uint32 conditionEffMask = cond->SourceGroup;
     SpellInfo* spellInfo = const_cast<SpellInfo*>(sSpellMgr->AssertSpellInfo(cond->SourceEntry));
@@ -1397,7 +1485,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
 
         // build new shared mask with found effect
         uint32 sharedMask = 1 << i;
-        ConditionContainer* cmp = spellInfo->Effects[i].ImplicitTargetConditions;
+        CompiledConditions* cmp = spellInfo->Effects[i].ImplicitTargetConditions;
         for (uint8 effIndex = i + 1; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
         {
             if (spellInfo->Effects[effIndex].ImplicitTargetConditions == cmp)
@@ -1420,7 +1508,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                 return false;
 
             // get shared data
-            ConditionContainer* sharedList = spellInfo->Effects[firstEffIndex].ImplicitTargetConditions;
+            CompiledConditions* sharedList = spellInfo->Effects[firstEffIndex].ImplicitTargetConditions;
 
             // there's already data entry for that sharedMask
             if (sharedList)
@@ -1437,7 +1525,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
             else
             {
                 // add new list, create new shared mask
-                sharedList = new ConditionContainer();
+                sharedList = new CompiledConditions();
                 bool assigned = false;
                 for (uint8 i = firstEffIndex; i < MAX_SPELL_EFFECTS; ++i)
                 {
@@ -1451,7 +1539,8 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                 if (!assigned)
                     delete sharedList;
             }
-            sharedList->push_back(cond);
+            sharedList->Conditions.push_back(cond);
+            ExternalConditionStore.push_back(sharedList);
             break;
         }
     }
@@ -2332,51 +2421,21 @@ void ConditionMgr::LogUselessConditionValue(Condition* cond, uint8 index, uint32
 
 void ConditionMgr::Clean()
 {
-    for (auto & itr : ConditionReferenceStore)
+    auto deleteConditions = [](auto& store)
     {
-        for (ConditionContainer::const_iterator it = itr.second.begin(); it != itr.second.end(); ++it)
-            delete *it;
-        itr.second.clear();
-    }
-
-    ConditionReferenceStore.clear();
-
-    for (uint32 i = 0; i < CONDITION_SOURCE_TYPE_MAX; ++i)
-    {
-        for (ConditionsByEntryMap::iterator it = ConditionStore[i].begin(); it != ConditionStore[i].end(); ++it)
-            for (ConditionContainer::const_iterator itr = it->second.begin(); itr != it->second.end(); ++itr)
-                delete *itr;
-
-        ConditionStore[i].clear();
-    }
-
-    for (ConditionEntriesByCreatureIdMap::iterator itr = VehicleSpellConditionStore.begin(); itr != VehicleSpellConditionStore.end(); ++itr)
-        for (ConditionsByEntryMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            for (ConditionContainer::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-
-    VehicleSpellConditionStore.clear();
-
-    for (SmartEventConditionContainer::iterator itr = SmartEventConditionStore.begin(); itr != SmartEventConditionStore.end(); ++itr)
-        for (ConditionsByEntryMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            for (ConditionContainer::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-
-    SmartEventConditionStore.clear();
-
-    for (ConditionEntriesByCreatureIdMap::iterator itr = SpellClickEventConditionStore.begin(); itr != SpellClickEventConditionStore.end(); ++itr)
-        for (ConditionsByEntryMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            for (ConditionContainer::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-
-    SpellClickEventConditionStore.clear();
-
-    for (ConditionEntriesByCreatureIdMap::iterator itr = NpcVendorConditionContainerStore.begin(); itr != NpcVendorConditionContainerStore.end(); ++itr)
-        for (ConditionsByEntryMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            for (ConditionContainer::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-
-    NpcVendorConditionContainerStore.clear();
+        for (auto& itr : store)
+            for (Condition* condition : itr.second.Conditions)
+                delete condition;
+
+        store.clear();
+    };
+
+    deleteConditions(ConditionReferenceStore);
+    deleteConditions(ConditionStore);
+    deleteConditions(VehicleSpellConditionStore);
+    deleteConditions(SmartEventConditionStore);
+    deleteConditions(SpellClickEventConditionStore);
+    deleteConditions(NpcVendorConditionContainerStore);
 
     // this is a BIG hack, feel free to fix it if you can figure out the ConditionMgr ;)
     for (std::vector<Condition*>::const_iterator itr = AllocatedMemoryStore.begin(); itr != AllocatedMemoryStore.end(); ++itr)
@@ -7,6 +7,8 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class WorldObject;
 class LootTemplate;
@@ -210,11 +212,58 @@ struct Condition
 };
 
 typedef std::vector<Condition*> ConditionContainer;
-typedef std::map<uint32 /*SourceEntry*/, ConditionContainer> ConditionsByEntryMap;
-typedef std::array<ConditionsByEntryMap, CONDITION_SOURCE_TYPE_MAX> ConditionEntriesByTypeArray;
-typedef std::map<uint32, ConditionsByEntryMap> ConditionEntriesByCreatureIdMap;
-typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionsByEntryMap> SmartEventConditionContainer;
-typedef std::map<uint32, ConditionContainer> ConditionReferenceContainer;//only used for references
+
+/*
+    Conditions of one source, compiled once all conditions are loaded: sorted by ElseGroup with references resolved to
+    their own compiled conditions. Met when all conditions of any ElseGroup are met, a group stops at its first failure.
+*/
+class TC_GAME_API CompiledConditions
+{
+public:
+    bool Meets(ConditionSourceInfo& sourceInfo) const;
+    // Drop the conditions, without deleting them
+    void Clear();
+
+    ConditionContainer Conditions; // as loaded
+
+private:
+    friend class ConditionMgr;
+
+    struct Step
+    {
+        Condition* Cond;
+        CompiledConditions const* Reference; // for reference conditions
+    };
+
+    std::vector<Step> _steps;
+    std::vector<uint32> _groupEnds; // index past the last step of each ElseGroup
+    bool _compiled = false;
+};
+
+struct SmartEventConditionKey
+{
+    int32 EntryOrGuid;
+    uint32 SourceType; // SAI source_type
+    uint32 EventId;    // SAI id + 1
+
+    bool operator==(SmartEventConditionKey const& right) const
+    {
+        return EntryOrGuid == right.EntryOrGuid && SourceType == right.SourceType && EventId == right.EventId;
+    }
+};
+
+struct SmartEventConditionKeyHash
+{
+    size_t operator()(SmartEventConditionKey const& key) const
+    {
+        return std::hash<uint64>()(uint64(uint32(key.EntryOrGuid)) << 32 | (key.SourceType << 24 ^ key.EventId));
+    }
+};
+
+typedef std::unordered_map<uint64 /*SourceType, SourceEntry*/, CompiledConditions> ConditionsByTypeAndEntryMap;
+typedef std::unordered_map<uint64 /*SourceGroup, SourceEntry*/, CompiledConditions> ConditionsByGroupAndEntryMap;
+typedef std::unordered_map<SmartEventConditionKey, CompiledConditions, SmartEventConditionKeyHash> SmartEventConditionContainer;
+typedef std::unordered_map<uint32, CompiledConditions> ConditionReferenceContainer;//only used for references
 
 class TC_GAME_API ConditionMgr
 {
@@ -247,6 +296,8 @@ class TC_GAME_API ConditionMgr
         bool IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint32 spellId, Player* player, Unit* vehicle) const;
         bool IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const;
         bool IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const;
+        // Compile conditions.Conditions, references must all be loaded
+        void CompileConditions(CompiledConditions& conditions);
 
         struct ConditionTypeInfo
         {
@@ -260,23 +311,26 @@ class TC_GAME_API ConditionMgr
 
     private:
         bool isSourceTypeValid(Condition* cond) const;
-        bool addToLootTemplate(Condition* cond, LootTemplate* loot) const;
-        bool addToGossipMenus(Condition* cond) const;
-        bool addToGossipMenuItems(Condition* cond) const;
-        bool addToSpellImplicitTargetConditions(Condition* cond) const;
+        bool addToLootTemplate(Condition* cond, LootTemplate* loot);
+        bool addToGossipMenus(Condition* cond);
+        bool addToGossipMenuItems(Condition* cond);
+        bool addToSpellImplicitTargetConditions(Condition* cond);
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
 
         static void LogUselessConditionValue(Condition* cond, uint8 index, uint32 value);
 
+        void CompileAllConditions();
         void Clean(); // free up resources
         std::vector<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
-        ConditionEntriesByTypeArray       ConditionStore;
+        ConditionsByTypeAndEntryMap       ConditionStore;
         ConditionReferenceContainer       ConditionReferenceStore;
-        ConditionEntriesByCreatureIdMap   VehicleSpellConditionStore;
-        ConditionEntriesByCreatureIdMap   SpellClickEventConditionStore;
-        ConditionEntriesByCreatureIdMap   NpcVendorConditionContainerStore;
+        ConditionsByGroupAndEntryMap      VehicleSpellConditionStore;
+        ConditionsByGroupAndEntryMap      SpellClickEventConditionStore;
+        ConditionsByGroupAndEntryMap      NpcVendorConditionContainerStore;
         SmartEventConditionContainer      SmartEventConditionStore;
+        // conditions held by loot templates, gossip menus and spell infos, filled by the addTo* functions and only kept until CompileAllConditions
+        std::vector<CompiledConditions*>  ExternalConditionStore;
 };
 
 #define sConditionMgr ConditionMgr::instance()
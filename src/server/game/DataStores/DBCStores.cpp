@@ -5,8 +5,11 @@
 #include "DBCfmt.h"
 #include "DBCFileLoader.h"
 #include "IteratorPair.h"
+#include "Timer.h"
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -163,8 +166,6 @@ DBCStorage <WorldSafeLocsEntry> sWorldSafeLocsStore(WorldSafeLocsEntryfmt);
 
 typedef std::list<std::string> StoreProblemList;
 
-uint32 DBCFileCount = 0;
-
 static bool LoadDBC_assert_print(uint32 fsize,uint32 rsize, const std::string& filename)
 {
     TC_LOG_ERROR("FIXME","ERROR: Size of '%s' setted by format string (%u) not equal size of C++ structure (%u).",filename.c_str(),fsize,rsize);
@@ -173,34 +174,73 @@ static bool LoadDBC_assert_print(uint32 fsize,uint32 rsize, const std::string& f
     return false;
 }
 
+struct DBCStoreLoad
+{
+    DBCStorageBase* Storage;
+    std::string FileName;
+    std::string CustomFormat;
+    std::string CustomIndexName;
+    uint32 Duration;
+    std::string Error;
+};
 
-template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
+// Stores don't depend on each other until the post load processing, they are all loaded first (see LoadDBCs)
+class DBCStoresLoader
 {
-    // compatibility format and C++ structure sizes
-    ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
+public:
+    explicit DBCStoresLoader(std::string const& dbcPath) : _dbcPath(dbcPath), _availableDbcLocales(0xFFFFFFFF) { }
+
+    template<class T>
+    void Add(DBCStorage<T>& storage, std::string const& filename, std::string const& customFormat = std::string(), std::string const& customIndexName = std::string())
+    {
+        // compatibility format and C++ structure sizes
+        ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
+
+        _stores.push_back({ &storage, filename, customFormat, customIndexName, 0, std::string() });
+    }
+
+    void Run(uint32 threadCount);
+    void LogReport(uint32 wallTime, uint32 threadCount) const;
+
+    uint32 GetStoreCount() const { return uint32(_stores.size()); }
+    StoreProblemList GetErrors() const;
 
-    ++DBCFileCount;
-    std::string dbcFilename = dbcPath + filename;
+private:
+    void Load(DBCStoreLoad& store);
+
+    std::string _dbcPath;
+    std::vector<DBCStoreLoad> _stores;
+    std::atomic<uint32> _availableDbcLocales;
+};
+
+void DBCStoresLoader::Load(DBCStoreLoad& store)
+{
+    uint32 const startTime = GetMSTime();
+    DBCStorageBase& storage = *store.Storage;
+    std::string dbcFilename = _dbcPath + store.FileName;
 
     if (storage.Load(dbcFilename))
     {
-        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        // without strings, localized files have nothing to provide
+        if (strchr(storage.GetFormat(), FT_STRING))
         {
-            if (!(availableDbcLocales & (1 << i)))
-                continue;
+            for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+            {
+                if (!(_availableDbcLocales & (1 << i)))
+                    continue;
 
-            std::string localizedName(dbcPath);
-            localizedName.append(localeNames[i]);
-            localizedName.push_back('/');
-            localizedName.append(filename);
+                std::string localizedName(_dbcPath);
+                localizedName.append(localeNames[i]);
+                localizedName.push_back('/');
+                localizedName.append(store.FileName);
 
-            if (!storage.LoadStringsFrom(localizedName))
-                availableDbcLocales &= ~(1 << i);             // mark as not available for speedup next checks
+                if (!storage.LoadStringsFrom(localizedName))
+                    _availableDbcLocales &= ~(1 << i);        // mark as not available for speedup next checks
+            }
         }
 
-        if (!customFormat.empty())
-            storage.LoadFromDB(filename, customFormat, customIndexName);
+        if (!store.CustomFormat.empty())
+            storage.LoadFromDB(store.FileName, store.CustomFormat, store.CustomIndexName);
     }
     else
     {
@@ -209,26 +249,82 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
         {
             std::ostringstream stream;
             stream << dbcFilename << " exists, and has " << storage.GetFieldCount() << " field(s) (expected " << strlen(storage.GetFormat()) << "). Extracted file might be from wrong client version or a database-update has been forgotten. Search on forum for TCE00008 for more info.";
-            std::string buf = stream.str();
-            errors.push_back(buf);
+            store.Error = stream.str();
             fclose(f);
         }
         else
-            errors.push_back(dbcFilename);
+            store.Error = dbcFilename;
     }
+
+    store.Duration = GetMSTimeDiffToNow(startTime);
 }
 
-void LoadDBCStores(const std::string& dataPath)
+void DBCStoresLoader::Run(uint32 threadCount)
 {
-    std::string dbcPath = dataPath+"dbc/";
+    threadCount = std::min<uint32>(std::max<uint32>(threadCount, 1), GetStoreCount());
+
+    uint32 const startTime = GetMSTime();
+    std::atomic<uint32> nextStore(0);
+    auto worker = [&]()
+    {
+        for (uint32 i = nextStore++; i < _stores.size(); i = nextStore++)
+            Load(_stores[i]);
+    };
+
+    if (threadCount <= 1)
+        worker();
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (uint32 i = 0; i < threadCount; ++i)
+            threads.emplace_back(worker);
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
 
-    const uint32 DBCFilesCount = 58;
+    LogReport(GetMSTimeDiffToNow(startTime), threadCount);
+}
+
+StoreProblemList DBCStoresLoader::GetErrors() const
+{
+    StoreProblemList errors;
+    for (DBCStoreLoad const& store : _stores)
+        if (!store.Error.empty())
+            errors.push_back(store.Error);
+    return errors;
+}
 
-    StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
+void DBCStoresLoader::LogReport(uint32 wallTime, uint32 threadCount) const
+{
+    uint64 totalTime = 0;
+    size_t heapSize = 0;
+    size_t mappedSize = 0;
+    uint32 inPlace = 0;
+    for (DBCStoreLoad const& store : _stores)
+    {
+        totalTime += store.Duration;
+        heapSize += store.Storage->GetHeapSize();
+        mappedSize += store.Storage->GetMappedSize();
+        if (store.Storage->IsInPlace())
+            ++inPlace;
+
+        TC_LOG_DEBUG("server.loading", ">>   %-36s %5u ms %8u KB heap %8u KB mapped%s", store.FileName.c_str(), store.Duration,
+            uint32(store.Storage->GetHeapSize() / 1024), uint32(store.Storage->GetMappedSize() / 1024), store.Storage->IsInPlace() ? " (in place)" : "");
+    }
 
-#define LOAD_DBC(store, file) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file)
+    TC_LOG_INFO("server.loading", ">> Loaded %u data stores on %u thread(s) in %u ms (sum of stores: " UI64FMTD " ms), %u KB heap, %u KB mapped, %u used in place",
+        GetStoreCount(), threadCount, wallTime, totalTime, uint32(heapSize / 1024), uint32(mappedSize / 1024), inPlace);
+}
 
+void LoadDBCStores(const std::string& dataPath, uint32 threadCount)
+{
+    std::string dbcPath = dataPath+"dbc/";
+
+    DBCStoresLoader loader(dbcPath);
+
+#define LOAD_DBC(store, file) loader.Add(store, file)
     LOAD_DBC(sAreaTableStore, "AreaTable.dbc");
     LOAD_DBC(sAreaTriggerStore, "AreaTrigger.dbc");
     LOAD_DBC(sAuctionHouseStore, "AuctionHouse.dbc");
@@ -237,7 +333,6 @@ void LoadDBCStores(const std::string& dataPath)
     LOAD_DBC(sCharacterFacialHairStylesStore, "CharacterFacialHairStyles.dbc");
     LOAD_DBC(sCharSectionsStore, "CharSections.dbc");
     LOAD_DBC(sCharStartOutfitStore, "CharStartOutfit.dbc");
-
     LOAD_DBC(sCharTitlesStore, "CharTitles.dbc");
     LOAD_DBC(sChatChannelsStore, "ChatChannels.dbc");
     LOAD_DBC(sChrClassesStore, "ChrClasses.dbc");
@@ -250,45 +345,18 @@ void LoadDBCStores(const std::string& dataPath)
     LOAD_DBC(sCreatureSpellDataStore, "CreatureSpellData.dbc");
     LOAD_DBC(sDurabilityCostsStore, "DurabilityCosts.dbc");
     LOAD_DBC(sDurabilityQualityStore, "DurabilityQuality.dbc");
-    
     LOAD_DBC(sEmotesStore, "Emotes.dbc");
     LOAD_DBC(sEmotesTextStore, "EmotesText.dbc");
     LOAD_DBC(sFactionStore, "Faction.dbc");
-    for (uint32 i=0;i<sFactionStore.GetNumRows(); ++i)
-    {
-        FactionEntry const * faction = sFactionStore.LookupEntry(i);
-        if (faction && faction->team)
-        {
-            SimpleFactionsList &flist = sFactionTeamMap[faction->team];
-            flist.push_back(i);
-        }
-    }
-
     LOAD_DBC(sFactionTemplateStore, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGameObjectDisplayInfoStore,  dbcPath, "GameObjectDisplayInfo.dbc");
-    for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
-    {
-        if (GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(i))
-        {
-            if (info->maxX < info->minX)
-                std::swap(*(float*)(&info->maxX), *(float*)(&info->minX));
-            if (info->maxY < info->minY)
-                std::swap(*(float*)(&info->maxY), *(float*)(&info->minY));
-            if (info->maxZ < info->minZ)
-                std::swap(*(float*)(&info->maxZ), *(float*)(&info->minZ));
-        }
-    }
+    LOAD_DBC(sGameObjectDisplayInfoStore, "GameObjectDisplayInfo.dbc");
     LOAD_DBC(sGemPropertiesStore, "GemProperties.dbc");
-
     LOAD_DBC(sGtCombatRatingsStore, "gtCombatRatings.dbc");
-
     LOAD_DBC(sGtChanceToMeleeCritBaseStore, "gtChanceToMeleeCritBase.dbc");
     LOAD_DBC(sGtChanceToMeleeCritStore, "gtChanceToMeleeCrit.dbc");
-
     LOAD_DBC(sGtChanceToSpellCritBaseStore, "gtChanceToSpellCritBase.dbc");
     LOAD_DBC(sGtChanceToSpellCritStore, "gtChanceToSpellCrit.dbc");
-    LoadDBC(availableDbcLocales,bad_dbc_files,sGtNPCManaCostScalerStore, dbcPath, "gtNPCManaCostScaler.dbc");
-
+    LOAD_DBC(sGtNPCManaCostScalerStore, "gtNPCManaCostScaler.dbc");
     LOAD_DBC(sGtOCTRegenHPStore, "gtOCTRegenHP.dbc");
     //LOAD_DBC(sGtOCTRegenMPStore, "gtOCTRegenMP.dbc");       -- not used currently
     LOAD_DBC(sGtRegenHPPerSptStore, "gtRegenHPPerSpt.dbc");
@@ -306,38 +374,17 @@ void LoadDBCStores(const std::string& dataPath)
     LOAD_DBC(sMailTemplateStore, "MailTemplate.dbc");
     LOAD_DBC(sMapStore, "Map.dbc");
 #ifdef LICH_KING
-    LOAD_DBC(sMapDifficultyStore,"MapDifficulty.dbc");
-    // fill data
-    for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
-        if (MapDifficultyEntry const* entry = sMapDifficultyStore.LookupEntry(i))
-            sMapDifficultyMap[MAKE_PAIR32(entry->MapId, entry->Difficulty)] = MapDifficulty(entry->resetTime, entry->maxPlayers, entry->areaTriggerText[0] != '\0');
-    sMapDifficultyStore.Clear();
-
+    LOAD_DBC(sMapDifficultyStore, "MapDifficulty.dbc");
     LOAD_DBC(sPvPDifficultyStore, "PvpDifficulty.dbc");
-#else
-    //fake MapDifficulty.dbc for BC 
-    //also partially handled in ObjectMgr::LoadInstanceTemplate() for instances
-    std::map<uint32, uint32> spawnMasks;
-
-    for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
-        if (MapEntry const* mapEntry = sMapStore.LookupEntry(i))
-            if (!mapEntry->Instanceable())
-                sMapDifficultyMap[MAKE_PAIR32(i, REGULAR_DIFFICULTY)] = MapDifficulty(0, 0, false);
 #endif
     LOAD_DBC(sQuestSortStore, "QuestSort.dbc");
     LOAD_DBC(sRandomPropertiesPointsStore, "RandPropPoints.dbc");
     LOAD_DBC(sSkillLineStore, "SkillLine.dbc");
     LOAD_DBC(sSkillLineAbilityStore, "SkillLineAbility.dbc");
     LOAD_DBC(sSkillRaceClassInfoStore, "SkillRaceClassInfo.dbc");
-    for (uint32 i = 0; i < sSkillRaceClassInfoStore.GetNumRows(); ++i)
-        if (SkillRaceClassInfoEntry const* entry = sSkillRaceClassInfoStore.LookupEntry(i))
-            if (sSkillLineStore.LookupEntry(entry->SkillId))
-                SkillRaceClassInfoBySkill.emplace(entry->SkillId, entry);
-
     LOAD_DBC(sSkillTiersStore, "SkillTiers.dbc");
     LOAD_DBC(sSoundEntriesStore, "SoundEntries.dbc");
     //"Spell.dbc" is now world.spell_template table
-
     LOAD_DBC(sSpellCastTimesStore, "SpellCastTimes.dbc");
     LOAD_DBC(sSpellCategoryStore, "SpellCategory.dbc");
     LOAD_DBC(sSpellDurationStore, "SpellDuration.dbc");
@@ -349,8 +396,82 @@ void LoadDBCStores(const std::string& dataPath)
     LOAD_DBC(sSpellShapeshiftStore, "SpellShapeshiftForm.dbc");
     LOAD_DBC(sStableSlotPricesStore, "StableSlotPrices.dbc");
     LOAD_DBC(sSummonPropertiesStore, "SummonProperties.dbc");
-
     LOAD_DBC(sTalentStore, "Talent.dbc");
+    LOAD_DBC(sTalentTabStore, "TalentTab.dbc");
+    LOAD_DBC(sTaxiNodesStore, "TaxiNodes.dbc");
+    LOAD_DBC(sTaxiPathStore, "TaxiPath.dbc");
+    //## TaxiPathNode.dbc ## Loaded only for initialization different structures
+    LOAD_DBC(sTaxiPathNodeStore, "TaxiPathNode.dbc");
+    LOAD_DBC(sTotemCategoryStore, "TotemCategory.dbc");
+    LOAD_DBC(sTransportAnimationStore, "TransportAnimation.dbc");
+    LOAD_DBC(sWMOAreaTableStore, "WMOAreaTable.dbc");
+    LOAD_DBC(sWorldMapAreaStore, "WorldMapArea.dbc");
+    LOAD_DBC(sWorldSafeLocsStore, "WorldSafeLocs.dbc");
+#undef LOAD_DBC
+
+    loader.Run(threadCount);
+
+    StoreProblemList bad_dbc_files = loader.GetErrors();
+
+    // error checks
+    if(bad_dbc_files.size() >= loader.GetStoreCount() )
+    {
+        TC_LOG_ERROR("server.loading","\nIncorrect DataDir value in Trinityd.conf or ALL required *.dbc files (%u) not found by path: %sdbc",loader.GetStoreCount(),dataPath.c_str());
+        exit(1);
+    }
+    else if(!bad_dbc_files.empty() )
+    {
+        std::string str;
+        for(std::list<std::string>::iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
+            str += *i + "\n";
+
+        TC_LOG_ERROR("server.loading", "\nSome required *.dbc files (" UI64FMTD " from %u) not found or not compatible : \n%s",bad_dbc_files.size(),loader.GetStoreCount(),str.c_str());
+        exit(1);
+    }
+
+    for (uint32 i=0;i<sFactionStore.GetNumRows(); ++i)
+    {
+        FactionEntry const * faction = sFactionStore.LookupEntry(i);
+        if (faction && faction->team)
+        {
+            SimpleFactionsList &flist = sFactionTeamMap[faction->team];
+            flist.push_back(i);
+        }
+    }
+
+    for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
+    {
+        if (GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(i))
+        {
+            if (info->maxX < info->minX)
+                std::swap(*(float*)(&info->maxX), *(float*)(&info->minX));
+            if (info->maxY < info->minY)
+                std::swap(*(float*)(&info->maxY), *(float*)(&info->minY));
+            if (info->maxZ < info->minZ)
+                std::swap(*(float*)(&info->maxZ), *(float*)(&info->minZ));
+        }
+    }
+
+#ifdef LICH_KING
+    // fill data
+    for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
+        if (MapDifficultyEntry const* entry = sMapDifficultyStore.LookupEntry(i))
+            sMapDifficultyMap[MAKE_PAIR32(entry->MapId, entry->Difficulty)] = MapDifficulty(entry->resetTime, entry->maxPlayers, entry->areaTriggerText[0] != '\0');
+    sMapDifficultyStore.Clear();
+#else
+    //fake MapDifficulty.dbc for BC 
+    //also partially handled in ObjectMgr::LoadInstanceTemplate() for instances
+    std::map<uint32, uint32> spawnMasks;
+
+    for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
+        if (MapEntry const* mapEntry = sMapStore.LookupEntry(i))
+            if (!mapEntry->Instanceable())
+                sMapDifficultyMap[MAKE_PAIR32(i, REGULAR_DIFFICULTY)] = MapDifficulty(0, 0, false);
+#endif
+    for (uint32 i = 0; i < sSkillRaceClassInfoStore.GetNumRows(); ++i)
+        if (SkillRaceClassInfoEntry const* entry = sSkillRaceClassInfoStore.LookupEntry(i))
+            if (sSkillLineStore.LookupEntry(entry->SkillId))
+                SkillRaceClassInfoBySkill.emplace(entry->SkillId, entry);
 
     // create talent spells set
     for (uint32 i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -362,8 +483,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i,j);
     }
 
-    LOAD_DBC(sTalentTabStore, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // fill table by amount of talent ranks and fill sTalentTabBitSizeInInspect
@@ -432,8 +551,6 @@ void LoadDBCStores(const std::string& dataPath)
     }
 #endif
 
-    LOAD_DBC(sTaxiNodesStore, "TaxiNodes.dbc");
-
     // Initialize global taxinodes mask
     sTaxiNodesMask.fill(0);
     for(uint32 i = 1; i < sTaxiNodesStore.GetNumRows(); ++i)
@@ -446,14 +563,11 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LOAD_DBC(sTaxiPathStore, "TaxiPath.dbc");
     for(uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if(TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID,entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
-    //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LOAD_DBC(sTaxiPathNodeStore, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -472,8 +586,6 @@ void LoadDBCStores(const std::string& dataPath)
         if (TaxiPathNodeEntry const* entry = sTaxiPathNodeStore.LookupEntry(i))
             sTaxiPathNodesByPath[entry->PathID][entry->NodeIndex] = entry;
 
-    LOAD_DBC(sTotemCategoryStore, "TotemCategory.dbc");
-    LOAD_DBC(sTransportAnimationStore, "TransportAnimation.dbc");
     for (uint32 i = 0; i < sTransportAnimationStore.GetNumRows(); ++i)
     {
         TransportAnimationEntry const* anim = sTransportAnimationStore.LookupEntry(i);
@@ -483,7 +595,6 @@ void LoadDBCStores(const std::string& dataPath)
         sTransportMgr->AddPathNodeToTransport(anim->TransportEntry, anim->TimeSeg, anim);
     }
 
-    LOAD_DBC(sWMOAreaTableStore, "WMOAreaTable.dbc");
     for(uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if(WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -491,8 +602,6 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple.insert(WMOAreaInfoByTripple::value_type(WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId), entry));
         }
     }
-    LOAD_DBC(sWorldMapAreaStore, "WorldMapArea.dbc");
-    LOAD_DBC(sWorldSafeLocsStore, "WorldSafeLocs.dbc");
 
     for (CharacterFacialHairStylesEntry const* entry : sCharacterFacialHairStylesStore)
         if (entry->Race && ((1 << (entry->Race - 1)) & RACEMASK_ALL_PLAYABLE) != 0) // ignore nonplayable races
@@ -505,22 +614,6 @@ void LoadDBCStores(const std::string& dataPath)
     for (CharStartOutfitEntry const* outfit : sCharStartOutfitStore)
         sCharStartOutfitMap[outfit->Race | (outfit->Class << 8) | (outfit->Gender << 16)] = outfit;
 
-    // error checks
-    if(bad_dbc_files.size() >= DBCFilesCount )
-    {
-        TC_LOG_ERROR("server.loading","\nIncorrect DataDir value in Trinityd.conf or ALL required *.dbc files (%d) not found by path: %sdbc",DBCFilesCount,dataPath.c_str());
-        exit(1);
-    }
-    else if(!bad_dbc_files.empty() )
-    {
-        std::string str;
-        for(std::list<std::string>::iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
-            str += *i + "\n";
-
-        TC_LOG_ERROR("server.loading", "\nSome required *.dbc files (" UI64FMTD " from %u) not found or not compatible : \n%s",bad_dbc_files.size(),DBCFilesCount,str.c_str());
-        exit(1);
-    }
-
     // check at up-to-date DBC files (53085 is last added spell in 2.4.3)
     // check at up-to-date DBC files (17514 is last ID in SkillLineAbilities in 2.4.3)
     // check at up-to-date DBC files (598 is last map added in 2.4.3)
@@ -538,8 +631,6 @@ void LoadDBCStores(const std::string& dataPath)
         TC_LOG_ERROR("server.loading","\nYou have _outdated_ DBC files. Please extract correct versions from current using client.");
         exit(1);
     }
-
-    TC_LOG_INFO("server.loading", ">> Loaded %d data stores", DBCFilesCount );
 }
 
 SimpleFactionsList const* GetFactionTeamList(uint32 faction)
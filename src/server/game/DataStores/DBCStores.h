@@ -139,7 +139,8 @@ TC_GAME_API extern DBCStorage <WMOAreaTableEntry>            sWMOAreaTableStore;
 //TC_GAME_API extern DBCStorage <WorldMapAreaEntry>           sWorldMapAreaStore; -- use Zone2MapCoordinates and Map2ZoneCoordinates
 TC_GAME_API extern DBCStorage <WorldSafeLocsEntry>           sWorldSafeLocsStore;
 
-void LoadDBCStores(const std::string& dataPath);
+// Independent stores are loaded on up to threadCount threads
+void LoadDBCStores(const std::string& dataPath, uint32 threadCount);
 
 // script support functions
 TC_GAME_API DBCStorage <SoundEntriesEntry>  const* GetSoundEntriesStore();
@@ -228,7 +228,10 @@ Creature::Creature(bool isWorldObject) : Unit(isWorldObject), MapObject(),
     m_boundaryCheckTime(2500), 
     _pickpocketLootRestore(0),
     m_combatPulseTime(0), 
-    m_combatPulseDelay(0)
+    m_combatPulseDelay(0),
+    m_aggroFlags(0),
+    m_aggroFlagsAI(nullptr),
+    m_aggroFlagsValid(false)
 {
     m_valuesCount = UNIT_END;
 
@@ -506,6 +509,8 @@ bool Creature::UpdateEntry(uint32 Entry, const CreatureData *data )
     if(!InitEntry(Entry,data))
         return false;
 
+    InvalidateAggroFlags();
+
     CreatureTemplate const* cInfo = GetCreatureTemplate();
     m_regenHealth = GetCreatureTemplate()->RegenHealth;
 
@@ -1062,6 +1067,7 @@ bool Creature::AIM_Initialize(CreatureAI* ai)
         return false;
  
     AI_InitializeAndEnable();
+    InvalidateAggroFlags();
     return true;
 }
 
@@ -1231,6 +1237,7 @@ Unit* Creature::SelectVictim(bool evade /*= true*/)
 void Creature::SetReactState(ReactStates st) 
 { 
     m_reactState = st; 
+    InvalidateAggroFlags();
     //sunstrider: also reset combat on passive
     switch (st)
     {
@@ -1921,6 +1928,51 @@ bool Creature::IsWithinSightDist(Unit const* u) const
 /**
 Hostile target is in stealth and in warn range
 */
+uint8 Creature::GetAggroFlags() const
+{
+    if (!IsAIEnabled || !i_AI)
+        return 0;
+
+    if (m_aggroFlagsValid && m_aggroFlagsAI == i_AI)
+        return m_aggroFlags;
+
+    m_aggroFlags = 0;
+    switch (AI()->GetMoveInLineOfSightMode())
+    {
+        case CreatureAI::MOVE_IN_LOS_SCRIPTED:
+            m_aggroFlags |= CREATURE_AGGRO_OBSERVER | CREATURE_AGGRO_ANY_UNIT;
+            break;
+        case CreatureAI::MOVE_IN_LOS_DEFAULT:
+            // early returns of CreatureAI::MoveInLineOfSight and CanAggro, the friendly check is done per target
+            if (HasReactState(REACT_AGGRESSIVE) && GetCreatureType() != CREATURE_TYPE_NON_COMBAT_PET && !IsCivilian())
+                m_aggroFlags |= CREATURE_AGGRO_OBSERVER;
+            break;
+        case CreatureAI::MOVE_IN_LOS_IGNORED:
+            break;
+    }
+
+    // static part of CanDoStealthAlert
+    if (!IsWorldBoss() && !IsTotem() && !IsCivilian() && !HasReactState(REACT_PASSIVE))
+        m_aggroFlags |= CREATURE_AGGRO_STEALTH_ALERT;
+
+    m_aggroFlagsAI = i_AI;
+    m_aggroFlagsValid = true;
+    return m_aggroFlags;
+}
+
+void Creature::InvalidateAggroFlags()
+{
+    m_aggroFlagsValid = false;
+    if (IsInWorld())
+        GetMap()->GetAggroCandidateIndex().Invalidate();
+}
+
+void Creature::SetFaction(uint32 faction)
+{
+    Unit::SetFaction(faction);
+    InvalidateAggroFlags();
+}
+
 void Creature::StartStealthAlert(Unit const* target)
 {
     m_stealthAlertCooldown = STEALTH_ALERT_COOLDOWN;
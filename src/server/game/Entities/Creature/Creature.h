@@ -4,6 +4,7 @@
 
 #include "Common.h"
 #include "Unit.h"
+#include "MapObjectAllocator.h"
 #include "ItemPrototype.h"
 #include "LootMgr.h"
 #include "CreatureGroups.h"
@@ -188,6 +189,14 @@ struct TC_GAME_API CreatureMovementData
     std::string ToString() const;
 };
 
+// What a creature may do with units moving in its sight, see Creature::GetAggroFlags
+enum CreatureAggroFlags : uint8
+{
+    CREATURE_AGGRO_OBSERVER      = 0x01, // MoveInLineOfSight may do something, to hostile or neutral units only unless CREATURE_AGGRO_ANY_UNIT is set
+    CREATURE_AGGRO_ANY_UNIT      = 0x02, // MoveInLineOfSight is scripted and may react to friendly units as well
+    CREATURE_AGGRO_STEALTH_ALERT = 0x04, // may look suspiciously at stealthed hostile players
+};
+
 static const uint32 CREATURE_REGEN_INTERVAL = 2 * SECOND * IN_MILLISECONDS;
 static const uint32 PET_FOCUS_REGEN_INTERVAL = 4 * SECOND * IN_MILLISECONDS;
 
@@ -517,6 +526,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
     friend class TestCase;
 
     public:
+        static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_CREATURE, size); }
+        static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
 
         explicit Creature(bool isWorldObject = false);
         ~Creature() override;
@@ -716,6 +727,12 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         //start lookup suspicously at target
         void StartStealthAlert(Unit const* target);
 
+        /* CreatureAggroFlags for relocation notifiers, only the parts of MoveInLineOfSight and CanDoStealthAlert that depend on this creature alone.
+        Computed when needed and kept until the AI, react state, faction or template changes. 0 while the AI is disabled. */
+        uint8 GetAggroFlags() const;
+        void InvalidateAggroFlags();
+        void SetFaction(uint32 faction) override;
+
         Unit* SelectNearestTarget(float dist = 0, bool playerOnly = false, bool furthest = false) const;
         //select nearest alive player
         Unit* SelectNearestTargetInAttackDistance(float dist) const;
@@ -994,6 +1011,10 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         float m_suppressedOrientation; // Stores the creature's "real" orientation while casting
 
         CreatureTextRepeatGroup m_textRepeat;
+
+        mutable uint8 m_aggroFlags;
+        mutable UnitAI const* m_aggroFlagsAI; // AI the flags were computed for, charm and possess swap it
+        mutable bool m_aggroFlagsValid;
 };
 
 class TC_GAME_API AssistDelayEvent : public BasicEvent
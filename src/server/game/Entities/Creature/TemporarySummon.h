@@ -7,6 +7,9 @@
 class TC_GAME_API TempSummon : public Creature
 {
 public:
+    static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_TEMPSUMMON, size); }
+    static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
     explicit TempSummon(SummonPropertiesEntry const* properties, Unit* owner, bool isWorldObject);
 	~TempSummon() {};
     void Update(uint32 time) override;
@@ -3,6 +3,7 @@
 #define TRINITYCORE_DYNAMICOBJECT_H
 
 #include "Object.h"
+#include "MapObjectAllocator.h"
 
 class Unit;
 
@@ -16,6 +17,9 @@ enum DynamicObjectType
 class TC_GAME_API DynamicObject : public WorldObject, public GridObject<DynamicObject>, public MapObject
 {
     public:
+        static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size); }
+        static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
         typedef std::set<ObjectGuid> AffectedSet;
         explicit DynamicObject(bool isWorldObject);
 		~DynamicObject();
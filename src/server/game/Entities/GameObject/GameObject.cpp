@@ -1109,6 +1109,8 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable);
+    if (IsInWorld())
+        GetMap()->InvalidateDynamicLineOfSight(*m_model);
 }
 
 void GameObject::UpdateModel()
@@ -5,6 +5,7 @@
 #include "Common.h"
 #include "SharedDefines.h"
 #include "Object.h"
+#include "MapObjectAllocator.h"
 #include "LootMgr.h"
 #include "Database/DatabaseEnv.h"
 #include "GameObjectAI.h"
@@ -469,6 +470,9 @@ class GameObjectModel;
 class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>, public MapObject
 {
     public:
+        static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_GAMEOBJECT, size); }
+        static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
         explicit GameObject();
         ~GameObject() override;
 
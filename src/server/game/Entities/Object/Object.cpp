@@ -1156,22 +1156,77 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if(IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        
-        return GetMap()->isInLineOfSight(x, y, z + 2.0f, ox, oy, oz + 2.0f, GetPhaseMask(), checks, ignoreFlags);
+        Position start, end;
+        GetLOSSegmentTo(ox, oy, oz, start, end);
+        return GetMap()->isInLineOfSight(start.GetPositionX(), start.GetPositionY(), start.GetPositionZ(), end.GetPositionX(), end.GetPositionY(), end.GetPositionZ(), GetPhaseMask(), checks, ignoreFlags);
    }
     
     return true;
 }
 
+void WorldObject::GetLOSSegmentTo(float ox, float oy, float oz, Position& start, Position& end) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+
+    start.Relocate(x, y, z + 2.0f);
+    end.Relocate(ox, oy, oz + 2.0f);
+}
+
+/*static*/ void WorldObject::AreWithinLOS(WorldObject const* const* objects, uint32 count, float x, float y, float z, bool* results, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags)
+{
+    std::fill(results, results + count, true);
+
+    // the dynamic tree filters by phase, so batch the objects sharing the phase mask of the first one in world
+    std::vector<G3D::Vector3> startPos, endPos;
+    std::vector<uint32> batched;
+    startPos.reserve(count);
+    endPos.reserve(count);
+    batched.reserve(count);
+    Map const* map = nullptr;
+    uint32 phaseMask = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        WorldObject const* object = objects[i];
+        if (!object->IsInWorld())
+            continue;
+
+        if (!map)
+        {
+            map = object->GetMap();
+            phaseMask = object->GetPhaseMask();
+        }
+
+        if (object->GetPhaseMask() != phaseMask)
+        {
+            results[i] = object->IsWithinLOS(x, y, z, checks, ignoreFlags);
+            continue;
+        }
+
+        ASSERT(object->GetMap() == map);
+        Position start, end;
+        object->GetLOSSegmentTo(x, y, z, start, end);
+        startPos.emplace_back(start.GetPositionX(), start.GetPositionY(), start.GetPositionZ());
+        endPos.emplace_back(end.GetPositionX(), end.GetPositionY(), end.GetPositionZ());
+        batched.push_back(i);
+    }
+
+    if (batched.empty())
+        return;
+
+    std::unique_ptr<bool[]> batchResults(new bool[batched.size()]);
+    map->isInLineOfSight(startPos.data(), endPos.data(), uint32(batched.size()), batchResults.get(), phaseMask, checks, ignoreFlags);
+    for (size_t i = 0; i < batched.size(); ++i)
+        results[batched[i]] = batchResults[i];
+}
+
 Position WorldObject::GetHitSpherePointFor(Position const& dest) const
 {
     G3D::Vector3 vThis(GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight());
@@ -14,6 +14,7 @@
 #include "Unit.h"
 #include "Util.h"
 #include "Creature.h"
+#include "PetCache.h"
 #include "PetDefines.h"
 #include "SpellHistory.h"
 
@@ -137,40 +138,37 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     uint32 ownerid = owner->GetGUID().GetCounter();
     Unit* target = nullptr;
 
-    QueryResult result;
-
+    PetCache& petCache = owner->GetPetCache();
+    PetCacheEntry const* cachedPet;
     if(petnumber)
-        // known petnumber entry                  0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND id = '%u'",ownerid, petnumber);
+        // known petnumber entry
+        cachedPet = petCache.GetByNumber(petnumber);
     else if(current)
-        // current pet (slot 0)                   0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND slot = '%u'", ownerid, PET_SAVE_AS_CURRENT);
-    else if(petentry)
-        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND entry = '%u' AND (slot = '%u' OR slot > '%u') ", ownerid, petentry, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT );
+        // current pet (slot 0)
+        cachedPet = petCache.GetCurrent();
     else
-        // any current or other non-stabled pet (for hunter "call pet")
-        //                                        0   1      2      3        4      5    6           7              8        9           10    11    12       13         14       15            16      17              18        19                 20                 21              22
-        result = CharacterDatabase.PQuery("SELECT id, entry, owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u') ",ownerid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
+        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
+        // or any current or other non-stabled pet (for hunter "call pet")
+        cachedPet = petCache.GetUnslotted(petentry);
 
-    if (!result)
+    if (!cachedPet)
     {
         m_loading = false;
         return false;
     }
 
-    Field *fields = result->Fetch();
+    // the cache may change while the pet is added to the map, when the previous pet is saved
+    PetCacheEntry const petData = *cachedPet;
 
     // update for case of current pet "slot = 0"
-    petentry = fields[1].GetUInt32();
+    petentry = petData.Entry;
     if(!petentry)
     {
         m_loading = false;
         return false;
     }
 
-    uint32 summon_spell_id = fields[21].GetUInt32();
+    uint32 summon_spell_id = petData.CreatedBySpell;
     SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(summon_spell_id);
 
     bool isTemporarySummon = spellInfo && spellInfo->GetDuration() > 0;
@@ -184,7 +182,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     Map *map = owner->GetMap();
     ObjectGuid::LowType guid = map->GenerateLowGuid<HighGuid::Pet>();
-    uint32 pet_number = fields[0].GetUInt32();
+    uint32 pet_number = petData.PetNumber;
     if(!Create(guid, map, owner->GetPhaseMask(), petentry, pet_number))
     {
         m_loading = false;
@@ -226,7 +224,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         return false;
     }
 
-    setPetType(PetType(fields[22].GetUInt8()));
+    setPetType(PetType(petData.Type));
     SetUInt32Value(UNIT_FIELD_FACTIONTEMPLATE,owner->GetFaction());
     SetUInt32Value(UNIT_CREATED_BY_SPELL, summon_spell_id);
 
@@ -252,11 +250,11 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     m_charmInfo->SetPetNumber(pet_number, IsPermanentPetFor(owner));
 
-    SetDisplayId(fields[3].GetUInt32());
-    SetNativeDisplayId(fields[3].GetUInt32());
-    uint32 petlevel = fields[4].GetUInt8();
+    SetDisplayId(petData.ModelId);
+    SetNativeDisplayId(petData.ModelId);
+    uint32 petlevel = petData.Level;
     SetUInt32Value(UNIT_NPC_FLAGS , UNIT_NPC_FLAG_NONE);
-    SetName(fields[11].GetString());
+    SetName(petData.Name);
 
     switch(getPetType())
     {
@@ -270,17 +268,17 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         case HUNTER_PET:
             SetByteValue(UNIT_FIELD_BYTES_0, UNIT_BYTES_0_OFFSET_CLASS, CLASS_WARRIOR);
             SetByteValue(UNIT_FIELD_BYTES_0, UNIT_BYTES_0_OFFSET_GENDER, GENDER_NONE);
-            SetByteValue(UNIT_FIELD_BYTES_1, UNIT_BYTES_1_OFFSET_PET_LOYALTY, fields[8].GetUInt32());
+            SetByteValue(UNIT_FIELD_BYTES_1, UNIT_BYTES_1_OFFSET_PET_LOYALTY, petData.Loyalty);
             SetSheath(SHEATH_STATE_MELEE);
             SetByteValue(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_1_UNK, UNIT_BYTE2_FLAG_UNK3);
 
-            SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, fields[12].GetBool() ? UNIT_RENAME_NOT_ALLOWED : UNIT_RENAME_ALLOWED);
+            SetByteFlag(UNIT_FIELD_BYTES_2, UNIT_BYTES_2_OFFSET_PET_FLAGS, petData.Renamed ? UNIT_RENAME_NOT_ALLOWED : UNIT_RENAME_ALLOWED);
 
             SetUInt32Value(UNIT_FIELD_FLAGS, UNIT_FLAG_PLAYER_CONTROLLED);
                                                             // this enables popup window (pet abandon, cancel)
-            SetTP(fields[9].GetInt32());
+            SetTP(petData.TrainingPoints);
             SetMaxPower(POWER_HAPPINESS,GetCreatePowers(POWER_HAPPINESS));
-            SetPower(   POWER_HAPPINESS,fields[15].GetUInt32());
+            SetPower(   POWER_HAPPINESS,petData.Happiness);
             SetPowerType(POWER_FOCUS);
             break;
         default:
@@ -291,7 +289,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     SetCreatorGUID(owner->GetGUID());
 
     InitStatsForLevel(petlevel);
-    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, fields[5].GetUInt32());
+    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, petData.Experience);
 
     SynchronizeLevelWithOwner();
 #ifdef LICH_KING
@@ -309,16 +307,19 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     }
 #endif
 
-    SetReactState( ReactStates( fields[6].GetUInt8() ));
-    m_loyaltyPoints = fields[7].GetInt32();
+    SetReactState( ReactStates( petData.ReactState ));
+    m_loyaltyPoints = petData.LoyaltyPoints;
 
     // set current pet as current
-    if(fields[10].GetUInt8() != 0)
+    if(petData.Slot != PET_SAVE_AS_CURRENT)
     {
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
         trans->PAppend("UPDATE character_pet SET slot = '%u' WHERE owner = '%u' AND slot = '0' AND id <> '%u'", PET_SAVE_NOT_IN_SLOT, ownerid, m_charmInfo->GetPetNumber());
         trans->PAppend("UPDATE character_pet SET slot = '%u' WHERE owner = '%u' AND id = '%u'", PET_SAVE_AS_CURRENT, ownerid, m_charmInfo->GetPetNumber());
         CharacterDatabase.CommitTransaction(trans);
+
+        petCache.MoveSlot(PET_SAVE_AS_CURRENT, PET_SAVE_NOT_IN_SLOT, pet_number);
+        petCache.GetByNumber(pet_number)->Slot = PET_SAVE_AS_CURRENT;
     }
 
     //load spells/cooldowns/auras
@@ -326,8 +327,8 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     AIM_Initialize();
 
-    uint32 savedhealth = fields[13].GetUInt32();
-    uint32 savedmana = fields[14].GetUInt32();
+    uint32 savedhealth = petData.Health;
+    uint32 savedmana = petData.Mana;
 
     if(getPetType() == SUMMON_PET && !current)              //all (?) summon pets come with full health when called, but not when they are current
     {
@@ -349,23 +350,23 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     map->AddToMap(this->ToCreature(), true);
 
     // Spells should be loaded after pet is added to map, because in CanCast is check on it
-    _LoadSpells();
-    _LoadSpellCooldowns();
+    _LoadSpells(petData);
+    _LoadSpellCooldowns(petData);
 
     // since last save (in seconds)
-    uint32 timediff = (time(nullptr) - fields[18].GetUInt32());
-    _LoadAuras(timediff); //sunstrider: special pet handling in there, we don't load aura saved too long ago since last dismiss
+    uint32 timediff = (time(nullptr) - petData.SaveTime);
+    _LoadAuras(petData, timediff); //sunstrider: special pet handling in there, we don't load aura saved too long ago since last dismiss
 
     if (!isTemporarySummon)
     {
-        m_charmInfo->LoadPetActionBar(fields[16].GetString());
+        m_charmInfo->LoadPetActionBar(petData.ActionBar);
 
-        _LoadSpells();
+        _LoadSpells(petData);
 #ifdef LICH_KING
         InitTalentForLevel();                               // re-init to check talent count
 #else
         //init teach spells
-        Tokens tokens = StrSplit(fields[17].GetString(), " ");
+        Tokens tokens = StrSplit(petData.TeachSpells, " ");
         Tokens::iterator iter;
         int index;
         for (iter = tokens.begin(), index = 0; index < 4; ++iter, ++index)
@@ -404,19 +405,12 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     //Declined names
     if(owner->GetTypeId() == TYPEID_PLAYER && getPetType() == HUNTER_PET)
     {
-        result = CharacterDatabase.PQuery("SELECT genitive, dative, accusative, instrumental, prepositional FROM character_pet_declinedname WHERE owner = '%u' AND id = '%u'", owner->GetGUID().GetCounter(), GetCharmInfo()->GetPetNumber());
-
-        if(result)
+        if(petData.HasDeclinedNames)
         {
             if(m_declinedname)
                 delete m_declinedname;
 
-            m_declinedname = new DeclinedName;
-            Field* _fields = result->Fetch();
-            for(int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
-            {
-                m_declinedname->name[i] = _fields[i].GetString();
-            }
+            m_declinedname = new DeclinedName(petData.DeclinedNames);
         }
     }
     
@@ -483,11 +477,18 @@ void Pet::SavePetToDB(PetSaveMode mode)
     if((mode != PET_SAVE_AS_CURRENT && mode != PET_SAVE_NOT_IN_SLOT) || !IsAlive())
         RemoveAllAuras();
 
+    // keep the owner pet cache in sync with what is written, summon pets auras and declined names are not rewritten here
+    PetCache& petCache = GetOwner()->GetPetCache();
+    std::unique_ptr<PetCacheEntry> petData = std::make_unique<PetCacheEntry>();
+    if (PetCacheEntry const* cachedPet = petCache.GetByNumber(m_charmInfo->GetPetNumber()))
+        *petData = *cachedPet;
+
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
-    _SaveSpells(trans);
+    _SaveSpells(trans, *petData);
     GetSpellHistory()->SaveToDB<Pet>(trans);
+    _SaveSpellCooldowns(*petData);
     if(getPetType() == HUNTER_PET)
-        _SaveAuras(trans);
+        _SaveAuras(trans, *petData);
 
     if (mode >= PET_SAVE_AS_CURRENT) //every mode but PET_SAVE_AS_DELETED
     {
@@ -499,55 +500,87 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
         // prevent duplicate using slot (except PET_SAVE_NOT_IN_SLOT)
         if(mode!=PET_SAVE_NOT_IN_SLOT)
+        {
             trans->PAppend("UPDATE character_pet SET slot = 3 WHERE owner = '%u' AND slot = '%u'", owner, uint32(mode) );
+            petCache.MoveSlot(uint8(mode), 3, m_charmInfo->GetPetNumber());
+        }
 
         // prevent existence another hunter pet in PET_SAVE_AS_CURRENT and PET_SAVE_NOT_IN_SLOT
         if(getPetType()==HUNTER_PET && (mode==PET_SAVE_AS_CURRENT||mode==PET_SAVE_NOT_IN_SLOT))
+        {
             trans->PAppend("DELETE FROM character_pet WHERE owner = '%u' AND (slot = '%u' OR slot > '%u')", owner, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT );
-        // save pet
-        std::ostringstream ss;
-        ss << "INSERT INTO character_pet ( id, entry,  owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType) "
-            << "VALUES ("
-            << m_charmInfo->GetPetNumber() << ", "
-            << GetEntry() << ", "
-            << owner << ", "
-            << GetNativeDisplayId() << ", "
-            << GetLevel() << ", "
-            << GetUInt32Value(UNIT_FIELD_PETEXPERIENCE) << ", "
-            << uint32(GetReactState()) << ", "
-            << m_loyaltyPoints << ", "
-            << GetLoyaltyLevel() << ", "
-            << m_TrainingPoints << ", "
-            << uint32(mode) << ", '"
-            << name.c_str() << "', "
-            << uint32((GetByteValue(UNIT_FIELD_BYTES_2, 2) == UNIT_RENAME_ALLOWED) ? 0 : 1) << ", "
-            << curhealth << ", "
-            << curmana << ", "
-            << GetPower(POWER_HAPPINESS) << ", "
-            << "'" << GenerateActionBarData() << "', '";
-        
+            petCache.RemoveUnslotted();
+        }
+
         //save spells the pet can teach to it's Master
+        std::ostringstream teachSpells;
         {
             int i = 0;
             for(auto itr = m_teachspells.begin(); i < 4 && itr != m_teachspells.end(); ++i, ++itr)
-                ss << itr->first << " " << itr->second << " ";
+                teachSpells << itr->first << " " << itr->second << " ";
             for(; i < 4; ++i)
-                ss << uint32(0) << " " << uint32(0) << " ";
+                teachSpells << uint32(0) << " " << uint32(0) << " ";
         }
 
-        ss  << "', "
-            << time(nullptr) << ", "
-            << uint32(m_resetTalentsCost) << ", "
-            << uint64(m_resetTalentsTime) << ", "
-            << GetUInt32Value(UNIT_CREATED_BY_SPELL) << ", "
-            << uint32(getPetType()) << ")";
+        petData->PetNumber = m_charmInfo->GetPetNumber();
+        petData->Entry = GetEntry();
+        petData->ModelId = GetNativeDisplayId();
+        petData->Level = GetLevel();
+        petData->Experience = GetUInt32Value(UNIT_FIELD_PETEXPERIENCE);
+        petData->ReactState = uint8(GetReactState());
+        petData->LoyaltyPoints = m_loyaltyPoints;
+        petData->Loyalty = GetLoyaltyLevel();
+        petData->TrainingPoints = m_TrainingPoints;
+        petData->Slot = uint8(mode);
+        petData->Name = m_name;
+        petData->Renamed = GetByteValue(UNIT_FIELD_BYTES_2, 2) != UNIT_RENAME_ALLOWED;
+        petData->Health = curhealth;
+        petData->Mana = curmana;
+        petData->Happiness = GetPower(POWER_HAPPINESS);
+        petData->ActionBar = GenerateActionBarData();
+        petData->TeachSpells = teachSpells.str();
+        petData->SaveTime = uint32(time(nullptr));
+        petData->ResetTalentsCost = m_resetTalentsCost;
+        petData->ResetTalentsTime = uint64(m_resetTalentsTime);
+        petData->CreatedBySpell = GetUInt32Value(UNIT_CREATED_BY_SPELL);
+        petData->Type = uint8(getPetType());
+
+        // save pet
+        std::ostringstream ss;
+        ss << "INSERT INTO character_pet ( id, entry,  owner, modelid, level, exp, Reactstate, loyaltypoints, loyalty, trainpoint, slot, name, renamed, curhealth, curmana, curhappiness, abdata, TeachSpelldata, savetime, resettalents_cost, resettalents_time, CreatedBySpell, PetType) "
+            << "VALUES ("
+            << petData->PetNumber << ", "
+            << petData->Entry << ", "
+            << owner << ", "
+            << petData->ModelId << ", "
+            << uint32(petData->Level) << ", "
+            << petData->Experience << ", "
+            << uint32(petData->ReactState) << ", "
+            << petData->LoyaltyPoints << ", "
+            << petData->Loyalty << ", "
+            << petData->TrainingPoints << ", "
+            << uint32(petData->Slot) << ", '"
+            << name.c_str() << "', "
+            << uint32(petData->Renamed ? 1 : 0) << ", "
+            << petData->Health << ", "
+            << petData->Mana << ", "
+            << petData->Happiness << ", "
+            << "'" << petData->ActionBar << "', '"
+            << petData->TeachSpells << "', "
+            << petData->SaveTime << ", "
+            << petData->ResetTalentsCost << ", "
+            << petData->ResetTalentsTime << ", "
+            << petData->CreatedBySpell << ", "
+            << uint32(petData->Type) << ")";
 
         trans->Append( ss.str().c_str() );
 
         CharacterDatabase.CommitTransaction(trans);
+        petCache.Store(std::move(petData));
     } else { // PET_SAVE_AS_DELETED
         RemoveAllAuras();
         DeleteFromDB(m_charmInfo->GetPetNumber());
+        petCache.Remove(m_charmInfo->GetPetNumber());
     }
 }
 
@@ -1389,35 +1422,42 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel)
         return 0;                                           //food too low level
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(PetCacheEntry const& petData)
 {
     if (GetEntry() == 510) // Don't load cooldowns for mage water elem
         return;
-    
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_SPELL_COOLDOWN);
-    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
-    PreparedQueryResult cooldownsResult = CharacterDatabase.Query(stmt);
 
-    GetSpellHistory()->LoadFromDB<Pet>(cooldownsResult);
+    time_t const now = time(nullptr);
+    for (PetCacheEntry::Cooldown const& cooldown : petData.Cooldowns)
+    {
+        if (cooldown.CooldownEnd <= now || !sSpellMgr->GetSpellInfo(cooldown.SpellId))
+            continue;
+
+        GetSpellHistory()->AddCooldown(cooldown.SpellId, 0, SpellHistory::Clock::from_time_t(cooldown.CooldownEnd), cooldown.CategoryId, SpellHistory::Clock::from_time_t(cooldown.CategoryEnd));
+    }
 }
 
-void Pet::_LoadSpells()
+void Pet::_SaveSpellCooldowns(PetCacheEntry& petData) const
 {
-    QueryResult result = CharacterDatabase.PQuery("SELECT spell, slot, active FROM pet_spell WHERE guid = '%u'",m_charmInfo->GetPetNumber());
-
-    if(result)
+    // same cooldowns as SpellHistory::SaveToDB<Pet>
+    petData.Cooldowns.clear();
+    for (auto const& cooldown : GetSpellHistory()->GetSpellCooldowns())
     {
-        do
-        {
-            Field *fields = result->Fetch();
+        if (cooldown.second.OnHold)
+            continue;
 
-            AddSpell(fields[0].GetUInt32(), ActiveStates(fields[2].GetUInt16()), PETSPELL_UNCHANGED);
-        }
-        while( result->NextRow() );
+        petData.Cooldowns.push_back({ cooldown.first, SpellHistory::Clock::to_time_t(cooldown.second.CooldownEnd),
+            cooldown.second.CategoryId, SpellHistory::Clock::to_time_t(cooldown.second.CategoryEnd) });
     }
 }
 
-void Pet::_SaveSpells(SQLTransaction& trans)
+void Pet::_LoadSpells(PetCacheEntry const& petData)
+{
+    for (PetCacheEntry::Spell const& spell : petData.Spells)
+        AddSpell(spell.SpellId, ActiveStates(spell.Active), PETSPELL_UNCHANGED);
+}
+
+void Pet::_SaveSpells(SQLTransaction& trans, PetCacheEntry& petData)
 {
     for (PetSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end(); itr = next)
     {
@@ -1446,9 +1486,14 @@ void Pet::_SaveSpells(SQLTransaction& trans)
         }
         itr->second.state = PETSPELL_UNCHANGED;
     }
+
+    petData.Spells.clear();
+    for (PetSpellMap::const_iterator itr = m_spells.begin(); itr != m_spells.end(); ++itr)
+        if (itr->second.type != PETSPELL_FAMILY)
+            petData.Spells.push_back({ itr->first, itr->second.active });
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(PetCacheEntry const& petData, uint32 timediff)
 {
     for (auto & m_modAura : m_modAuras)
         m_modAura.clear();
@@ -1457,88 +1502,81 @@ void Pet::_LoadAuras(uint32 timediff)
     for(int i = UNIT_FIELD_AURA; i <= UNIT_FIELD_AURASTATE; ++i)
         SetUInt32Value(i, 0);
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_PET_AURA);
-    stmt->setUInt32(0, m_charmInfo->GetPetNumber());
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
+    for (PetCacheEntry::Aura const& savedAura : petData.Auras)
+    {
+        int32 damage[3];
+        int32 baseDamage[3];
+        ObjectGuid caster_guid(savedAura.CasterGuid);
+        // NULL guid stored - pet is the caster of the spell - see Pet::_SaveAuras
+        if (!caster_guid)
+            caster_guid = GetGUID();
+        uint32 spellid = savedAura.SpellId;
+        uint8 effmask = savedAura.EffectMask;
+        uint8 recalculatemask = savedAura.RecalculateMask;
+        uint8 stackcount = savedAura.StackCount;
+        damage[0] = savedAura.Amount[0];
+        damage[1] = savedAura.Amount[1];
+        damage[2] = savedAura.Amount[2];
+        baseDamage[0] = savedAura.BaseAmount[0];
+        baseDamage[1] = savedAura.BaseAmount[1];
+        baseDamage[2] = savedAura.BaseAmount[2];
+        int32 maxduration = savedAura.MaxDuration;
+        int32 remaintime = savedAura.RemainTime;
+        uint8 remaincharges = savedAura.RemainCharges;
+        float critChance = savedAura.CritChance;
+        bool applyResilience = savedAura.ApplyResilience;
+
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
+        if (!spellInfo)
+        {
+            TC_LOG_ERROR("entities.pet", "Unknown aura (spellid %u), ignore.", spellid);
+            continue;
+        }
 
-    if (result)
-    {
-        do
+        // negative effects should continue counting down after logout
+        if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_EXPIRE_OFFLINE)))
         {
-            int32 damage[3];
-            int32 baseDamage[3];
-            Field* fields = result->Fetch();
-            ObjectGuid caster_guid(fields[0].GetUInt64());
-            // NULL guid stored - pet is the caster of the spell - see Pet::_SaveAuras
-            if (!caster_guid)
-                caster_guid = GetGUID();
-            uint32 spellid = fields[1].GetUInt32();
-            uint8 effmask = fields[2].GetUInt8();
-            uint8 recalculatemask = fields[3].GetUInt8();
-            uint8 stackcount = fields[4].GetUInt8();
-            damage[0] = fields[5].GetInt32();
-            damage[1] = fields[6].GetInt32();
-            damage[2] = fields[7].GetInt32();
-            baseDamage[0] = fields[8].GetInt32();
-            baseDamage[1] = fields[9].GetInt32();
-            baseDamage[2] = fields[10].GetInt32();
-            int32 maxduration = fields[11].GetInt32();
-            int32 remaintime = fields[12].GetInt32();
-            uint8 remaincharges = fields[13].GetUInt8();
-            float critChance = fields[14].GetFloat();
-            bool applyResilience = fields[15].GetBool();
-
-            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
-            if (!spellInfo)
-            {
-                TC_LOG_ERROR("entities.pet", "Unknown aura (spellid %u), ignore.", spellid);
+            if (remaintime / IN_MILLISECONDS <= int32(timediff))
                 continue;
-            }
-
-            // negative effects should continue counting down after logout
-            if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_EXPIRE_OFFLINE)))
-            {
-                if (remaintime / IN_MILLISECONDS <= int32(timediff))
-                    continue;
 
-                remaintime -= timediff * IN_MILLISECONDS;
-            }
+            remaintime -= timediff * IN_MILLISECONDS;
+        }
 
-            // prevent wrong values of remaincharges
-            if (spellInfo->ProcCharges)
-            {
-                if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
-                    remaincharges = spellInfo->ProcCharges;
-            }
-            else
-                remaincharges = 0;
+        // prevent wrong values of remaincharges
+        if (spellInfo->ProcCharges)
+        {
+            if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
+                remaincharges = spellInfo->ProcCharges;
+        }
+        else
+            remaincharges = 0;
 
-            AuraCreateInfo createInfo(spellInfo, effmask, this);
-            createInfo
-                .SetCasterGUID(caster_guid)
-                .SetBaseAmount(baseDamage);
+        AuraCreateInfo createInfo(spellInfo, effmask, this);
+        createInfo
+            .SetCasterGUID(caster_guid)
+            .SetBaseAmount(baseDamage);
 
-            if (Aura* aura = Aura::TryCreate(createInfo))
+        if (Aura* aura = Aura::TryCreate(createInfo))
+        {
+            if (!aura->CanBeSaved())
             {
-                if (!aura->CanBeSaved())
-                {
-                    aura->Remove();
-                    continue;
-                }
-                aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, critChance, applyResilience, &damage[0]);
-                aura->ApplyForTargets();
-                TC_LOG_DEBUG("entities.pet", "Added aura spellid %u, effectmask %u", spellInfo->Id, effmask);
+                aura->Remove();
+                continue;
             }
-        } while (result->NextRow());
+            aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, critChance, applyResilience, &damage[0]);
+            aura->ApplyForTargets();
+            TC_LOG_DEBUG("entities.pet", "Added aura spellid %u, effectmask %u", spellInfo->Id, effmask);
+        }
     }
 }
 
-void Pet::_SaveAuras(SQLTransaction& trans)
+void Pet::_SaveAuras(SQLTransaction& trans, PetCacheEntry& petData)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_AURAS);
     stmt->setUInt32(0, m_charmInfo->GetPetNumber());
     trans->Append(stmt);
 
+    petData.Auras.clear();
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         // windrunner: skip all auras from spell that apply at cast SPELL_AURA_MOD_SHAPESHIFT or pet area auras.
@@ -1556,50 +1594,57 @@ void Pet::_SaveAuras(SQLTransaction& trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        PetCacheEntry::Aura savedAura;
+        savedAura.EffectMask = 0;
+        savedAura.RecalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (aura->GetEffect(i))
             {
-                baseDamage[i] = aura->GetEffect(i)->GetBaseAmount();
-                damage[i] = aura->GetEffect(i)->GetAmount();
-                effMask |= (1 << i);
+                savedAura.BaseAmount[i] = aura->GetEffect(i)->GetBaseAmount();
+                savedAura.Amount[i] = aura->GetEffect(i)->GetAmount();
+                savedAura.EffectMask |= (1 << i);
                 if (aura->GetEffect(i)->CanBeRecalculated())
-                    recalculateMask |= (1 << i);
+                    savedAura.RecalculateMask |= (1 << i);
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                savedAura.BaseAmount[i] = 0;
+                savedAura.Amount[i] = 0;
             }
         }
 
         // don't save guid of caster in case we are caster of the spell - guid for pet is generated every pet load, so it won't match saved guid anyways
-        ObjectGuid casterGUID = (itr->second->GetCasterGUID() == GetGUID()) ? ObjectGuid::Empty : itr->second->GetCasterGUID();
+        savedAura.CasterGuid = (aura->GetCasterGUID() == GetGUID()) ? 0 : aura->GetCasterGUID().GetRawValue();
+        savedAura.SpellId = aura->GetId();
+        savedAura.StackCount = aura->GetStackAmount();
+        savedAura.MaxDuration = aura->GetMaxDuration();
+        savedAura.RemainTime = aura->GetDuration();
+        savedAura.RemainCharges = aura->GetCharges();
+        savedAura.CritChance = aura->GetCritChance();
+        savedAura.ApplyResilience = aura->CanApplyResilience();
+        petData.Auras.push_back(savedAura);
 
         uint8 index = 0;
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PET_AURA);
         stmt->setUInt32(index++, m_charmInfo->GetPetNumber());
-        stmt->setUInt64(index++, casterGUID.GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setFloat(index++, itr->second->GetCritChance());
-        stmt->setBool(index++, itr->second->CanApplyResilience());
+        stmt->setUInt64(index++, savedAura.CasterGuid);
+        stmt->setUInt32(index++, savedAura.SpellId);
+        stmt->setUInt8(index++, savedAura.EffectMask);
+        stmt->setUInt8(index++, savedAura.RecalculateMask);
+        stmt->setUInt8(index++, savedAura.StackCount);
+        stmt->setInt32(index++, savedAura.Amount[0]);
+        stmt->setInt32(index++, savedAura.Amount[1]);
+        stmt->setInt32(index++, savedAura.Amount[2]);
+        stmt->setInt32(index++, savedAura.BaseAmount[0]);
+        stmt->setInt32(index++, savedAura.BaseAmount[1]);
+        stmt->setInt32(index++, savedAura.BaseAmount[2]);
+        stmt->setInt32(index++, savedAura.MaxDuration);
+        stmt->setInt32(index++, savedAura.RemainTime);
+        stmt->setUInt8(index++, savedAura.RemainCharges);
+        stmt->setFloat(index++, savedAura.CritChance);
+        stmt->setBool(index++, savedAura.ApplyResilience);
 
         trans->Append(stmt);
     }
@@ -1615,6 +1660,8 @@ bool Pet::AddSpell(uint32 spellId, ActiveStates active /*= ACT_DECIDE*/, PetSpel
         {
             TC_LOG_ERROR("entities.pet","Pet::addSpell: Non-existed in SpellStore spell #%u request, deleting for all pets in `pet_spell`.", spellId);
             CharacterDatabase.PExecute("DELETE FROM pet_spell WHERE spell = '%u'", spellId);
+            if (Player* owner = GetOwner())
+                owner->GetPetCache().RemoveSpell(spellId);
         }
         else
             TC_LOG_ERROR("entities.pet","Pet::addSpell: Non-existed in SpellStore spell #%u request.", spellId);
@@ -15,7 +15,7 @@ typedef std::map<uint32, uint32> TeachSpellMap;
 typedef std::vector<uint32> AutoSpellList;
 
 class Player;
-
+struct PetCacheEntry;
 
 class TC_GAME_API Pet : public Guardian
 {
@@ -90,11 +90,12 @@ class TC_GAME_API Pet : public Guardian
         void CastPetAuras(bool current);
         void CastPetAura(PetAura const* aura);
 
-        void _LoadSpellCooldowns();
-        void _LoadAuras(uint32 timediff);
-        void _SaveAuras(SQLTransaction& trans);
-        void _LoadSpells();
-        void _SaveSpells(SQLTransaction& trans);
+        void _LoadSpellCooldowns(PetCacheEntry const& petData);
+        void _SaveSpellCooldowns(PetCacheEntry& petData) const;
+        void _LoadAuras(PetCacheEntry const& petData, uint32 timediff);
+        void _SaveAuras(SQLTransaction& trans, PetCacheEntry& petData);
+        void _LoadSpells(PetCacheEntry const& petData);
+        void _SaveSpells(SQLTransaction& trans, PetCacheEntry& petData);
 
         bool AddSpell(uint32 spell_id, ActiveStates active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
         bool LearnSpell(uint32 spell_id);
@@ -0,0 +1,241 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PetCache.h"
+#include "DatabaseEnv.h"
+#include <algorithm>
+
+namespace
+{
+    bool IsUnslotted(uint8 slot)
+    {
+        return slot == PET_SAVE_AS_CURRENT || slot > PET_SAVE_LAST_STABLE_SLOT;
+    }
+
+    std::vector<PetCacheEntry const*> SortedBySlot(std::vector<PetCacheEntry const*> pets)
+    {
+        std::stable_sort(pets.begin(), pets.end(), [](PetCacheEntry const* left, PetCacheEntry const* right) { return left->Slot < right->Slot; });
+        return pets;
+    }
+}
+
+void PetCache::LoadFromDB(PreparedQueryResult pets, PreparedQueryResult spells, PreparedQueryResult cooldowns, PreparedQueryResult auras, PreparedQueryResult declinedNames)
+{
+    _pets.clear();
+    _loaded = true;
+
+    if (pets)
+    {
+        do
+        {
+            Field* fields = pets->Fetch();
+
+            std::unique_ptr<PetCacheEntry> pet = std::make_unique<PetCacheEntry>();
+            pet->PetNumber         = fields[0].GetUInt32();
+            pet->Entry             = fields[1].GetUInt32();
+            pet->ModelId           = fields[2].GetUInt32();
+            pet->Level             = fields[3].GetUInt8();
+            pet->Experience        = fields[4].GetUInt32();
+            pet->ReactState        = fields[5].GetUInt8();
+            pet->LoyaltyPoints     = fields[6].GetInt32();
+            pet->Loyalty           = fields[7].GetUInt32();
+            pet->TrainingPoints    = fields[8].GetInt32();
+            pet->Slot              = fields[9].GetUInt8();
+            pet->Name              = fields[10].GetString();
+            pet->Renamed           = fields[11].GetBool();
+            pet->Health            = fields[12].GetUInt32();
+            pet->Mana              = fields[13].GetUInt32();
+            pet->Happiness         = fields[14].GetUInt32();
+            pet->ActionBar         = fields[15].GetString();
+            pet->TeachSpells       = fields[16].GetString();
+            pet->SaveTime          = fields[17].GetUInt32();
+            pet->ResetTalentsCost  = fields[18].GetUInt32();
+            pet->ResetTalentsTime  = fields[19].GetUInt32();
+            pet->CreatedBySpell    = fields[20].GetUInt32();
+            pet->Type              = fields[21].GetUInt8();
+            _pets.push_back(std::move(pet));
+        } while (pets->NextRow());
+    }
+
+    if (spells)
+    {
+        do
+        {
+            Field* fields = spells->Fetch();
+            if (PetCacheEntry* pet = GetByNumber(fields[0].GetUInt32()))
+                pet->Spells.push_back({ fields[1].GetUInt16(), fields[2].GetUInt16() });
+        } while (spells->NextRow());
+    }
+
+    if (cooldowns)
+    {
+        do
+        {
+            Field* fields = cooldowns->Fetch();
+            if (PetCacheEntry* pet = GetByNumber(fields[0].GetUInt32()))
+                pet->Cooldowns.push_back({ fields[1].GetUInt32(), time_t(fields[2].GetUInt32()), fields[3].GetUInt32(), time_t(fields[4].GetUInt32()) });
+        } while (cooldowns->NextRow());
+    }
+
+    if (auras)
+    {
+        do
+        {
+            Field* fields = auras->Fetch();
+            PetCacheEntry* pet = GetByNumber(fields[0].GetUInt32());
+            if (!pet)
+                continue;
+
+            PetCacheEntry::Aura aura;
+            aura.CasterGuid = fields[1].GetUInt64();
+            aura.SpellId = fields[2].GetUInt32();
+            aura.EffectMask = fields[3].GetUInt8();
+            aura.RecalculateMask = fields[4].GetUInt8();
+            aura.StackCount = fields[5].GetUInt8();
+            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            {
+                aura.Amount[i] = fields[6 + i].GetInt32();
+                aura.BaseAmount[i] = fields[9 + i].GetInt32();
+            }
+            aura.MaxDuration = fields[12].GetInt32();
+            aura.RemainTime = fields[13].GetInt32();
+            aura.RemainCharges = fields[14].GetUInt8();
+            aura.CritChance = fields[15].GetFloat();
+            aura.ApplyResilience = fields[16].GetBool();
+            pet->Auras.push_back(aura);
+        } while (auras->NextRow());
+    }
+
+    if (declinedNames)
+    {
+        do
+        {
+            Field* fields = declinedNames->Fetch();
+            PetCacheEntry* pet = GetByNumber(fields[0].GetUInt32());
+            if (!pet)
+                continue;
+
+            pet->HasDeclinedNames = true;
+            for (uint8 i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                pet->DeclinedNames.name[i] = fields[1 + i].GetString();
+        } while (declinedNames->NextRow());
+    }
+}
+
+void PetCache::LoadFromDB(ObjectGuid::LowType ownerGuid)
+{
+    CharacterDatabaseStatements const statements[5] =
+    {
+        CHAR_SEL_OWNER_PETS,
+        CHAR_SEL_OWNER_PET_SPELLS,
+        CHAR_SEL_OWNER_PET_SPELL_COOLDOWNS,
+        CHAR_SEL_OWNER_PET_AURAS,
+        CHAR_SEL_OWNER_PET_DECLINED_NAMES
+    };
+
+    PreparedQueryResult results[5];
+    for (uint8 i = 0; i < 5; ++i)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(statements[i]);
+        stmt->setUInt32(0, ownerGuid);
+        results[i] = CharacterDatabase.Query(stmt);
+    }
+
+    LoadFromDB(results[0], results[1], results[2], results[3], results[4]);
+}
+
+PetCacheEntry* PetCache::GetByNumber(uint32 petNumber)
+{
+    for (auto const& pet : _pets)
+        if (pet->PetNumber == petNumber)
+            return pet.get();
+
+    return nullptr;
+}
+
+PetCacheEntry* PetCache::GetCurrent()
+{
+    for (auto const& pet : _pets)
+        if (pet->Slot == PET_SAVE_AS_CURRENT)
+            return pet.get();
+
+    return nullptr;
+}
+
+PetCacheEntry* PetCache::GetUnslotted(uint32 entry /*= 0*/)
+{
+    for (auto const& pet : _pets)
+        if (IsUnslotted(pet->Slot) && (!entry || pet->Entry == entry))
+            return pet.get();
+
+    return nullptr;
+}
+
+std::vector<PetCacheEntry const*> PetCache::GetStabled() const
+{
+    std::vector<PetCacheEntry const*> stabled;
+    for (auto const& pet : _pets)
+        if (!IsUnslotted(pet->Slot))
+            stabled.push_back(pet.get());
+
+    return SortedBySlot(std::move(stabled));
+}
+
+std::vector<PetCacheEntry const*> PetCache::GetAll() const
+{
+    std::vector<PetCacheEntry const*> all;
+    all.reserve(_pets.size());
+    for (auto const& pet : _pets)
+        all.push_back(pet.get());
+
+    return SortedBySlot(std::move(all));
+}
+
+PetCacheEntry& PetCache::Store(std::unique_ptr<PetCacheEntry> entry)
+{
+    Remove(entry->PetNumber);
+    _pets.push_back(std::move(entry));
+    return *_pets.back();
+}
+
+void PetCache::Remove(uint32 petNumber)
+{
+    _pets.erase(std::remove_if(_pets.begin(), _pets.end(), [petNumber](std::unique_ptr<PetCacheEntry> const& pet) { return pet->PetNumber == petNumber; }), _pets.end());
+}
+
+void PetCache::RemoveUnslotted()
+{
+    _pets.erase(std::remove_if(_pets.begin(), _pets.end(), [](std::unique_ptr<PetCacheEntry> const& pet) { return IsUnslotted(pet->Slot); }), _pets.end());
+}
+
+void PetCache::MoveSlot(uint8 from, uint8 to, uint32 exceptPetNumber /*= 0*/)
+{
+    for (auto const& pet : _pets)
+        if (pet->Slot == from && pet->PetNumber != exceptPetNumber)
+            pet->Slot = to;
+}
+
+void PetCache::RemoveAuras(uint8 slot)
+{
+    for (auto const& pet : _pets)
+        if (pet->Slot == slot)
+            pet->Auras.clear();
+}
+
+void PetCache::RemoveSpell(uint32 spellId)
+{
+    for (auto const& pet : _pets)
+        pet->Spells.erase(std::remove_if(pet->Spells.begin(), pet->Spells.end(), [spellId](PetCacheEntry::Spell const& spell) { return spell.SpellId == spellId; }), pet->Spells.end());
+}
@@ -0,0 +1,135 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_PETCACHE_H
+#define TRINITYCORE_PETCACHE_H
+
+#include "DatabaseEnvFwd.h"
+#include "PetDefines.h"
+#include "Unit.h"
+#include <ctime>
+#include <memory>
+#include <vector>
+
+// One character_pet row with its pet_spell, pet_spell_cooldown, pet_aura and character_pet_declinedname rows
+struct PetCacheEntry
+{
+    struct Spell
+    {
+        uint32 SpellId;
+        uint16 Active;
+    };
+
+    struct Cooldown
+    {
+        uint32 SpellId;
+        time_t CooldownEnd;
+        uint32 CategoryId;
+        time_t CategoryEnd;
+    };
+
+    struct Aura
+    {
+        uint64 CasterGuid; // 0 if the pet itself is the caster
+        uint32 SpellId;
+        uint8 EffectMask;
+        uint8 RecalculateMask;
+        uint8 StackCount;
+        int32 Amount[MAX_SPELL_EFFECTS];
+        int32 BaseAmount[MAX_SPELL_EFFECTS];
+        int32 MaxDuration;
+        int32 RemainTime;
+        uint8 RemainCharges;
+        float CritChance;
+        bool ApplyResilience;
+    };
+
+    uint32 PetNumber = 0;
+    uint32 Entry = 0;
+    uint32 ModelId = 0;
+    uint8 Level = 0;
+    uint32 Experience = 0;
+    uint8 ReactState = 0;
+    int32 LoyaltyPoints = 0;
+    uint32 Loyalty = 0;
+    int32 TrainingPoints = 0;
+    uint8 Slot = PET_SAVE_NOT_IN_SLOT;
+    std::string Name;
+    bool Renamed = false;
+    uint32 Health = 0;
+    uint32 Mana = 0;
+    uint32 Happiness = 0;
+    std::string ActionBar;
+    std::string TeachSpells;
+    uint32 SaveTime = 0;
+    uint32 ResetTalentsCost = 0;
+    uint64 ResetTalentsTime = 0;
+    uint32 CreatedBySpell = 0;
+    uint8 Type = 0;
+
+    bool HasDeclinedNames = false;
+    DeclinedName DeclinedNames;
+    std::vector<Spell> Spells;
+    std::vector<Cooldown> Cooldowns;
+    std::vector<Aura> Auras;
+};
+
+/**
+    In memory copy of the pets of an online player, so summoning, calling, stabling or zoning with a pet does not have to query
+    the character database from the map thread.
+    Filled from the login query holder (or synchronously, once, for players not loaded through it) and kept in sync with every
+    write to the pet tables made while the owner is online, the writes themselves are still sent asynchronously.
+*/
+class TC_GAME_API PetCache
+{
+public:
+    PetCache() : _loaded(false) { }
+
+    bool IsLoaded() const { return _loaded; }
+    // new characters have no pet to load
+    void SetLoaded() { _loaded = true; }
+
+    void LoadFromDB(PreparedQueryResult pets, PreparedQueryResult spells, PreparedQueryResult cooldowns, PreparedQueryResult auras, PreparedQueryResult declinedNames);
+    // Fallback for players not loaded through the login query holder
+    void LoadFromDB(ObjectGuid::LowType ownerGuid);
+
+    PetCacheEntry* GetByNumber(uint32 petNumber);
+    PetCacheEntry* GetCurrent();
+    // Current or not stabled pet, with the given entry if any
+    PetCacheEntry* GetUnslotted(uint32 entry = 0);
+    // Stabled pets, ordered by slot
+    std::vector<PetCacheEntry const*> GetStabled() const;
+    // All pets, ordered by slot
+    std::vector<PetCacheEntry const*> GetAll() const;
+
+    // Replace the pet with the same number, if any
+    PetCacheEntry& Store(std::unique_ptr<PetCacheEntry> entry);
+    void Remove(uint32 petNumber);
+    // Mirror of "DELETE FROM character_pet WHERE owner = ? AND (slot = 0 OR slot > PET_SAVE_LAST_STABLE_SLOT)"
+    void RemoveUnslotted();
+    // Mirror of "UPDATE character_pet SET slot = ? WHERE owner = ? AND slot = ? [AND id <> ?]"
+    void MoveSlot(uint8 from, uint8 to, uint32 exceptPetNumber = 0);
+    // Mirror of "DELETE FROM pet_aura WHERE guid IN (SELECT id FROM character_pet WHERE owner = ? AND slot = ?)"
+    void RemoveAuras(uint8 slot);
+    // Mirror of "DELETE FROM pet_spell WHERE spell = ?" for the pets of this owner. Other online owners drop the spell
+    // the same way when one of their pets loads it.
+    void RemoveSpell(uint32 spellId);
+
+private:
+    bool _loaded;
+    std::vector<std::unique_ptr<PetCacheEntry>> _pets; // a handful at most
+};
+
+#endif
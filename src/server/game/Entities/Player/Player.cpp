@@ -290,6 +290,8 @@ Player::Player(WorldSession *session) :
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
 
+    m_visibilityPass = 0;
+
     for (unsigned char & m_forced_speed_change : m_forced_speed_changes)
         m_forced_speed_change = 0;
 
@@ -458,6 +460,7 @@ bool Player::Create(ObjectGuid::LowType guidlow, const std::string& name, uint8
     Object::_Create(guidlow, 0, HighGuid::Player);
 
     m_name = name;
+    m_petCache.SetLoaded();
 
     PlayerInfo const* info = sObjectMgr->GetPlayerInfo(race, class_);
     if (!info)
@@ -3878,7 +3881,7 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
 
 void Player::LeaveAllArenaTeams(ObjectGuid guid)
 {
-    CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(guid);
+    CharacterCacheEntryRef characterInfo = sCharacterCache->GetCharacterCacheByGuid(guid);
     if (!characterInfo)
         return;
 
@@ -3923,7 +3926,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
 
     ObjectGuid::LowType guid = playerguid.GetCounter();
 
-    CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(playerguid);
+    CharacterCacheEntryRef characterInfo = sCharacterCache->GetCharacterCacheByGuid(playerguid);
     std::string name;
     if (characterInfo)
         name = characterInfo->name;
@@ -6964,7 +6967,7 @@ uint32 Player::GetZoneIdFromDB(ObjectGuid guid)
 uint32 Player::GetLevelFromStorage(ObjectGuid guid)
 {
     // Get data from global storage
-    if (CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(guid.GetCounter()))
+    if (CharacterCacheEntryRef playerData = sCharacterCache->GetCharacterCacheByGuid(guid.GetCounter()))
         return playerData->level;
 
     return 0;
@@ -15934,6 +15937,10 @@ bool Player::LoadFromDB( uint32 guid, SQLQueryHolder *holder )
         m_stableSlots = 2;
     }
 
+    m_petCache.LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PETS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_SPELLS),
+        holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_SPELL_COOLDOWNS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_AURAS),
+        holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PET_DECLINED_NAMES));
+
     m_atLoginFlags = fields[LOAD_DATA_AT_LOGIN].GetUInt32();
 
     // Honor system
@@ -16751,6 +16758,9 @@ void Player::_LoadMail()
         } while (result->NextRow());
     }
     m_mailsLoaded = true;
+
+    // we may now modify these mails, expired mails returns already queried can't be applied to them anymore
+    sObjectMgr->SkipOldMailsOf(GetGUID().GetCounter());
 }
 
 void Player::LoadPet()
@@ -16765,6 +16775,15 @@ void Player::LoadPet()
     }
 }
 
+PetCache& Player::GetPetCache()
+{
+    // players not loaded through the login query holder
+    if (!m_petCache.IsLoaded())
+        m_petCache.LoadFromDB(GetGUID().GetCounter());
+
+    return m_petCache;
+}
+
 void Player::_LoadQuestStatus(PreparedQueryResult result)
 {
     m_QuestStatus.clear();
@@ -20273,9 +20292,9 @@ void Player::UpdateTriggerVisibility()
     WorldPacket packet;
     for (auto itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
-        if (itr->IsCreatureOrVehicle())
+        if (itr->first.IsCreatureOrVehicle())
         {
-            Creature* creature = GetMap()->GetCreature(*itr);
+            Creature* creature = GetMap()->GetCreature(itr->first);
             // Update fields of triggers, transformed units or unselectable units (values dependent on GM state)
             if (!creature || (!creature->IsTrigger() && !creature->HasAuraType(SPELL_AURA_TRANSFORM) && !creature->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NOT_SELECTABLE)))
                 continue;
@@ -20284,9 +20303,9 @@ void Player::UpdateTriggerVisibility()
             creature->BuildValuesUpdateBlockForPlayer(&udata, this);
             creature->RemoveFieldNotifyFlag(UF_FLAG_PUBLIC);
         }
-        else if (itr->IsGameObject())
+        else if (itr->first.IsGameObject())
         {
-            GameObject* go = GetMap()->GetGameObject(*itr);
+            GameObject* go = GetMap()->GetGameObject(itr->first);
             if (!go)
                 continue;
 
@@ -20344,7 +20363,7 @@ void Player::UpdateVisibilityOf(WorldObject* target)
         if (CanSeeOrDetect(target, false, true))
         {
             target->SendUpdateToPlayer(this);
-            m_clientGUIDs.insert(target->GetGUID());
+            AddClientGUID(target->GetGUID());
 
             //TC_LOG_DEBUG("debug.grid","Object %u (Type: %u) is visible now for player %u. Distance = %f",target->GetGUID().GetCounter(),target->GetTypeId(),GetGUID().GetCounter(),GetDistance(target));
 
@@ -20357,35 +20376,35 @@ void Player::UpdateVisibilityOf(WorldObject* target)
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player* player, T* target, std::vector<Unit*>& /*v*/)
 {
-    s64.insert(target->GetGUID());
+    player->AddClientGUID(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(Player* player, GameObject* target, std::vector<Unit*>& /*v*/)
 {
     if(!target->IsTransport())
-        s64.insert(target->GetGUID());
+        player->AddClientGUID(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player* player, Creature* target, std::vector<Unit*>& v)
 {
-    s64.insert(target->GetGUID());
-    v.insert(target);
+    player->AddClientGUID(target->GetGUID());
+    v.push_back(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(Player* player, Player* target, std::vector<Unit*>& v)
 {
-    s64.insert(target->GetGUID());
-    v.insert(target);
+    player->AddClientGUID(target->GetGUID());
+    v.push_back(target);
 }
 
 
 template<class T>
-void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow)
+void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow)
 {
     if(!target)
         return;
@@ -20407,18 +20426,18 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
         if (CanSeeOrDetect(target, false, true))
         {
             target->BuildCreateUpdateBlockForPlayer(&data, this);
-            UpdateVisibilityOf_helper(m_clientGUIDs,target, visibleNow);
+            UpdateVisibilityOf_helper(this, target, visibleNow);
 
             //TC_LOG_DEBUG("debug.grid", "Object %u (Type: %u) is visible now for player %u. Distance = %f", target->GetGUID().GetCounter(), target->GetTypeId(), GetGUID().GetCounter(), GetDistance(target));
         }
     }
 }
 
-template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::vector<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
 void Player::UpdateObjectVisibility(bool forced)
 {
@@ -21716,8 +21735,9 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata;
     WorldPacket packet;
-    for(ObjectGuid m_clientGUID : m_clientGUIDs)
+    for(auto const& clientGUID : m_clientGUIDs)
     {
+        ObjectGuid const& m_clientGUID = clientGUID.first;
         if(m_clientGUID.IsGameObject())
         {
             if (GameObject* obj = ObjectAccessor::GetGameObject(*this, m_clientGUID))
@@ -23139,8 +23159,11 @@ void Player::RemoveAllCurrentPetAuras()
 {
     if(Pet* pet = GetPet())
         pet->RemoveAllAuras();
-     else
-        CharacterDatabase.PQuery("DELETE FROM pet_aura WHERE guid IN ( SELECT id FROM character_pet WHERE owner = %u AND slot = %u )", GetGUID().GetCounter(), PET_SAVE_NOT_IN_SLOT);
+    else
+    {
+        CharacterDatabase.PExecute("DELETE FROM pet_aura WHERE guid IN ( SELECT id FROM character_pet WHERE owner = %u AND slot = %u )", GetGUID().GetCounter(), PET_SAVE_NOT_IN_SLOT);
+        GetPetCache().RemoveAuras(PET_SAVE_NOT_IN_SLOT);
+    }
 }
 
 void Player::GetBetaZoneCoord(uint32& map, float& x, float& y, float& z, float& o)
@@ -23341,7 +23364,7 @@ void Player::UpdateArenaTitles()
     }
 
     //else, normal case :
-    CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(GetGUID().GetCounter());
+    CharacterCacheEntryRef playerData = sCharacterCache->GetCharacterCacheByGuid(GetGUID().GetCounter());
     if (!playerData)
         return;
 
@@ -23720,10 +23743,11 @@ void Player::PrepareGossipMenu(WorldObject* source, uint32 menuId /*= 0*/, bool
         if (showQuests && source->ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_QUESTGIVER)
             PrepareQuestMenu(source->GetGUID());
 
+    ConditionSourceInfo srcInfo(this, source);
     for (auto itr = menuItemBounds.first; itr != menuItemBounds.second; ++itr)
     {
         bool canTalk = true;
-        if (!sConditionMgr->IsObjectMeetToConditions(this, source, itr->second.Conditions))
+        if (!itr->second.Conditions.Meets(srcInfo))
             continue;
 
         if (Creature* creature = source->ToCreature())
@@ -24045,9 +24069,10 @@ uint32 Player::GetGossipTextId(uint32 menuId, WorldObject* source) const
 
     GossipMenusMapBounds menuBounds = sObjectMgr->GetGossipMenusMapBounds(menuId);
 
+    ConditionSourceInfo srcInfo(this, source);
     for (auto itr = menuBounds.first; itr != menuBounds.second; ++itr)
     {
-        if (sConditionMgr->IsObjectMeetToConditions(const_cast<Player*>(this), source, itr->second.conditions))
+        if (itr->second.conditions.Meets(srcInfo))
             textId = itr->second.text_id;
     }
 
@@ -24076,7 +24101,7 @@ uint32 Player::GetDefaultGossipMenuForSource(WorldObject* source)
 
 uint32 Player::GetGuildIdFromCharacterInfo(ObjectGuid::LowType guid)
 {
-    if (CharacterCacheEntry const* playerData = sCharacterCache->GetCharacterCacheByGuid(guid))
+    if (CharacterCacheEntryRef playerData = sCharacterCache->GetCharacterCacheByGuid(guid))
         return playerData->guildId;
     return 0;
 }
@@ -24088,7 +24113,7 @@ void Player::SetInArenaTeam(uint32 ArenaTeamId, uint8 slot)
 
 uint32 Player::GetArenaTeamIdFromCharacterInfo(ObjectGuid guid, uint8 type)
 {
-    CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(guid);
+    CharacterCacheEntryRef characterInfo = sCharacterCache->GetCharacterCacheByGuid(guid);
     if (!characterInfo)
         return 0;
 
@@ -13,6 +13,7 @@
 #include "Util.h"                                           // for Tokens typedef
 #include "SpellMgr.h"
 #include "PlayerTaxi.h"
+#include "PetCache.h"
 
 #include<string>
 #include<vector>
@@ -114,6 +115,8 @@ struct SpellModifier
 };
 
 typedef std::unordered_map<uint16, PlayerSpell*> PlayerSpellMap;
+// guid -> visibility pass the object was last checked in
+typedef std::unordered_map<ObjectGuid, uint32> ClientGUIDContainer;
 typedef std::unordered_set<SpellModifier*> SpellModContainer;
 
 struct SpellCooldown
@@ -986,6 +989,11 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_SKILLS                = 18,
     PLAYER_LOGIN_QUERY_LOAD_BG_DATA               = 19,
     PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION       = 20,
+    PLAYER_LOGIN_QUERY_LOAD_PETS                  = 21,
+    PLAYER_LOGIN_QUERY_LOAD_PET_SPELLS            = 22,
+    PLAYER_LOGIN_QUERY_LOAD_PET_SPELL_COOLDOWNS   = 23,
+    PLAYER_LOGIN_QUERY_LOAD_PET_AURAS             = 24,
+    PLAYER_LOGIN_QUERY_LOAD_PET_DECLINED_NAMES    = 25,
 
     MAX_PLAYER_LOGIN_QUERY
 };
@@ -1414,6 +1422,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendItemDurations();
 		void LoadCorpse(PreparedQueryResult result);
         void LoadPet();
+        // All pets of the player, loaded at login
+        PetCache& GetPetCache();
 
         uint32 m_stableSlots;
 
@@ -2275,7 +2285,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SetHomebind(WorldLocation const& loc, uint32 area_id);
 
         // currently visible objects at player client
-		GuidUnorderedSet m_clientGUIDs;
+		ClientGUIDContainer m_clientGUIDs;
+        // incremented by each Trinity::VisibleNotifier, objects not checked by a pass are out of range once it ends
+        uint32 m_visibilityPass;
+        void AddClientGUID(ObjectGuid const& guid) { m_clientGUIDs.emplace(guid, m_visibilityPass); }
 
         bool HaveAtClient(WorldObject const* u) const { return u==this || m_clientGUIDs.find(u->GetGUID())!=m_clientGUIDs.end(); }
 
@@ -2289,7 +2302,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 		void UpdateTriggerVisibility();
 
         template<class T>
-            void UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow);
+            void UpdateVisibilityOf(T* target, UpdateData& data, std::vector<Unit*>& visibleNow);
 
         uint8 m_forced_speed_changes[MAX_MOVE_TYPE];
 
@@ -2642,6 +2655,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         // Temporarily removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
+        PetCache m_petCache;
         uint32 m_oldpetspell;
 
         uint32 _activeCheats; //mask from PlayerCommandStates
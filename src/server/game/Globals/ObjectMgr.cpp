@@ -11,6 +11,7 @@
 #include "UpdateMask.h"
 #include "World.h"
 #include "WorldSession.h"
+#include "WorldSnapshot.h"
 #include "Group.h"
 #include "GroupMgr.h"
 #include "Guild.h"
@@ -419,7 +420,7 @@ void ObjectMgr::LoadCreatureTemplates(bool reload /* = false */)
     uint32 oldMSTime = GetMSTime();
 
     //                                                 
-    QueryResult result = WorldDatabase.Query("SELECT entry, difficulty_entry_1, modelid1, modelid2, modelid3, "
+    QueryResult result = WorldSnapshot::Query("creature_template", "SELECT entry, difficulty_entry_1, modelid1, modelid2, modelid3, "
                                              //   5
                                              "modelid4, name, subname, IconName, gossip_menu_id, minlevel, maxlevel, exp, faction, npcflag, speed, "
                                              //
@@ -434,7 +435,7 @@ void ObjectMgr::LoadCreatureTemplates(bool reload /* = false */)
                                              "HealthModifier, ManaModifier, ArmorModifier, DamageModifier, ExperienceModifier, RacialLeader, RegenHealth, "
                                              //   
                                              "mechanic_immune_mask, spell_school_immune_mask, flags_extra, ScriptName, ctm.Ground, ctm.Swim, ctm.Flight, ctm.Rooted "
-                                             "FROM creature_template ct LEFT JOIN creature_template_movement ctm ON ct.entry = ctm.CreatureId");
+                                             "FROM creature_template ct LEFT JOIN creature_template_movement ctm ON ct.entry = ctm.CreatureId", { "creature_template", "creature_template_movement" });
 
     if (!result)
     {
@@ -1472,7 +1473,7 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
     //                                                0              1   2    3
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid,"
+    QueryResult result = WorldSnapshot::Query("creature", "SELECT creature.guid, id, map, modelid,"
     //   4             5           6           7           8            9              10         11
         "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
     //   12         13           14            15       16      17                   18                                        19                20
@@ -1480,8 +1481,8 @@ void ObjectMgr::LoadCreatures()
         "FROM creature "
         "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
         "LEFT OUTER JOIN creature_encounter_respawn ON creature.guid = creature_encounter_respawn.guid "
-        "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
-        );
+        "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid ",
+        { "creature", "game_event_creature", "creature_encounter_respawn", "pool_creature" });
 
     if(!result)
     {
@@ -1661,13 +1662,13 @@ void ObjectMgr::LoadGameObjects()
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
+    QueryResult result = WorldSnapshot::Query("gameobject", "SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation,"
     //   7          8          9          10         11             12            13     14         15         16         17
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, event, ScriptName, pool_entry "
         "FROM gameobject "
         "LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
-        "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid "
-    );
+        "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid ",
+        { "gameobject", "game_event_gameobject", "pool_gameobject" });
 
     if(!result)
     {
@@ -5208,36 +5209,120 @@ void ObjectMgr::LoadGossipTextLocales()
 }
 
 //not very fast function but it is called only once a day, or on starting-up
-void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
+class OldMailsQueryHolder : public SQLQueryHolder
 {
-    uint32 oldMSTime = GetMSTime();
+public:
+    enum
+    {
+        MAILS,
+        MAIL_ITEMS,
+
+        MAX
+    };
+
+    void Initialize(uint64 basetime)
+    {
+        SetSize(MAX);
+
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
+        stmt->setUInt64(0, basetime);
+        SetPreparedQuery(MAILS, stmt);
 
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
+        stmt->setUInt32(0, (uint32)basetime);
+        SetPreparedQuery(MAIL_ITEMS, stmt);
+    }
+};
+
+void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
+{
     time_t curTime = GameTime::GetGameTime();
     tm lt;
     localtime_r(&curTime, &lt);
     uint64 basetime(curTime);
+
+    // Server running, query asynchronously and let UpdateOldMails handle the result a chunk per world update
+    if (serverUp)
+    {
+        // previous run not finished yet, the mails it did not handle yet will be selected again
+        if (_oldMails.Callback.valid() || _oldMails.Mails)
+            return;
+
+        TC_LOG_INFO("misc", "Returning mails current time: hour: %d, minute: %d, second: %d ", lt.tm_hour, lt.tm_min, lt.tm_sec);
+
+        // players who already listed their mails may modify them before the result comes back, their mails are left
+        // alone. Players loading their mails later are added by SkipOldMailsOf.
+        _oldMails.SkippedReceivers.clear();
+        {
+            boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+            for (auto const& itr : ObjectAccessor::GetPlayers())
+                if (itr.second->m_mailsLoaded)
+                    _oldMails.SkippedReceivers.insert(itr.second->GetGUID().GetCounter());
+        }
+
+        OldMailsQueryHolder* holder = new OldMailsQueryHolder();
+        holder->Initialize(basetime);
+        _oldMails.BaseTime = basetime;
+        _oldMails.StartMSTime = GetMSTime();
+        _oldMails.Callback = CharacterDatabase.DelayQueryHolder(holder);
+        return;
+    }
+
     TC_LOG_INFO("misc", "Returning mails current time: hour: %d, minute: %d, second: %d ", lt.tm_hour, lt.tm_min, lt.tm_sec);
 
+    _oldMails = OldMailsJob();
+    _oldMails.BaseTime = basetime;
+    _oldMails.StartMSTime = GetMSTime();
+
     // Delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL);
+    stmt->setUInt64(0, basetime);
+    CharacterDatabase.Execute(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
+    stmt->setUInt64(0, basetime);
+    PreparedQueryResult mails = CharacterDatabase.Query(stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
+    stmt->setUInt32(0, (uint32)basetime);
+    PreparedQueryResult items = mails ? CharacterDatabase.Query(stmt) : PreparedQueryResult();
+
+    StartOldMails(mails, items);
+
+    // nobody to wait for at startup, handle everything in one go
+    while (_oldMails.Mails)
+        ProcessOldMails(sWorld->getIntConfig(CONFIG_MAIL_EXPIRED_CHUNK_SIZE), false);
+}
+
+void ObjectMgr::UpdateOldMails()
+{
+    if (_oldMails.Callback.valid() && _oldMails.Callback.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
     {
-        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL);
-        stmt->setUInt64(0, basetime);
-        CharacterDatabase.Execute(stmt);
+        SQLQueryHolder* holder = _oldMails.Callback.get();
+        StartOldMails(holder->GetPreparedResult(OldMailsQueryHolder::MAILS), holder->GetPreparedResult(OldMailsQueryHolder::MAIL_ITEMS));
+        delete holder;
     }
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
-    stmt->setUInt64(0, basetime);
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-    if (!result)
+
+    if (_oldMails.Mails)
+        ProcessOldMails(sWorld->getIntConfig(CONFIG_MAIL_EXPIRED_CHUNK_SIZE), true);
+}
+
+void ObjectMgr::SkipOldMailsOf(ObjectGuid::LowType receiver)
+{
+    if (_oldMails.Callback.valid() || _oldMails.Mails)
+        _oldMails.SkippedReceivers.insert(receiver);
+}
+
+void ObjectMgr::StartOldMails(PreparedQueryResult mails, PreparedQueryResult items)
+{
+    if (!mails)
     {
         TC_LOG_INFO("server.loading", ">> No expired mails found.");
+        _oldMails = OldMailsJob();
         return;                                             // any mails need to be returned or deleted
     }
 
-    std::map<uint32 /*messageId*/, MailItemInfoVec> itemsCache;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
-    stmt->setUInt32(0, (uint32)basetime);
-    if (PreparedQueryResult items = CharacterDatabase.Query(stmt))
+    if (items)
     {
         MailItemInfo item;
         do
@@ -5246,97 +5331,108 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
             item.item_guid = fields[0].GetUInt32();
             item.item_template = fields[1].GetUInt32();
             uint32 mailId = fields[2].GetUInt32();
-            itemsCache[mailId].push_back(item);
+            _oldMails.Items[mailId].push_back(item);
         } while (items->NextRow());
     }
 
-    uint32 deletedCount = 0;
-    uint32 returnedCount = 0;
-    do
+    _oldMails.Mails = mails;
+}
+
+void ObjectMgr::ProcessOldMails(uint32 chunkSize, bool serverUp)
+{
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    uint64 basetime = _oldMails.BaseTime;
+    bool done = false;
+
+    for (uint32 handled = 0; !chunkSize || handled < chunkSize; ++handled)
     {
-        Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiver = fields[3].GetUInt32();
+        Field* fields = _oldMails.Mails->Fetch();
+        uint32 messageID = fields[0].GetUInt32();
+        uint8 messageType = fields[1].GetUInt8();
+        uint32 sender = fields[2].GetUInt32();
+        uint32 receiver = fields[3].GetUInt32();
         bool has_items = fields[4].GetBool();
-        m->expire_time = time_t(fields[5].GetUInt32());
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt8();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player* player = nullptr;
-        if (serverUp)
-            player = ObjectAccessor::FindConnectedPlayer(ObjectGuid(HighGuid::Player, m->receiver));
-
-        if (player && player->m_mailsLoaded)
-        {                                                   // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-                                                            // his in mailbox and he has already listed his mails)
-            delete m;
-            continue;
-        }
+        uint8 checked = fields[7].GetUInt8();
 
-        // Delete or return mail
-        if (has_items)
+        // the receiver had listed his mails when the query was issued or did since, this mail may not be what we read anymore.
+        // Checking m_mailsLoaded now would miss a receiver who logged out since, after having modified his mails.
+        if (!serverUp || !_oldMails.SkippedReceivers.count(receiver))
         {
-            // read items from cache
-            m->items.swap(itemsCache[m->messageID]);
-
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            // Delete or return mail
+            bool returned = false;
+            if (has_items)
             {
-                // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                // read items from cache
+                MailItemInfoVec items;
+                items.swap(_oldMails.Items[messageID]);
+
+                // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+                if (messageType != MAIL_NORMAL || (checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
                 {
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
-                    stmt->setUInt32(0, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
-                }
+                    // mail open and then not returned
+                    for (MailItemInfoVec::iterator itr2 = items.begin(); itr2 != items.end(); ++itr2)
+                    {
+                        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+                        stmt->setUInt32(0, itr2->item_guid);
+                        trans->Append(stmt);
+                    }
 
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
-                stmt->setUInt32(0, m->messageID);
-                CharacterDatabase.Execute(stmt);
-            }
-            else
-            {
-                // Mail will be returned
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
-                stmt->setUInt32(0, m->receiver);
-                stmt->setUInt32(1, m->sender);
-                stmt->setUInt32(2, basetime + 30 * DAY);
-                stmt->setUInt32(3, basetime);
-                stmt->setUInt8(4, uint8(MAIL_CHECK_MASK_RETURNED));
-                stmt->setUInt32(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
+                    stmt->setUInt32(0, messageID);
+                    trans->Append(stmt);
+                }
+                else
                 {
-                    // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
-                    stmt->setUInt32(0, m->sender);
-                    stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
-
-                    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
-                    stmt->setUInt32(0, m->sender);
-                    stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    // Mail will be returned
+                    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
+                    stmt->setUInt32(0, receiver);
+                    stmt->setUInt32(1, sender);
+                    stmt->setUInt32(2, basetime + 30 * DAY);
+                    stmt->setUInt32(3, basetime);
+                    stmt->setUInt8(4, uint8(MAIL_CHECK_MASK_RETURNED));
+                    stmt->setUInt32(5, messageID);
+                    trans->Append(stmt);
+                    for (MailItemInfoVec::iterator itr2 = items.begin(); itr2 != items.end(); ++itr2)
+                    {
+                        // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
+                        stmt->setUInt32(0, sender);
+                        stmt->setUInt32(1, itr2->item_guid);
+                        trans->Append(stmt);
+
+                        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
+                        stmt->setUInt32(0, sender);
+                        stmt->setUInt32(1, itr2->item_guid);
+                        trans->Append(stmt);
+                    }
+                    returned = true;
+                    ++_oldMails.Returned;
                 }
-                delete m;
-                ++returnedCount;
-                continue;
+            }
+
+            if (!returned)
+            {
+                PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
+                stmt->setUInt32(0, messageID);
+                trans->Append(stmt);
+                ++_oldMails.Deleted;
             }
         }
 
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
-        stmt->setUInt32(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
-        delete m;
-        ++deletedCount;
-    } while (result->NextRow());
+        if (!_oldMails.Mails->NextRow())
+        {
+            done = true;
+            break;
+        }
+    }
+
+    CharacterDatabase.CommitTransaction(trans);
+
+    if (!done)
+        return;
 
-    TC_LOG_INFO("server.loading", ">> Processed %u expired mails: %u deleted and %u returned in %u ms", deletedCount + returnedCount, deletedCount, returnedCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Processed %u expired mails: %u deleted and %u returned in %u ms", _oldMails.Deleted + _oldMails.Returned, _oldMails.Deleted, _oldMails.Returned, GetMSTimeDiffToNow(_oldMails.StartMSTime));
+    _oldMails = OldMailsJob();
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
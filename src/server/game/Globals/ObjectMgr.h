@@ -14,11 +14,13 @@
 #include "World.h"
 #include "Position.h"
 #include "IteratorPair.h"
+#include "Mail.h"
 
 #include <string>
 #include <map>
 #include <limits>
 #include <unordered_map>
+#include <unordered_set>
 
 class Group;
 class Guild;
@@ -503,14 +505,14 @@ struct GossipMenuItems
     uint32          BoxMoney;
     std::string     BoxText;
     uint32          BoxBroadcastTextId;
-    ConditionContainer   Conditions;
+    CompiledConditions   Conditions;
 };
 
 struct GossipMenus
 {
     uint32          entry;
     uint32          text_id;
-    ConditionContainer   conditions;
+    CompiledConditions   conditions;
 };
 
 typedef std::multimap<uint32, GossipMenuItems> GossipMenuItemsContainer;
@@ -844,7 +846,11 @@ class TC_GAME_API ObjectMgr
             return itr != mFishingBaseForArea.end() ? itr->second : 0;
         }
 
+        // Synchronous at startup. With the server up, only queries the expired mails, UpdateOldMails then handles them a chunk at a time
         void ReturnOrDeleteOldMails(bool serverUp);
+        void UpdateOldMails();
+        // The receiver just loaded his mails, leave his expired mails queried so far alone
+        void SkipOldMailsOf(ObjectGuid::LowType receiver);
 
         CreatureBaseStats const* GetCreatureBaseStats(uint8 level, uint8 unitClass);
 
@@ -1223,6 +1229,22 @@ class TC_GAME_API ObjectMgr
 
     private:
         void LoadScripts(ScriptMapMap& scripts, char const* tablename);
+        void StartOldMails(PreparedQueryResult mails, PreparedQueryResult items);
+        // Return or delete up to chunkSize expired mails (0 for all) in one transaction
+        void ProcessOldMails(uint32 chunkSize, bool serverUp);
+
+        struct OldMailsJob
+        {
+            QueryResultHolderFuture Callback;
+            PreparedQueryResult Mails;                      // positioned on the next mail to handle
+            std::unordered_map<uint32 /*messageId*/, MailItemInfoVec> Items;
+            std::unordered_set<ObjectGuid::LowType> SkippedReceivers;
+            uint64 BaseTime = 0;
+            uint32 StartMSTime = 0;
+            uint32 Deleted = 0;
+            uint32 Returned = 0;
+        };
+        OldMailsJob _oldMails;
         void ConvertCreatureAddonAuras(CreatureAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelations& map,char const* table);
 
@@ -0,0 +1,86 @@
+#include "WorldSnapshot.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "QuerySnapshot.h"
+#include "Timer.h"
+#include "World.h"
+#include <boost/filesystem/operations.hpp>
+
+uint64 WorldSnapshot::GetTablesChecksum(std::initializer_list<char const*> tables)
+{
+    std::string sql = "CHECKSUM TABLE ";
+    for (char const* table : tables)
+    {
+        if (sql.back() != ' ')
+            sql += ", ";
+        sql += table;
+    }
+
+    QueryResult result = WorldDatabase.Query(sql.c_str());
+    if (!result)
+        return 0;
+
+    // FNV-1a over table names and their checksums
+    uint64 checksum = 14695981039346656037ULL;
+    auto hash = [&checksum](char const* data, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            checksum ^= uint8(data[i]);
+            checksum *= 1099511628211ULL;
+        }
+    };
+
+    do
+    {
+        Field* fields = result->Fetch();
+        if (fields[1].IsNull()) // table does not exist
+            return 0;
+
+        std::string const table = fields[0].GetString();
+        uint64 const tableChecksum = fields[1].GetUInt64();
+        hash(table.c_str(), table.size());
+        hash(reinterpret_cast<char const*>(&tableChecksum), sizeof(tableChecksum));
+    } while (result->NextRow());
+
+    return checksum ? checksum : 1;
+}
+
+QueryResult WorldSnapshot::Query(char const* name, std::string const& sql, std::initializer_list<char const*> tables)
+{
+    if (!sWorld->getBoolConfig(CONFIG_WORLD_SNAPSHOT_ENABLED))
+        return WorldDatabase.Query(sql.c_str());
+
+    uint32 const oldMSTime = GetMSTime();
+    uint64 const checksum = GetTablesChecksum(tables);
+    if (!checksum)
+        return WorldDatabase.Query(sql.c_str());
+
+    std::string directory = sConfigMgr->GetStringDefault("WorldSnapshot.Directory", "");
+    if (directory.empty())
+        directory = sWorld->GetDataPath() + "snapshots";
+
+    boost::system::error_code error;
+    boost::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        TC_LOG_ERROR("server.loading", "WorldSnapshot: could not create directory %s (%s), snapshots disabled.", directory.c_str(), error.message().c_str());
+        return WorldDatabase.Query(sql.c_str());
+    }
+
+    std::string const fileName = directory + "/" + name + ".snapshot";
+    if (QueryResult result = QuerySnapshot::Load(fileName, sql, checksum))
+    {
+        TC_LOG_INFO("server.loading", ">> Read " UI64FMTD " rows of %s from snapshot in %u ms", result->GetRowCount(), name, GetMSTimeDiffToNow(oldMSTime));
+        return result;
+    }
+
+    QueryResult result = WorldDatabase.Query(sql.c_str());
+    if (!result)
+        return result;
+
+    result = QuerySnapshot::Store(fileName, sql, checksum, std::move(result));
+    TC_LOG_INFO("server.loading", ">> Snapshot %s outdated, queried and rewrote " UI64FMTD " rows in %u ms", name, result->GetRowCount(), GetMSTimeDiffToNow(oldMSTime));
+    return result;
+}
@@ -0,0 +1,23 @@
+#ifndef TRINITY_WORLDSNAPSHOT_H
+#define TRINITY_WORLDSNAPSHOT_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <initializer_list>
+#include <string>
+
+/* On disk snapshots of the big static world tables (see QuerySnapshot). When enabled, a query is read back from its
+   snapshot file as long as CHECKSUM TABLE still returns the same values for all of its source tables, else it is run
+   on the world database and its snapshot is rewritten. Applies to startup as well as to .reload commands. */
+class TC_GAME_API WorldSnapshot
+{
+public:
+    // Same as WorldDatabase.Query(sql) when snapshots are disabled. name is the snapshot file name, tables must list every table sql reads.
+    static QueryResult Query(char const* name, std::string const& sql, std::initializer_list<char const*> tables);
+
+private:
+    // 0 if a table is missing or the checksum query failed
+    static uint64 GetTablesChecksum(std::initializer_list<char const*> tables);
+};
+
+#endif
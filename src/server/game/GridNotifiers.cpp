@@ -9,9 +9,36 @@
 #include "Transport.h"
 #include "ObjectAccessor.h"
 #include "CellImpl.h"
+#include "World.h"
 
 using namespace Trinity;
 
+VisibleNotifier::VisibleNotifier(Player &player) : i_player(player), i_pass(++player.m_visibilityPass)
+{
+    if (Map* map = player.FindMap())
+        i_visibleNow.swap(map->GetVisibleNowScratch());
+}
+
+VisibleNotifier::~VisibleNotifier()
+{
+    if (Map* map = i_player.FindMap())
+    {
+        i_visibleNow.clear();
+        i_visibleNow.swap(map->GetVisibleNowScratch());
+    }
+}
+
+bool VisibleNotifier::MarkVisited(ObjectGuid const& guid)
+{
+    auto itr = i_player.m_clientGUIDs.find(guid);
+    // a later (nested) pass may have stamped it already, never move a stamp backwards
+    if (itr == i_player.m_clientGUIDs.end() || itr->second >= i_pass)
+        return false;
+
+    itr->second = i_pass;
+    return true;
+}
+
 void VisibleNotifier::SendToSelf()
 {
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
@@ -20,10 +47,8 @@ void VisibleNotifier::SendToSelf()
     {
         for (Transport::PassengerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            if (MarkVisited((*itr)->GetGUID()))
             {
-                vis_guids.erase((*itr)->GetGUID());
-
                 switch ((*itr)->GetTypeId())
                 {
                 case TYPEID_GAMEOBJECT:
@@ -47,19 +72,40 @@ void VisibleNotifier::SendToSelf()
         }
     }
 
-    for (auto it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    // erase first, then let the players gone out of range update their own view of us
+    std::vector<ObjectGuid> outOfRange;
+    Map* map = i_player.FindMap();
+    if (map)
+        outOfRange.swap(map->GetOutOfRangeScratch());
+
+    for (auto it = i_player.m_clientGUIDs.begin(); it != i_player.m_clientGUIDs.end();)
     {
-        i_player.m_clientGUIDs.erase(*it);
-        i_data.AddOutOfRangeGUID(*it);
+        if (it->second < i_pass)
+        {
+            outOfRange.push_back(it->first);
+            i_data.AddOutOfRangeGUID(it->first);
+            it = i_player.m_clientGUIDs.erase(it);
+        }
+        else
+            ++it;
+    }
 
-        if (it->IsPlayer())
+    for (ObjectGuid const& guid : outOfRange)
+    {
+        if (guid.IsPlayer())
         {
-            Player* player = ObjectAccessor::FindPlayer(*it);
+            Player* player = ObjectAccessor::FindPlayer(guid);
             if (player && !player->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
                 player->UpdateVisibilityOf(&i_player);
         }
     }
 
+    if (map)
+    {
+        outOfRange.clear();
+        outOfRange.swap(map->GetOutOfRangeScratch());
+    }
+
     if (!i_data.HasData())
         return;
 
@@ -67,8 +113,8 @@ void VisibleNotifier::SendToSelf()
     i_data.BuildPacket(&packet, false);
     i_player.GetSession()->SendPacket(&packet);
 
-    for (std::set<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
-        i_player.SendInitialVisiblePackets(*it);
+    for (Unit* unit : i_visibleNow)
+        i_player.SendInitialVisiblePackets(unit);
 }
 
 void VisibleChangesNotifier::Visit(CreatureMapType &m)
@@ -90,6 +136,20 @@ void VisibleChangesNotifier::Visit(DynamicObjectMapType &m)
                     player->UpdateVisibilityOf(&i_object);
 }
 
+// true if neither MoveInLineOfSight nor a stealth alert can come out of c seeing u
+inline bool IsAggroPairCulled(Creature* c, Unit* u)
+{
+    uint8 const flags = c->GetAggroFlags();
+    if (flags & CREATURE_AGGRO_ANY_UNIT)
+        return false;
+
+    if (!(flags & CREATURE_AGGRO_OBSERVER))
+        return !((flags & CREATURE_AGGRO_STEALTH_ALERT) && u->GetTypeId() == TYPEID_PLAYER && u->HasStealthAura());
+
+    // default AI, CanAggro refuses friendly targets and stealth alerts need a hostile one
+    return c->IsFriendlyTo(u);
+}
+
 inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
 {
     if (!u->IsAlive() || !c->IsAlive() || c == u || u->IsInFlight())
@@ -97,6 +157,14 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
 
     if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
     {
+        if (sWorld->getBoolConfig(CONFIG_AGGRO_CULLING_ENABLED))
+        {
+            bool const culled = IsAggroPairCulled(c, u);
+            c->GetMap()->GetAggroCandidateIndex().CountPair(culled);
+            if (culled)
+                return;
+        }
+
         if (c->IsAIEnabled && c->CanSeeOrDetect(u, false, true))
             c->AI()->MoveInLineOfSight_Safe(u);
         else
@@ -112,7 +180,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        vis_guids.erase(player->GetGUID());
+        MarkVisited(player->GetGUID());
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -131,7 +199,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->GetSource();
 
-        vis_guids.erase(c->GetGUID());
+        MarkVisited(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -155,7 +223,7 @@ void CreatureRelocationNotifier::Visit(PlayerMapType &m)
 
 void CreatureRelocationNotifier::Visit(CreatureMapType &m)
 {
-    if (!i_creature.IsAlive())
+    if (!i_creature.IsAlive() || i_skipCreatures)
         return;
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -178,6 +246,13 @@ void DelayedUnitRelocation::Visit(CreatureMapType &m)
 
         CreatureRelocationNotifier relocate(*unit);
 
+        // creatures around only matter for aggro, skip them if unit cannot react to them and none of them can react to unit
+        relocate.i_skipCreatures = sWorld->getBoolConfig(CONFIG_AGGRO_CULLING_ENABLED)
+            && !(unit->GetAggroFlags() & CREATURE_AGGRO_OBSERVER)
+            && !i_map.GetAggroCandidateIndex().CanBeObserved(i_map, unit, i_radius);
+        if (relocate.i_skipCreatures)
+            i_map.GetAggroCandidateIndex().CountSkippedVisit();
+
         TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
         TypeContainerVisitor<CreatureRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
 
@@ -258,21 +333,26 @@ void MessageDistDeliverer::Visit(PlayerMapType &m)
         if (target->GetExactDist2dSq(i_source) > i_distSq)
             continue;
 
-        // Send packet to all who are sharing the player's vision
-        for (auto p : target->GetSharedVisionList())
-            if (p->m_seer == target)
-                    SendPacket(p);
+        SendToPlayer(target);
+    }
+}
 
-        //send only if player viewpoint is on himself (?except for vehicles where the viewpoint is on the vehicle?)
-        if (target->m_seer != target
+bool MessageDistDeliverer::SendToPlayer(Player* target)
+{
+    // Send packet to all who are sharing the player's vision
+    for (auto p : target->GetSharedVisionList())
+        if (p->m_seer == target)
+            SendPacket(p);
+
+    //send only if player viewpoint is on himself (?except for vehicles where the viewpoint is on the vehicle?)
+    if (target->m_seer != target
 #ifdef LICH_KING
-            && !target->GetVehicle()
+        && !target->GetVehicle()
 #endif
-            )
-            continue;
+        )
+        return false;
 
-        SendPacket(target);
-    }
+    return SendPacket(target);
 }
 
 void MessageDistDeliverer::Visit(CreatureMapType &m)
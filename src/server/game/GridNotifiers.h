@@ -16,16 +16,23 @@
 
 namespace Trinity
 {
+	/* Instead of copying the client guids and erasing the visited ones, each notifier starts a new visibility pass and
+	   stamps the client guids it visits. Guids left with an older pass are out of range in SendToSelf.
+	   Buffers are borrowed from the player map and given back at destruction, so a notify does not allocate. */
 	struct TC_GAME_API VisibleNotifier
 	{
 		Player &i_player;
 		UpdateData i_data;
-		std::set<Unit*> i_visibleNow;
-		GuidUnorderedSet vis_guids;
+		std::vector<Unit*> i_visibleNow;
+		uint32 const i_pass;
 
-		VisibleNotifier(Player &player) : i_player(player), vis_guids(player.m_clientGUIDs) { }
+		VisibleNotifier(Player &player);
+		~VisibleNotifier();
 		template<class T> void Visit(GridRefManager<T> &m);
 		void SendToSelf(void);
+
+		// mark guid as checked by this pass, return false if it is not at client or was already checked
+		bool MarkVisited(ObjectGuid const& guid);
 	};
 
 	struct VisibleChangesNotifier
@@ -51,7 +58,8 @@ namespace Trinity
 	struct TC_GAME_API CreatureRelocationNotifier
 	{
 		Creature &i_creature;
-		CreatureRelocationNotifier(Creature &c) : i_creature(c) { }
+		bool i_skipCreatures; // set when no creature around can trigger anything with i_creature, see AggroCandidateIndex
+		CreatureRelocationNotifier(Creature &c) : i_creature(c), i_skipCreatures(false) { }
 		template<class T> void Visit(GridRefManager<T> &) { }
 		void Visit(CreatureMapType &);
 		void Visit(PlayerMapType &);
@@ -120,16 +128,25 @@ namespace Trinity
 		void Visit(DynamicObjectMapType &m);
 		template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
 
-		void SendPacket(Player* player)
+		// Sends to the players sharing target's vision, then to target itself. Returns whether target got the packet
+		bool SendToPlayer(Player* target);
+
+		bool CanReceive(Player const* player) const
 		{
 			// never send packet to self
 			if (player == i_source || (team != Team(0) && Team(player->GetTeam()) != team) || skipped_receiver == player)
-				return;
+				return false;
 
-			if (!player->HaveAtClient(i_source))
-				return;
+			return player->HaveAtClient(i_source);
+		}
+
+		bool SendPacket(Player* player)
+		{
+			if (!CanReceive(player))
+				return false;
 
 			player->GetSession()->SendPacket(i_message);
+			return true;
 		}
 	};
 
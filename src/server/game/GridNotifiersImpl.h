@@ -41,7 +41,7 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
 	for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
 	{
-		vis_guids.erase(iter->GetSource()->GetGUID());
+		MarkVisited(iter->GetSource()->GetGUID());
 		i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
 	}
 }
@@ -89,7 +89,7 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid, SQLTransaction trans)
     }
     else
     {
-        CharacterCacheEntry const* cInfo = sCharacterCache->GetCharacterCacheByGuid(playerGuid);
+        CharacterCacheEntryRef cInfo = sCharacterCache->GetCharacterCacheByGuid(playerGuid);
         if (!cInfo)
             return false;
 
@@ -371,7 +371,7 @@ void ArenaTeam::Roster(WorldSession *session)
     
     for (auto itr : Members)
     {
-        CharacterCacheEntry const* pData = sCharacterCache->GetCharacterCacheByGuid(itr.Guid);
+        CharacterCacheEntryRef pData = sCharacterCache->GetCharacterCacheByGuid(itr.Guid);
         
         pl = ObjectAccessor::FindConnectedPlayer(itr.Guid);
 
@@ -169,7 +169,7 @@ void WorldSession::HandleSendMail(WorldPacket& recvData) //LK ok
     }
     else
     {
-        if (CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(receiverGuid))
+        if (CharacterCacheEntryRef characterInfo = sCharacterCache->GetCharacterCacheByGuid(receiverGuid))
         {
             receiverTeam = Player::TeamForRace(characterInfo->race);
             receiverLevel = characterInfo->level;
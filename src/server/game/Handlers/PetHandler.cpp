@@ -661,6 +661,17 @@ void WorldSession::HandlePetRename( WorldPacket & recvData )
         }
     }
 
+    if (PetCacheEntry* cachedPet = _player->GetPetCache().GetByNumber(pet->GetCharmInfo()->GetPetNumber()))
+    {
+        cachedPet->Name = name;
+        cachedPet->Renamed = true;
+        if (isdeclined)
+        {
+            cachedPet->HasDeclinedNames = true;
+            cachedPet->DeclinedNames = declinedname;
+        }
+    }
+
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     if(isdeclined)
     {
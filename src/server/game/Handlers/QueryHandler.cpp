@@ -10,7 +10,7 @@
 void WorldSession::SendNameQueryOpcode(ObjectGuid guid)
 {
     Player* player = ObjectAccessor::FindPlayer(guid);
-    CharacterCacheEntry const* nameData = sCharacterCache->GetCharacterCacheByGuid(guid.GetCounter());
+    CharacterCacheEntryRef nameData = sCharacterCache->GetCharacterCacheByGuid(guid.GetCounter());
 
     WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 4 + 4 + 4 + 1));
 #ifdef LICH_KING
@@ -669,8 +669,9 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count);                                  // placeholder
 
-    for(auto m_clientGUID : _player->m_clientGUIDs)
+    for(auto const& clientGUID : _player->m_clientGUIDs)
     {
+        ObjectGuid const& m_clientGUID = clientGUID.first;
         uint8 questStatus = DIALOG_STATUS_NONE;
 
         if (m_clientGUID.IsAnyTypeCreature())
@@ -5,6 +5,8 @@
 #include "World.h"
 #include "ObjectMgr.h"
 #include "AccountMgr.h"
+#include "GameTime.h"
+#include "LogsDatabaseBuffer.h"
 
 #define NO_SESSION_STRING "no session"
 
@@ -181,28 +183,29 @@ void LogsDatabaseAccessor::GMCommand(WorldSession const* m_session, Unit const*
     if (zoneName.size() > 20) //max db lenght
         zoneName.resize(20);
 
-    /*PrepareStatement(LOGS_INS_GM_COMMAND, "INSERT INTO gm_command (account, guid, gmlevel, time, map, x, y, z, area_name, zone_name, selection_type, selection_guid,
-    selection_name, selection_map, selection_x, selection_y, selection_z, command, IP) VALUES (?,?,?,UNIX_TIMESTAMP(),?,?,?,??,?,?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC); */
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_GM_COMMAND);
-    stmt->setUInt32(0, m_session ? m_session->GetAccountId() : 0);
-    stmt->setUInt32(1, player ? player->GetGUID().GetCounter() : 0);
-    stmt->setUInt8(2, m_session ? m_session->GetSecurity() : 0);
-    stmt->setUInt32(3, player ? player->GetMapId() : 0);
-    stmt->setFloat(4, player ? player->GetPositionX() : 0);
-    stmt->setFloat(5, player ? player->GetPositionY() : 0);
-    stmt->setFloat(6, player ? player->GetPositionZ() : 0);
-    stmt->setString(7, areaName);
-    stmt->setString(8, zoneName);
-    stmt->setString(9, GetLogNameForGuid(targetGUID));
-    stmt->setUInt32(10, targetGUID.GetCounter());
-    stmt->setString(11, targetNameLog);
-    stmt->setUInt32(12, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetMapId() : 0);
-    stmt->setFloat(13, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionX() : 0);
-    stmt->setFloat(14, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionY() : 0);
-    stmt->setFloat(15, (player && player->GetSelectedUnit()) ? player->GetSelectedUnit()->GetPositionZ() : 0);
-    stmt->setString(16, fullcmd);
-    stmt->setString(17, m_session ? m_session->GetRemoteAddress() : NO_SESSION_STRING);
-    LogsDatabase.Execute(stmt);
+    Unit const* selected = player ? player->GetSelectedUnit() : nullptr;
+
+    LogsDatabaseRow row;
+    row << (m_session ? m_session->GetAccountId() : 0);
+    row << (player ? player->GetGUID().GetCounter() : 0);
+    row << uint32(m_session ? m_session->GetSecurity() : 0);
+    row << uint32(GameTime::GetGameTime());
+    row << (player ? player->GetMapId() : 0);
+    row << (player ? player->GetPositionX() : 0.0f);
+    row << (player ? player->GetPositionY() : 0.0f);
+    row << (player ? player->GetPositionZ() : 0.0f);
+    row << areaName;
+    row << zoneName;
+    row << GetLogNameForGuid(targetGUID);
+    row << targetGUID.GetCounter();
+    row << targetNameLog;
+    row << (selected ? selected->GetMapId() : 0);
+    row << (selected ? selected->GetPositionX() : 0.0f);
+    row << (selected ? selected->GetPositionY() : 0.0f);
+    row << (selected ? selected->GetPositionZ() : 0.0f);
+    row << fullcmd;
+    row << (m_session ? m_session->GetRemoteAddress() : NO_SESSION_STRING);
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_GM_COMMAND, row);
 }
 
 void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player const* player, Player const* toPlayer, uint32 logChannelId, std::string const& to, std::string const& msg)
@@ -219,20 +222,18 @@ void LogsDatabaseAccessor::CharacterChat(ChatMsg type, Language lang, Player con
     if (!ShouldLog(CONFIG_LOG_CHAR_CHAT, CONFIG_GM_LOG_CHAR_CHAT, gmInvolved))
         return;
 
-    // PrepareStatement(LOGS_INS_CHAR_CHAT, "INSERT INTO char_chat (time,type,guid,account,target_guid,channelId,channelName,message,IP,gm_involved) VALUES (UNIX_TIMESTAMP(),?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_CHAT);
-
-    stmt->setUInt8( 0, uint8(type));
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, session->GetAccountId());
-    stmt->setUInt32(3, toPlayer ? toPlayer->GetGUID().GetCounter() : 0);
-    stmt->setUInt32(4, logChannelId);
-    stmt->setString(5, to);
-    stmt->setString(6, msg);
-    stmt->setString(7, session->GetRemoteAddress());
-    stmt->setBool(  8, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    LogsDatabaseRow row;
+    row << uint32(GameTime::GetGameTime());
+    row << uint32(type);
+    row << player->GetGUID().GetCounter();
+    row << session->GetAccountId();
+    row << (toPlayer ? toPlayer->GetGUID().GetCounter() : 0);
+    row << logChannelId;
+    row << to;
+    row << msg;
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_CHAT, row);
 }
 
 
@@ -372,37 +373,32 @@ void LogsDatabaseAccessor::Mail(uint32 mailId, MailMessageType type, uint32 send
     
     //## Insert into database
 
-    SQLTransaction trans = LogsDatabase.BeginTransaction();
-
-    //PrepareStatement(LOGS_INS_CHAR_MAIL, "INSERT INTO mail (id, type, sender_account, sender_guid_or_entry, receiver_guid, subject, message, money, time, IP, gm_involved) VALUES (?,?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC)
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_MAIL);
-    stmt->setUInt32(0, mailId);
-    stmt->setUInt8(1, uint8(type));
-    stmt->setUInt32(2, sender ? sender->GetSession()->GetAccountId() : 0);
-    stmt->setUInt32(3, sender_guidlow_or_entry);
-    stmt->setUInt32(4, receiver_guidlow);
-    stmt->setString(5, subject);
-    stmt->setString(6, body);
-    stmt->setUInt32(7, money);
-    stmt->setUInt32(8, cod);
-    stmt->setString(9, IP);
-    stmt->setBool(9, gmInvolved);
-    trans->Append(stmt);
+    LogsDatabaseRow row;
+    row << mailId;
+    row << uint32(type);
+    row << (sender ? sender->GetSession()->GetAccountId() : 0);
+    row << sender_guidlow_or_entry;
+    row << receiver_guidlow;
+    row << subject;
+    row << body;
+    row << money;
+    row << cod;
+    row << uint32(GameTime::GetGameTime());
+    row << IP;
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_MAIL, row);
 
     uint32 mail_itemId = 0;
     for (auto itr : items)
     {
-        //PrepareStatement(LOGS_INS_MAIL_ITEMS, "INSERT INTO mail_items (mail_id, id, item_guid, item_entry, item_count) VALUES (?,?,?,?,?)", CONNECTION_ASYNC);
-        stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_MAIL_ITEMS);
-        stmt->setUInt32(0, mailId);
-        stmt->setUInt8(1, mail_itemId++);
-        stmt->setUInt32(2, itr.second->GetGUID().GetCounter());
-        stmt->setUInt32(3, itr.second->GetEntry());
-        stmt->setUInt16(4, itr.second->GetCount());
-        trans->Append(stmt);
+        LogsDatabaseRow itemRow;
+        itemRow << mailId;
+        itemRow << mail_itemId++;
+        itemRow << itr.second->GetGUID().GetCounter();
+        itemRow << itr.second->GetEntry();
+        itemRow << itr.second->GetCount();
+        sLogsDatabaseBuffer->Append(LOGS_BUFFER_MAIL_ITEMS, itemRow);
     }
-
-    LogsDatabase.CommitTransaction(trans);
 }
 
 void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, std::vector<Item*> const& p1Items, std::vector<Item*> const& p2Items, uint32 p1Gold, uint32 p2Gold)
@@ -414,37 +410,32 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_TRADE, CONFIG_GM_LOG_CHAR_ITEM_TRADE, gmInvolved))
         return;
 
-    SQLTransaction trans = LogsDatabase.BeginTransaction();
-
-    //PrepareStatement(LOGS_INS_CHAR_TRADE, "INSERT INTO char_trade (id, player1_account, player2_account, player1_guid, player2_guid, money1, money2, player1_IP, player2_IP, time, gm_involved) VALUES (?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_TRADE);
-    stmt->setUInt32(0, max_trade_id);
-    stmt->setUInt32(1, p1->GetSession()->GetAccountId());
-    stmt->setUInt32(2, p2->GetSession()->GetAccountId());
-    stmt->setUInt32(3, p1->GetGUID().GetCounter());
-    stmt->setUInt32(4, p2->GetGUID().GetCounter());
-    stmt->setUInt32(5, p1Gold);
-    stmt->setUInt32(6, p2Gold);
-    stmt->setString(7, p1->GetSession()->GetRemoteAddress());
-    stmt->setString(8, p2->GetSession()->GetRemoteAddress());
-    stmt->setBool(9, gmInvolved);
-    trans->Append(stmt);
+    LogsDatabaseRow row;
+    row << tradeId;
+    row << p1->GetSession()->GetAccountId();
+    row << p2->GetSession()->GetAccountId();
+    row << p1->GetGUID().GetCounter();
+    row << p2->GetGUID().GetCounter();
+    row << p1Gold;
+    row << p2Gold;
+    row << p1->GetSession()->GetRemoteAddress();
+    row << p2->GetSession()->GetRemoteAddress();
+    row << uint32(GameTime::GetGameTime());
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_TRADE, row);
 
     auto logItemTrade = [&](Item* item, bool p1top2)
     { 
         if (!item)
             return;
 
-        // PrepareStatement(LOGS_INS_CHAR_TRADE_ITEMS, "INSERT INTO char_trade_items (trade_id, p1top2, item_guid, item_entry, item_count) VALUES (?,?,?,?,?)", CONNECTION_ASYNC);
-        stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_TRADE_ITEMS);
-
-        stmt->setUInt32(0, tradeId);
-        stmt->setBool(1, p1top2);
-        stmt->setUInt32(2, item->GetGUID().GetCounter());
-        stmt->setUInt32(3, item->GetEntry());
-        stmt->setUInt8(4, item->GetCount());
-
-        trans->Append(stmt);
+        LogsDatabaseRow itemRow;
+        itemRow << tradeId;
+        itemRow << p1top2;
+        itemRow << item->GetGUID().GetCounter();
+        itemRow << item->GetEntry();
+        itemRow << item->GetCount();
+        sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_TRADE_ITEMS, itemRow);
     };
 
     for (auto itr : p1Items)
@@ -452,8 +443,6 @@ void LogsDatabaseAccessor::CharacterTrade(Player const* p1, Player const* p2, st
 
     for (auto itr : p2Items)
         logItemTrade(itr, false);
-
-    LogsDatabase.CommitTransaction(trans);
 }
 
 void LogsDatabaseAccessor::CleanupOldMonitorLogs()
@@ -485,19 +474,17 @@ void LogsDatabaseAccessor::WonAuction(uint32 bidderAccount, ObjectGuid::LowType
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_AUCTION, CONFIG_GM_LOG_CHAR_ITEM_AUCTION, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_AUCTION_WON, "INSERT INTO char_auction_won (bidder_account, bidder_guid, seller_account, seller_guid, item_guid, item_entry, item_count, time, gm_involved) VALUES (?,?,?,?,?,?,?,UNIX_TIMESTAMP(),?", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_AUCTION_WON);
-
-    stmt->setUInt32(0, bidderAccount);
-    stmt->setUInt32(1, bidderGUID);
-    stmt->setUInt32(2, sellerAccount);
-    stmt->setUInt32(3, sellerGUID);
-    stmt->setUInt32(4, itemGUID);
-    stmt->setUInt32(5, itemEntry);
-    stmt->setUInt16(6, itemCount);
-    stmt->setBool(7, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    LogsDatabaseRow row;
+    row << bidderAccount;
+    row << bidderGUID;
+    row << sellerAccount;
+    row << sellerGUID;
+    row << itemGUID;
+    row << itemEntry;
+    row << itemCount;
+    row << uint32(GameTime::GetGameTime());
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_AUCTION_WON, row);
 }
 
 void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowType itemGUID, uint32 itemEntry, uint32 itemCount)
@@ -510,18 +497,16 @@ void LogsDatabaseAccessor::CreateAuction(Player const* player, ObjectGuid::LowTy
     if (!ShouldLog(CONFIG_LOG_CHAR_ITEM_AUCTION, CONFIG_GM_LOG_CHAR_ITEM_AUCTION, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_CHAR_AUCTION_CREATE, "INSERT INTO char_auction_create (seller_account, seller_guid, item_guid, item_entry, item_count, time, IP, gm_involved) VALUES (?,?,?,?,?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_AUCTION_CREATE);
-    
-    stmt->setUInt32(0, accountId);
-    stmt->setUInt32(1, player->GetGUID().GetCounter());
-    stmt->setUInt32(2, itemGUID);
-    stmt->setUInt32(3, itemEntry);
-    stmt->setUInt16(4, itemCount);
-    stmt->setString(5, session->GetRemoteAddress());
-    stmt->setBool(6, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    LogsDatabaseRow row;
+    row << accountId;
+    row << player->GetGUID().GetCounter();
+    row << itemGUID;
+    row << itemEntry;
+    row << itemCount;
+    row << uint32(GameTime::GetGameTime());
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_AUCTION_CREATE, row);
 }
 
 void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player const* player, Item const* item, Unit const* vendor)
@@ -543,19 +528,17 @@ void LogsDatabaseAccessor::BuyOrSellItemToVendor(BuyTransactionType type, Player
         return;
     }
 
-    //PrepareStatement(LOGS_INS_CHAR_ITEM_VENDOR, "INSERT INTO char_item_vendor (transaction_type, account, guid, item_entry, item_count, vendor_entry, time, IP, gm_involved) VALUES (?,?,?,?,?,?,UNIT_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_CHAR_ITEM_VENDOR);
-
-    stmt->setString(0, transaction_type);
-    stmt->setUInt32(1, player->GetSession()->GetAccountId());
-    stmt->setUInt32(2, player->GetGUID().GetCounter());
-    stmt->setUInt32(3, item->GetEntry());
-    stmt->setUInt32(4, item->GetCount());
-    stmt->setUInt32(5, vendor->GetEntry());
-    stmt->setString(6, player->GetSession()->GetRemoteAddress());
-    stmt->setBool(7, gmInvolved);
-
-    LogsDatabase.Execute(stmt);
+    LogsDatabaseRow row;
+    row << transaction_type;
+    row << player->GetSession()->GetAccountId();
+    row << player->GetGUID().GetCounter();
+    row << item->GetEntry();
+    row << item->GetCount();
+    row << vendor->GetEntry();
+    row << uint32(GameTime::GetGameTime());
+    row << player->GetSession()->GetRemoteAddress();
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_CHAR_ITEM_VENDOR, row);
 }
 
 void LogsDatabaseAccessor::CleanupOldLogs()
@@ -626,12 +609,23 @@ void LogsDatabaseAccessor::LogConnectionIP(WorldSession const* session)
     if (!ShouldLog(CONFIG_LOG_CONNECTION_IP, CONFIG_GM_LOG_CONNECTION_IP, gmInvolved))
         return;
 
-    //PrepareStatement(LOGS_INS_ACCOUNT_IP, "INSERT INTO account_ip (id, time, ip, gm_involved) VALUES (?,UNIX_TIMESTAMP(),?,?)", CONNECTION_ASYNC);
-    PreparedStatement* stmt = LogsDatabase.GetPreparedStatement(LOGS_INS_ACCOUNT_IP);
-
-    stmt->setUInt32(0, session->GetAccountId());
-    stmt->setString(1, session->GetRemoteAddress());
-    stmt->setBool(2, gmInvolved);
+    LogsDatabaseRow row;
+    row << session->GetAccountId();
+    row << uint32(GameTime::GetGameTime());
+    row << session->GetRemoteAddress();
+    row << gmInvolved;
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_ACCOUNT_IP, row);
+}
 
-    LogsDatabase.Execute(stmt);
+void LogsDatabaseAccessor::WardenFail(WorldSession const* session, uint32 checkId, std::string const& comment)
+{
+    Player const* player = session->GetPlayer();
+
+    LogsDatabaseRow row;
+    row << (player ? player->GetGUID().GetCounter() : 0);
+    row << session->GetAccountId();
+    row << checkId;
+    row << comment;
+    row << uint64(GameTime::GetGameTime());
+    sLogsDatabaseBuffer->Append(LOGS_BUFFER_WARDEN_FAILS, row);
 }
\ No newline at end of file
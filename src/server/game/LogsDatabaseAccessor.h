@@ -49,6 +49,7 @@ public:
     static void CreateAuction(Player const* player, ObjectGuid::LowType itemGUID, uint32 itemEntry, uint32 itemCount);
 
     static void LogConnectionIP(WorldSession const* session);
+    static void WardenFail(WorldSession const* session, uint32 checkId, std::string const& comment);
 
     enum BuyTransactionType
     {
@@ -0,0 +1,247 @@
+#include "LogsDatabaseBuffer.h"
+#include "DatabaseEnv.h"
+#include "Monitor.h"
+#include "World.h"
+#include <algorithm>
+
+namespace
+{
+    struct LogsBufferTableInfo
+    {
+        char const* Name;
+        char const* Columns;
+        LogsBufferTable Parent; // table referenced by a foreign key, written in the same transaction. MAX_LOGS_BUFFER_TABLES if none.
+    };
+
+    LogsBufferTableInfo const LogsBufferTables[MAX_LOGS_BUFFER_TABLES] =
+    {
+        { "account_ip",          "id, time, ip, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_auction_create", "seller_account, seller_guid, item_guid, item_entry, item_count, time, IP, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_auction_won",    "bidder_account, bidder_guid, seller_account, seller_guid, item_guid, item_entry, item_count, time, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_chat",           "time, type, guid, account, target_guid, channelId, channelName, message, IP, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_item_vendor",    "transaction_type, account, guid, item_entry, item_count, vendor_entry, time, IP, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_trade",          "id, player1_account, player2_account, player1_guid, player2_guid, money1, money2, player1_IP, player2_IP, time, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "char_trade_items",    "trade_id, p1top2, item_guid, item_entry, item_count", LOGS_BUFFER_CHAR_TRADE },
+        { "gm_command",          "account, guid, gmlevel, time, map, x, y, z, area_name, zone_name, selection_type, selection_guid, selection_name, selection_map, selection_x, selection_y, selection_z, command, IP", MAX_LOGS_BUFFER_TABLES },
+        { "mail",                "id, type, sender_account, sender_guid_or_entry, receiver_guid, subject, message, money, cod, time, IP, gm_involved", MAX_LOGS_BUFFER_TABLES },
+        { "mail_items",          "mail_id, id, item_guid, item_entry, item_count", MAX_LOGS_BUFFER_TABLES },
+        { "warden_fails",        "guid, account, check_id, comment, time", MAX_LOGS_BUFFER_TABLES },
+    };
+
+    // keep well below the default max_allowed_packet
+    size_t const MaxInsertSize = 1024 * 1024;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(bool value)
+{
+    Separate();
+    _values += value ? '1' : '0';
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(int32 value)
+{
+    Separate();
+    _values += std::to_string(value);
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(uint32 value)
+{
+    Separate();
+    _values += std::to_string(value);
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(int64 value)
+{
+    Separate();
+    _values += std::to_string(value);
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(uint64 value)
+{
+    Separate();
+    _values += std::to_string(value);
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(float value)
+{
+    Separate();
+    _values += std::to_string(value);
+    return *this;
+}
+
+LogsDatabaseRow& LogsDatabaseRow::operator<<(std::string const& value)
+{
+    std::string escaped = value;
+    LogsDatabase.EscapeString(escaped);
+
+    Separate();
+    _values += '\'';
+    _values += escaped;
+    _values += '\'';
+    return *this;
+}
+
+LogsDatabaseBuffer::LogsDatabaseBuffer() :
+    _bufferedRows(0),
+    _bufferedBytes(0),
+    _batchFull(false),
+    _flushTimer(0),
+    _droppedRows(0)
+{
+}
+
+LogsDatabaseBuffer* LogsDatabaseBuffer::instance()
+{
+    static LogsDatabaseBuffer instance;
+    return &instance;
+}
+
+void LogsDatabaseBuffer::BuildInsert(LogsBufferTable table, std::string const* rows, size_t count, std::string& sql)
+{
+    sql = "INSERT INTO ";
+    sql += LogsBufferTables[table].Name;
+    sql += " (";
+    sql += LogsBufferTables[table].Columns;
+    sql += ") VALUES ";
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i)
+            sql += ',';
+        sql += '(';
+        sql += rows[i];
+        sql += ')';
+    }
+}
+
+void LogsDatabaseBuffer::Append(LogsBufferTable table, LogsDatabaseRow const& row)
+{
+    if (!sWorld->getBoolConfig(CONFIG_LOGS_BUFFER_ENABLED))
+    {
+        std::string sql;
+        BuildInsert(table, &row.GetValues(), 1, sql);
+        LogsDatabase.Execute(sql.c_str());
+        return;
+    }
+
+    size_t const maxBytes = size_t(sWorld->getIntConfig(CONFIG_LOGS_BUFFER_MAX_MEMORY)) * 1024 * 1024;
+    uint32 const batchSize = sWorld->getIntConfig(CONFIG_LOGS_BUFFER_BATCH_SIZE);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (maxBytes && _bufferedBytes + row.GetValues().size() > maxBytes)
+    {
+        _droppedRows.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    _rows[table].push_back(row.GetValues());
+    ++_bufferedRows;
+    _bufferedBytes += row.GetValues().size();
+    if (batchSize && _rows[table].size() >= batchSize)
+        _batchFull = true;
+}
+
+void LogsDatabaseBuffer::TakeStatements(std::vector<std::vector<std::string>>& transactions)
+{
+    size_t const firstTransaction = transactions.size();
+    std::array<size_t, MAX_LOGS_BUFFER_TABLES> tableTransactions; // index in transactions
+    for (uint8 table = 0; table < MAX_LOGS_BUFFER_TABLES; ++table)
+    {
+        LogsBufferTable const parent = LogsBufferTables[table].Parent;
+        if (parent != MAX_LOGS_BUFFER_TABLES)
+            tableTransactions[table] = tableTransactions[parent];
+        else
+        {
+            tableTransactions[table] = transactions.size();
+            transactions.emplace_back();
+        }
+
+        std::vector<std::string>& statements = transactions[tableTransactions[table]];
+        std::vector<std::string>& rows = _rows[table];
+        size_t first = 0;
+        while (first < rows.size())
+        {
+            // split so that no statement gets much bigger than MaxInsertSize
+            size_t last = first;
+            size_t size = 0;
+            do
+            {
+                size += rows[last].size() + 3;
+                ++last;
+            } while (last < rows.size() && size < MaxInsertSize);
+
+            statements.emplace_back();
+            BuildInsert(LogsBufferTable(table), &rows[first], last - first, statements.back());
+            first = last;
+        }
+        rows.clear();
+    }
+
+    transactions.erase(std::remove_if(transactions.begin() + firstTransaction, transactions.end(),
+        [](std::vector<std::string> const& statements) { return statements.empty(); }), transactions.end());
+
+    _bufferedRows = 0;
+    _bufferedBytes = 0;
+    _batchFull = false;
+    _flushTimer = 0;
+}
+
+void LogsDatabaseBuffer::Commit(std::vector<std::vector<std::string>> const& transactions)
+{
+    for (std::vector<std::string> const& statements : transactions)
+    {
+        SQLTransaction trans = LogsDatabase.BeginTransaction();
+        for (std::string const& sql : statements)
+            trans->Append(sql.c_str());
+        LogsDatabase.CommitTransaction(trans);
+    }
+}
+
+void LogsDatabaseBuffer::Update(uint32 diff)
+{
+    std::vector<std::vector<std::string>> transactions;
+    uint32 writtenRows = 0;
+    uint32 deferredFlushes = 0;
+    uint64 bufferedBytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _flushTimer += diff;
+        if (!_batchFull && _flushTimer < sWorld->getIntConfig(CONFIG_LOGS_BUFFER_FLUSH_INTERVAL))
+            return;
+
+        bufferedBytes = _bufferedBytes;
+        if (!_bufferedRows)
+            _flushTimer = 0;
+        // the database is not keeping up, don't add to its queue. Retried at next update.
+        else if (uint32 maxQueueSize = sWorld->getIntConfig(CONFIG_LOGS_BUFFER_MAX_QUEUE_SIZE); maxQueueSize && LogsDatabase.QueueSize() > maxQueueSize)
+            deferredFlushes = 1;
+        else
+        {
+            writtenRows = uint32(_bufferedRows);
+            TakeStatements(transactions);
+        }
+    }
+
+    Commit(transactions);
+
+    uint32 statementCount = 0;
+    for (std::vector<std::string> const& statements : transactions)
+        statementCount += uint32(statements.size());
+
+    sMonitor->AddLogsBufferCounts(writtenRows, statementCount, deferredFlushes, _droppedRows.exchange(0), bufferedBytes);
+}
+
+void LogsDatabaseBuffer::Flush()
+{
+    std::vector<std::vector<std::string>> transactions;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        TakeStatements(transactions);
+    }
+
+    Commit(transactions);
+}
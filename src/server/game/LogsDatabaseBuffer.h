@@ -0,0 +1,91 @@
+#ifndef _LOGSDATABASEBUFFER_H
+#define _LOGSDATABASEBUFFER_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Log tables written through LogsDatabaseBuffer. Tables referencing another one must come after it, they are flushed in this order.
+enum LogsBufferTable
+{
+    LOGS_BUFFER_ACCOUNT_IP,
+    LOGS_BUFFER_CHAR_AUCTION_CREATE,
+    LOGS_BUFFER_CHAR_AUCTION_WON,
+    LOGS_BUFFER_CHAR_CHAT,
+    LOGS_BUFFER_CHAR_ITEM_VENDOR,
+    LOGS_BUFFER_CHAR_TRADE,
+    LOGS_BUFFER_CHAR_TRADE_ITEMS,
+    LOGS_BUFFER_GM_COMMAND,
+    LOGS_BUFFER_MAIL,
+    LOGS_BUFFER_MAIL_ITEMS,
+    LOGS_BUFFER_WARDEN_FAILS,
+
+    MAX_LOGS_BUFFER_TABLES
+};
+
+// Values of one log row, in the column order of its table (see LogsDatabaseBuffer.cpp)
+class TC_GAME_API LogsDatabaseRow
+{
+public:
+    LogsDatabaseRow& operator<<(bool value);
+    LogsDatabaseRow& operator<<(int32 value);
+    LogsDatabaseRow& operator<<(uint32 value);
+    LogsDatabaseRow& operator<<(int64 value);
+    LogsDatabaseRow& operator<<(uint64 value);
+    LogsDatabaseRow& operator<<(float value);
+    // escaped
+    LogsDatabaseRow& operator<<(std::string const& value);
+
+    std::string const& GetValues() const { return _values; }
+
+private:
+    void Separate() { if (!_values.empty()) _values += ','; }
+
+    std::string _values;
+};
+
+/**
+    Buffers the rows of the busiest log tables and writes them as multi-row INSERTs, one transaction per table (tables with a
+    foreign key share the transaction of the table they reference) so that a failing row only loses its own table, every
+    DBLog.Buffer.FlushInterval ms or at the next world update once a table holds DBLog.Buffer.BatchSize rows.
+    While the LogsDatabase queue holds more than DBLog.Buffer.MaxQueueSize operations flushes are deferred, rows keep
+    accumulating until DBLog.Buffer.MaxMemory is reached and are dropped past it.
+    Rows can be added from any thread.
+*/
+class TC_GAME_API LogsDatabaseBuffer
+{
+public:
+    static LogsDatabaseBuffer* instance();
+
+    void Append(LogsBufferTable table, LogsDatabaseRow const& row);
+
+    // World thread
+    void Update(uint32 diff);
+    // Write everything now, regardless of the database queue. Used at shutdown.
+    void Flush();
+
+private:
+    LogsDatabaseBuffer();
+
+    // Build the INSERTs for all buffered rows, grouped by transaction, and empty the buffers. _lock must be held.
+    void TakeStatements(std::vector<std::vector<std::string>>& transactions);
+    static void Commit(std::vector<std::vector<std::string>> const& transactions);
+    static void BuildInsert(LogsBufferTable table, std::string const* rows, size_t count, std::string& sql);
+
+    std::mutex _lock;
+    std::array<std::vector<std::string>, MAX_LOGS_BUFFER_TABLES> _rows;
+    size_t _bufferedRows;
+    size_t _bufferedBytes;
+    bool _batchFull;
+    uint32 _flushTimer;
+
+    // reported to the Monitor at each flush
+    std::atomic<uint32> _droppedRows;
+};
+
+#define sLogsDatabaseBuffer LogsDatabaseBuffer::instance()
+
+#endif //_LOGSDATABASEBUFFER_H
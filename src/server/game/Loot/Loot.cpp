@@ -35,7 +35,8 @@ LootItem::LootItem(LootStoreItem const& li)
 // Basic checks for player/item compatibility - if false no chance to see the item in the loot
 bool LootItem::AllowedForPlayer(Player const * player) const
 {
-    if (!sConditionMgr->IsObjectMeetToConditions(const_cast<Player*>(player), conditions))
+    ConditionSourceInfo srcInfo(player);
+    if (!conditions.Meets(srcInfo))
         return false;
 
     if (needs_quest)
@@ -115,7 +116,7 @@ void Loot::AddItem(LootStoreItem const & item)
         // non-conditional one-player only items are counted here,
         // free for all items are counted in FillFFALoot(),
         // non-ffa conditionals are counted in FillNonQuestNonFFAConditionalLoot()
-        if (!item.needs_quest && item.conditions.empty() && !(proto->Flags & ITEM_FLAG_MULTI_DROP))
+        if (!item.needs_quest && item.conditions.Conditions.empty() && !(proto->Flags & ITEM_FLAG_MULTI_DROP))
             ++unlootedCount;
     }
 }
@@ -277,7 +278,7 @@ NotNormalLootItemList* Loot::FillNonQuestNonFFAConditionalLoot(Player* player, b
             if (presentAtLooting)
                 item.AddAllowedLooter(player);
 
-            if (!item.conditions.empty())
+            if (!item.conditions.Conditions.empty())
             {
                 ql->push_back(NotNormalLootItem(i));
                 if (!item.is_counted)
@@ -415,7 +416,7 @@ LootItem* Loot::LootItemInSlot(uint32 lootSlot, Player* player, NotNormalLootIte
                     }
             }
         }
-        else if (!item->conditions.empty())
+        else if (!item->conditions.Conditions.empty())
         {
             NotNormalLootItemMap::const_iterator itr = PlayerNonQuestNonFFAConditionalItems.find(player->GetGUID());
             if (itr != PlayerNonQuestNonFFAConditionalItems.end())
@@ -455,7 +456,7 @@ bool Loot::hasItemForAll() const
         return true;
 
     for (LootItem const& item : items)
-        if (!item.is_looted && !item.freeforall && item.conditions.empty())
+        if (!item.is_looted && !item.freeforall && item.conditions.Conditions.empty())
             return true;
     return false;
 }
@@ -557,7 +558,7 @@ ByteBuffer& operator<<(ByteBuffer& b, LootView const& lv)
         // blocked rolled items and quest items, and !ffa items
         for (uint8 i = 0; i < l.items.size(); ++i)
         {
-            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
+            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.Conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
             {
                 uint8 slot_type;
 
@@ -612,7 +613,7 @@ ByteBuffer& operator<<(ByteBuffer& b, LootView const& lv)
     {
         for (uint8 i = 0; i < l.items.size(); ++i)
         {
-            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
+            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.Conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
             {
                 if (!l.roundRobinPlayer.IsEmpty() && lv.viewer->GetGUID() != l.roundRobinPlayer)
                     // item shall not be displayed.
@@ -631,7 +632,7 @@ ByteBuffer& operator<<(ByteBuffer& b, LootView const& lv)
         uint8 slot_type = lv.permission == OWNER_PERMISSION ? LOOT_SLOT_TYPE_OWNER : LOOT_SLOT_TYPE_ALLOW_LOOT;
         for (uint8 i = 0; i < l.items.size(); ++i)
         {
-            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
+            if (!l.items[i].is_looted && !l.items[i].freeforall && l.items[i].conditions.Conditions.empty() && l.items[i].AllowedForPlayer(lv.viewer))
             {
                 b << uint8(i) << l.items[i];
                 b << uint8(slot_type);
@@ -97,7 +97,7 @@ struct TC_GAME_API LootItem
     uint32  itemid;
     uint32  randomSuffix;
     int32   randomPropertyId;
-    ConditionContainer conditions;                               // additional loot condition
+    CompiledConditions conditions;                               // additional loot condition
     ObjectGuid rollWinnerGUID;                              // Stores the guid of person who won loot, if his bags are full only he can see the item in loot list!
     uint16  conditionId : 16;                          // old conditions, allow compiler pack structure
     uint8   count : 8;
@@ -22,6 +22,7 @@
 #include "Log.h"
 #include "ObjectMgr.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 #include "Util.h"
 #include "SharedDefines.h"
 #include "ItemEnchantmentMgr.h"
@@ -80,6 +81,7 @@ class LootTemplate::LootGroup                               // A set of loot def
         ~LootGroup();
 
         void AddEntry(LootStoreItem* item);                 // Adds an entry to the group (at loading stage)
+        void Compile();                                     // Builds the alias table, once all entries are added
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const * player) const;
                                                             // The same for active quests of the player
@@ -96,7 +98,15 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Alias table over ExplicitlyChanced, the last slot holds the chance left to EqualChanced (or to no drop)
+        std::vector<float> AliasChance;
+        std::vector<uint32> Alias;
+        std::vector<uint32> ItemIds;                        // sorted item ids of all entries
+        uint16 CommonLootMode = 0xFFFF;                     // loot mode bits set for all entries
+
         LootStoreItem const* Roll(Loot& loot, uint16 lootMode) const;   // Rolls an item from the group, returns NULL if all miss their chances
+        LootStoreItem const* RollFiltered(Loot& loot, uint16 lootMode) const; // Same, with the entries not allowed for this loot taken out first
+        bool HasEntryInLoot(Loot const& loot) const;
 
         // This class must never be copied - storing pointers
         LootGroup(LootGroup const&) = delete;
@@ -133,7 +143,7 @@ uint32 LootStore::LoadLootTable()
     TC_LOG_INFO("server.loading", "%s :", GetName());
 
     //                                                 0     1     2          3       4              5         6        7         8        
-    QueryResult result = WorldDatabase.PQuery("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM %s", GetName());
+    QueryResult result = WorldSnapshot::Query(GetName(), std::string("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM ") + GetName(), { GetName() });
 
     if(!result)
         return 0;
@@ -160,6 +170,9 @@ uint32 LootStore::LoadLootTable()
             continue;
         }
 
+        if (!reference)
+            storeitem->proto = sObjectMgr->GetItemTemplate(item);
+
         // Looking for the template of the entry
                                                         // often entries are put together
         if (m_LootTemplates.empty() || tab->first != entry)
@@ -181,6 +194,9 @@ uint32 LootStore::LoadLootTable()
 
     } while (result->NextRow());
 
+    for (auto const& itr : m_LootTemplates)
+        itr.second->Compile();
+
     Verify();                                           // Checks validity of the loot store
 
     return count;
@@ -277,9 +293,7 @@ bool LootStoreItem::Roll(bool rate) const
     if (reference > 0)                                   // reference case
         return roll_chance_f(chance* (rate ? sWorld->GetRate(RATE_DROP_ITEM_REFERENCED) : 1.0f));
 
-    ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(itemid);
-
-    float qualityModifier = pProto ? sWorld->GetRate(qualityToRate[pProto->Quality]) : 1.0f;
+    float qualityModifier = proto ? sWorld->GetRate(qualityToRate[proto->Quality]) : 1.0f;
 
     return roll_chance_f(chance*qualityModifier);
 }
@@ -362,19 +376,119 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
         EqualChanced.push_back(item);
 }
 
+// Builds the alias table giving each explicitly chanced entry the chance RollFiltered would give it
+// (entries are taken in order until the roll is spent), so that rolling is O(1)
+void LootTemplate::LootGroup::Compile()
+{
+    AliasChance.clear();
+    Alias.clear();
+    ItemIds.clear();
+    CommonLootMode = 0xFFFF;
+
+    for (LootStoreItem const* item : ExplicitlyChanced)
+    {
+        ItemIds.push_back(item->itemid);
+        CommonLootMode &= item->lootmode;
+    }
+
+    for (LootStoreItem const* item : EqualChanced)
+    {
+        ItemIds.push_back(item->itemid);
+        CommonLootMode &= item->lootmode;
+    }
+
+    std::sort(ItemIds.begin(), ItemIds.end());
+    ItemIds.erase(std::unique(ItemIds.begin(), ItemIds.end()), ItemIds.end());
+
+    if (ExplicitlyChanced.empty())
+        return;
+
+    uint32 const count = uint32(ExplicitlyChanced.size()) + 1;
+    std::vector<double> weights(count);
+    double total = 0.0;
+    for (uint32 i = 0; i < count - 1; ++i)
+    {
+        weights[i] = std::min(std::min(double(ExplicitlyChanced[i]->chance), 100.0), 100.0 - total);
+        total += weights[i];
+    }
+    weights[count - 1] = 100.0 - total;
+
+    // Vose's alias method: each slot keeps its own outcome with AliasChance, else gives Alias
+    AliasChance.resize(count, 1.0f);
+    Alias.resize(count);
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Alias[i] = i;
+        weights[i] *= count / 100.0;
+        if (weights[i] < 1.0)
+            small.push_back(i);
+        else
+            large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+        large.pop_back();
+
+        AliasChance[less] = float(weights[less]);
+        Alias[less] = more;
+        weights[more] -= 1.0 - weights[less];
+        if (weights[more] < 1.0)
+            small.push_back(more);
+        else
+            large.push_back(more);
+    }
+    // leftovers are only rounding errors away from 1
+}
+
+// True if an entry of the group may already be in the loot (and then be excluded by LootGroupInvalidSelector)
+bool LootTemplate::LootGroup::HasEntryInLoot(Loot const& loot) const
+{
+    for (LootItem const& lootItem : loot.items)
+        if (std::binary_search(ItemIds.begin(), ItemIds.end(), lootItem.itemid))
+            return true;
+
+    return false;
+}
+
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, uint16 lootMode) const
+{
+    // excluded entries shift the chances of the following ones, roll the slow way
+    if (!(CommonLootMode & lootMode) || HasEntryInLoot(loot))
+        return RollFiltered(loot, lootMode);
+
+    if (!AliasChance.empty())                               // First explicitly chanced entries are checked
+    {
+        uint32 slot = urand(0, uint32(AliasChance.size()) - 1);
+        if (rand_norm() >= AliasChance[slot])
+            slot = Alias[slot];
+
+        if (slot < ExplicitlyChanced.size())
+            return ExplicitlyChanced[slot];
+    }
+
+    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+        return EqualChanced[urand(0, uint32(EqualChanced.size()) - 1)];
+
+    return nullptr;                                         // Empty drop from the group
+}
+
+LootStoreItem const* LootTemplate::LootGroup::RollFiltered(Loot& loot, uint16 lootMode) const
 {
     LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    possibleLoot.erase(std::remove_if(possibleLoot.begin(), possibleLoot.end(), LootGroupInvalidSelector(loot, lootMode)), possibleLoot.end());
 
     if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
     {
         float roll = (float)rand_chance();
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+        for (LootStoreItem* item : possibleLoot)           // check each explicitly chanced entry in the template and modify its chance based on quality.
         {
-            LootStoreItem* item = *itr;
             if (item->chance >= 100.0f)
                 return item;
 
@@ -385,7 +499,7 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, uint16 lootMode)
     }
 
     possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    possibleLoot.erase(std::remove_if(possibleLoot.begin(), possibleLoot.end(), LootGroupInvalidSelector(loot, lootMode)), possibleLoot.end());
     if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
         return Trinity::Containers::SelectRandomContainerElement(possibleLoot);
 
@@ -419,10 +533,10 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const * player) const
 void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
 {
     for (auto & i : ExplicitlyChanced)
-        i->conditions.clear();
+        i->conditions.Clear();
 
     for (auto & i : EqualChanced)
-        i->conditions.clear();
+        i->conditions.Clear();
 }
 
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
@@ -519,11 +633,18 @@ void LootTemplate::AddEntry(LootStoreItem* item)
         Entries.push_back(item);
 }
 
+void LootTemplate::Compile()
+{
+    for (LootGroup* group : Groups)
+        if (group)
+            group->Compile();
+}
+
 
 void LootTemplate::CopyConditions(const ConditionContainer& conditions)
 {
     for (auto & Entrie : Entries)
-        Entrie->conditions.clear();
+        Entrie->conditions.Clear();
 
     for (auto group : Groups)
         if (group)
@@ -559,9 +680,8 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId
     }
 
     // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    for (LootStoreItem const* item : Entries)
     {
-        LootStoreItem* item = *i;
         if (!(item->lootmode & lootMode))                       // Do not add if mode mismatch
             continue;
 
@@ -570,7 +690,7 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId
 
         if (item->reference > 0)                            // References processing
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(item->reference);
+            LootTemplate const* Referenced = item->referenced ? item->referenced : LootTemplates_Reference.GetLootFor(item->reference);
             if (!Referenced)
                 continue;                                       // Error message already printed at loading stage
 
@@ -676,7 +796,9 @@ void LootTemplate::CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_se
     {
         if(item->reference > 0)
         {
-            if(!LootTemplates_Reference.GetLootFor(item->reference))
+            // also links the reference for Process, this is called again for all stores whenever references are reloaded
+            item->referenced = LootTemplates_Reference.GetLootFor(item->reference);
+            if(!item->referenced)
                 LootTemplates_Reference.ReportNonExistingId(item->reference, "Reference", item->itemid);
             else if(ref_set)
                 ref_set->erase(item->reference);
@@ -688,12 +810,12 @@ void LootTemplate::CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_se
             group->CheckLootRefs(store,ref_set);
 }
 
-bool LootTemplate::addConditionItem(Condition* cond)
+CompiledConditions* LootTemplate::addConditionItem(Condition* cond)
 {
     if (!cond || !cond->isLoaded())//should never happen, checked at loading
     {
         TC_LOG_ERROR("loot", "LootTemplate::addConditionItem: condition is null");
-        return false;
+        return nullptr;
     }
 
     if (!Entries.empty())
@@ -702,8 +824,8 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if (Entrie->itemid == uint32(cond->SourceEntry))
             {
-                Entrie->conditions.push_back(cond);
-                return true;
+                Entrie->conditions.Conditions.push_back(cond);
+                return &Entrie->conditions;
             }
         }
     }
@@ -722,8 +844,8 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if (i->itemid == uint32(cond->SourceEntry))
                     {
-                        i->conditions.push_back(cond);
-                        return true;
+                        i->conditions.Conditions.push_back(cond);
+                        return &i->conditions;
                     }
                 }
             }
@@ -735,14 +857,14 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if (i->itemid == uint32(cond->SourceEntry))
                     {
-                        i->conditions.push_back(cond);
-                        return true;
+                        i->conditions.Conditions.push_back(cond);
+                        return &i->conditions;
                     }
                 }
             }
         }
     }
-    return false;
+    return nullptr;
 }
 
 bool LootTemplate::isReference(uint32 id)
@@ -29,6 +29,7 @@ class Player;
 class LootStore;
 struct Loot;
 struct LootItem;
+struct ItemTemplate;
 
 struct LootStoreItem
 {
@@ -40,13 +41,15 @@ struct LootStoreItem
     uint8   groupid;
     uint8   mincount;                                       // mincount for drop items
     uint8   maxcount;                                       // max drop count for the item mincount or Ref multiplicator
-    ConditionContainer conditions;                               // additional loot condition
+    CompiledConditions conditions;                               // additional loot condition
+    ItemTemplate const* proto;                              // filled at loading for items
+    LootTemplate const* referenced;                         // filled by LootStore::CheckLootRefs for references
 
                                                                  // Constructor
                                                                  // displayid is filled in IsValid() which must be called after
     LootStoreItem(uint32 _itemid, uint32 _reference, float _chance, bool _needs_quest, uint16 _lootmode, uint8 _groupid, int32 _mincount, uint8 _maxcount)
         : itemid(_itemid), reference(_reference), chance(_chance), lootmode(_lootmode),
-        needs_quest(_needs_quest), groupid(_groupid), mincount(_mincount), maxcount(_maxcount)
+        needs_quest(_needs_quest), groupid(_groupid), mincount(_mincount), maxcount(_maxcount), proto(nullptr), referenced(nullptr)
     { }
 
     bool Roll(bool rate) const;                             // Checks if the entry takes it's chance (at loot generation)
@@ -56,7 +59,7 @@ struct LootStoreItem
 struct Loot;
 class LootTemplate;
 
-typedef std::list<LootStoreItem*> LootStoreItemList;
+typedef std::vector<LootStoreItem*> LootStoreItemList;
 typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
 
 typedef std::set<uint32> LootIdSet;
@@ -107,6 +110,8 @@ class TC_GAME_API LootTemplate
 
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem* item);
+        // Prepares groups for rolling, once all entries are added
+        void Compile();
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId = 0) const;
         void CopyConditions(const ConditionContainer& conditions);
@@ -120,7 +125,8 @@ class TC_GAME_API LootTemplate
         // Checks integrity of the template
         void Verify(LootStore const& store, uint32 Id) const;
         void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
-        bool addConditionItem(Condition* cond);
+        // Add cond to the item it is for, return the conditions of this item or nullptr if not found
+        CompiledConditions* addConditionItem(Condition* cond);
         bool isReference(uint32 id);
         
     private:
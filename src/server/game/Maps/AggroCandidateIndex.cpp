@@ -0,0 +1,150 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AggroCandidateIndex.h"
+#include "CellImpl.h"
+#include "Creature.h"
+#include "Map.h"
+#include "Monitor.h"
+#include "Timer.h"
+
+namespace
+{
+    uint32 const REPORT_INTERVAL = 5 * IN_MILLISECONDS;
+
+    bool IsOwnedOrControlled(Creature const* creature)
+    {
+        return !creature->GetCharmerOrOwnerGUID().IsEmpty() || creature->IsControlledByPlayer();
+    }
+
+    struct AggroCandidateCollector
+    {
+        AggroCandidateIndex& i_index;
+
+        explicit AggroCandidateCollector(AggroCandidateIndex& index) : i_index(index) { }
+
+        template<class T> void Visit(GridRefManager<T> &) { }
+        void Visit(CreatureMapType &m)
+        {
+            for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+                i_index.Add(iter->GetSource());
+        }
+    };
+}
+
+AggroCandidateIndex::AggroCandidateIndex()
+    : _built(false), _updateTimer(REPORT_INTERVAL), _checkedPairs(0), _culledPairs(0), _skippedVisits(0)
+{
+}
+
+void AggroCandidateIndex::Add(Creature const* creature)
+{
+    uint8 const flags = creature->GetAggroFlags();
+    if (!(flags & CREATURE_AGGRO_OBSERVER))
+        return;
+
+    if ((flags & CREATURE_AGGRO_ANY_UNIT) || IsOwnedOrControlled(creature))
+        _unconditionalCells.insert(Trinity::ComputeCellCoord(creature->GetPositionX(), creature->GetPositionY()).normalize().GetId());
+    else
+        _observerFactions.emplace(creature->GetFaction(), creature);
+}
+
+void AggroCandidateIndex::Build(Map& map)
+{
+    Clear();
+
+    // pets are in the world containers, all other creatures in the grid ones
+    AggroCandidateCollector collector(*this);
+    TypeContainerVisitor<AggroCandidateCollector, GridTypeMapContainer> gridVisitor(collector);
+    TypeContainerVisitor<AggroCandidateCollector, WorldTypeMapContainer> worldVisitor(collector);
+    for (GridRefManager<NGridType>::iterator i = map.begin(); i != map.end(); ++i)
+    {
+        i->GetSource()->VisitAllGrids(gridVisitor);
+        i->GetSource()->VisitAllGrids(worldVisitor);
+    }
+
+    _built = true;
+}
+
+bool AggroCandidateIndex::CanBeObserved(Map& map, Creature const* creature, float radius)
+{
+    if (!_built)
+        Build(map);
+
+    if (IsOwnedOrControlled(creature))
+        return true;
+
+    // same area as the relocation notifier visit
+    if (!_unconditionalCells.empty())
+    {
+        CellArea const area = Cell::CalculateCellArea(*creature, radius + creature->GetCombatReach());
+        for (uint32 cellId : _unconditionalCells)
+        {
+            uint32 const x = cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP;
+            uint32 const y = cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP;
+            if (x >= area.low_bound.x_coord && x <= area.high_bound.x_coord && y >= area.low_bound.y_coord && y <= area.high_bound.y_coord)
+                return true;
+        }
+    }
+
+    // GetReactionTo between two creatures nobody owns or controls only depends on their factions
+    uint32 const faction = creature->GetFaction();
+    auto itr = _observedFactions.find(faction);
+    if (itr != _observedFactions.end())
+        return itr->second;
+
+    bool observed = false;
+    for (auto const& observer : _observerFactions)
+    {
+        // the answer for its own faction would not hold for the other creatures sharing it
+        if (observer.second == creature)
+            return true;
+
+        if (!observer.second->IsFriendlyTo(creature))
+        {
+            observed = true;
+            break;
+        }
+    }
+
+    _observedFactions[faction] = observed;
+    return observed;
+}
+
+void AggroCandidateIndex::Clear()
+{
+    _built = false;
+    _unconditionalCells.clear();
+    _observerFactions.clear();
+    _observedFactions.clear();
+}
+
+void AggroCandidateIndex::Update(uint32 diff)
+{
+    if (_updateTimer > diff)
+    {
+        _updateTimer -= diff;
+        return;
+    }
+
+    _updateTimer = REPORT_INTERVAL;
+
+    if (_checkedPairs || _culledPairs || _skippedVisits)
+        sMonitor->AddAggroCullingCounts(_checkedPairs, _culledPairs, _skippedVisits);
+
+    _checkedPairs = 0;
+    _culledPairs = 0;
+    _skippedVisits = 0;
+}
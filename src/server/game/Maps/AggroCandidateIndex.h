@@ -0,0 +1,71 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_AGGROCANDIDATEINDEX_H
+#define TRINITY_AGGROCANDIDATEINDEX_H
+
+#include "Define.h"
+#include <unordered_map>
+#include <unordered_set>
+
+class Creature;
+class Map;
+
+/**
+    Which creatures of a map may react to other creatures moving in their sight, see Creature::GetAggroFlags.
+    Relocation notifiers use it to skip the creature/creature pairs of a moving creature when nothing around can react to it:
+    observers with a default AI only react to units they are not friendly with, and between two creatures nobody owns or
+    controls, friendliness only depends on their factions. Observers that may react to anything (scripted, or owned or
+    controlled by someone) are only kept by cell, they only prevent culling of the creatures in the cells around them.
+    Built on first use during a relocation batch and dropped at its end (it holds creature pointers), or as soon as a creature
+    of the map changes AI, react state, faction or template.
+    Not thread safe, only used from the map update thread.
+*/
+class TC_GAME_API AggroCandidateIndex
+{
+public:
+    AggroCandidateIndex();
+
+    // false if no creature of map within radius of creature can react to it in MoveInLineOfSight
+    bool CanBeObserved(Map& map, Creature const* creature, float radius);
+
+    void Invalidate() { _built = false; }
+    void Clear();
+
+    // Count one creature/unit pair given to the relocation worker, culled if skipped because of the aggro flags
+    void CountPair(bool culled) { ++(culled ? _culledPairs : _checkedPairs); }
+    // Count one creature container visit skipped thanks to the index
+    void CountSkippedVisit() { ++_skippedVisits; }
+
+    // Report the counts to the Monitor, every few seconds
+    void Update(uint32 diff);
+
+    // used when building the index
+    void Add(Creature const* creature);
+
+private:
+    void Build(Map& map);
+
+    bool _built;
+    std::unordered_set<uint32> _unconditionalCells; // cell ids holding a scripted observer, or an observer owned or controlled by someone, those may react to anything
+    std::unordered_map<uint32, Creature const*> _observerFactions; // faction -> one observer with a default AI
+    std::unordered_map<uint32, bool> _observedFactions; // faction -> CanBeObserved result for creatures nobody owns or controls
+    uint32 _updateTimer;
+    uint32 _checkedPairs;
+    uint32 _culledPairs;
+    uint32 _skippedVisits;
+};
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include "GameTime.h"
+#include "Monitor.h"
+#include "Timer.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    uint32 const PURGE_INTERVAL = 5 * IN_MILLISECONDS;
+
+    int32 Quantize(float value)
+    {
+        return int32(std::floor(value / LineOfSightCache::QUANTUM));
+    }
+
+    // 64 yards regions, map coordinates are within +-17067 yards
+    int32 const REGION_OFFSET = 512;
+
+    int32 RegionCoord(float value)
+    {
+        return int32(std::floor(value / LineOfSightCache::REGION_SIZE)) + REGION_OFFSET;
+    }
+
+    uint32 RegionId(int32 x, int32 y)
+    {
+        return (uint32(x) << 16) | uint32(y & 0xFFFF);
+    }
+
+    bool IsFresh(uint32 storeTime)
+    {
+        return GetMSTimeDiff(storeTime, GameTime::GetGameTimeMS()) < sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL);
+    }
+}
+
+LineOfSightCache::Key::Key(G3D::Vector3 const& start, G3D::Vector3 const& end, uint32 phaseMask, uint32 ignoreFlags)
+    : PhaseMask(phaseMask), IgnoreFlags(ignoreFlags)
+{
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        Start[i] = Quantize(start[i]);
+        End[i] = Quantize(end[i]);
+    }
+}
+
+bool LineOfSightCache::Key::operator==(Key const& other) const
+{
+    for (uint8 i = 0; i < 3; ++i)
+        if (Start[i] != other.Start[i] || End[i] != other.End[i])
+            return false;
+
+    return PhaseMask == other.PhaseMask && IgnoreFlags == other.IgnoreFlags;
+}
+
+size_t LineOfSightCache::KeyHash::operator()(Key const& key) const
+{
+    // FNV-1a over the key fields
+    uint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (uint8 i = 0; i < 3; ++i)
+    {
+        mix(uint32(key.Start[i]));
+        mix(uint32(key.End[i]));
+    }
+    mix(key.PhaseMask);
+    mix(key.IgnoreFlags);
+    return size_t(hash);
+}
+
+LineOfSightCache::LineOfSightCache()
+    : _dynamicGeneration(0), _updateTimer(PURGE_INTERVAL), _hits(0), _misses(0)
+{
+}
+
+LineOfSightCache::CachedResult LineOfSightCache::FindStatic(Key const& key) const
+{
+    auto itr = _entries.find(key);
+    if (itr == _entries.end() || itr->second.Static == RESULT_UNKNOWN || !IsFresh(itr->second.StaticTime))
+        return RESULT_UNKNOWN;
+
+    return itr->second.Static;
+}
+
+LineOfSightCache::CachedResult LineOfSightCache::FindDynamic(Key const& key) const
+{
+    auto itr = _entries.find(key);
+    if (itr == _entries.end() || !IsDynamicValid(itr->first, itr->second))
+        return RESULT_UNKNOWN;
+
+    return itr->second.Dynamic;
+}
+
+bool LineOfSightCache::IsDynamicValid(Key const& key, Entry const& entry) const
+{
+    return entry.Dynamic != RESULT_UNKNOWN && IsFresh(entry.DynamicTime) && GetDynamicGeneration(key) <= entry.DynamicGeneration;
+}
+
+uint64 LineOfSightCache::GetDynamicGeneration(Key const& key) const
+{
+    if (_regionGenerations.empty())
+        return 0;
+
+    // the segment stays within the box of its ends, quantized ends are at most QUANTUM yards off
+    int32 const minX = RegionCoord(std::min(key.Start[0], key.End[0]) * QUANTUM);
+    int32 const maxX = RegionCoord((std::max(key.Start[0], key.End[0]) + 1) * QUANTUM);
+    int32 const minY = RegionCoord(std::min(key.Start[1], key.End[1]) * QUANTUM);
+    int32 const maxY = RegionCoord((std::max(key.Start[1], key.End[1]) + 1) * QUANTUM);
+
+    uint64 generation = 0;
+    for (int32 x = minX; x <= maxX; ++x)
+    {
+        for (int32 y = minY; y <= maxY; ++y)
+        {
+            auto itr = _regionGenerations.find(RegionId(x, y));
+            if (itr != _regionGenerations.end())
+                generation = std::max(generation, itr->second);
+        }
+    }
+    return generation;
+}
+
+void LineOfSightCache::InvalidateDynamic(G3D::AABox const& bounds)
+{
+    ++_dynamicGeneration;
+    int32 const maxX = RegionCoord(bounds.high().x);
+    int32 const maxY = RegionCoord(bounds.high().y);
+    for (int32 x = RegionCoord(bounds.low().x); x <= maxX; ++x)
+        for (int32 y = RegionCoord(bounds.low().y); y <= maxY; ++y)
+            _regionGenerations[RegionId(x, y)] = _dynamicGeneration;
+}
+
+LineOfSightCache::Entry* LineOfSightCache::GetOrCreate(Key const& key)
+{
+    auto itr = _entries.find(key);
+    if (itr != _entries.end())
+        return &itr->second;
+
+    // full until the next purge, queries still work, they are just not cached
+    if (_entries.size() >= MAX_ENTRIES)
+        return nullptr;
+
+    Entry& entry = _entries[key];
+    entry.StaticTime = 0;
+    entry.DynamicTime = 0;
+    entry.DynamicGeneration = 0;
+    entry.Static = RESULT_UNKNOWN;
+    entry.Dynamic = RESULT_UNKNOWN;
+    return &entry;
+}
+
+void LineOfSightCache::StoreStatic(Key const& key, bool result)
+{
+    if (Entry* entry = GetOrCreate(key))
+    {
+        entry->StaticTime = GameTime::GetGameTimeMS();
+        entry->Static = result ? RESULT_CLEAR : RESULT_BLOCKED;
+    }
+}
+
+void LineOfSightCache::StoreDynamic(Key const& key, bool result)
+{
+    if (Entry* entry = GetOrCreate(key))
+    {
+        entry->DynamicTime = GameTime::GetGameTimeMS();
+        entry->DynamicGeneration = _dynamicGeneration;
+        entry->Dynamic = result ? RESULT_CLEAR : RESULT_BLOCKED;
+    }
+}
+
+void LineOfSightCache::Update(uint32 diff)
+{
+    if (_updateTimer > diff)
+    {
+        _updateTimer -= diff;
+        return;
+    }
+
+    _updateTimer = PURGE_INTERVAL;
+
+    // regions invalidated before every remaining dynamic result was stored don't matter anymore
+    uint64 oldestGeneration = _dynamicGeneration;
+    for (auto itr = _entries.begin(); itr != _entries.end();)
+    {
+        Entry const& entry = itr->second;
+        bool const staticFresh = entry.Static != RESULT_UNKNOWN && IsFresh(entry.StaticTime);
+        bool const dynamicFresh = IsDynamicValid(itr->first, entry);
+        if (dynamicFresh)
+            oldestGeneration = std::min(oldestGeneration, entry.DynamicGeneration);
+
+        if (staticFresh || dynamicFresh)
+            ++itr;
+        else
+            itr = _entries.erase(itr);
+    }
+
+    for (auto itr = _regionGenerations.begin(); itr != _regionGenerations.end();)
+    {
+        if (itr->second <= oldestGeneration)
+            itr = _regionGenerations.erase(itr);
+        else
+            ++itr;
+    }
+
+    if (_hits || _misses)
+        sMonitor->AddLineOfSightCacheCounts(_hits, _misses);
+
+    _hits = 0;
+    _misses = 0;
+}
+
+void LineOfSightCache::Clear()
+{
+    _entries.clear();
+    _regionGenerations.clear();
+}
@@ -0,0 +1,104 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LINEOFSIGHTCACHE_H
+#define TRINITY_LINEOFSIGHTCACHE_H
+
+#include "Define.h"
+#include <G3D/AABox.h>
+#include <G3D/Vector3.h>
+#include <unordered_map>
+
+/**
+    Short lived line of sight results of one map, keyed by quantized segment ends, phase mask and vmap ignore flags.
+    Static (vmap) and dynamic (gameobject) results are kept apart: static ones only expire with the TTL while dynamic
+    ones are also dropped as soon as a gameobject model is inserted, removed, moved or toggled near them, so opening a
+    door is seen right away. Invalidation is tracked per REGION_SIZE yards square: a moving transport only drops the
+    results of segments crossing the regions its bounds cover.
+    Ends are snapped to QUANTUM yards, segments closer than that share their result.
+    Not thread safe, only used from the map update thread like the DynamicMapTree it caches.
+*/
+class TC_GAME_API LineOfSightCache
+{
+public:
+    static constexpr float QUANTUM = 0.25f;
+    static constexpr uint32 MAX_ENTRIES = 16384;
+    static constexpr float REGION_SIZE = 64.0f;
+
+    enum CachedResult : int8
+    {
+        RESULT_UNKNOWN = -1,
+        RESULT_BLOCKED = 0,
+        RESULT_CLEAR   = 1,
+    };
+
+    struct Key
+    {
+        Key(G3D::Vector3 const& start, G3D::Vector3 const& end, uint32 phaseMask, uint32 ignoreFlags);
+
+        bool operator==(Key const& other) const;
+
+        int32 Start[3];
+        int32 End[3];
+        uint32 PhaseMask;
+        uint32 IgnoreFlags;
+    };
+
+    LineOfSightCache();
+
+    CachedResult FindStatic(Key const& key) const;
+    CachedResult FindDynamic(Key const& key) const;
+    void StoreStatic(Key const& key, bool result);
+    void StoreDynamic(Key const& key, bool result);
+
+    // A gameobject model with these bounds changed in the map, forget the dynamic results of segments crossing them
+    void InvalidateDynamic(G3D::AABox const& bounds);
+
+    // Count one query, hit if it was answered without touching the trees
+    void CountQuery(bool hit) { ++(hit ? _hits : _misses); }
+
+    // Purge expired entries and report hits and misses to the Monitor, every few seconds
+    void Update(uint32 diff);
+    void Clear();
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const;
+    };
+
+    struct Entry
+    {
+        uint32 StaticTime;
+        uint32 DynamicTime;
+        uint64 DynamicGeneration;
+        CachedResult Static;
+        CachedResult Dynamic;
+    };
+
+    Entry* GetOrCreate(Key const& key);
+    // Last invalidation of the regions covered by the segment of key
+    uint64 GetDynamicGeneration(Key const& key) const;
+    bool IsDynamicValid(Key const& key, Entry const& entry) const;
+
+    std::unordered_map<Key, Entry, KeyHash> _entries;
+    std::unordered_map<uint32 /*region*/, uint64 /*generation*/> _regionGenerations;
+    uint64 _dynamicGeneration;              // incremented by every invalidation, transports do it every update
+    uint32 _updateTimer;
+    uint32 _hits;
+    uint32 _misses;
+};
+
+#endif
@@ -738,6 +738,9 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
             }
         }
     }
+
+    // the index keeps creature pointers, do not let it outlive the batch
+    _aggroCandidates.Clear();
 }
 
 void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
@@ -802,6 +805,8 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 void Map::Update(const uint32 &t_diff)
 {
     _dynamicTree.update(t_diff);
+    _losCache.Update(t_diff);
+    _aggroCandidates.Update(t_diff);
     /// update worldsessions for existing players
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -2235,13 +2240,137 @@ float Map::GetGameObjectCeil(uint32 phasemask, float x, float y, float z, float
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
-    if ((checks & LINEOFSIGHT_CHECK_VMAP)
-        && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
-    if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
-        && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
-    return true;
+    if (!sWorld->getBoolConfig(CONFIG_LOS_CACHE_ENABLED))
+    {
+        if ((checks & LINEOFSIGHT_CHECK_VMAP)
+            && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
+            return false;
+        if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
+            && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
+            return false;
+        return true;
+    }
+
+    LineOfSightCache::Key const key(G3D::Vector3(x1, y1, z1), G3D::Vector3(x2, y2, z2), phasemask, uint32(ignoreFlags));
+    bool hit = true;
+    bool result = true;
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        LineOfSightCache::CachedResult cached = _losCache.FindStatic(key);
+        if (cached == LineOfSightCache::RESULT_UNKNOWN)
+        {
+            hit = false;
+            result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags);
+            _losCache.StoreStatic(key, result);
+        }
+        else
+            result = cached == LineOfSightCache::RESULT_CLEAR;
+    }
+
+    if (result && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        LineOfSightCache::CachedResult cached = _losCache.FindDynamic(key);
+        if (cached == LineOfSightCache::RESULT_UNKNOWN)
+        {
+            hit = false;
+            result = _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+            _losCache.StoreDynamic(key, result);
+        }
+        else
+            result = cached == LineOfSightCache::RESULT_CLEAR;
+    }
+
+    _losCache.CountQuery(hit);
+    return result;
+}
+
+void Map::isInLineOfSight(G3D::Vector3 const* startPos, G3D::Vector3 const* endPos, uint32 count, bool* results, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    std::fill(results, results + count, true);
+    if (!sWorld->getBoolConfig(CONFIG_LOS_CACHE_ENABLED))
+    {
+        if (checks & LINEOFSIGHT_CHECK_VMAP)
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), startPos, endPos, count, results, ignoreFlags);
+        if (checks & LINEOFSIGHT_CHECK_GOBJECT)
+            _dynamicTree.isInLineOfSight(startPos, endPos, count, results, phasemask);
+        return;
+    }
+
+    // same as the single segment version, but the segments missing from the cache still go through the trees as one batch per tree
+    std::vector<LineOfSightCache::Key> keys;
+    keys.reserve(count);
+    std::vector<bool> hits(count, true);
+    std::vector<uint32> missing;
+    std::vector<G3D::Vector3> missingStart, missingEnd;
+    std::unique_ptr<bool[]> missingResults(new bool[count]);
+
+    auto runMissing = [&](bool dynamic)
+    {
+        if (missing.empty())
+            return;
+
+        missingStart.clear();
+        missingEnd.clear();
+        for (uint32 index : missing)
+        {
+            missingStart.push_back(startPos[index]);
+            missingEnd.push_back(endPos[index]);
+        }
+
+        uint32 const missingCount = uint32(missing.size());
+        std::fill(missingResults.get(), missingResults.get() + missingCount, true);
+        if (dynamic)
+            _dynamicTree.isInLineOfSight(missingStart.data(), missingEnd.data(), missingCount, missingResults.get(), phasemask);
+        else
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), missingStart.data(), missingEnd.data(), missingCount, missingResults.get(), ignoreFlags);
+
+        for (uint32 i = 0; i < missingCount; ++i)
+        {
+            uint32 const index = missing[i];
+            results[index] = missingResults[i];
+            hits[index] = false;
+            if (dynamic)
+                _losCache.StoreDynamic(keys[index], missingResults[i]);
+            else
+                _losCache.StoreStatic(keys[index], missingResults[i]);
+        }
+        missing.clear();
+    };
+
+    for (uint32 i = 0; i < count; ++i)
+        keys.emplace_back(startPos[i], endPos[i], phasemask, uint32(ignoreFlags));
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            LineOfSightCache::CachedResult cached = _losCache.FindStatic(keys[i]);
+            if (cached == LineOfSightCache::RESULT_UNKNOWN)
+                missing.push_back(i);
+            else
+                results[i] = cached == LineOfSightCache::RESULT_CLEAR;
+        }
+        runMissing(false);
+    }
+
+    if (checks & LINEOFSIGHT_CHECK_GOBJECT)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (!results[i])
+                continue;
+
+            LineOfSightCache::CachedResult cached = _losCache.FindDynamic(keys[i]);
+            if (cached == LineOfSightCache::RESULT_UNKNOWN)
+                missing.push_back(i);
+            else
+                results[i] = cached == LineOfSightCache::RESULT_CLEAR;
+        }
+        runMissing(true);
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        _losCache.CountQuery(hits[i]);
 }
 
 bool Map::IsInWater(float x, float y, float pZ, LiquidData *data) const
@@ -2359,9 +2488,9 @@ void Map::SendRemoveTransports(Player* player)
     // sunwell: remove static transports from client
     for (auto it = player->m_clientGUIDs.begin(); it != player->m_clientGUIDs.end(); )
     {
-        if (it->IsTransport())
+        if (it->first.IsTransport())
         {
-            transData.AddOutOfRangeGUID(*it);
+            transData.AddOutOfRangeGUID(it->first);
             it = player->m_clientGUIDs.erase(it);
         }
         else
@@ -4469,6 +4598,7 @@ void Map::RemoveGameObjectModel(GameObjectModel const& model)
 { 
     TC_LOG_TRACE("maps", "Map %u - Removed model %s", GetId(), model.name.c_str());
     _dynamicTree.remove(model); 
+    _losCache.InvalidateDynamic(model.getBounds());
 }
 
 void Map::InsertGameObjectModel(GameObjectModel const& model) 
@@ -4476,6 +4606,7 @@ void Map::InsertGameObjectModel(GameObjectModel const& model)
     TC_LOG_TRACE("maps", "Map %u - Added model %s", GetId(), model.name.c_str());
     DEBUG_ASSERT(!_dynamicTree.contains(model));
     _dynamicTree.insert(model); 
+    _losCache.InvalidateDynamic(model.getBounds());
 }
 
 bool Map::ContainsGameObjectModel(GameObjectModel const& model) const 
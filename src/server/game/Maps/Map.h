@@ -9,6 +9,8 @@
 #include "MapRefManager.h"
 #include "MPSCQueue.h"
 #include "DynamicTree.h"
+#include "LineOfSightCache.h"
+#include "AggroCandidateIndex.h"
 #include "Models/GameObjectModel.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include "ObjectGuid.h"
@@ -270,6 +272,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void RemoveGameObjectModel(GameObjectModel const& model);
         void InsertGameObjectModel(GameObjectModel const& model);
         bool ContainsGameObjectModel(GameObjectModel const& model) const;
+        // A gameobject model changed without being removed or inserted (collision toggled), cached gameobject line of sight around it is stale
+        void InvalidateDynamicLineOfSight(GameObjectModel const& model) { _losCache.InvalidateDynamic(model.getBounds()); }
+        AggroCandidateIndex& GetAggroCandidateIndex() { return _aggroCandidates; }
         float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f) const
         {
             return _dynamicTree.getHeight(x, y, z, maxSearchDist + collisionHeight, phasemask);
@@ -277,6 +282,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // Same as isInLineOfSight for each segment from startPos[i] to endPos[i], but rays are traversed together as packets
+        void isInLineOfSight(G3D::Vector3 const* startPos, G3D::Vector3 const* endPos, uint32 count, bool* results, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
         void Balance() { _dynamicTree.balance(); }
         //get dynamic collision (gameobjects only ?)
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
@@ -403,6 +410,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
 		MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+        // Buffers lent to Trinity::VisibleNotifier so that visibility updates on this map do not allocate
+        std::vector<Unit*>& GetVisibleNowScratch() { return _visibleNowScratch; }
+        std::vector<ObjectGuid>& GetOutOfRangeScratch() { return _outOfRangeScratch; }
+
 		typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
 		CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
         CreatureBySpawnIdContainer const& GetCreatureBySpawnIdStore() const { return _creatureBySpawnIdStore; }
@@ -618,6 +629,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _losCache;
+        AggroCandidateIndex _aggroCandidates;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -794,6 +807,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         
 		MapStoredObjectTypesContainer _objectsStore;
         CreatureBySpawnIdContainer _creatureBySpawnIdStore;
+        std::vector<Unit*> _visibleNowScratch;
+        std::vector<ObjectGuid> _outOfRangeScratch;
         GameObjectBySpawnIdContainer _gameobjectBySpawnIdStore;
 		std::unordered_map<uint32/*cellId*/, std::unordered_set<Corpse*>> _corpsesByCell;
 		std::unordered_map<ObjectGuid, Corpse*> _corpsesByPlayer;
@@ -0,0 +1,323 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapObjectAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace
+{
+    // keeps objects 16 bytes aligned, like the global allocator does
+    size_t const HeaderSize = 16;
+    size_t const ChunkSize = 64 * 1024;
+    size_t const MinChunkSlots = 8;
+
+    struct ThreadPools;
+    struct SizeClassPool;
+
+    struct SlotHeader
+    {
+        SizeClassPool* Pool;
+    };
+
+    // a free slot reuses the header space
+    struct FreeSlot
+    {
+        FreeSlot* Next;
+    };
+
+    static_assert(sizeof(SlotHeader) <= HeaderSize && sizeof(FreeSlot) <= HeaderSize, "MapObjectAllocator header too small");
+
+    // Written by the owning thread only, except RemoteFrees. Read by anyone for the stats.
+    struct PoolCounters
+    {
+        std::atomic<uint64> Capacity { 0 };
+        std::atomic<uint64> Bytes { 0 };
+        std::atomic<uint64> Allocations { 0 };
+        std::atomic<uint64> LocalFrees { 0 };
+        std::atomic<uint64> RemoteFrees { 0 };
+    };
+
+    void AddToCounter(std::atomic<uint64>& counter, uint64 value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct SizeClassPool
+    {
+        SizeClassPool(ThreadPools* owner, PoolCounters& counters, size_t slotSize) :
+            Owner(owner), Counters(counters), SlotSize(slotSize), LocalFree(nullptr), RemoteFree(nullptr) { }
+
+        // Owning thread
+        FreeSlot* Pop()
+        {
+            if (!LocalFree)
+            {
+                TakeRemoteFrees();
+                if (!LocalFree)
+                    Grow();
+            }
+
+            FreeSlot* slot = LocalFree;
+            LocalFree = slot->Next;
+            return slot;
+        }
+
+        // Owning thread
+        void Push(FreeSlot* slot)
+        {
+            slot->Next = LocalFree;
+            LocalFree = slot;
+        }
+
+        // Any thread
+        void PushRemote(FreeSlot* slot)
+        {
+            FreeSlot* head = RemoteFree.load(std::memory_order_relaxed);
+            do
+                slot->Next = head;
+            while (!RemoteFree.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+
+            Counters.RemoteFrees.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void TakeRemoteFrees()
+        {
+            if (!RemoteFree.load(std::memory_order_relaxed))
+                return;
+
+            FreeSlot* head = RemoteFree.exchange(nullptr, std::memory_order_acquire);
+            FreeSlot* tail = head;
+            while (tail->Next)
+                tail = tail->Next;
+
+            tail->Next = LocalFree;
+            LocalFree = head;
+        }
+
+        void Grow()
+        {
+            size_t const slots = std::max(MinChunkSlots, ChunkSize / SlotSize);
+            Chunks.emplace_back(new char[slots * SlotSize]);
+            char* chunk = Chunks.back().get();
+            for (size_t i = slots; i > 0; --i)
+                Push(reinterpret_cast<FreeSlot*>(chunk + (i - 1) * SlotSize));
+
+            AddToCounter(Counters.Capacity, slots);
+            AddToCounter(Counters.Bytes, slots * SlotSize);
+        }
+
+        ThreadPools* const Owner;
+        PoolCounters& Counters;
+        size_t const SlotSize;                  // header included
+        FreeSlot* LocalFree;
+        std::atomic<FreeSlot*> RemoteFree;
+        std::vector<std::unique_ptr<char[]>> Chunks;
+    };
+
+    struct ThreadPools
+    {
+        SizeClassPool* GetPool(MapObjectPoolType type, size_t slotSize)
+        {
+            // a handful of sizes per type at most (Creature, Pet, Totem...)
+            for (std::unique_ptr<SizeClassPool> const& pool : Pools[type])
+                if (pool->SlotSize == slotSize)
+                    return pool.get();
+
+            Pools[type].push_back(std::make_unique<SizeClassPool>(this, Counters[type], slotSize));
+            return Pools[type].back().get();
+        }
+
+        std::array<std::vector<std::unique_ptr<SizeClassPool>>, MAX_MAP_OBJECT_POOLS> Pools;
+        std::array<PoolCounters, MAX_MAP_OBJECT_POOLS> Counters;
+        bool Owned = false;                     // guarded by the registry lock
+    };
+
+    // ThreadPools are never deleted, their slots may still be in use after their thread exited
+    struct PoolsRegistry
+    {
+        std::mutex Lock;
+        std::vector<ThreadPools*> Threads;
+    };
+
+    // not destroyed at exit, objects may be freed by static destructors
+    PoolsRegistry& GetRegistry()
+    {
+        static PoolsRegistry* registry = new PoolsRegistry();
+        return *registry;
+    }
+
+    std::atomic<bool> PoolsEnabled(true);
+
+    thread_local ThreadPools* LocalPools = nullptr;
+
+    // Gives the pools of an exiting thread to the next thread needing some
+    struct LocalPoolsRelease
+    {
+        ~LocalPoolsRelease()
+        {
+            if (!Pools)
+                return;
+
+            PoolsRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Lock);
+            Pools->Owned = false;
+            LocalPools = nullptr;
+        }
+
+        ThreadPools* Pools = nullptr;
+    };
+
+    thread_local LocalPoolsRelease LocalRelease;
+
+    ThreadPools* AcquireLocalPools()
+    {
+        PoolsRegistry& registry = GetRegistry();
+        {
+            std::lock_guard<std::mutex> lock(registry.Lock);
+            for (ThreadPools* pools : registry.Threads)
+            {
+                if (!pools->Owned)
+                {
+                    LocalPools = pools;
+                    break;
+                }
+            }
+
+            if (!LocalPools)
+            {
+                LocalPools = new ThreadPools();
+                registry.Threads.push_back(LocalPools);
+            }
+
+            LocalPools->Owned = true;
+        }
+
+        LocalRelease.Pools = LocalPools;
+        return LocalPools;
+    }
+
+    void AddStats(MapObjectPoolStats& stats, PoolCounters const& counters)
+    {
+        uint64 const allocations = counters.Allocations.load(std::memory_order_relaxed);
+        uint64 const frees = counters.LocalFrees.load(std::memory_order_relaxed) + counters.RemoteFrees.load(std::memory_order_relaxed);
+        stats.Live += allocations > frees ? allocations - frees : 0;
+        stats.Capacity += counters.Capacity.load(std::memory_order_relaxed);
+        stats.Bytes += counters.Bytes.load(std::memory_order_relaxed);
+        stats.Allocations += allocations;
+        stats.RemoteFrees += counters.RemoteFrees.load(std::memory_order_relaxed);
+    }
+
+    char const* const PoolNames[MAX_MAP_OBJECT_POOLS] =
+    {
+        "Creature",
+        "TempSummon",
+        "GameObject",
+        "DynamicObject",
+        "Aura",
+        "AuraApplication",
+        "AuraEffect",
+        "Spell",
+    };
+}
+
+void* MapObjectAllocator::Allocate(MapObjectPoolType type, size_t size)
+{
+    if (!PoolsEnabled.load(std::memory_order_relaxed))
+    {
+        char* block = static_cast<char*>(::operator new(HeaderSize + size));
+        reinterpret_cast<SlotHeader*>(block)->Pool = nullptr;
+        return block + HeaderSize;
+    }
+
+    ThreadPools* pools = LocalPools ? LocalPools : AcquireLocalPools();
+    size_t const slotSize = HeaderSize + ((size + HeaderSize - 1) & ~(HeaderSize - 1));
+    SizeClassPool* pool = pools->GetPool(type, slotSize);
+
+    char* slot = reinterpret_cast<char*>(pool->Pop());
+    reinterpret_cast<SlotHeader*>(slot)->Pool = pool;
+    AddToCounter(pool->Counters.Allocations, 1);
+    return slot + HeaderSize;
+}
+
+void MapObjectAllocator::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    char* slot = static_cast<char*>(ptr) - HeaderSize;
+    SizeClassPool* pool = reinterpret_cast<SlotHeader*>(slot)->Pool;
+    if (!pool)
+    {
+        ::operator delete(slot);
+        return;
+    }
+
+    if (pool->Owner == LocalPools)
+    {
+        pool->Push(reinterpret_cast<FreeSlot*>(slot));
+        AddToCounter(pool->Counters.LocalFrees, 1);
+    }
+    else
+        pool->PushRemote(reinterpret_cast<FreeSlot*>(slot));
+}
+
+void MapObjectAllocator::SetEnabled(bool enabled)
+{
+    PoolsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MapObjectAllocator::IsEnabled()
+{
+    return PoolsEnabled.load(std::memory_order_relaxed);
+}
+
+std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> MapObjectAllocator::GetStats()
+{
+    std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> stats;
+    PoolsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    for (ThreadPools const* pools : registry.Threads)
+        for (uint8 type = 0; type < MAX_MAP_OBJECT_POOLS; ++type)
+            AddStats(stats[type], pools->Counters[type]);
+
+    return stats;
+}
+
+std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> MapObjectAllocator::GetThreadStats()
+{
+    std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> stats;
+    if (LocalPools)
+        for (uint8 type = 0; type < MAX_MAP_OBJECT_POOLS; ++type)
+            AddStats(stats[type], LocalPools->Counters[type]);
+
+    return stats;
+}
+
+uint32 MapObjectAllocator::GetThreadCount()
+{
+    PoolsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    return uint32(registry.Threads.size());
+}
+
+char const* MapObjectAllocator::GetPoolName(MapObjectPoolType type)
+{
+    return type < MAX_MAP_OBJECT_POOLS ? PoolNames[type] : "Unknown";
+}
@@ -0,0 +1,76 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPOBJECTALLOCATOR_H
+#define TRINITY_MAPOBJECTALLOCATOR_H
+
+#include "Define.h"
+#include <array>
+#include <cstddef>
+
+// Classes allocated through MapObjectAllocator, derived classes share the pool type of their base
+enum MapObjectPoolType : uint8
+{
+    MAP_OBJECT_POOL_CREATURE,
+    MAP_OBJECT_POOL_TEMPSUMMON,         // also Minion, Guardian, Pet, Totem, Puppet
+    MAP_OBJECT_POOL_GAMEOBJECT,         // also transports
+    MAP_OBJECT_POOL_DYNAMICOBJECT,
+    MAP_OBJECT_POOL_AURA,
+    MAP_OBJECT_POOL_AURA_APPLICATION,
+    MAP_OBJECT_POOL_AURA_EFFECT,
+    MAP_OBJECT_POOL_SPELL,
+
+    MAX_MAP_OBJECT_POOLS
+};
+
+struct MapObjectPoolStats
+{
+    uint64 Live = 0;            // objects currently allocated
+    uint64 Capacity = 0;        // slots in all chunks
+    uint64 Bytes = 0;           // memory held by the chunks
+    uint64 Allocations = 0;     // since startup
+    uint64 RemoteFrees = 0;     // objects freed by another thread than the allocating one, since startup
+};
+
+/**
+    Slab allocator for the objects maps create and destroy the most. Each thread (in practice each map updater thread,
+    plus the world thread) owns its pools: one per pool type and object size, made of chunks of fixed size slots.
+    Allocating and freeing on the owning thread is a free list push/pop without any lock.
+    An object freed by another thread (an aura removed by its caster's map, a creature deleted at world thread) is
+    pushed on a lock free list of its pool, taken back by the owning thread the next time it runs out of free slots.
+    Chunks are kept for reuse and never given back to the system. Pools of a thread that exits are adopted by the
+    next thread needing pools.
+    Each object is preceded by a 16 bytes header pointing to its pool, null for objects allocated while pools are
+    disabled (ObjectPools.Enable), which come from the global allocator.
+*/
+class TC_GAME_API MapObjectAllocator
+{
+public:
+    static void* Allocate(MapObjectPoolType type, size_t size);
+    static void Free(void* ptr);
+
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    // Summed over all threads
+    static std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> GetStats();
+    // Pools of the calling thread only
+    static std::array<MapObjectPoolStats, MAX_MAP_OBJECT_POOLS> GetThreadStats();
+    // Threads having used the pools, including the ones which exited
+    static uint32 GetThreadCount();
+    static char const* GetPoolName(MapObjectPoolType type);
+};
+
+#endif
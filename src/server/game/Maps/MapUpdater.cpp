@@ -7,6 +7,7 @@
 #include "Monitor.h"
 #include "World.h"
 #include "MapManager.h"
+#include "SyncQueryTracker.h"
 
 #define MINIMUM_MAP_UPDATE_INTERVAL 30
 
@@ -33,6 +34,7 @@ class MapUpdateRequest
 
         void call()
         {
+            SyncQueryTracker::BeginTick(SYNC_QUERY_THREAD_MAP);
             sMonitor->MapUpdateStart(m_map);
             m_map.DoUpdate(m_diff, MINIMUM_MAP_UPDATE_INTERVAL);
             sMonitor->MapUpdateEnd(m_map);
@@ -79,7 +79,7 @@ typedef std::map<uint32, TransportAnimation> TransportAnimationContainer;
 
 class TransportMgr
 {
-        friend void LoadDBCStores(std::string const&);
+        friend void LoadDBCStores(std::string const&, uint32);
 
     public:
         static TransportMgr* instance()
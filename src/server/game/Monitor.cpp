@@ -6,9 +6,57 @@
 
 Monitor::Monitor()
     : _worldTickCount(0),
-    _generalInfoTimer(0)
+    _generalInfoTimer(0),
+    _losCacheHits(0),
+    _losCacheMisses(0),
+    _aggroCheckedPairs(0),
+    _aggroCulledPairs(0),
+    _aggroSkippedVisits(0),
+    _logsBufferWrittenRows(0),
+    _logsBufferStatements(0),
+    _logsBufferDeferredFlushes(0),
+    _logsBufferDroppedRows(0),
+    _logsBufferPeakBytes(0)
 {
     _worldTicksInfo.reserve(DAY * 20); //already prepare 1 day worth of 20 updates per seconds
+
+    for (uint8 band = 0; band < MOVEMENT_RELAY_BAND_COUNT; band++)
+    {
+        _movementRelaySent[band] = 0;
+        _movementRelayCoalesced[band] = 0;
+    }
+}
+
+void Monitor::AddMovementRelayCounts(MovementRelayBand band, uint32 sent, uint32 coalesced)
+{
+    if (sent)
+        _movementRelaySent[band].fetch_add(sent, std::memory_order_relaxed);
+    if (coalesced)
+        _movementRelayCoalesced[band].fetch_add(coalesced, std::memory_order_relaxed);
+}
+
+void Monitor::AddLineOfSightCacheCounts(uint32 hits, uint32 misses)
+{
+    _losCacheHits.fetch_add(hits, std::memory_order_relaxed);
+    _losCacheMisses.fetch_add(misses, std::memory_order_relaxed);
+}
+
+void Monitor::AddAggroCullingCounts(uint32 checkedPairs, uint32 culledPairs, uint32 skippedVisits)
+{
+    _aggroCheckedPairs.fetch_add(checkedPairs, std::memory_order_relaxed);
+    _aggroCulledPairs.fetch_add(culledPairs, std::memory_order_relaxed);
+    _aggroSkippedVisits.fetch_add(skippedVisits, std::memory_order_relaxed);
+}
+
+void Monitor::AddLogsBufferCounts(uint32 writtenRows, uint32 statements, uint32 deferredFlushes, uint32 droppedRows, uint64 bufferedBytes)
+{
+    _logsBufferWrittenRows.fetch_add(writtenRows, std::memory_order_relaxed);
+    _logsBufferStatements.fetch_add(statements, std::memory_order_relaxed);
+    _logsBufferDeferredFlushes.fetch_add(deferredFlushes, std::memory_order_relaxed);
+    _logsBufferDroppedRows.fetch_add(droppedRows, std::memory_order_relaxed);
+
+    uint64 peak = _logsBufferPeakBytes.load(std::memory_order_relaxed);
+    while (bufferedBytes > peak && !_logsBufferPeakBytes.compare_exchange_weak(peak, bufferedBytes, std::memory_order_relaxed));
 }
 
 void Monitor::Update(uint32 diff)
@@ -219,6 +267,46 @@ void Monitor::UpdateGeneralInfos(uint32 diff)
             trans->PAppend("INSERT INTO mon_classes (time, `class`, players) VALUES (%u, %u, %u)", (uint32)now, i, classesCount[i]);
     }
 
+    /* movement relay, per observer band */
+    if (sWorld->getConfig(CONFIG_MOVEMENT_TIERED_BROADCAST))
+    {
+        for (uint8 band = 0; band < MOVEMENT_RELAY_BAND_COUNT; band++)
+        {
+            uint64 sent = _movementRelaySent[band].exchange(0);
+            uint64 coalesced = _movementRelayCoalesced[band].exchange(0);
+            trans->PAppend("INSERT INTO mon_movement (time, band, sent, coalesced) VALUES (%u, %u, " UI64FMTD ", " UI64FMTD ")", (uint32)now, uint32(band), sent, coalesced);
+        }
+    }
+
+    /* line of sight cache */
+    if (sWorld->getConfig(CONFIG_LOS_CACHE_ENABLED))
+    {
+        uint64 hits = _losCacheHits.exchange(0);
+        uint64 misses = _losCacheMisses.exchange(0);
+        trans->PAppend("INSERT INTO mon_los_cache (time, hits, misses) VALUES (%u, " UI64FMTD ", " UI64FMTD ")", (uint32)now, hits, misses);
+    }
+
+    /* relocation aggro culling */
+    if (sWorld->getConfig(CONFIG_AGGRO_CULLING_ENABLED))
+    {
+        uint64 checkedPairs = _aggroCheckedPairs.exchange(0);
+        uint64 culledPairs = _aggroCulledPairs.exchange(0);
+        uint64 skippedVisits = _aggroSkippedVisits.exchange(0);
+        trans->PAppend("INSERT INTO mon_aggro_culling (time, checked_pairs, culled_pairs, skipped_visits) VALUES (%u, " UI64FMTD ", " UI64FMTD ", " UI64FMTD ")", (uint32)now, checkedPairs, culledPairs, skippedVisits);
+    }
+
+    /* buffered logs */
+    if (sWorld->getConfig(CONFIG_LOGS_BUFFER_ENABLED))
+    {
+        uint64 writtenRows = _logsBufferWrittenRows.exchange(0);
+        uint64 statements = _logsBufferStatements.exchange(0);
+        uint64 deferredFlushes = _logsBufferDeferredFlushes.exchange(0);
+        uint64 droppedRows = _logsBufferDroppedRows.exchange(0);
+        uint64 peakBytes = _logsBufferPeakBytes.exchange(0);
+        trans->PAppend("INSERT INTO mon_logs_buffer (time, written_rows, statements, deferred_flushes, dropped_rows, peak_bytes) VALUES (%u, " UI64FMTD ", " UI64FMTD ", " UI64FMTD ", " UI64FMTD ", " UI64FMTD ")",
+            (uint32)now, writtenRows, statements, deferredFlushes, droppedRows, peakBytes);
+    }
+
     LogsDatabase.CommitTransaction(trans);
 }
 
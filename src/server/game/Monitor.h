@@ -1,6 +1,9 @@
 #ifndef __MONITOR_H
 #define __MONITOR_H
 
+#include "MovementRelay.h"
+#include <atomic>
+
 /*
 Ideas:
 - Allow to trigger profiling at next udpate, by command or automatically every X according to config
@@ -110,6 +113,15 @@ public:
 
 	// Flattened timediff upated every minute. This is a cached value.
 	uint32 GetSmoothTimeDiff() const { return smoothTD.Get(); }
+
+	// Count movement packets relayed (sent) or skipped (coalesced) to observers of the given band, see MovementRelay. Thread safe.
+	void AddMovementRelayCounts(MovementRelayBand band, uint32 sent, uint32 coalesced);
+	// Count line of sight queries answered from (hits) or missing (misses) a map LineOfSightCache. Thread safe.
+	void AddLineOfSightCacheCounts(uint32 hits, uint32 misses);
+	// Count creature/unit relocation pairs checked or culled by their aggro flags, and creature container visits skipped by a map AggroCandidateIndex. Thread safe.
+	void AddAggroCullingCounts(uint32 checkedPairs, uint32 culledPairs, uint32 skippedVisits);
+	// Count log rows and INSERTs written by the LogsDatabaseBuffer, flushes deferred because of the LogsDatabase queue and rows dropped past its memory cap, and record its peak size. Thread safe.
+	void AddLogsBufferCounts(uint32 writtenRows, uint32 statements, uint32 deferredFlushes, uint32 droppedRows, uint64 bufferedBytes);
 private:
 	// -- MapUpdater & World functions
 	void MapUpdateStart(Map const& map);
@@ -149,6 +161,26 @@ private:
 	MonitorAlert      _monitAlert;
 
 	SmoothedTimeDiff smoothTD;
+
+	//movement packets per observer band since last general info update
+	std::atomic<uint64> _movementRelaySent[MOVEMENT_RELAY_BAND_COUNT];
+	std::atomic<uint64> _movementRelayCoalesced[MOVEMENT_RELAY_BAND_COUNT];
+
+	//line of sight cache queries, all maps, since last general info update
+	std::atomic<uint64> _losCacheHits;
+	std::atomic<uint64> _losCacheMisses;
+
+	//relocation aggro culling, all maps, since last general info update
+	std::atomic<uint64> _aggroCheckedPairs;
+	std::atomic<uint64> _aggroCulledPairs;
+	std::atomic<uint64> _aggroSkippedVisits;
+
+	//buffered logs, since last general info update
+	std::atomic<uint64> _logsBufferWrittenRows;
+	std::atomic<uint64> _logsBufferStatements;
+	std::atomic<uint64> _logsBufferDeferredFlushes;
+	std::atomic<uint64> _logsBufferDroppedRows;
+	std::atomic<uint64> _logsBufferPeakBytes;
 };
 
 #define sMonitor Monitor::instance()
@@ -194,6 +194,7 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature* creature, uint32 a
         return;
 
     WaypointNode const& arrivedNode = _path->nodes.at(arrivedNodeIndex);
+    _arrivedNode = arrivedNodeIndex;
     
     if (arrivedNode.eventId && urand(0, 99) < arrivedNode.eventChance)
     {
@@ -395,12 +396,34 @@ void WaypointMovementGenerator<Creature>::SplineFinished(Creature* creature, uin
     }
 }
 
-bool WaypointMovementGenerator<Creature>::GeneratePathToNextPoint(Position const& from, Creature* creature, WaypointNode const& nextNode, uint32& splineId)
+bool WaypointMovementGenerator<Creature>::GeneratePathToNextPoint(Position const& from, Creature* creature, uint32 fromNode, uint32 nextNode, uint32& splineId)
 {
+    WaypointNode const& nextNodeData = _path->nodes.at(nextNode);
+
     //generate mmaps path to next point
     PathGenerator path(creature);
-    path.SetSourcePosition(from);
-    bool result = path.CalculatePath(nextNode.x, nextNode.y, nextNode.z, true);
+
+    //paths between two db nodes are the same at each lap and for every creature moving alike, share them
+    bool const sharedSegment = !customPath && fromNode < _path->nodes.size();
+    WaypointSegmentKey key = { };
+    if (sharedSegment)
+    {
+        key = { _path->id, fromNode, nextNode, creature->GetMapId(), creature->GetPhaseMask(), path.GetOptions(), uint32(creature->GetCollisionHeight() * 100.0f) };
+        size_t const previousSize = m_precomputedPath.size();
+        if (sWaypointMgr->GetSegment(key, m_precomputedPath))
+        {
+            splineId += uint32(m_precomputedPath.size() - previousSize);
+            splineToPathIds[splineId] = nextNodeData.id;
+            return true;
+        }
+
+        WaypointNode const& fromNodeData = _path->nodes[fromNode];
+        path.SetSourcePosition(Position(fromNodeData.x, fromNodeData.y, fromNodeData.z));
+    }
+    else
+        path.SetSourcePosition(from);
+
+    bool result = path.CalculatePath(nextNodeData.x, nextNodeData.y, nextNodeData.z, true);
     if (!result || (path.GetPathType() & PATHFIND_NOPATH))
         return false; //should never happen
 
@@ -415,13 +438,29 @@ bool WaypointMovementGenerator<Creature>::GeneratePathToNextPoint(Position const
         splineId++;
     }
 
+    // incomplete or shortcut paths may only be a temporary state of the navmesh or of dynamic collision, compute them again next time
+    if (sharedSegment && path.GetPathType() == PATHFIND_NORMAL)
+        sWaypointMgr->AddSegment(key, Movement::PointsArray(points.begin() + skip, points.end()));
+
     //register id of the last point for movement inform
-    splineToPathIds[splineId] = nextNode.id;
+    splineToPathIds[splineId] = nextNodeData.id;
 
-    //TC_LOG_TRACE("misc", "[path %u] Inserted node (db %u) at (%f,%f,%f) (splineId %u)", path_id, nextNode.id, nextNode.x, nextNode.y, nextNode.z, splineId);
+    //TC_LOG_TRACE("misc", "[path %u] Inserted node (db %u) at (%f,%f,%f) (splineId %u)", path_id, nextNodeData.id, nextNodeData.x, nextNodeData.y, nextNodeData.z, splineId);
     return true;
 }
 
+uint32 WaypointMovementGenerator<Creature>::GetStandingNode(Creature* creature) const
+{
+    if (_arrivedNode >= _path->nodes.size())
+        return WAYPOINT_NO_NODE;
+
+    WaypointNode const& node = _path->nodes[_arrivedNode];
+    if (creature->GetExactDist2d(node.x, node.y) > 0.5f || std::fabs(creature->GetPositionZ() - node.z) > 2.0f)
+        return WAYPOINT_NO_NODE;
+
+    return _arrivedNode;
+}
+
 bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
 {
     //make sure we don't trigger OnArrived from last path at this point
@@ -469,7 +508,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
                 //insert first node
                 WaypointNode const* next_node = &(_path->nodes.at(nextMemoryNodeId));
 
-                GeneratePathToNextPoint(creature, creature, *next_node, splineId);
+                GeneratePathToNextPoint(creature, creature, GetStandingNode(creature), nextMemoryNodeId, splineId);
 
                 //stop path if node has delay
                 if (next_node->delay)
@@ -478,6 +517,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
                 WaypointMoveType lastMoveType = WaypointMoveType(currentNode.moveType);
 
                 WaypointNode const* lastNode = next_node;
+                uint32 lastNodeId = nextMemoryNodeId;
 
                 //prepare next nodes if m_useSmoothSpline is enabled
                 while (m_useSmoothSpline && GetNextMemoryNode(nextMemoryNodeId, nextMemoryNodeId, false))
@@ -488,7 +528,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
                     if (next_node->moveType != lastMoveType)
                         break;
 
-                    GeneratePathToNextPoint(Position(lastNode->x, lastNode->y, lastNode->z), creature, *next_node, splineId);
+                    GeneratePathToNextPoint(Position(lastNode->x, lastNode->y, lastNode->z), creature, lastNodeId, nextMemoryNodeId, splineId);
 
                     //stop if this is the last node in path
                     if (IsLastMemoryNode(nextMemoryNodeId))
@@ -502,6 +542,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
                         break;
 
                     lastNode = next_node;
+                    lastNodeId = nextMemoryNodeId;
                 }
 
                 //if last node has orientation, set it to spline
@@ -514,12 +555,14 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
                 //random paths have no end so lets set our spline path limit at 10 nodes
                 uint32 count = 0;
                 Position lastPosition = creature->GetPosition();
+                uint32 lastNodeId = GetStandingNode(creature);
                 while (GetNextMemoryNode(nextMemoryNodeId, nextMemoryNodeId, true) && count < 10)
                 {
                     WaypointNode const& nxtNode = _path->nodes.at(nextMemoryNodeId);
 
-                    GeneratePathToNextPoint(lastPosition, creature, nxtNode, splineId);
+                    GeneratePathToNextPoint(lastPosition, creature, lastNodeId, nextMemoryNodeId, splineId);
                     lastPosition = Position(nxtNode.x, nxtNode.y, nxtNode.z);
+                    lastNodeId = nextMemoryNodeId;
                     count++;
 
                     //stop path if node has delay
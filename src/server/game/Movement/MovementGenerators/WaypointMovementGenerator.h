@@ -36,6 +36,7 @@
 #define FLIGHT_TRAVEL_UPDATE  100
 #define STOP_TIME_FOR_PLAYER  3 * MINUTE * IN_MILLISECONDS           // 3 Minutes
 #define TIMEDIFF_NEXT_WP      250
+#define WAYPOINT_NO_NODE      0xFFFFFFFF
 
 enum WaypointPathType
 {
@@ -143,7 +144,10 @@ class TC_GAME_API WaypointMovementGenerator<Creature> : public MovementGenerator
         */
         bool StartMove(Creature* c);
         //meant to be used by StartSplinePath only. Return false if should break in loop
-        bool GeneratePathToNextPoint(Position const& from, Creature* creature, WaypointNode const& nextNode, uint32& splineId);
+        //fromNode is the index of the node at 'from' if any (else WAYPOINT_NO_NODE), nextNode an index of _path
+        bool GeneratePathToNextPoint(Position const& from, Creature* creature, uint32 fromNode, uint32 nextNode, uint32& splineId);
+        //index of the node the creature arrived at if it's still there, else WAYPOINT_NO_NODE
+        uint32 GetStandingNode(Creature* creature) const;
 
         bool IsPaused();
 
@@ -169,6 +173,7 @@ class TC_GAME_API WaypointMovementGenerator<Creature> : public MovementGenerator
         //true when creature has reached the start node in path (it has to travel from its current position first)
         uint32 reachedFirstNode;
         bool _done;
+        uint32 _arrivedNode = WAYPOINT_NO_NODE; //last node reached, index of _path
 
         typedef std::unordered_map<uint32 /*splineId*/, uint32 /*pathNodeId*/> SplineToPathIdMapping;
         //filled at spline path generation. Used to determine which node spline system reached. When spline id is finished, it means we've reached path id.
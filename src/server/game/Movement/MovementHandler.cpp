@@ -18,6 +18,7 @@
 #include "Chat.h"
 #include "PlayerAntiCheat.h"
 #include "GameTime.h"
+#include "MovementRelay.h"
 
 #define MOVEMENT_PACKET_TIME_DELAY 0
 
@@ -423,7 +424,8 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recvData)
 
     data.appendPackGUID(mover->GetGUID());
     WriteMovementInfo(&data, &movementInfo);
-    mover->SendMessageToSet(&data, _player);
+    // heartbeats only refresh the position of an already moving unit, far observers can miss some
+    _movementRelay.Relay(mover, &data, _player, opcode == MSG_MOVE_HEARTBEAT);
     mover->m_movementInfo = movementInfo;
 
 #ifdef LICH_KING
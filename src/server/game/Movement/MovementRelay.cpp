@@ -0,0 +1,111 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MovementRelay.h"
+#include "CellImpl.h"
+#include "GameTime.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Monitor.h"
+#include "Player.h"
+#include "World.h"
+
+namespace
+{
+    // MessageDistDeliverer, skipping players in the bands not relayed this time
+    struct TieredMessageDeliverer : public Trinity::MessageDistDeliverer
+    {
+        float i_nearDistSq;
+        float i_midDistSq;
+        bool const* i_relayBand;
+        uint32 i_sent[MOVEMENT_RELAY_BAND_COUNT] = { };
+        uint32 i_coalesced[MOVEMENT_RELAY_BAND_COUNT] = { };
+
+        TieredMessageDeliverer(WorldObject* src, WorldPacket const* msg, float dist, Player const* skipped, float nearDist, float midDist, bool const* relayBand)
+            : Trinity::MessageDistDeliverer(src, msg, dist, false, skipped), i_nearDistSq(nearDist * nearDist), i_midDistSq(midDist * midDist), i_relayBand(relayBand) { }
+
+        MovementRelayBand GetBand(float distSq) const
+        {
+            if (distSq <= i_nearDistSq)
+                return MOVEMENT_RELAY_NEAR;
+            if (distSq <= i_midDistSq)
+                return MOVEMENT_RELAY_MID;
+            return MOVEMENT_RELAY_FAR;
+        }
+
+        void Visit(PlayerMapType& m)
+        {
+            for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+            {
+                Player* target = iter->GetSource();
+                if (!target->InSamePhase(i_phaseMask))
+                    continue;
+
+                float const distSq = target->GetExactDist2dSq(i_source);
+                if (distSq > i_distSq)
+                    continue;
+
+                MovementRelayBand const band = GetBand(distSq);
+                if (i_relayBand[band])
+                {
+                    if (SendToPlayer(target))
+                        ++i_sent[band];
+                }
+                else if (target->m_seer == target && CanReceive(target))
+                    ++i_coalesced[band];
+            }
+        }
+
+        // shared vision through creatures and dynamic objects is rare, always relay
+        using Trinity::MessageDistDeliverer::Visit;
+    };
+}
+
+MovementRelay::MovementRelay()
+{
+    for (uint32& time : _lastRelayTime)
+        time = 0;
+}
+
+void MovementRelay::Relay(WorldObject* mover, WorldPacket const* data, Player* skipped, bool coalescable)
+{
+    if (!sWorld->getConfig(CONFIG_MOVEMENT_TIERED_BROADCAST))
+    {
+        mover->SendMessageToSet(data, skipped);
+        return;
+    }
+
+    if (!mover->IsInWorld())
+        return;
+
+    uint32 const now = GameTime::GetGameTimeMS();
+    uint32 const intervals[MOVEMENT_RELAY_BAND_COUNT] = { 0, sWorld->getConfig(CONFIG_MOVEMENT_TIERED_MID_INTERVAL), sWorld->getConfig(CONFIG_MOVEMENT_TIERED_FAR_INTERVAL) };
+    bool relayBand[MOVEMENT_RELAY_BAND_COUNT];
+    for (uint8 band = 0; band < MOVEMENT_RELAY_BAND_COUNT; ++band)
+    {
+        relayBand[band] = !coalescable || GetMSTimeDiff(_lastRelayTime[band], now) >= intervals[band];
+        if (relayBand[band])
+            _lastRelayTime[band] = now;
+    }
+
+    // same range as WorldObject::SendMessageToSet
+    float const dist = mover->GetVisibilityRange() + mover->GetCombatReach() + VISIBILITY_COMPENSATION;
+    TieredMessageDeliverer notifier(mover, data, dist, skipped, float(sWorld->getConfig(CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE)), float(sWorld->getConfig(CONFIG_MOVEMENT_TIERED_MID_DISTANCE)), relayBand);
+    Cell::VisitWorldObjects(mover, notifier, dist);
+
+    if (sWorld->getConfig(CONFIG_MONITORING_ENABLED))
+        for (uint8 band = 0; band < MOVEMENT_RELAY_BAND_COUNT; ++band)
+            sMonitor->AddMovementRelayCounts(MovementRelayBand(band), notifier.i_sent[band], notifier.i_coalesced[band]);
+}
@@ -0,0 +1,52 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MOVEMENTRELAY_H
+#define TRINITY_MOVEMENTRELAY_H
+
+#include "Define.h"
+
+class Player;
+class WorldObject;
+class WorldPacket;
+
+// Observer distance bands used when Movement.TieredBroadcast.Enable is set
+enum MovementRelayBand : uint8
+{
+    MOVEMENT_RELAY_NEAR = 0, // every packet is relayed
+    MOVEMENT_RELAY_MID  = 1, // heartbeats at most every Movement.TieredBroadcast.MidInterval
+    MOVEMENT_RELAY_FAR  = 2, // heartbeats at most every Movement.TieredBroadcast.FarInterval
+
+    MOVEMENT_RELAY_BAND_COUNT
+};
+
+/**
+    Relays client movement packets of one mover to the players around it.
+    Without tiered broadcast this is the same as SendMessageToSet. With it, heartbeats to mid and far observers are
+    coalesced: they only get the latest heartbeat once the band interval expired. Every other movement opcode (start,
+    stop, jump, facing...) still reaches all observers right away, so far observers never extrapolate a stale state.
+*/
+class TC_GAME_API MovementRelay
+{
+public:
+    MovementRelay();
+
+    void Relay(WorldObject* mover, WorldPacket const* data, Player* skipped, bool coalescable);
+
+private:
+    uint32 _lastRelayTime[MOVEMENT_RELAY_BAND_COUNT];
+};
+
+#endif
@@ -5,8 +5,10 @@
 #include "MapManager.h"
 #include "Log.h"
 #include "WaypointDefines.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
 
-WaypointMgr::WaypointMgr() { }
+WaypointMgr::WaypointMgr() : _segmentsClock(0) { }
 
 WaypointMgr::~WaypointMgr()
 {
@@ -17,7 +19,7 @@ void WaypointMgr::Load()
     uint32 oldMSTime = GetMSTime();
 
     //                                                0    1         2           3          4            5           6        7      8           9
-    QueryResult result = WorldDatabase.Query("SELECT id, point, position_x, position_y, position_z, orientation, move_type, delay, action, action_chance FROM waypoint_data wd ORDER BY wd.id, wd.point");
+    QueryResult result = WorldSnapshot::Query("waypoint_data", "SELECT id, point, position_x, position_y, position_z, orientation, move_type, delay, action, action_chance FROM waypoint_data wd ORDER BY wd.id, wd.point", { "waypoint_data" });
 
     if (!result)
     {
@@ -93,6 +95,8 @@ void WaypointMgr::ReloadPath(uint32 id)
     if (itr != _waypointStore.end())
         _waypointStore.erase(itr);
 
+    ClearSegments(id);
+
     QueryResult result = WorldDatabase.PQuery("SELECT point, position_x, position_y, position_z, orientation, move_type, delay, action, action_chance FROM waypoint_data WHERE id = %u ORDER BY point",id);
 
     if (!result)
@@ -146,3 +150,57 @@ void WaypointMgr::ReloadPath(uint32 id)
 
     _waypointStore[id] = std::move(path);
 }
+
+bool WaypointMgr::GetSegment(WaypointSegmentKey const& key, Movement::PointsArray& points) const
+{
+    std::shared_lock<std::shared_mutex> lock(_segmentsLock);
+    auto itr = _segments.find(key);
+    if (itr == _segments.end())
+        return false;
+
+    itr->second.LastUse.store(++_segmentsClock, std::memory_order_relaxed);
+    points.insert(points.end(), itr->second.Points.begin(), itr->second.Points.end());
+    return true;
+}
+
+void WaypointMgr::AddSegment(WaypointSegmentKey const& key, Movement::PointsArray const& points)
+{
+    std::unique_lock<std::shared_mutex> lock(_segmentsLock);
+    if (_segments.size() >= MAX_SEGMENTS)
+        EvictSegments();
+
+    auto itr = _segments.emplace(key, WaypointSegment(points)).first;
+    itr->second.LastUse.store(++_segmentsClock, std::memory_order_relaxed);
+}
+
+void WaypointMgr::EvictSegments()
+{
+    std::vector<uint64> uses;
+    uses.reserve(_segments.size());
+    for (auto const& segment : _segments)
+        uses.push_back(segment.second.LastUse.load(std::memory_order_relaxed));
+
+    auto cutoff = uses.begin() + uses.size() / 4;
+    std::nth_element(uses.begin(), cutoff, uses.end());
+    uint64 const oldestKept = *cutoff;
+
+    for (auto itr = _segments.begin(); itr != _segments.end();)
+    {
+        if (itr->second.LastUse.load(std::memory_order_relaxed) < oldestKept)
+            itr = _segments.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void WaypointMgr::ClearSegments(uint32 pathId)
+{
+    std::unique_lock<std::shared_mutex> lock(_segmentsLock);
+    for (auto itr = _segments.begin(); itr != _segments.end();)
+    {
+        if (itr->first.PathId == pathId)
+            itr = _segments.erase(itr);
+        else
+            ++itr;
+    }
+}
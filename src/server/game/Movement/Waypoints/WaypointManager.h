@@ -2,11 +2,52 @@
 #ifndef TRINITY_WAYPOINTMANAGER_H
 #define TRINITY_WAYPOINTMANAGER_H
 
+#include <atomic>
+#include <shared_mutex>
 #include <unordered_map>
 #include "WaypointDefines.h"
+#include "MoveSplineInitArgs.h"
 
 typedef std::unordered_map<uint32, WaypointPath> WaypointPathContainer;
 
+// Identifies the pathfinding between two nodes of a path, for units moving with the same path options
+struct WaypointSegmentKey
+{
+    uint32 PathId;
+    uint32 FromNode;        // index in WaypointPath::nodes
+    uint32 ToNode;          // index in WaypointPath::nodes
+    uint32 MapId;
+    uint32 PhaseMask;
+    uint32 Options;         // PathOptions
+    uint32 CollisionHeight; // in cm
+
+    bool operator==(WaypointSegmentKey const& right) const
+    {
+        return PathId == right.PathId && FromNode == right.FromNode && ToNode == right.ToNode && MapId == right.MapId
+            && PhaseMask == right.PhaseMask && Options == right.Options && CollisionHeight == right.CollisionHeight;
+    }
+};
+
+struct WaypointSegmentKeyHash
+{
+    size_t operator()(WaypointSegmentKey const& key) const
+    {
+        size_t hash = std::hash<uint64>()(uint64(key.PathId) << 32 | (key.FromNode << 16 ^ key.ToNode));
+        return hash ^ std::hash<uint64>()(uint64(key.MapId) << 32 ^ uint64(key.Options) << 40 ^ key.PhaseMask ^ uint64(key.CollisionHeight) << 16);
+    }
+};
+
+struct WaypointSegment
+{
+    explicit WaypointSegment(Movement::PointsArray const& points) : Points(points), LastUse(0) { }
+    WaypointSegment(WaypointSegment const& right) : Points(right.Points), LastUse(right.LastUse.load()) { }
+
+    Movement::PointsArray Points;
+    mutable std::atomic<uint64> LastUse; // WaypointMgr::_segmentsClock at the last GetSegment or AddSegment
+};
+
+typedef std::unordered_map<WaypointSegmentKey, WaypointSegment, WaypointSegmentKeyHash> WaypointSegmentContainer;
+
 class TC_GAME_API WaypointMgr
 {
     public:
@@ -32,12 +73,28 @@ class TC_GAME_API WaypointMgr
             return nullptr;
         }
 
+        /* Path points between two nodes as computed by PathGenerator, the start node excluded. Segments don't change
+        for a given path, they are computed by the first creature walking them and shared by all others.
+        Thread safe. Return false if this segment wasn't added yet. Only the MAX_SEGMENTS most recently used segments are kept. */
+        bool GetSegment(WaypointSegmentKey const& key, Movement::PointsArray& points) const;
+        void AddSegment(WaypointSegmentKey const& key, Movement::PointsArray const& points);
+
     private:
         // Only allow instantiation from ACE_Singleton
         WaypointMgr();
         ~WaypointMgr();
 
+        void ClearSegments(uint32 pathId);
+        // Drop the least recently used quarter of the segments, _segmentsLock must be held exclusively
+        void EvictSegments();
+
+        static size_t const MAX_SEGMENTS = 50000;
+
         WaypointPathContainer _waypointStore;
+
+        mutable std::shared_mutex _segmentsLock;
+        WaypointSegmentContainer _segments;
+        mutable std::atomic<uint64> _segmentsClock;
 };
 
 #define sWaypointMgr WaypointMgr::instance()
@@ -8,6 +8,7 @@
 #include "QueryHolder.h"
 #include "QueryCallback.h"
 #include "World.h"
+#include "MovementRelay.h"
 
 class PlayerAntiCheat;
 class MailItemsInfo;
@@ -315,7 +316,6 @@ class TC_GAME_API WorldSession
         //pet
         void SendPetNameQuery(ObjectGuid guid, uint32 petnumber);
         void SendStablePet(ObjectGuid guid );
-        void SendStablePetCallback(ObjectGuid guid, PreparedQueryResult result);
         void SendStableResult(uint8 guid);
         bool CheckStableMaster(ObjectGuid guid);
 
@@ -629,16 +629,10 @@ class TC_GAME_API WorldSession
         void HandleBinderActivateOpcode(WorldPacket& recvPacket);
         void HandleListStabledPetsOpcode(WorldPacket& recvPacket);
         void HandleStablePet(WorldPacket& recvPacket);
-        void HandleStablePetCallback(PreparedQueryResult result);
         void HandleUnstablePet(WorldPacket& recvPacket);
-        //check if there is any pet in current slot
-        void HandleUnstablePetCallback(uint32 petId, PreparedQueryResult result);
-        //actually unstable pet
-        void HandleUnstablePetCallback2(uint32 petId, uint32 petEntry, PreparedQueryResult result);
         void HandleBuyStableSlot(WorldPacket& recvPacket);
         void HandleStableRevivePet(WorldPacket& recvPacket);
         void HandleStableSwapPet(WorldPacket& recvPacket);
-        void HandleStableSwapPetCallback(uint32 petId, PreparedQueryResult result);
 
         void HandleDuelAcceptedOpcode(WorldPacket& recvPacket);
         void HandleDuelCancelledOpcode(WorldPacket& recvPacket);
@@ -988,6 +982,8 @@ class TC_GAME_API WorldSession
 
         std::shared_ptr<ReplayRecorder> m_replayRecorder;
         std::shared_ptr<ReplayPlayer> m_replayPlayer;
+
+        MovementRelay _movementRelay;
 };
 #endif
 /// @}
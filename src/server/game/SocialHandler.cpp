@@ -34,7 +34,7 @@ void WorldSession::HandleAddFriendOpcode(WorldPacket& recvData)
     ObjectGuid::LowType friendGuid = sCharacterCache->GetCharacterGuidByName(friendName);
     if (friendGuid)
     {
-        if (CharacterCacheEntry const* characterInfo = sCharacterCache->GetCharacterCacheByGuid(friendGuid))
+        if (CharacterCacheEntryRef characterInfo = sCharacterCache->GetCharacterCacheByGuid(friendGuid))
         {
             uint32 team = Player::TeamForRace(characterInfo->race);
             uint32 friendAccountId = characterInfo->accountId;
@@ -19,6 +19,9 @@ class TC_GAME_API AuraEffect
         ~AuraEffect();
         explicit AuraEffect(Aura* base, uint8 effIndex, int32 const* baseAmount, Unit* caster);
     public:
+        static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_AURA_EFFECT, size); }
+        static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
         Unit* GetCaster() const { return GetBase()->GetCaster(); }
         ObjectGuid GetCasterGUID() const { return GetBase()->GetCasterGUID(); }
         Aura* GetBase() const { return m_base; }
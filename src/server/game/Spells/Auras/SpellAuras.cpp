@@ -2703,7 +2703,7 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit* ca
             continue;
 
         std::vector<Unit*> units;
-        ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
+        CompiledConditions const* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
 
         float radius = GetSpellInfo()->Effects[effIndex].CalcRadius(caster);
         
@@ -2729,15 +2729,21 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit* ca
             break;
         }
         case SPELL_EFFECT_APPLY_AREA_AURA_PET:
-            if (!condList || sConditionMgr->IsObjectMeetToConditions(GetUnitOwner(), ref, *condList))
+        {
+            ConditionSourceInfo srcInfo(GetUnitOwner(), ref);
+            if (!condList || condList->Meets(srcInfo))
                 units.push_back(GetUnitOwner());
+        }
             // no break
         case SPELL_EFFECT_APPLY_AREA_AURA_OWNER:
         {
             if (Unit* owner = GetUnitOwner()->GetCharmerOrOwner())
                 if (GetUnitOwner()->IsWithinDistInMap(owner, radius))
-                    if (!condList || sConditionMgr->IsObjectMeetToConditions(owner, ref, *condList))
+                {
+                    ConditionSourceInfo srcInfo(owner, ref);
+                    if (!condList || condList->Meets(srcInfo))
                         units.push_back(owner);
+                }
             break;
         }
         }
@@ -2802,7 +2808,7 @@ void DynObjAura::FillTargetMap(std::unordered_map<Unit*, uint8>& targets, Unit*
             selectionType = m_spellInfo->Effects[effIndex].TargetB.GetCheckType();
 
         std::vector<Unit*> units;
-        ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
+        CompiledConditions const* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
 
         Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetDynobjOwner(), dynObjOwnerCaster, dynObjOwnerCaster, m_spellInfo, selectionType, condList);
         Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetDynobjOwner(), units, check);
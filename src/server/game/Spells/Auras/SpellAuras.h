@@ -2,6 +2,7 @@
 #define TRINITY_SPELLAURAS_H
 
 #include "SpellAuraDefines.h"
+#include "MapObjectAllocator.h"
 
 struct DamageManaShield
 {
@@ -52,6 +53,9 @@ private:
     void _HandleEffect(uint8 effIndex, bool apply);
 
 public:
+    static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_AURA_APPLICATION, size); }
+    static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
     Unit * GetTarget() const { return _target; }
     Aura* GetBase() const { return _base; }
 
@@ -109,6 +113,9 @@ class TC_GAME_API Aura
     friend class Unit;
 
 public:
+    static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_AURA, size); }
+    static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
+
     typedef std::unordered_map<ObjectGuid, AuraApplication*> ApplicationMap;
 
     static uint8 BuildEffectMaskForOwner(SpellInfo const* spellProto, uint8 availableEffectMask, WorldObject* owner);
@@ -1132,10 +1132,10 @@ void Spell::SelectImplicitNearbyTargets(SpellEffIndex effIndex, SpellImplicitTar
         break;
     }
 
-    ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
+    CompiledConditions const* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
 
     // handle emergency case - try to use other provided targets if no conditions provided
-    if (targetType.GetCheckType() == TARGET_CHECK_ENTRY && (!condList || condList->empty()))
+    if (targetType.GetCheckType() == TARGET_CHECK_ENTRY && (!condList || condList->Conditions.empty()))
     {
         //sLog->outDebug(LOG_FILTER_SPELLS_AURAS, "Spell::SelectImplicitNearbyTargets: no conditions entry for target with TARGET_CHECK_ENTRY of spell ID %u, effect %u - selecting default targets", m_spellInfo->Id, effIndex);
         switch (targetType.GetObjectType())
@@ -1252,7 +1252,7 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     std::list<WorldObject*> targets;
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
-    ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
+    CompiledConditions const* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
     float coneAngle = M_PI / 2;
     float radius = m_spellInfo->Effects[effIndex].CalcRadius(m_caster) * m_spellValue->RadiusMod;
 
@@ -1368,6 +1368,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Trinity::Containers::RandomResize(targets, maxTargets);
         }
 
+        PrefetchAreaTargetsLOS(targets);
+
         for (auto & target : targets)
         {
             if (Unit* newTarget = target->ToUnit())
@@ -1375,7 +1377,59 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             else if (GameObject* gObjTarget = target->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
+
+        m_losPrefetch.clear();
+    }
+}
+
+void Spell::PrefetchAreaTargetsLOS(std::list<WorldObject*> const& targets)
+{
+    m_losPrefetch.clear();
+
+    // same conditions as CheckEffectTarget, prefetch only the checks done from every target to a common point
+    if (m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+        return;
+
+    if (IsTriggered())
+    {
+        if (m_triggeredByAuraSpell && m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+            return;
+
+        m_losPrefetchPoint.Relocate(m_caster);
+        if (m_targets.HasDst())
+            m_losPrefetchPoint.Relocate(m_targets.GetDstPos());
     }
+    else if (m_targets.HasDst())
+        m_losPrefetchPoint.Relocate(m_targets.GetDstPos());
+    else
+        return;
+
+    std::vector<WorldObject const*> units;
+    units.reserve(targets.size());
+    for (WorldObject* target : targets)
+        if (target->ToUnit() && target != m_caster && m_caster->IsInMap(target))
+            units.push_back(target);
+
+    // a single check gains nothing from batching
+    if (units.size() < 2)
+        return;
+
+    std::unique_ptr<bool[]> results(new bool[units.size()]);
+    WorldObject::AreWithinLOS(units.data(), uint32(units.size()), m_losPrefetchPoint.GetPositionX(), m_losPrefetchPoint.GetPositionY(), m_losPrefetchPoint.GetPositionZ(), results.get());
+    for (size_t i = 0; i < units.size(); ++i)
+        m_losPrefetch[units[i]->GetGUID()] = results[i];
+}
+
+bool Spell::IsTargetWithinLOS(Unit const* target, float x, float y, float z) const
+{
+    if (!m_losPrefetch.empty() && m_losPrefetchPoint.GetPositionX() == x && m_losPrefetchPoint.GetPositionY() == y && m_losPrefetchPoint.GetPositionZ() == z)
+    {
+        auto itr = m_losPrefetch.find(target->GetGUID());
+        if (itr != m_losPrefetch.end())
+            return itr->second;
+    }
+
+    return target->IsWithinLOS(x, y, z);
 }
 
 void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
@@ -1899,7 +1953,7 @@ void Spell::SelectEffectTypeImplicitTargets(uint8 effIndex)
     }
 }
 
-uint32 Spell::GetSearcherTypeMask(SpellTargetObjectTypes objType, ConditionContainer* condList)
+uint32 Spell::GetSearcherTypeMask(SpellTargetObjectTypes objType, CompiledConditions const* condList)
 {
     // this function selects which containers need to be searched for spell target
     uint32 retMask = GRID_MAP_TYPE_MASK_ALL;
@@ -1929,7 +1983,7 @@ uint32 Spell::GetSearcherTypeMask(SpellTargetObjectTypes objType, ConditionConta
         retMask &= GRID_MAP_TYPE_MASK_PLAYER;
 
     if (condList)
-        retMask &= sConditionMgr->GetSearcherTypeMaskForConditionList(*condList);
+        retMask &= sConditionMgr->GetSearcherTypeMaskForConditionList(condList->Conditions);
     return retMask;
 }
 
@@ -1963,7 +2017,7 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject*
     }
 }
 
-WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
+WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
 {
     WorldObject* target = nullptr;
     uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList);
@@ -1975,7 +2029,7 @@ WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objec
     return target;
 }
 
-void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
+void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
 {
     uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList);
     if (!containerTypeMask)
@@ -1985,7 +2039,7 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> >(searcher, containerTypeMask, m_caster, position, range);
 }
 
-void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal)
+void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, CompiledConditions const* condList, bool isChainHeal)
 {
     // max dist for jump target selection
     float jumpRadius = 0.0f;
@@ -7640,7 +7694,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
 
         // Ignore LoS for totems with positive effects, check it in all other cases
         bool casterIsTotem = (m_caster->GetTypeId() == TYPEID_UNIT && m_caster->ToCreature()->IsTotem());
-        if ((!casterIsTotem || !IsPositive()) && !target->IsWithinLOS(x, y, z))
+        if ((!casterIsTotem || !IsPositive()) && !IsTargetWithinLOS(target, x, y, z))
             return false;
 
         return true;
@@ -7706,7 +7760,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
         {
             if (m_targets.HasDst())
             {
-                if (!target->IsWithinLOS(m_targets.GetDstPos()->GetPositionX(), m_targets.GetDstPos()->GetPositionY(), m_targets.GetDstPos()->GetPositionZ()))
+                if (!IsTargetWithinLOS(target, m_targets.GetDstPos()->GetPositionX(), m_targets.GetDstPos()->GetPositionY(), m_targets.GetDstPos()->GetPositionZ()))
                     return false;
             }
             else 
@@ -8156,7 +8210,7 @@ namespace Trinity
 {
 
     WorldObjectSpellTargetCheck::WorldObjectSpellTargetCheck(WorldObject* caster, WorldObject* referer, SpellInfo const* spellInfo,
-        SpellTargetCheckTypes selectionType, ConditionContainer const* condList) : _caster(caster), _referer(referer), _spellInfo(spellInfo),
+        SpellTargetCheckTypes selectionType, CompiledConditions const* condList) : _caster(caster), _referer(referer), _spellInfo(spellInfo),
         _targetSelectionType(selectionType), _condList(condList)
     {
         if (condList)
@@ -8239,11 +8293,11 @@ namespace Trinity
         if (!_condSrcInfo)
             return true;
         _condSrcInfo->mConditionTargets[0] = target;
-        return sConditionMgr->IsObjectMeetToConditions(*_condSrcInfo, *_condList);
+        return _condList->Meets(*_condSrcInfo);
     }
 
     WorldObjectSpellNearbyTargetCheck::WorldObjectSpellNearbyTargetCheck(float range, WorldObject* caster, SpellInfo const* spellInfo,
-        SpellTargetCheckTypes selectionType, ConditionContainer const* condList)
+        SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
         : WorldObjectSpellTargetCheck(caster, caster, spellInfo, selectionType, condList), _range(range), _position(caster)
     {
     }
@@ -8260,7 +8314,7 @@ namespace Trinity
     }
 
     WorldObjectSpellAreaTargetCheck::WorldObjectSpellAreaTargetCheck(float range, Position const* position, WorldObject* caster,
-        WorldObject* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList)
+        WorldObject* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
         : WorldObjectSpellTargetCheck(caster, referer, spellInfo, selectionType, condList), _range(range), _position(position)
     {
     }
@@ -8285,7 +8339,7 @@ namespace Trinity
     }
 
     WorldObjectSpellConeTargetCheck::WorldObjectSpellConeTargetCheck(float coneAngle, float range, WorldObject* caster,
-        SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList)
+        SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
         : WorldObjectSpellAreaTargetCheck(range, caster, caster, caster, spellInfo, selectionType, condList), _coneAngle(coneAngle)
     {
     }
@@ -8315,7 +8369,7 @@ namespace Trinity
         return WorldObjectSpellAreaTargetCheck::operator()(target);
     }
 
-    WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Position const* position, WorldObject* caster, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList)
+    WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Position const* position, WorldObject* caster, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList)
         : WorldObjectSpellTargetCheck(caster, caster, spellInfo, selectionType, condList), _range(range), _position(position) { }
 
     bool WorldObjectSpellTrajTargetCheck::operator()(WorldObject* target) const
@@ -7,6 +7,7 @@
 #include "Position.h"
 #include "DBCEnums.h"
 #include "ConditionMgr.h"
+#include "MapObjectAllocator.h"
 
 namespace WorldPackets
 {
@@ -294,6 +295,8 @@ class TC_GAME_API Spell
     friend class TestCase;
 
     public:
+        static void* operator new(size_t size) { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_SPELL, size); }
+        static void operator delete(void* ptr) { MapObjectAllocator::Free(ptr); }
 
         void EffectNULL(uint32 );
         void EffectUnused(uint32 );
@@ -424,12 +427,12 @@ class TC_GAME_API Spell
 
         void SelectEffectTypeImplicitTargets(uint8 effIndex);
 
-        uint32 GetSearcherTypeMask(SpellTargetObjectTypes objType, ConditionContainer* condList);
+        uint32 GetSearcherTypeMask(SpellTargetObjectTypes objType, CompiledConditions const* condList);
         template<class SEARCHER> void SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject* referer, Position const* pos, float radius);
 
-        WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList = nullptr);
-        void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
-        void SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, ConditionContainer* condList, bool isChainHeal);
+        WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, CompiledConditions const* condList = nullptr);
+        void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
+        void SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories selectCategory, CompiledConditions const* condList, bool isChainHeal);
 
         inline uint32 prepare(Unit* const target, AuraEffect const* triggeredByAura = nullptr)
         {
@@ -485,6 +488,9 @@ class TC_GAME_API Spell
         void UpdateSpellCastDataAmmo(WorldPackets::Spells::SpellAmmo& ammo);
 
         bool CheckEffectTarget(Unit const* target, uint32 eff) const;
+        // Batch the LoS checks CheckEffectTarget will do for area targets, only valid until the targets are added
+        void PrefetchAreaTargetsLOS(std::list<WorldObject*> const& targets);
+        bool IsTargetWithinLOS(Unit const* target, float x, float y, float z) const;
         void CheckSrc() { if(!m_targets.HasSrc()) m_targets.SetSrc(m_caster); }
         void CheckDst() { if(!m_targets.HasDst()) m_targets.SetDst(m_caster); }
 
@@ -796,6 +802,10 @@ class TC_GAME_API Spell
         // sunwell:
         bool _spellTargetsSelected;
 
+        // target->IsWithinLOS(m_losPrefetchPoint) results filled by PrefetchAreaTargetsLOS
+        Position m_losPrefetchPoint;
+        std::unordered_map<ObjectGuid, bool> m_losPrefetch;
+
         PathGenerator* m_preGeneratedPath;
         // We need to keep this variable in spell to allow applying it for channels or for when cast finish
         SpellMissInfo _forceHitResult;
@@ -811,10 +821,10 @@ namespace Trinity
         SpellInfo const* _spellInfo;
         SpellTargetCheckTypes _targetSelectionType;
         ConditionSourceInfo* _condSrcInfo;
-        ConditionContainer const* _condList;
+        CompiledConditions const* _condList;
 
         WorldObjectSpellTargetCheck(WorldObject* caster, WorldObject* referer, SpellInfo const* spellInfo,
-            SpellTargetCheckTypes selectionType, ConditionContainer const* condList);
+            SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
         ~WorldObjectSpellTargetCheck();
 
         bool operator()(WorldObject* target) const;
@@ -825,7 +835,7 @@ namespace Trinity
         float _range;
         Position const* _position;
         WorldObjectSpellNearbyTargetCheck(float range, WorldObject* caster, SpellInfo const* spellInfo,
-            SpellTargetCheckTypes selectionType, ConditionContainer const* condList);
+            SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
 
         bool operator()(WorldObject* target);
     };
@@ -835,7 +845,7 @@ namespace Trinity
         float _range;
         Position const* _position;
         WorldObjectSpellAreaTargetCheck(float range, Position const* position, WorldObject* caster,
-            WorldObject* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList);
+            WorldObject* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
 
         bool operator()(WorldObject* target) const;
     };
@@ -844,7 +854,7 @@ namespace Trinity
     {
         float _coneAngle;
         WorldObjectSpellConeTargetCheck(float coneAngle, float range, WorldObject* caster,
-            SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList);
+            SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
 
         bool operator()(WorldObject* target) const;
     };
@@ -854,7 +864,7 @@ namespace Trinity
         float _range;
         Position const* _position;
         WorldObjectSpellTrajTargetCheck(float range, Position const* position, WorldObject* caster,
-            SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionContainer const* condList);
+            SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, CompiledConditions const* condList);
 
         bool operator()(WorldObject* target) const;
     };
@@ -6064,7 +6064,7 @@ void Spell::EffectDuel(uint32 i)
     if(!target->HaveAtClient(caster))
     {
          caster->SendUpdateToPlayer(target); 
-         target->m_clientGUIDs.insert(caster->GetGUID());
+         target->AddClientGUID(caster->GetGUID());
          target->SendInitialVisiblePackets((Unit*)caster);
     }
 
@@ -134,6 +134,7 @@ public:
     void BuildCooldownPacket(WorldPacket& data, uint8 flags, uint32 spellId, uint32 cooldown) const;
 
     CooldownStorageType::size_type GetCooldownsSizeForPacket() const { return _spellCooldowns.size(); }
+    CooldownStorageType const& GetSpellCooldowns() const { return _spellCooldowns; }
     void SaveCooldownStateBeforeDuel();
     void RestoreCooldownStateAfterDuel();
 
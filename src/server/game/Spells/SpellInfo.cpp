@@ -3265,10 +3265,10 @@ void SpellInfo::_InitializeSpellPositivity()
 
 void SpellInfo::_UnloadImplicitTargetConditionLists()
 {
-    // find the same instances of ConditionContainer and delete them.
+    // find the same instances of CompiledConditions and delete them.
     for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
     {
-        ConditionContainer* cur = Effects[i].ImplicitTargetConditions;
+        CompiledConditions* cur = Effects[i].ImplicitTargetConditions;
         if (!cur)
             continue;
         for (uint8 j = i; j < MAX_SPELL_EFFECTS; ++j)
@@ -10,7 +10,7 @@ enum AuraType : unsigned int;
 enum SpellCastResult : int;
 class SpellInfo;
 class Spell;
-struct Condition;
+class CompiledConditions;
 class Unit;
 class WorldObject;
 class Item;
@@ -281,7 +281,7 @@ public:
 #else
     uint64    SpellClassMask; //fake field for BC, contains spell_affect table data
 #endif
-    std::vector<Condition*>* ImplicitTargetConditions;
+    CompiledConditions* ImplicitTargetConditions;
 
     SpellEffectInfo() : _spellInfo(nullptr), _effIndex(0), Effect(0), ApplyAuraName(0), Amplitude(0), DieSides(0),
         RealPointsPerLevel(0), BasePoints(0), PointsPerComboPoint(0), ValueMultiplier(0), DamageMultiplier(0),
@@ -349,16 +349,15 @@ struct TC_GAME_API ImmunityInfo
     boost::container::flat_set<SpellEffects> SpellEffectImmune;
 };
 
-class TC_GAME_API SpellInfo
+class TC_GAME_API alignas(64) SpellInfo
 {
     friend class SpellMgr;
 
 public:
+    // Fields read on every cast, aura update and proc check come first, the class is cache line aligned so that they fill its
+    // first two lines: attributes, school mask, damage class and family, then proc flags and chance, interrupt flags and the
+    // duration, range and cast time entries. Rarely read data (names, visuals) is at the end.
     uint32 Id;
-    //can be null
-    SpellCategoryEntry const* Category;
-    uint32 Dispel;
-    Mechanics Mechanic;
     uint32 Attributes;
     uint32 AttributesEx;
     uint32 AttributesEx2;
@@ -368,6 +367,35 @@ public:
     uint32 AttributesEx6;
     uint32 AttributesEx7; // LK field, not commented out so we can still use it if we want
     uint32 AttributesCu;
+    uint32 SchoolMask;
+    uint32 DmgClass;
+    uint32 SpellFamilyName;
+#ifdef LICH_KING
+    flag96 SpellFamilyFlags;
+#else
+    uint64 SpellFamilyFlags;
+#endif
+    uint32 ProcFlags;
+    uint32 ProcChance;
+    uint32 ProcCharges;
+    uint32 Dispel;
+    Mechanics Mechanic;
+    uint32 PreventionType;
+    uint32 InterruptFlags;
+    uint32 AuraInterruptFlags;
+    uint32 ChannelInterruptFlags;
+    uint32 ExplicitTargetMask;
+    //can be null
+    SpellDurationEntry const* DurationEntry;
+    //can be null
+    SpellRangeEntry const* RangeEntry;
+    //can be null
+    SpellCastTimesEntry const* CastTimeEntry;
+    //can be null
+    SpellCategoryEntry const* Category;
+    SpellChainNode const* ChainEntry;
+
+    // cast validation
     uint32 Stances;
     uint32 StancesNot;
     uint32 Targets;
@@ -384,23 +412,13 @@ public:
     uint32 ExcludeCasterAuraSpell;
     uint32 ExcludeTargetAuraSpell;
 #endif
-    //can be null
-    SpellCastTimesEntry const* CastTimeEntry;
     uint32 RecoveryTime;
     uint32 CategoryRecoveryTime;
     uint32 StartRecoveryCategory;
     uint32 StartRecoveryTime;
-    uint32 InterruptFlags;
-    uint32 AuraInterruptFlags;
-    uint32 ChannelInterruptFlags;
-    uint32 ProcFlags;
-    uint32 ProcChance;
-    uint32 ProcCharges;
     uint32 MaxLevel;
     uint32 BaseLevel; // = min level
     uint32 SpellLevel;
-    //can be null
-    SpellDurationEntry const* DurationEntry;
     uint32 PowerType;
     uint32 ManaCost;
     uint32 ManaCostPerlevel;
@@ -408,18 +426,25 @@ public:
     uint32 ManaPerSecondPerLevel;
     uint32 ManaCostPercentage;
     //uint32 RuneCostID; //LK
-    //can be null
-    SpellRangeEntry const* RangeEntry;
     float  Speed;
     uint32 StackAmount;
-    uint32 Totem[2];
-    int32  Reagent[MAX_SPELL_REAGENTS];
-    uint32 ReagentCount[MAX_SPELL_REAGENTS];
+    uint32 MaxTargetLevel;
+    uint32 MaxAffectedTargets;
+#ifdef LICH_KING
+    int32  AreaGroupId;
+#else
+    uint32 AreaId;
+#endif
     int32  EquippedItemClass;
     int32  EquippedItemSubClassMask;
     int32  EquippedItemInventoryTypeMask;
-    //spell effects later
+    uint32 Totem[2];
     uint32 TotemCategory[2];
+    int32  Reagent[MAX_SPELL_REAGENTS];
+    uint32 ReagentCount[MAX_SPELL_REAGENTS];
+    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
+
+    // rarely read
 #ifdef LICH_KING
     uint32 SpellVisual[2];
 #else
@@ -430,25 +455,6 @@ public:
     uint32 Priority;
     char* SpellName[16];
     char* Rank[16];
-    uint32 MaxTargetLevel;
-    uint32 MaxAffectedTargets;
-    uint32 SpellFamilyName;
-#ifdef LICH_KING
-    flag96 SpellFamilyFlags;
-#else
-    uint64 SpellFamilyFlags;
-#endif
-    uint32 DmgClass;
-    uint32 PreventionType;
-#ifdef LICH_KING
-    int32  AreaGroupId;
-#else
-    uint32 AreaId;
-#endif
-    uint32 SchoolMask;
-    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
-    uint32 ExplicitTargetMask;
-    SpellChainNode const* ChainEntry;
 
     SpellInfo(SpellEntry const* spellEntry);
     ~SpellInfo();
@@ -3353,6 +3353,20 @@ void SpellMgr::LoadSpellInfoCorrections()
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo corrections in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
+void SpellMgr::LoadSpellAreaAttributes()
+{
+    QueryResult result = WorldDatabase.Query("SELECT DISTINCT spell FROM spell_area WHERE autocast = 1");
+    if (!result)
+        return;
+
+    do
+    {
+        // missing spells are reported by LoadSpellAreas
+        if (SpellInfo* spellInfo = _GetSpellInfo(result->Fetch()[0].GetUInt32()))
+            spellInfo->Attributes |= SPELL_ATTR0_CANT_CANCEL;
+    } while (result->NextRow());
+}
+
 void SpellMgr::LoadSpellAreas()
 {
     uint32 oldMSTime = GetMSTime();
@@ -3389,12 +3403,8 @@ void SpellMgr::LoadSpellAreas()
         spellArea.gender = Gender(fields[8].GetUInt8());
         spellArea.autocast = fields[9].GetBool();
 
-        if (SpellInfo const* spellInfo = GetSpellInfo(spell))
-        {
-            if (spellArea.autocast)
-                const_cast<SpellInfo*>(spellInfo)->Attributes |= SPELL_ATTR0_CANT_CANCEL;
-        }
-        else
+        // SPELL_ATTR0_CANT_CANCEL of autocast spells is set by LoadSpellAreaAttributes
+        if (!GetSpellInfo(spell))
         {
             TC_LOG_ERROR("sql.sql", "The spell %u listed in `spell_area` does not exist", spell);
             continue;
@@ -863,10 +863,7 @@ class TC_GAME_API SpellMgr
         }
 
         // Spell proc events
-        SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const
-        {
-            return Trinity::Containers::MapGetValuePtr(mSpellProcMap, spellId);
-        }
+        SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const { return Trinity::Containers::MapGetValuePtr(mSpellProcMap, spellId); }
         static bool CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo);
 
         SpellEnchantProcEntry const* GetSpellEnchantProcEvent(uint32 enchId) const
@@ -1033,6 +1030,8 @@ class TC_GAME_API SpellMgr
         void LoadSpellInfoCorrections();
         void LoadSpellInfoCustomAttributes(); //Some custom attributes are also added in SpellMgr::LoadSpellLinked()
         void LoadSpellAreas();
+        // Auras cast by spell_area can't be canceled. Apart from LoadSpellAreas, which needs the quests loaded.
+        void LoadSpellAreaAttributes();
         void LoadSpellInfoImmunities();
         void LoadSpellInfoDiminishing();
 
@@ -14,6 +14,7 @@
 #include "WardenModuleMac.h"
 #include "SHA1.h"
 #include "GameTime.h"
+#include "LogsDatabaseAccessor.h"
 
 WardenMac::WardenMac()
 {
@@ -124,7 +125,7 @@ void WardenMac::HandleHashResult(ByteBuffer &buff)
     {
         TC_LOG_DEBUG("warden","Request hash reply: failed");
         if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'Hash reply failed', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+            LogsDatabaseAccessor::WardenFail(Client, 0, "Hash reply failed");
 
         if (sWorld->getConfig(CONFIG_WARDEN_KICK))
             Client->KickPlayer();
@@ -195,7 +196,7 @@ void WardenMac::HandleData(ByteBuffer &buff)
         TC_LOG_DEBUG("warden","Handle data failed: SHA1 hash is wrong!");
         found = true;
         if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'SHA1 hash is wrong', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+            LogsDatabaseAccessor::WardenFail(Client, 0, "SHA1 hash is wrong");
     }
 
     MD5_CTX ctx;
@@ -211,7 +212,7 @@ void WardenMac::HandleData(ByteBuffer &buff)
         TC_LOG_DEBUG("warden","Handle data failed: MD5 hash is wrong!");
         found = true;
         if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'MD5 hash is wrong', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+            LogsDatabaseAccessor::WardenFail(Client, 0, "MD5 hash is wrong");
     }
 
     if (found && sWorld->getConfig(CONFIG_WARDEN_KICK))
@@ -19,6 +19,7 @@
 #include "Chat.h"
 #include "GameTime.h"
 #include "PlayerAntiCheat.h"
+#include "LogsDatabaseAccessor.h"
 
 CWardenDataStorage WardenDataStorage;
 
@@ -143,7 +144,7 @@ void WardenWin::HandleHashResult(ByteBuffer &buff)
     {
         TC_LOG_TRACE("warden","Request hash reply: failed");
         if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'Hash reply failed', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+            LogsDatabaseAccessor::WardenFail(Client, 0, "Hash reply failed");
 
         if (sWorld->getConfig(CONFIG_WARDEN_KICK))
             Client->KickPlayer();
@@ -299,7 +300,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
         buff.rpos(buff.wpos());
         
         if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'Invalid checksum', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+            LogsDatabaseAccessor::WardenFail(Client, 0, "Invalid checksum");
         
         if (sWorld->getConfig(CONFIG_WARDEN_KICK))
             Client->KickPlayer();
@@ -324,7 +325,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
             TC_LOG_DEBUG("warden","Warden: TIMING CHECK FAILED (result 0x00) for account %u, player %u (%s).", Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
             found = true;
             if (sWorld->getConfig(CONFIG_WARDEN_DB_LOG))
-                LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, 0, 'Timing check', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), time(NULL));
+                LogsDatabaseAccessor::WardenFail(Client, 0, "Timing check");
         }
 
         uint32 newClientTicks;
@@ -365,7 +366,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     found = true;
 
                     if (rd->action & WA_ACT_LOG)
-                        LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                        LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                     if (rd->action & WA_ACT_KICK)
                         kick = true;
                     if (rd->action & WA_ACT_BAN) {
@@ -382,7 +383,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     TC_LOG_DEBUG("warden","Warden: MEM CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                     
                     if (rd->action & WA_ACT_LOG)
-                        LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                        LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                     if (rd->action & WA_ACT_KICK)
                         kick = true;
                     if (rd->action & WA_ACT_BAN) {
@@ -412,7 +413,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                         //TC_LOG_DEBUG("warden","RESULT PAGE_CHECK fail, CheckId %u account Id %u", rd->id, Client->GetAccountId());
                         TC_LOG_DEBUG("warden","Warden: PAGE CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                         if (rd->action & WA_ACT_LOG)
-                            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                            LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                         if (rd->action & WA_ACT_KICK)
                             kick = true;
                         if (rd->action & WA_ACT_BAN) {
@@ -425,7 +426,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                         //TC_LOG_DEBUG("warden","RESULT MODULE_CHECK fail, CheckId %u account Id %u", rd->id, Client->GetAccountId());
                         TC_LOG_DEBUG("warden","Warden: MODULE CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                         if (rd->action & WA_ACT_LOG)
-                            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                            LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                         if (rd->action & WA_ACT_KICK)
                             kick = true;
                         if (rd->action & WA_ACT_BAN) {
@@ -438,7 +439,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                         //TC_LOG_DEBUG("warden","RESULT DRIVER_CHECK fail, CheckId %u account Id %u", rd->id, Client->GetAccountId());
                         TC_LOG_DEBUG("warden","Warden: DRIVER_CHECK CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                         if (rd->action & WA_ACT_LOG)
-                            LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                            LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                         if (rd->action & WA_ACT_KICK)
                             kick = true;
                         if (rd->action & WA_ACT_BAN) {
@@ -473,7 +474,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     TC_LOG_DEBUG("warden","Warden: LUA STR CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                     found = true;
                     if (rd->action & WA_ACT_LOG)
-                        LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                        LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                     if (rd->action & WA_ACT_KICK)
                         kick = true;
                     if (rd->action & WA_ACT_BAN) {
@@ -508,7 +509,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     TC_LOG_DEBUG("warden","Warden: MPQ CHECK NOT 0x00 for account %u, player %u (%s).", Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                     found = true;
                     if (rd->action & WA_ACT_LOG)
-                        LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                        LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                     if (rd->action & WA_ACT_KICK)
                         kick = true;
                     if (rd->action & WA_ACT_BAN) {
@@ -524,7 +525,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     TC_LOG_DEBUG("warden","Warden: MPQ CHECK FAILED at check %u (%s) for account %u, player %u (%s).", rd->id, rd->comment.c_str(), Client->GetAccountId(), Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetPlayer() ? Client->GetPlayer()->GetName().c_str() : "<Not connected>");
                     found = true;
                     if (rd->action & WA_ACT_LOG)
-                        LogsDatabase.PQuery("INSERT INTO warden_fails (guid, account, check_id, comment, time) VALUES (%u, %u, %u, '%s', %u)", Client->GetPlayer() ? Client->GetPlayer()->GetGUID().GetCounter() : 0, Client->GetAccountId(), rd->id, rd->comment.c_str(), time(NULL));
+                        LogsDatabaseAccessor::WardenFail(Client, rd->id, rd->comment);
                     if (rd->action & WA_ACT_KICK)
                         kick = true;
                     if (rd->action & WA_ACT_BAN) {
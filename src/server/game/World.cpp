@@ -27,6 +27,7 @@
 #include "Monitor.h"
 #include "Log.h"
 #include "LogsDatabaseAccessor.h"
+#include "LogsDatabaseBuffer.h"
 #include "LootMgr.h"
 #include "LootItemStorage.h"
 #include "M2Stores.h"
@@ -35,6 +36,7 @@
 #include "Management/VMapFactory.h"
 #include "Management/VMapManager2.h"
 #include "MapManager.h"
+#include "MapObjectAllocator.h"
 #include "Memory.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
@@ -49,6 +51,7 @@
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "SyncQueryTracker.h"
 #include "TemporarySummon.h"
 #include "Transport.h"
 #include "TransportMgr.h"
@@ -59,6 +62,7 @@
 #include "Weather.h"
 #include "WhoListStorage.h"
 #include "World.h"
+#include "WorldLoader.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #ifdef TESTS
@@ -1203,6 +1207,40 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 10);
     m_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 4);
+    m_configs[CONFIG_LOADING_THREADS] = sConfigMgr->GetIntDefault("Loading.Threads", 1);
+    m_configs[CONFIG_DBC_LOADING_THREADS] = sConfigMgr->GetIntDefault("DBC.LoadingThreads", 4);
+    m_configs[CONFIG_MAP_OBJECT_POOLS_ENABLED] = sConfigMgr->GetBoolDefault("ObjectPools.Enable", true);
+    // safe on reload, each object remembers whether it came from a pool
+    MapObjectAllocator::SetEnabled(getBoolConfig(CONFIG_MAP_OBJECT_POOLS_ENABLED));
+    m_configs[CONFIG_WORLD_SNAPSHOT_ENABLED] = sConfigMgr->GetBoolDefault("WorldSnapshot.Enable", false);
+    m_configs[CONFIG_MOVEMENT_TIERED_BROADCAST] = sConfigMgr->GetBoolDefault("Movement.TieredBroadcast.Enable", false);
+    m_configs[CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE] = sConfigMgr->GetIntDefault("Movement.TieredBroadcast.NearDistance", 30);
+    m_configs[CONFIG_MOVEMENT_TIERED_MID_DISTANCE] = sConfigMgr->GetIntDefault("Movement.TieredBroadcast.MidDistance", 60);
+    if (m_configs[CONFIG_MOVEMENT_TIERED_MID_DISTANCE] < m_configs[CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE])
+    {
+        TC_LOG_ERROR("server.loading", "Movement.TieredBroadcast.MidDistance (%u) must be greater or equal to Movement.TieredBroadcast.NearDistance (%u), set to %u.",
+            m_configs[CONFIG_MOVEMENT_TIERED_MID_DISTANCE], m_configs[CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE], m_configs[CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE]);
+        m_configs[CONFIG_MOVEMENT_TIERED_MID_DISTANCE] = m_configs[CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE];
+    }
+    m_configs[CONFIG_MOVEMENT_TIERED_MID_INTERVAL] = sConfigMgr->GetIntDefault("Movement.TieredBroadcast.MidInterval", 1000);
+    m_configs[CONFIG_MOVEMENT_TIERED_FAR_INTERVAL] = sConfigMgr->GetIntDefault("Movement.TieredBroadcast.FarInterval", 2000);
+    m_configs[CONFIG_LOS_CACHE_ENABLED] = sConfigMgr->GetBoolDefault("LineOfSight.Cache.Enable", true);
+    m_configs[CONFIG_LOS_CACHE_TTL] = sConfigMgr->GetIntDefault("LineOfSight.Cache.TTL", 500);
+    m_configs[CONFIG_AGGRO_CULLING_ENABLED] = sConfigMgr->GetBoolDefault("Creature.AggroCulling.Enable", true);
+    m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE] = sConfigMgr->GetIntDefault("Database.SyncQueryTracker.Mode", SYNC_QUERY_TRACKER_DISABLED);
+    if (m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE] < SYNC_QUERY_TRACKER_DISABLED || m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE] > SYNC_QUERY_TRACKER_ASSERT)
+    {
+        TC_LOG_ERROR("server.loading", "Database.SyncQueryTracker.Mode (%i) must be 0, 1 or 2. Using 0 instead.", m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE]);
+        m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE] = SYNC_QUERY_TRACKER_DISABLED;
+    }
+    m_configs[CONFIG_SYNC_QUERY_TRACKER_BUDGET] = sConfigMgr->GetIntDefault("Database.SyncQueryTracker.TickBudget", 5);
+    SyncQueryTracker::Configure(SyncQueryTrackerMode(m_configs[CONFIG_SYNC_QUERY_TRACKER_MODE]), m_configs[CONFIG_SYNC_QUERY_TRACKER_BUDGET]);
+    m_configs[CONFIG_MAIL_EXPIRED_CHUNK_SIZE] = sConfigMgr->GetIntDefault("Mail.Expired.ChunkSize", 500);
+    m_configs[CONFIG_LOGS_BUFFER_ENABLED] = sConfigMgr->GetBoolDefault("DBLog.Buffer.Enable", true);
+    m_configs[CONFIG_LOGS_BUFFER_FLUSH_INTERVAL] = sConfigMgr->GetIntDefault("DBLog.Buffer.FlushInterval", 1000);
+    m_configs[CONFIG_LOGS_BUFFER_BATCH_SIZE] = sConfigMgr->GetIntDefault("DBLog.Buffer.BatchSize", 500);
+    m_configs[CONFIG_LOGS_BUFFER_MAX_MEMORY] = sConfigMgr->GetIntDefault("DBLog.Buffer.MaxMemory", 32);
+    m_configs[CONFIG_LOGS_BUFFER_MAX_QUEUE_SIZE] = sConfigMgr->GetIntDefault("DBLog.Buffer.MaxQueueSize", 1000);
 
     m_configs[CONFIG_WORLDCHANNEL_MINLEVEL] = sConfigMgr->GetIntDefault("WorldChannel.MinLevel", 10);
 
@@ -1413,7 +1451,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     TC_LOG_INFO("server.loading","Initialize data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, getConfig(CONFIG_DBC_LOADING_THREADS));
     DetectDBCLang();
 
     // Load cinematic cameras
@@ -1430,349 +1468,190 @@ void World::SetInitialWorldSettings()
     MMAP::MMapManager* mmmgr = MMAP::MMapFactory::createOrGetMMapManager();
     mmmgr->InitializeThreadUnsafe(mapIds);
 
-    TC_LOG_INFO("server.loading","Loading Item Extended Cost Data...");
-    sObjectMgr->LoadItemExtendedCost();
-
-    TC_LOG_INFO("server.loading","Loading Spell templates...");
-    sObjectMgr->LoadSpellTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data..." );
-    sSpellMgr->LoadSkillLineAbilityMap();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data..." );
-    sSpellMgr->LoadSpellRequired();
-
     ///- Initialize static helper structures
     AIRegistry::Initialize();
 
-    TC_LOG_INFO("server.loading", "Loading SpellInfo store...");  //must be after all SpellEntry's alterations
-    sSpellMgr->LoadSpellInfoStore(false);
-
-    TC_LOG_INFO("server.loading", "Loading SpellInfo corrections...");
-    sSpellMgr->LoadSpellInfoCorrections();
-
-    TC_LOG_INFO("server.loading", "Loading SpellInfo custom attributes...");
-    sSpellMgr->LoadSpellInfoCustomAttributes(); //must be after LoadSkillLineAbilityMap
-
-    TC_LOG_INFO("server.loading", "Loading Spell Elixir types..." ); //must be after SpellInfo
-    sSpellMgr->LoadSpellElixirs();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...." ); //must be after LoadSkillLineAbilityMap and after SpellInfo
-    sSpellMgr->LoadSpellRanks();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills..." );
-    sSpellMgr->LoadSpellLearnSkills();                        // must be after LoadSpellChains and after SpellInfo
-
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells..." );  //must be after SpellInfo
-    sSpellMgr->LoadSpellLearnSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
-
-    TC_LOG_INFO("server.loading", "Loading Threat Spells Definitions..."); //must be after SpellInfo
-    sSpellMgr->LoadSpellThreats();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    TC_LOG_INFO("server.loading", "Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
-
-    TC_LOG_INFO("server.loading", "Loading InstanceTemplate" );
-    sObjectMgr->LoadInstanceTemplate();
+    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
+    /* World loaders, as a dependency graph. With Loading.Threads > 1, loaders run concurrently as soon as their dependencies are done.
+       A loader must list every loader filling a container it reads, or writing a container it also writes. Loaders that fill the
+       SpellInfo store or alter SpellInfo's are chained before "Spells", which every loader reading SpellInfo's depends on.
+       The loaders adding spawns to the grid store are chained as well. */
+    WorldLoader loader;
+
+    // Spells
+    loader.Add("ItemExtendedCost", "Loading Item Extended Cost Data...", {}, [] { sObjectMgr->LoadItemExtendedCost(); });
+    loader.Add("SpellTemplates", "Loading Spell templates...", {}, [] { sObjectMgr->LoadSpellTemplates(); });
+    loader.Add("SkillLineAbilityMap", "Loading SkillLineAbilityMultiMap Data...", {}, [] { sSpellMgr->LoadSkillLineAbilityMap(); });
+    loader.Add("SpellRequired", "Loading Spell Required Data...", { "SpellTemplates" }, [] { sSpellMgr->LoadSpellRequired(); });
+    loader.Add("SpellInfoStore", "Loading SpellInfo store...", { "SpellTemplates", "SkillLineAbilityMap", "SpellRequired" }, [] { sSpellMgr->LoadSpellInfoStore(false); }); //must be after all SpellEntry's alterations
+    loader.Add("SpellInfoCorrections", "Loading SpellInfo corrections...", { "SpellInfoStore" }, [] { sSpellMgr->LoadSpellInfoCorrections(); });
+    loader.Add("SpellInfoCustomAttributes", "Loading SpellInfo custom attributes...", { "SpellInfoCorrections" }, [] { sSpellMgr->LoadSpellInfoCustomAttributes(); });
+    loader.Add("SpellElixirs", "Loading Spell Elixir types...", { "SpellInfoCustomAttributes" }, [] { sSpellMgr->LoadSpellElixirs(); });
+    loader.Add("SpellRanks", "Loading Spell Rank Data....", { "SpellElixirs" }, [] { sSpellMgr->LoadSpellRanks(); });
+    loader.Add("SpellGroups", "Loading Spell Group types...", { "SpellRanks" }, [] { sSpellMgr->LoadSpellGroups(); });
+    loader.Add("SpellLearnSkills", "Loading Spell Learn Skills...", { "SpellGroups" }, [] { sSpellMgr->LoadSpellLearnSkills(); });
+    loader.Add("SpellLearnSpells", "Loading Spell Learn Spells...", { "SpellLearnSkills" }, [] { sSpellMgr->LoadSpellLearnSpells(); });
+    loader.Add("SpellBonuses", "Loading Spell Bonus Data...", { "SpellLearnSpells" }, [] { sSpellMgr->LoadSpellBonuses(); });
+    loader.Add("SpellThreats", "Loading Threat Spells Definitions...", { "SpellBonuses" }, [] { sSpellMgr->LoadSpellThreats(); });
+    loader.Add("SpellGroupStackRules", "Loading Spell Group Stack Rules...", { "SpellThreats" }, [] { sSpellMgr->LoadSpellGroupStackRules(); });
+    // SpellInfo alterations, all of them before "Spells"
+    loader.Add("SpellInfoDiminishing", "Loading SpellInfo diminishing infos...", { "SpellGroupStackRules" }, [] { sSpellMgr->LoadSpellInfoDiminishing(); });
+    loader.Add("SpellInfoImmunities", "Loading SpellInfo immunity infos...", { "SpellInfoDiminishing" }, [] { sSpellMgr->LoadSpellInfoImmunities(); });
+    loader.Add("SpellAreaAttributes", "Loading SpellArea autocast attributes...", { "SpellInfoImmunities" }, [] { sSpellMgr->LoadSpellAreaAttributes(); });
+    loader.Add("SpellTargetPositions", "Loading Spell target coordinates...", { "SpellAreaAttributes" }, [] { sSpellMgr->LoadSpellTargetPositions(); });
+    loader.Add("SpellAffects", "Loading SpellAffect definitions...", { "SpellTargetPositions" }, [] { sSpellMgr->LoadSpellAffects(); });
+    loader.Add("SpellLinked", "Loading linked spells...", { "SpellAffects" }, [] { sSpellMgr->LoadSpellLinked(); });
+    loader.Add("SpellProcs", "Loading Spell Proc conditions and data...", { "SpellLinked" }, [] { sSpellMgr->LoadSpellProcs(); }); //must be after LoadSpellAffects
+    // "Spells" is the point from which SpellInfo's and spell ranks/learn data may be read, SpellInfo's are final from there
+    // except for the effects ImplicitTargetConditions, set by "Conditions" and only read by spell target selection once loaded
+    loader.Add("Spells", "Loading spell pet auras...", { "SpellProcs" }, [] { sSpellMgr->LoadSpellPetAuras(); });
+
+    loader.Add("ScriptNames", "Loading Script Names...", {}, [] { sObjectMgr->LoadScriptNames(); });
+    loader.Add("InstanceTemplate", "Loading InstanceTemplate", { "ScriptNames" }, [] { sObjectMgr->LoadInstanceTemplate(); });
     // sunwell: Global Storage, should be loaded asap
-    TC_LOG_INFO("server.loading", "Loading character cache store...");
-    sCharacterCache->LoadCharacterCacheStorage();
-
+    loader.Add("CharacterCache", "Loading character cache store...", {}, [] { sCharacterCache->LoadCharacterCacheStorage(); });
     ///- Clean up and pack instances
-    // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    TC_LOG_INFO("server.loading", "Loading instances..." );
-    sInstanceSaveMgr->LoadInstances();                              // must be called before `creature_respawn`/`gameobject_respawn` tables
-
-//    TC_LOG_INFO("server.loading", "Packing instances..." );
-//    sInstanceSaveMgr->PackInstances();
-
-    TC_LOG_INFO("server.loading", "Loading Broadcast texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    TC_LOG_INFO("server.loading", "Loading Localization strings..." );
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadGossipTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadQuestGreetingsLocales();
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-
-    TC_LOG_INFO("server.loading", "Loading Page Texts..." );
-    sObjectMgr->LoadPageTexts();
-
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates..." );   // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading NPC Texts..." );
-    sObjectMgr->LoadGossipText();
-
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table..." );
-    LoadRandomEnchantmentsTable();
-
-    TC_LOG_INFO("server.loading", "Loading Items..." );                   // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Model Based Info Data..." );
-    sObjectMgr->LoadCreatureModelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Creature templates..." );
-    sObjectMgr->LoadCreatureTemplates(false);
-
-    TC_LOG_INFO("server.loading", "Loading Equipment templates...");
-    sObjectMgr->LoadEquipmentTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Creature template addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data..." );
-    sObjectMgr->LoadReputationOnKill();
-
-    TC_LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    TC_LOG_INFO("server.loading", "Loading Pet Create Spells..." );
-    sObjectMgr->LoadPetCreateSpells();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    TC_LOG_INFO("server.loading", "Loading Spawn Group Templates...");
-    sObjectMgr->LoadSpawnGroupTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading instance spawn groups...");
-    sObjectMgr->LoadInstanceSpawnGroups();
-
-    if(!getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING))
-    {
-        TC_LOG_INFO("server.loading", "Loading Creature Data..." );
-        sObjectMgr->LoadCreatures();
-
-        TC_LOG_INFO("server.loading", "Loading Creature Addon Data..." );
-        sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
-
-        TC_LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
-        sObjectMgr->LoadCreatureMovementOverrides();                 // must be after LoadCreatures()
-    }
-
-    if (!getConfig(CONFIG_DEBUG_DISABLE_GAMEOBJECTS_LOADING))
-    {
-        TC_LOG_INFO("server.loading", "Loading Gameobject Data...");
-        sObjectMgr->LoadGameObjects();
-    }
-
-    TC_LOG_INFO("server.loading", "Loading Spawn Group Data...");
-    sObjectMgr->LoadSpawnGroups();
-
-    TC_LOG_INFO("server.loading", "Loading Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                     // must be after LoadCreatures(), LoadGameObjects()
-
-    TC_LOG_INFO("server.loading", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    TC_LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Game Event Data...");
-    sGameEventMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Weather Data..." );
-    sObjectMgr->LoadWeatherZoneChances();
-
-    TC_LOG_INFO("server.loading","Loading GameObject models...");
-    LoadGameObjectModelList(sWorld->GetDataPath());
-
-    TC_LOG_INFO("server.loading", "Loading SpellInfo diminishing infos...");
-    sSpellMgr->LoadSpellInfoDiminishing();
-
-    TC_LOG_INFO("server.loading", "Loading SpellInfo immunity infos...");
-    sSpellMgr->LoadSpellInfoImmunities();
-
-    TC_LOG_INFO("server.loading", "Loading Quests..." );
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    TC_LOG_INFO("server.loading", "Loading Quests Relations..." );
-    sObjectMgr->LoadQuestRelations();                            // must be after quest load
-
-    TC_LOG_INFO("server.loading", "Loading Quests Greetings...");
-    sObjectMgr->LoadQuestGreetings();                           // must be loaded after creature_template, gameobject_template tables
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger definitions..." );
-    sObjectMgr->LoadAreaTriggerTeleports();
-
-    TC_LOG_INFO("server.loading", "Loading Access Requirements..." );
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
-
-    TC_LOG_INFO("server.loading", "Loading Quest Area Triggers..." );
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    TC_LOG_INFO("server.loading", "Loading SpellArea Data...");  // must be after quest load
-    sSpellMgr->LoadSpellAreas();
-
-    TC_LOG_INFO("server.loading", "Loading Tavern Area Triggers..." );
-    sObjectMgr->LoadTavernAreaTriggers();
-
-    TC_LOG_INFO("server.loading", "Loading AreaTrigger script names..." );
-    sObjectMgr->LoadAreaTriggerScripts();
-
-    TC_LOG_INFO("server.loading", "Loading Graveyard-zone links...");
-    sObjectMgr->LoadGraveyardZones();
-
-    TC_LOG_INFO("server.loading", "Loading Spell target coordinates..." );
-    sSpellMgr->LoadSpellTargetPositions();
-
-    TC_LOG_INFO("server.loading", "Loading SpellAffect definitions..." );
-    sSpellMgr->LoadSpellAffects(); 
-
-    TC_LOG_INFO("server.loading", "Loading linked spells...");
-    sSpellMgr->LoadSpellLinked();
-
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs(); //must be after LoadSpellAffects 
-
-    TC_LOG_INFO("server.loading", "Loading spell pet auras..." );
-    sSpellMgr->LoadSpellPetAuras();
-
-    TC_LOG_INFO("server.loading","Overriding SpellItemEnchantment...");
-    sSpellMgr->OverrideSpellItemEnchantment();
-
-    TC_LOG_INFO("server.loading", "Loading player Create Info & Level Stats..." );
-    sObjectMgr->LoadPlayerInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Exploration BaseXP Data..." );
-    sObjectMgr->LoadExplorationBaseXP();
-
-    TC_LOG_INFO("server.loading", "Loading Pet Name Parts..." );
-    sObjectMgr->LoadPetNames();
-
-    TC_LOG_INFO("server.loading", "Loading the max pet number..." );
-    sObjectMgr->LoadPetNumber();
-
-    TC_LOG_INFO("server.loading", "Loading pet level stats..." );
-    sObjectMgr->LoadPetLevelInfo();
-
-    TC_LOG_INFO("server.loading", "Loading Disabled Spells..." );
-    sObjectMgr->LoadSpellDisabledEntrys();
-
-    TC_LOG_INFO("server.loading", "Loading Loot Tables..." );
-    LoadLootTables();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table..." );
-    LoadSkillDiscoveryTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table..." );
-    LoadSkillExtraItemTable();
-
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements..." );
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loader.Add("Instances", "Loading instances...", { "InstanceTemplate" }, [] { sInstanceSaveMgr->LoadInstances(); }); // must be called before `creature_respawn`/`gameobject_respawn` tables
+
+    // Texts & locales
+    loader.Add("BroadcastTexts", "Loading Broadcast texts...", {}, [] { sObjectMgr->LoadBroadcastTexts(); sObjectMgr->LoadBroadcastTextLocales(); });
+    loader.Add("CreatureLocales", "Loading Creature Localization strings...", {}, [] { sObjectMgr->LoadCreatureLocales(); });
+    loader.Add("GameObjectLocales", "Loading GameObject Localization strings...", {}, [] { sObjectMgr->LoadGameObjectLocales(); });
+    loader.Add("ItemLocales", "Loading Item Localization strings...", {}, [] { sObjectMgr->LoadItemLocales(); });
+    loader.Add("QuestLocales", "Loading Quest Localization strings...", {}, [] { sObjectMgr->LoadQuestLocales(); });
+    loader.Add("GossipTextLocales", "Loading Npc Text Localization strings...", {}, [] { sObjectMgr->LoadGossipTextLocales(); });
+    loader.Add("PageTextLocales", "Loading Page Text Localization strings...", {}, [] { sObjectMgr->LoadPageTextLocales(); });
+    loader.Add("GossipMenuItemsLocales", "Loading Npc Options Localization strings...", {}, [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+    loader.Add("QuestGreetingsLocales", "Loading Quest Greetings Localization strings...", {}, [] { sObjectMgr->LoadQuestGreetingsLocales(); });
+    loader.Add("PageTexts", "Loading Page Texts...", {}, [] { sObjectMgr->LoadPageTexts(); });
+    loader.Add("GossipText", "Loading NPC Texts...", {}, [] { sObjectMgr->LoadGossipText(); });
+
+    // Templates
+    loader.Add("GameObjectTemplate", "Loading Game Object Templates...", { "PageTexts", "ScriptNames", "Spells" }, [] { sObjectMgr->LoadGameObjectTemplate(); });
+    loader.Add("SpellEnchantProcData", "Loading Enchant Spells Proc datas...", { "Spells" }, [] { sSpellMgr->LoadSpellEnchantProcData(); });
+    loader.Add("RandomEnchantments", "Loading Item Random Enchantments Table...", {}, [] { LoadRandomEnchantmentsTable(); });
+    loader.Add("ItemTemplates", "Loading Items...", { "RandomEnchantments", "PageTexts", "ScriptNames", "Spells", "ItemExtendedCost" }, [] { sObjectMgr->LoadItemTemplates(); });
+    loader.Add("CreatureModelInfo", "Loading Creature Model Based Info Data...", {}, [] { sObjectMgr->LoadCreatureModelInfo(); });
+    loader.Add("CreatureTemplates", "Loading Creature templates...", { "CreatureModelInfo", "ScriptNames", "Spells" }, [] { sObjectMgr->LoadCreatureTemplates(false); });
+    loader.Add("EquipmentTemplates", "Loading Equipment templates...", { "CreatureTemplates", "ItemTemplates" }, [] { sObjectMgr->LoadEquipmentTemplates(); });
+    loader.Add("CreatureTemplateAddons", "Loading Creature template addons...", { "CreatureTemplates" }, [] { sObjectMgr->LoadCreatureTemplateAddons(); });
+    loader.Add("ReputationOnKill", "Loading Creature Reputation OnKill Data...", { "CreatureTemplates" }, [] { sObjectMgr->LoadReputationOnKill(); });
+    loader.Add("PointsOfInterest", "Loading Points Of Interest Data...", {}, [] { sObjectMgr->LoadPointsOfInterest(); });
+    loader.Add("PetCreateSpells", "Loading Pet Create Spells...", { "CreatureTemplates" }, [] { sObjectMgr->LoadPetCreateSpells(); });
+    loader.Add("CreatureClassLevelStats", "Loading Creature Base Stats...", { "CreatureTemplates" }, [] { sObjectMgr->LoadCreatureClassLevelStats(); });
+    loader.Add("SpawnGroupTemplates", "Loading Spawn Group Templates...", {}, [] { sObjectMgr->LoadSpawnGroupTemplates(); });
+    loader.Add("InstanceSpawnGroups", "Loading instance spawn groups...", { "SpawnGroupTemplates", "InstanceTemplate" }, [] { sObjectMgr->LoadInstanceSpawnGroups(); });
+
+    // Spawns. Creatures and gameobjects both fill the grid store, keep them chained.
+    loader.Add("Creatures", "Loading Creature Data...", { "CreatureTemplates", "EquipmentTemplates", "CreatureTemplateAddons", "CreatureClassLevelStats", "SpawnGroupTemplates", "Instances" }, [this]
+    {
+        if (!getConfig(CONFIG_DEBUG_DISABLE_CREATURES_LOADING))
+        {
+            sObjectMgr->LoadCreatures();
+            sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
+            sObjectMgr->LoadCreatureMovementOverrides();                 // must be after LoadCreatures()
+        }
+    });
+    loader.Add("GameObjects", "Loading Gameobject Data...", { "GameObjectTemplate", "SpawnGroupTemplates", "Instances", "Creatures" }, [this]
+    {
+        if (!getConfig(CONFIG_DEBUG_DISABLE_GAMEOBJECTS_LOADING))
+            sObjectMgr->LoadGameObjects();
+    });
+    loader.Add("SpawnGroups", "Loading Spawn Group Data...", { "Creatures", "GameObjects", "InstanceSpawnGroups" }, [] { sObjectMgr->LoadSpawnGroups(); });
+    loader.Add("LinkedRespawn", "Loading Linked Respawn...", { "SpawnGroups" }, [] { sObjectMgr->LoadLinkedRespawn(); }); // must be after LoadCreatures(), LoadGameObjects()
+    loader.Add("TransportTemplates", "Loading Transport templates...", { "GameObjectTemplate" }, [] { sTransportMgr->LoadTransportTemplates(); });
+    loader.Add("Pools", "Loading Objects Pooling Data...", { "LinkedRespawn" }, [] { sPoolMgr->LoadFromDB(); });
+    loader.Add("GameEvents", "Loading Game Event Data...", { "Pools", "ItemTemplates", "ItemExtendedCost" }, [] { sGameEventMgr->LoadFromDB(); });
+    loader.Add("WeatherZoneChances", "Loading Weather Data...", {}, [] { sObjectMgr->LoadWeatherZoneChances(); });
+    loader.Add("GameObjectModels", "Loading GameObject models...", {}, [] { LoadGameObjectModelList(sWorld->GetDataPath()); });
+
+    // Quests
+    loader.Add("Quests", "Loading Quests...", { "CreatureTemplates", "ItemTemplates", "GameObjectTemplate", "Spells" }, [] { sObjectMgr->LoadQuests(); }); // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loader.Add("QuestRelations", "Loading Quests Relations...", { "Quests", "GameEvents" }, [] { sObjectMgr->LoadQuestRelations(); }); // must be after quest load
+    loader.Add("QuestGreetings", "Loading Quests Greetings...", { "CreatureTemplates", "GameObjectTemplate" }, [] { sObjectMgr->LoadQuestGreetings(); });
+    loader.Add("AreaTriggerTeleports", "Loading AreaTrigger definitions...", {}, [] { sObjectMgr->LoadAreaTriggerTeleports(); });
+    loader.Add("AccessRequirements", "Loading Access Requirements...", { "ItemTemplates", "Quests" }, [] { sObjectMgr->LoadAccessRequirements(); }); // must be after item template load
+    loader.Add("QuestAreaTriggers", "Loading Quest Area Triggers...", { "Quests" }, [] { sObjectMgr->LoadQuestAreaTriggers(); });
+    loader.Add("SpellAreas", "Loading SpellArea Data...", { "Quests", "Spells" }, [] { sSpellMgr->LoadSpellAreas(); }); // must be after quest load
+    loader.Add("TavernAreaTriggers", "Loading Tavern Area Triggers...", {}, [] { sObjectMgr->LoadTavernAreaTriggers(); });
+    loader.Add("AreaTriggerScripts", "Loading AreaTrigger script names...", { "ScriptNames" }, [] { sObjectMgr->LoadAreaTriggerScripts(); });
+    loader.Add("GraveyardZones", "Loading Graveyard-zone links...", {}, [] { sObjectMgr->LoadGraveyardZones(); });
+
+    // alters the SpellItemEnchantment store, also read by items
+    loader.Add("SpellItemEnchantment", "Overriding SpellItemEnchantment...", { "Spells", "ItemTemplates", "RandomEnchantments", "GameEvents" }, [] { sSpellMgr->OverrideSpellItemEnchantment(); });
+
+    // Players & pets
+    loader.Add("PlayerInfo", "Loading player Create Info & Level Stats...", { "ItemTemplates", "Spells" }, [] { sObjectMgr->LoadPlayerInfo(); });
+    loader.Add("ExplorationBaseXP", "Loading Exploration BaseXP Data...", {}, [] { sObjectMgr->LoadExplorationBaseXP(); });
+    loader.Add("PetNames", "Loading Pet Name Parts...", {}, [] { sObjectMgr->LoadPetNames(); });
+    loader.Add("PetNumber", "Loading the max pet number...", {}, [] { sObjectMgr->LoadPetNumber(); });
+    loader.Add("PetLevelInfo", "Loading pet level stats...", { "CreatureTemplates" }, [] { sObjectMgr->LoadPetLevelInfo(); });
+    loader.Add("SpellDisabledEntrys", "Loading Disabled Spells...", { "Spells" }, [] { sObjectMgr->LoadSpellDisabledEntrys(); });
+
+    // Loot & skills
+    loader.Add("LootTables", "Loading Loot Tables...", { "ItemTemplates", "CreatureTemplates", "GameObjectTemplate", "Quests", "Spells" }, [] { LoadLootTables(); });
+    loader.Add("SkillDiscoveryTable", "Loading Skill Discovery Table...", { "Spells" }, [] { LoadSkillDiscoveryTable(); });
+    loader.Add("SkillExtraItemTable", "Loading Skill Extra Item Table...", { "Spells", "ItemTemplates" }, [] { LoadSkillExtraItemTable(); });
+    loader.Add("FishingBaseSkillLevel", "Loading Skill Fishing base level requirements...", {}, [] { sObjectMgr->LoadFishingBaseSkillLevel(); });
 
     ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Auctions..." );
-    sAuctionMgr->LoadAuctionItems();
-    sAuctionMgr->LoadAuctions();
-
-//    TC_LOG_INFO("server.loading", "Loading Guilds..." );
-//    sObjectMgr->LoadGuilds();
-
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams..." );
-    sObjectMgr->LoadArenaTeams();
-
-    TC_LOG_INFO("server.loading", "Loading Groups..." );
-    sGroupMgr->LoadGroups();
-
-    TC_LOG_INFO("server.loading", "Loading ReservedNames..." );
-    sObjectMgr->LoadReservedPlayersNames();
-
-    TC_LOG_INFO("server.loading", "Loading GameObject for quests..." );
-    sObjectMgr->LoadGameObjectForQuests();
-
-    TC_LOG_INFO("server.loading", "Loading BattleMasters..." );
-    sObjectMgr->LoadBattleMastersEntry();
-
-    TC_LOG_INFO("server.loading", "Loading GameTeleports..." );
-    sObjectMgr->LoadGameTele();
-
-    TC_LOG_INFO("server.loading", "Loading Npc gossip menus..." );
-    sObjectMgr->LoadGossipMenu();
-
-    TC_LOG_INFO("server.loading", "Loading Npc Options..." );
-    sObjectMgr->LoadGossipMenuItems();
-
-    TC_LOG_INFO("server.loading", "Loading Npc gossips Id..." );
-    sObjectMgr->LoadCreatureGossip();                                 // must be after load Creature and menus
-
-    TC_LOG_INFO("server.loading", "Loading vendors..." );
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    TC_LOG_INFO("server.loading", "Loading trainers..." );
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    TC_LOG_INFO("server.loading", "Loading Waypoints..." );
-    sWaypointMgr->Load();
-
-    TC_LOG_INFO("server.loading","Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Formations..." );
-    sCreatureGroupMgr->LoadCreatureFormations();
-
-    TC_LOG_INFO("server.loading","Loading Conditions...");
-    sConditionMgr->LoadConditions();
-
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sObjectMgr->LoadGMTickets();
-
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
-
+    loader.Add("Auctions", "Loading Auctions...", { "ItemTemplates", "CharacterCache", "SpellItemEnchantment" }, [] { sAuctionMgr->LoadAuctionItems(); sAuctionMgr->LoadAuctions(); });
+    loader.Add("ArenaTeams", "Loading ArenaTeams...", { "CharacterCache" }, [] { sObjectMgr->LoadArenaTeams(); });
+    loader.Add("Groups", "Loading Groups...", { "CharacterCache", "Instances" }, [] { sGroupMgr->LoadGroups(); });
+    loader.Add("ReservedNames", "Loading ReservedNames...", {}, [] { sObjectMgr->LoadReservedPlayersNames(); });
+    loader.Add("GameObjectForQuests", "Loading GameObject for quests...", { "GameObjectTemplate", "Quests", "LootTables" }, [] { sObjectMgr->LoadGameObjectForQuests(); });
+    loader.Add("BattleMasters", "Loading BattleMasters...", { "CreatureTemplates" }, [] { sObjectMgr->LoadBattleMastersEntry(); });
+    loader.Add("GameTele", "Loading GameTeleports...", {}, [] { sObjectMgr->LoadGameTele(); });
+
+    // Npcs
+    loader.Add("GossipMenu", "Loading Npc gossip menus...", { "GossipText" }, [] { sObjectMgr->LoadGossipMenu(); });
+    loader.Add("GossipMenuItems", "Loading Npc Options...", { "GossipMenu", "PointsOfInterest", "BroadcastTexts" }, [] { sObjectMgr->LoadGossipMenuItems(); });
+    loader.Add("CreatureGossip", "Loading Npc gossips Id...", { "Creatures", "GossipMenu" }, [] { sObjectMgr->LoadCreatureGossip(); }); // must be after load Creature and menus
+    loader.Add("Vendors", "Loading vendors...", { "CreatureTemplates", "ItemTemplates", "ItemExtendedCost", "GameEvents" }, [] { sObjectMgr->LoadVendors(); }); // must be after load CreatureTemplate and ItemTemplate
+    loader.Add("TrainerSpell", "Loading trainers...", { "CreatureTemplates", "Spells" }, [] { sObjectMgr->LoadTrainerSpell(); }); // must be after load CreatureTemplate
+    loader.Add("Waypoints", "Loading Waypoints...", {}, [] { sWaypointMgr->Load(); });
+    loader.Add("SmartWaypoints", "Loading SmartAI Waypoints...", {}, [] { sSmartWaypointMgr->LoadFromDB(); });
+    loader.Add("CreatureFormations", "Loading Creature Formations...", { "Creatures", "Waypoints" }, [] { sCreatureGroupMgr->LoadCreatureFormations(); });
+
+    // Conditions reference about everything loaded above and store spell implicit target conditions into SpellInfo's.
+    // Nodes reading those must depend on "Conditions", none does, they are only read when casting.
+    loader.Add("Conditions", "Loading Conditions...", { "SpellItemEnchantment", "LootTables", "GossipMenuItems", "CreatureGossip", "Vendors", "TrainerSpell",
+        "QuestRelations", "QuestAreaTriggers", "AccessRequirements", "SpawnGroups", "GameObjects", "SpellDisabledEntrys", "SkillExtraItemTable", "SkillDiscoveryTable" },
+        [] { sConditionMgr->LoadConditions(); });
+
+    loader.Add("GMTickets", "Loading GM tickets...", { "CharacterCache" }, [] { sObjectMgr->LoadGMTickets(); });
+    loader.Add("Addons", "Loading client addons...", {}, [] { AddonMgr::LoadFromDB(); });
     ///- Handle outdated emails (delete/return)
-    TC_LOG_INFO("server.loading", "Returning old mails..." );
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    loader.Add("OldMails", "Returning old mails...", { "CharacterCache", "ItemTemplates", "SpellItemEnchantment" }, [] { sObjectMgr->ReturnOrDeleteOldMails(false); });
 
-    TC_LOG_INFO("server.loading","Loading faction change items...");
-    sObjectMgr->LoadFactionChangeItems();
-    TC_LOG_INFO("server.loading","Loading faction change spells...");
-    sObjectMgr->LoadFactionChangeSpells();
-    TC_LOG_INFO("server.loading","Loading faction change titles...");
-    sObjectMgr->LoadFactionChangeTitles();
-    TC_LOG_INFO("server.loading","Loading faction change quests...");
-    sObjectMgr->LoadFactionChangeQuests();
-    TC_LOG_INFO("server.loading","Loading faction change reputations (generic)...");
-    sObjectMgr->LoadFactionChangeReputGeneric();
+    loader.Add("FactionChange", "Loading faction change data...", { "ItemTemplates", "Spells", "Quests" }, []
+    {
+        sObjectMgr->LoadFactionChangeItems();
+        sObjectMgr->LoadFactionChangeSpells();
+        sObjectMgr->LoadFactionChangeTitles();
+        sObjectMgr->LoadFactionChangeQuests();
+        sObjectMgr->LoadFactionChangeReputGeneric();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading spell script names...");
-    sObjectMgr->LoadSpellScriptNames();
+    loader.Add("SpellScriptNames", "Loading spell script names...", { "ScriptNames", "Spells" }, [] { sObjectMgr->LoadSpellScriptNames(); });
+    loader.Add("CreatureTexts", "Loading Creature Texts...", { "CreatureTemplates", "BroadcastTexts" }, [] { sCreatureTextMgr->LoadCreatureTexts(); });
+    loader.Add("CreatureTextLocales", "Loading Creature Text Locales...", { "CreatureTexts" }, [] { sCreatureTextMgr->LoadCreatureTextLocales(); });
 
-    TC_LOG_INFO("server.loading","Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
+    ///- Load and initialize scripts
+    loader.Add("Scripts", "Loading Scripts...", { "Creatures", "GameObjects", "Quests", "SpellItemEnchantment", "Waypoints" }, []
+    {
+        sObjectMgr->LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sObjectMgr->LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadWaypointScripts();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
+    loader.Run(getConfig(CONFIG_LOADING_THREADS));
 
-    ///- Load and initialize scripts
-    TC_LOG_INFO("server.loading", "Loading Scripts..." );
-    sObjectMgr->LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr->LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
+    // Everything below needs all the data above and runs sequentially
 
     TC_LOG_INFO("server.loading", "Initializing Scripts..." );
     sScriptMgr->Initialize(_TRINITY_SCRIPT_CONFIG);
@@ -2076,6 +1955,12 @@ void World::Update(time_t diff)
         sAuctionMgr->Update();
     }
 
+    ///- Return or delete the next chunk of expired mails, if any
+    sObjectMgr->UpdateOldMails();
+
+    ///- Write the buffered logs if due
+    sLogsDatabaseBuffer->Update(diff);
+
     #ifdef PLAYERBOT
     sRandomPlayerbotMgr.UpdateAI(diff);
     sRandomPlayerbotMgr.UpdateSessions(diff);
@@ -243,6 +243,26 @@ enum WorldConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PREMATURE_BG_REWARD,
     CONFIG_NUMTHREADS,
+    CONFIG_LOADING_THREADS,
+    CONFIG_DBC_LOADING_THREADS,
+    CONFIG_MAP_OBJECT_POOLS_ENABLED,
+    CONFIG_WORLD_SNAPSHOT_ENABLED,
+    CONFIG_MOVEMENT_TIERED_BROADCAST,
+    CONFIG_MOVEMENT_TIERED_NEAR_DISTANCE,
+    CONFIG_MOVEMENT_TIERED_MID_DISTANCE,
+    CONFIG_MOVEMENT_TIERED_MID_INTERVAL,
+    CONFIG_MOVEMENT_TIERED_FAR_INTERVAL,
+    CONFIG_LOS_CACHE_ENABLED,
+    CONFIG_LOS_CACHE_TTL,
+    CONFIG_AGGRO_CULLING_ENABLED,
+    CONFIG_SYNC_QUERY_TRACKER_MODE,
+    CONFIG_SYNC_QUERY_TRACKER_BUDGET,
+    CONFIG_MAIL_EXPIRED_CHUNK_SIZE,
+    CONFIG_LOGS_BUFFER_ENABLED,
+    CONFIG_LOGS_BUFFER_FLUSH_INTERVAL,
+    CONFIG_LOGS_BUFFER_BATCH_SIZE,
+    CONFIG_LOGS_BUFFER_MAX_MEMORY,
+    CONFIG_LOGS_BUFFER_MAX_QUEUE_SIZE,
 
     CONFIG_WORLDCHANNEL_MINLEVEL,
 
@@ -0,0 +1,145 @@
+#include "WorldLoader.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+void WorldLoader::Add(std::string const& name, char const* description, std::initializer_list<char const*> dependencies, LoadFunction load)
+{
+    ASSERT(_nodeIndex.find(name) == _nodeIndex.end(), "WorldLoader: loader %s added twice", name.c_str());
+
+    uint32 const index = uint32(_nodes.size());
+    Node node;
+    node.Name = name;
+    node.Description = description;
+    node.Load = std::move(load);
+    for (char const* dependency : dependencies)
+    {
+        auto itr = _nodeIndex.find(dependency);
+        ASSERT(itr != _nodeIndex.end(), "WorldLoader: loader %s depends on unknown (or not yet added) loader %s", name.c_str(), dependency);
+        _nodes[itr->second].Dependents.push_back(index);
+        ++node.DependencyCount;
+    }
+
+    _nodes.push_back(std::move(node));
+    _nodeIndex[name] = index;
+}
+
+void WorldLoader::RunNode(Node& node)
+{
+    TC_LOG_INFO("server.loading", "%s", node.Description);
+    uint32 const startTime = GetMSTime();
+    node.Load();
+    node.Duration = GetMSTimeDiffToNow(startTime);
+}
+
+void WorldLoader::RunSequential()
+{
+    for (Node& node : _nodes)
+        RunNode(node);
+}
+
+void WorldLoader::RunParallel(uint32 threadCount)
+{
+    std::mutex lock;
+    std::condition_variable readyCondition;
+    // lowest index first, keeps the execution close to declaration order and starts long chains early
+    std::priority_queue<uint32, std::vector<uint32>, std::greater<uint32>> ready;
+    std::vector<uint32> pendingDependencies(_nodes.size());
+    size_t finished = 0;
+
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+    {
+        pendingDependencies[i] = _nodes[i].DependencyCount;
+        if (!pendingDependencies[i])
+            ready.push(i);
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            readyCondition.wait(guard, [&] { return !ready.empty() || finished == _nodes.size(); });
+            if (ready.empty())
+                return;
+
+            uint32 const index = ready.top();
+            ready.pop();
+
+            guard.unlock();
+            RunNode(_nodes[index]);
+            guard.lock();
+
+            ++finished;
+            for (uint32 dependent : _nodes[index].Dependents)
+                if (!--pendingDependencies[dependent])
+                    ready.push(dependent);
+
+            readyCondition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i)
+        threads.emplace_back(worker);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ASSERT(finished == _nodes.size());
+}
+
+void WorldLoader::Run(uint32 threadCount)
+{
+    threadCount = std::min<uint32>(std::max<uint32>(threadCount, 1), uint32(_nodes.size()));
+
+    uint32 const startTime = GetMSTime();
+    if (threadCount <= 1)
+        RunSequential();
+    else
+        RunParallel(threadCount);
+
+    LogReport(GetMSTimeDiffToNow(startTime), threadCount);
+}
+
+void WorldLoader::LogReport(uint32 wallTime, uint32 threadCount) const
+{
+    // critical path: longest chain of durations through the dependency graph (declaration order is topological)
+    std::vector<uint32> pathTime(_nodes.size(), 0);
+    uint32 criticalPath = 0;
+    uint64 totalTime = 0;
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+    {
+        pathTime[i] += _nodes[i].Duration;
+        criticalPath = std::max(criticalPath, pathTime[i]);
+        totalTime += _nodes[i].Duration;
+        for (uint32 dependent : _nodes[i].Dependents)
+            pathTime[dependent] = std::max(pathTime[dependent], pathTime[i]);
+    }
+
+    std::vector<uint32> byDuration(_nodes.size());
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+        byDuration[i] = i;
+    std::sort(byDuration.begin(), byDuration.end(), [this](uint32 a, uint32 b) { return _nodes[a].Duration > _nodes[b].Duration; });
+
+    TC_LOG_INFO("server.loading", ">> Ran %u loaders on %u thread(s) in %u ms (sum of loaders: " UI64FMTD " ms, critical path: %u ms)",
+        uint32(_nodes.size()), threadCount, wallTime, totalTime, criticalPath);
+
+    uint32 const slowestShown = 10;
+    for (uint32 i = 0; i < byDuration.size(); ++i)
+    {
+        Node const& node = _nodes[byDuration[i]];
+        if (i < slowestShown)
+            TC_LOG_INFO("server.loading", ">>   %-32s %6u ms", node.Name.c_str(), node.Duration);
+        else
+            TC_LOG_DEBUG("server.loading", ">>   %-32s %6u ms", node.Name.c_str(), node.Duration);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef _WORLD_LOADER_H_INCLUDED
+#define _WORLD_LOADER_H_INCLUDED
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+Startup loaders declared as a dependency graph.
+- A loader may only depend on loaders added before it, so declaration order is always a valid sequential order
+- With a single thread, loaders run in declaration order on the calling thread (same behavior as a plain call list)
+- With more threads, every loader whose dependencies are done may run concurrently. Loaders doing sync queries
+  each take their own connection from the pool, so DB.SynchThreads bounds how many can actually query at once.
+Dependencies must cover every container a loader reads or writes that another loader also writes.
+*/
+class TC_GAME_API WorldLoader
+{
+public:
+    typedef std::function<void()> LoadFunction;
+
+    // description is logged when the loader starts, as the "Loading xxx..." lines used to be
+    void Add(std::string const& name, char const* description, std::initializer_list<char const*> dependencies, LoadFunction load);
+
+    // Run all loaders then log a timing report. Blocks until all loaders are done.
+    void Run(uint32 threadCount);
+
+private:
+    struct Node
+    {
+        std::string Name;
+        char const* Description;
+        LoadFunction Load;
+        std::vector<uint32> Dependents;
+        uint32 DependencyCount = 0;
+        uint32 Duration = 0;
+    };
+
+    void RunNode(Node& node);
+    void RunSequential();
+    void RunParallel(uint32 threadCount);
+    void LogReport(uint32 wallTime, uint32 threadCount) const;
+
+    std::vector<Node> _nodes;
+    std::unordered_map<std::string, uint32> _nodeIndex;
+};
+
+#endif
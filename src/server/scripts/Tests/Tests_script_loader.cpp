@@ -21,12 +21,26 @@ void AddSC_test_talents_shaman();
 void AddSC_test_talents_warlock();
 void AddSC_test_talents_warrior();
 void AddSC_test_creature();
+void AddSC_test_event_scheduling();
+void AddSC_test_conditions();
+void AddSC_test_spell_hot_info();
+void AddSC_test_map_object_allocator();
+void AddSC_test_los_ray_packet();
+void AddSC_test_los_cache();
+void AddSC_test_aggro_culling();
 
 void AddTestsScripts()
 {
     AddSC_test_dummy();
     AddSC_test_loot_chance();
     AddSC_test_creature();
+    AddSC_test_event_scheduling();
+    AddSC_test_conditions();
+    AddSC_test_spell_hot_info();
+    AddSC_test_map_object_allocator();
+    AddSC_test_los_ray_packet();
+    AddSC_test_los_cache();
+    AddSC_test_aggro_culling();
 
 	AddSC_test_spells_druid();
 	AddSC_test_spells_hunter();
@@ -1,11 +1,15 @@
 #include "TestCase.h"
 #include "TestPlayer.h"
 #include "World.h"
+#include "Loot.h"
+#include "LootMgr.h"
 
+// Binomial drop count, accept up to 4 standard deviations
 template<class T>
 bool WithinStandartDeviation(T resultChance, T theoricChance, uint32 iterations)
 {
-    return true;
+    T const deviation = std::sqrt(theoricChance * (T(1) - theoricChance) / T(iterations));
+    return std::fabs(resultChance - theoricChance) <= T(4) * deviation;
 }
 
 class QuestLootChanceTest : public TestCaseScript
@@ -45,7 +49,90 @@ public:
     }
 };
 
+class LootGroupChanceTest : public TestCaseScript
+{
+public:
+
+    LootGroupChanceTest() : TestCaseScript("loot groupchance") { }
+
+    class LootGroupChanceTestImpl : public TestCase
+    {
+    public:
+        LootGroupChanceTestImpl() : TestCase(STATUS_PASSING) { }
+
+        enum Items
+        {
+            ITEM_LINEN_CLOTH     = 2589,
+            ITEM_WOOL_CLOTH      = 2592,
+            ITEM_SILK_CLOTH      = 4306,
+            ITEM_MAGEWEAVE_CLOTH = 4338,
+        };
+
+        static std::unique_ptr<LootTemplate> MakeGroup(float linenChance, float woolChance, uint16 linenLootMode = LOOT_MODE_DEFAULT)
+        {
+            std::unique_ptr<LootTemplate> tab = std::make_unique<LootTemplate>();
+            tab->AddEntry(new LootStoreItem(ITEM_LINEN_CLOTH, 0, linenChance, false, linenLootMode, 1, 1, 1));
+            tab->AddEntry(new LootStoreItem(ITEM_WOOL_CLOTH, 0, woolChance, false, LOOT_MODE_DEFAULT, 1, 1, 1));
+            tab->AddEntry(new LootStoreItem(ITEM_SILK_CLOTH, 0, 0.0f, false, LOOT_MODE_DEFAULT, 1, 1, 1));
+            tab->AddEntry(new LootStoreItem(ITEM_MAGEWEAVE_CLOTH, 0, 0.0f, false, LOOT_MODE_DEFAULT, 1, 1, 1));
+            tab->Compile();
+            return tab;
+        }
+
+        // Checks the drop chance of each item of a MakeGroup template
+        void TestDrops(LootTemplate const& tab, std::map<uint32, float> const& expected, uint32 alreadyLooted = 0)
+        {
+            uint32 const iterations = 20000;
+            std::map<uint32, uint32> drops;
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                Loot loot;
+                if (alreadyLooted)
+                    loot.AddItem(LootStoreItem(alreadyLooted, 0, 100.0f, false, LOOT_MODE_DEFAULT, 0, 1, 1));
+
+                tab.Process(loot, false, LOOT_MODE_DEFAULT);
+                for (LootItem const& item : loot.items)
+                    if (item.itemid != alreadyLooted)
+                        ++drops[item.itemid];
+            }
+
+            for (auto const& itr : expected)
+            {
+                float chance = float(drops[itr.first]) / float(iterations);
+                ASSERT_INFO("Item %u dropped with chance %f, expected %f", itr.first, chance, itr.second);
+                TEST_ASSERT(WithinStandartDeviation(chance, itr.second, iterations));
+            }
+        }
+
+        void Test() override
+        {
+            SECTION("Explicit and equal chances", [&] {
+                TestDrops(*MakeGroup(30.0f, 50.0f), { { ITEM_LINEN_CLOTH, 0.3f }, { ITEM_WOOL_CLOTH, 0.5f }, { ITEM_SILK_CLOTH, 0.1f }, { ITEM_MAGEWEAVE_CLOTH, 0.1f } });
+            });
+
+            SECTION("Explicit chances over 100%", [&] {
+                TestDrops(*MakeGroup(70.0f, 50.0f), { { ITEM_LINEN_CLOTH, 0.7f }, { ITEM_WOOL_CLOTH, 0.3f }, { ITEM_SILK_CLOTH, 0.0f }, { ITEM_MAGEWEAVE_CLOTH, 0.0f } });
+            });
+
+            // excluded entries give their place to the following ones
+            SECTION("Entry excluded by loot mode", [&] {
+                TestDrops(*MakeGroup(30.0f, 50.0f, LOOT_MODE_HARD_MODE_1), { { ITEM_LINEN_CLOTH, 0.0f }, { ITEM_WOOL_CLOTH, 0.5f }, { ITEM_SILK_CLOTH, 0.25f }, { ITEM_MAGEWEAVE_CLOTH, 0.25f } });
+            });
+
+            SECTION("Entry excluded as duplicate", [&] {
+                TestDrops(*MakeGroup(30.0f, 50.0f), { { ITEM_LINEN_CLOTH, 0.0f }, { ITEM_WOOL_CLOTH, 0.5f }, { ITEM_SILK_CLOTH, 0.25f }, { ITEM_MAGEWEAVE_CLOTH, 0.25f } }, ITEM_LINEN_CLOTH);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<LootGroupChanceTestImpl>();
+    }
+};
+
 void AddSC_test_loot_chance()
 {
     new QuestLootChanceTest();
+    new LootGroupChanceTest();
 }
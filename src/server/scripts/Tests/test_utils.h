@@ -1,8 +1,19 @@
 #ifndef TEST_UTILS_H
 #define TEST_UTILS_H
 
+#include "Define.h"
+#include <chrono>
+
 // Utility functions for tests
 namespace Testing {
+    // For the timings logged by the benchmark sections of utilities tests
+    typedef std::chrono::steady_clock Clock;
+
+    inline uint64 ElapsedUs(Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+
     // Create a bot as player, as well a training dummy 10 meters in front of it. Spawned in testing map (id 13)
     /*
     void PrepareCasterAndTarget(Player*& caster, Creature*& target);
@@ -0,0 +1,78 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "AggroCandidateIndex.h"
+#include "CreatureAI.h"
+#include "Map.h"
+#include "NullCreatureAI.h"
+
+class AggroCullingTest : public TestCaseScript
+{
+public:
+    AggroCullingTest() : TestCaseScript("utilities aggro_culling") { }
+
+    class AggroCullingTestImpl : public TestCase
+    {
+    public:
+        AggroCullingTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // CreatureAI::MoveInLineOfSight, may react to any unit
+        class ScriptedObserverAI : public CreatureAI
+        {
+        public:
+            explicit ScriptedObserverAI(Creature* creature) : CreatureAI(creature) { }
+        };
+
+        void Test() override
+        {
+            uint32 const STONESKIN_TOTEM_RNK_1 = 8071;
+            float const farDistance = 3 * MAX_VISIBILITY_DISTANCE;
+
+            TestPlayer* shaman = SpawnPlayer(CLASS_SHAMAN, RACE_DRAENEI);
+            TEST_CAST(shaman, shaman, STONESKIN_TOTEM_RNK_1, SPELL_CAST_OK, TRIGGERED_FULL_MASK);
+            Creature* totem = GetMap()->GetCreature(shaman->m_SummonSlot[SUMMON_SLOT_TOTEM]);
+            TEST_ASSERT(totem != nullptr);
+
+            Position farPosition(GetLocation());
+            farPosition.MoveInFront(GetLocation(), farDistance);
+            // only the creatures set up as observers below can react to it
+            Creature* farCreature = SpawnCreatureWithPosition(farPosition);
+            farCreature->AIM_Initialize(new PassiveAI(farCreature));
+
+            // separate index, the map one is used by map updates
+            SECTION("Player totem", [&] {
+                TEST_ASSERT(!(totem->GetAggroFlags() & CREATURE_AGGRO_OBSERVER));
+
+                AggroCandidateIndex index;
+                TEST_ASSERT(!index.CanBeObserved(*GetMap(), farCreature, MAX_VISIBILITY_DISTANCE));
+            });
+
+            SECTION("Scripted observer only prevents culling around it", [&] {
+                Creature* observer = SpawnCreature();
+                observer->AIM_Initialize(new ScriptedObserverAI(observer));
+                TEST_ASSERT(observer->GetAggroFlags() & CREATURE_AGGRO_ANY_UNIT);
+
+                Position nearPosition(GetLocation());
+                nearPosition.MoveInFront(GetLocation(), 30.0f);
+                Creature* nearCreature = SpawnCreatureWithPosition(nearPosition);
+                nearCreature->AIM_Initialize(new PassiveAI(nearCreature));
+
+                AggroCandidateIndex index;
+                TEST_ASSERT(index.CanBeObserved(*GetMap(), nearCreature, MAX_VISIBILITY_DISTANCE));
+                TEST_ASSERT(!index.CanBeObserved(*GetMap(), farCreature, MAX_VISIBILITY_DISTANCE));
+
+                observer->DespawnOrUnsummon();
+                nearCreature->DespawnOrUnsummon();
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<AggroCullingTestImpl>();
+    }
+};
+
+void AddSC_test_aggro_culling()
+{
+    new AggroCullingTest();
+}
@@ -0,0 +1,141 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "ConditionMgr.h"
+#include "test_utils.h"
+#include <random>
+
+class ConditionsTest : public TestCaseScript
+{
+public:
+    ConditionsTest() : TestCaseScript("utilities conditions") { }
+
+    class ConditionsTestImpl : public TestCase
+    {
+    public:
+        ConditionsTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // Random cheap conditions on the first target, spread over up to 4 interleaved else groups
+        static void FillConditions(std::mt19937& rng, std::vector<Condition>& storage, uint32 count)
+        {
+            storage.resize(count);
+            for (Condition& condition : storage)
+            {
+                condition.ElseGroup = rng() % 4;
+                condition.NegativeCondition = rng() % 4 == 0;
+                switch (rng() % 4)
+                {
+                    case 0:
+                        condition.ConditionType = CONDITION_CLASS;
+                        condition.ConditionValue1 = 1 << (rng() % MAX_CLASSES);
+                        break;
+                    case 1:
+                        condition.ConditionType = CONDITION_RACE;
+                        condition.ConditionValue1 = 1 << (rng() % MAX_RACES);
+                        break;
+                    case 2:
+                        condition.ConditionType = CONDITION_LEVEL;
+                        condition.ConditionValue1 = 1 + rng() % 70;
+                        condition.ConditionValue2 = rng() % COMP_TYPE_MAX;
+                        break;
+                    default:
+                        condition.ConditionType = CONDITION_ALIVE;
+                        break;
+                }
+            }
+        }
+
+        void Test() override
+        {
+            TestPlayer* player = SpawnRandomPlayer();
+
+            SECTION("Compiled conditions same result and throughput", [&] {
+                uint32 const listCount = 2000;
+                uint32 const passes = 50;
+                std::mt19937 rng(12345);
+
+                std::vector<std::vector<Condition>> storages(listCount);
+                std::vector<ConditionContainer> containers(listCount);
+                std::vector<CompiledConditions> compiled(listCount);
+                for (uint32 i = 0; i < listCount; ++i)
+                {
+                    FillConditions(rng, storages[i], 1 + rng() % 8);
+                    for (Condition& condition : storages[i])
+                        containers[i].push_back(&condition);
+
+                    compiled[i].Conditions = containers[i];
+                    sConditionMgr->CompileConditions(compiled[i]);
+                }
+
+                uint32 mismatches = 0;
+                for (uint32 i = 0; i < listCount; ++i)
+                {
+                    ConditionSourceInfo oldInfo(player);
+                    ConditionSourceInfo newInfo(player);
+                    if (sConditionMgr->IsObjectMeetToConditions(oldInfo, containers[i]) != compiled[i].Meets(newInfo))
+                        ++mismatches;
+                }
+
+                uint32 oldMet = 0;
+                Testing::Clock::time_point start = Testing::Clock::now();
+                for (uint32 pass = 0; pass < passes; ++pass)
+                    for (ConditionContainer const& container : containers)
+                    {
+                        ConditionSourceInfo srcInfo(player);
+                        oldMet += sConditionMgr->IsObjectMeetToConditions(srcInfo, container);
+                    }
+                uint64 oldTime = Testing::ElapsedUs(start);
+
+                uint32 newMet = 0;
+                start = Testing::Clock::now();
+                for (uint32 pass = 0; pass < passes; ++pass)
+                    for (CompiledConditions const& conditions : compiled)
+                    {
+                        ConditionSourceInfo srcInfo(player);
+                        newMet += conditions.Meets(srcInfo);
+                    }
+                uint64 newTime = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "Conditions: %u lists checked %u times in " UI64FMTD " us (condition list: " UI64FMTD " us)", listCount, passes, newTime, oldTime);
+
+                ASSERT_INFO("%u condition lists give a different result once compiled", mismatches);
+                TEST_ASSERT(mismatches == 0 && oldMet == newMet);
+            });
+
+            SECTION("Compiled conditions else groups", [&] {
+                Condition wrongClass;
+                wrongClass.ConditionType = CONDITION_CLASS;
+                wrongClass.ConditionValue1 = ~player->GetClassMask() & CLASSMASK_ALL_PLAYABLE;
+                Condition alive;
+                alive.ConditionType = CONDITION_ALIVE;
+                alive.ElseGroup = 1;
+
+                CompiledConditions conditions;
+                conditions.Conditions = { &alive, &wrongClass };
+                sConditionMgr->CompileConditions(conditions);
+                ConditionSourceInfo srcInfo(player);
+                TEST_ASSERT(conditions.Meets(srcInfo));
+
+                CompiledConditions failing;
+                failing.Conditions = { &wrongClass };
+                sConditionMgr->CompileConditions(failing);
+                ConditionSourceInfo failInfo(player);
+                TEST_ASSERT(!failing.Meets(failInfo));
+                TEST_ASSERT(failInfo.mLastFailedCondition == &wrongClass);
+
+                CompiledConditions empty;
+                sConditionMgr->CompileConditions(empty);
+                TEST_ASSERT(empty.Meets(srcInfo));
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<ConditionsTestImpl>();
+    }
+};
+
+void AddSC_test_conditions()
+{
+    new ConditionsTest();
+}
@@ -0,0 +1,185 @@
+#include "TestCase.h"
+#include "EventMap.h"
+#include "EventProcessor.h"
+#include "test_utils.h"
+#include <map>
+#include <random>
+
+// Minimal copy of the former multimap based EventMap, used as reference for both behavior and speed
+class MultimapEventMap
+{
+public:
+    MultimapEventMap() : _time(0), _lastEvent(0) { }
+
+    void Update(uint32 time) { _time += time; }
+    void ScheduleEvent(uint32 eventId, uint32 time) { _eventMap.insert(std::make_pair(_time + time, eventId)); }
+    void Repeat(uint32 time) { _eventMap.insert(std::make_pair(_time + time, _lastEvent)); }
+
+    void CancelEvent(uint32 eventId)
+    {
+        for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+        {
+            if (eventId == (itr->second & 0x0000FFFF))
+                itr = _eventMap.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
+    uint32 ExecuteEvent()
+    {
+        if (_eventMap.empty() || _eventMap.begin()->first > _time)
+            return 0;
+
+        _lastEvent = _eventMap.begin()->second;
+        _eventMap.erase(_eventMap.begin());
+        return _lastEvent & 0x0000FFFF;
+    }
+
+private:
+    uint32 _time;
+    uint32 _lastEvent;
+    std::multimap<uint32, uint32> _eventMap;
+};
+
+class EventSchedulingTest : public TestCaseScript
+{
+public:
+    EventSchedulingTest() : TestCaseScript("utilities event_scheduling") { }
+
+    class EventSchedulingTestImpl : public TestCase
+    {
+    public:
+        EventSchedulingTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // Simulate a bunch of creature AIs: each tick execute what's due, repeat it, and sometimes cancel and reschedule an event.
+        // Returns a checksum of the executed events order.
+        template<class Map>
+        static uint64 RunAIs(std::vector<Map>& maps, uint32 ticks, uint64& operations)
+        {
+            std::mt19937 rng(12345);
+            uint64 checksum = 0;
+            for (Map& map : maps)
+                for (uint32 eventId = 1; eventId <= 8; ++eventId)
+                    map.ScheduleEvent(eventId, rng() % 20000);
+
+            for (uint32 tick = 0; tick < ticks; ++tick)
+            {
+                for (Map& map : maps)
+                {
+                    map.Update(100);
+                    while (uint32 eventId = map.ExecuteEvent())
+                    {
+                        checksum = checksum * 31 + eventId;
+                        map.Repeat(1000 + rng() % 10000);
+                        ++operations;
+                    }
+
+                    if (rng() % 16 == 0)
+                    {
+                        uint32 eventId = 1 + rng() % 8;
+                        map.CancelEvent(eventId);
+                        map.ScheduleEvent(eventId, rng() % 5000);
+                        operations += 2;
+                    }
+                }
+            }
+
+            return checksum;
+        }
+
+        class CountingEvent : public BasicEvent
+        {
+        public:
+            explicit CountingEvent(uint32& counter) : _counter(counter) { }
+            bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override { ++_counter; return true; }
+
+        private:
+            uint32& _counter;
+        };
+
+        void Test() override
+        {
+            SECTION("EventMap same behavior as multimap", [&] {
+                uint64 newOperations = 0;
+                uint64 oldOperations = 0;
+
+                std::vector<EventMap> newMaps(2000);
+                Testing::Clock::time_point start = Testing::Clock::now();
+                uint64 newChecksum = RunAIs(newMaps, 600, newOperations);
+                uint64 newTime = Testing::ElapsedUs(start);
+
+                std::vector<MultimapEventMap> oldMaps(2000);
+                start = Testing::Clock::now();
+                uint64 oldChecksum = RunAIs(oldMaps, 600, oldOperations);
+                uint64 oldTime = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "EventMap: " UI64FMTD " operations in " UI64FMTD " us (multimap: " UI64FMTD " us)", newOperations, newTime, oldTime);
+
+                ASSERT_INFO("Executed events differ from the multimap implementation");
+                TEST_ASSERT(newChecksum == oldChecksum && newOperations == oldOperations);
+            });
+
+            SECTION("EventMap ordering", [&] {
+                EventMap events;
+                events.ScheduleEvent(1, 100);
+                events.ScheduleEvent(2, 50);
+                events.ScheduleEvent(3, 100);
+                events.ScheduleEvent(4, 100, 1);
+                events.DelayEvents(10, 1);
+                events.ScheduleEvent(5, 110);
+                events.Update(200);
+
+                TEST_ASSERT(events.ExecuteEvent() == 2);
+                TEST_ASSERT(events.ExecuteEvent() == 1);
+                TEST_ASSERT(events.ExecuteEvent() == 3);
+                TEST_ASSERT(events.ExecuteEvent() == 4);
+                TEST_ASSERT(events.ExecuteEvent() == 5);
+                TEST_ASSERT(events.ExecuteEvent() == 0);
+            });
+
+            SECTION("EventProcessor throughput", [&] {
+                uint32 const eventCount = 200000;
+                uint32 executed = 0;
+                std::mt19937 rng(12345);
+                EventProcessor processor;
+                std::vector<BasicEvent*> events;
+                events.reserve(eventCount);
+
+                Testing::Clock::time_point start = Testing::Clock::now();
+                for (uint32 i = 0; i < eventCount; ++i)
+                {
+                    BasicEvent* event = new CountingEvent(executed);
+                    events.push_back(event);
+                    processor.AddEvent(event, processor.CalculateTime(rng() % 60000));
+                }
+                uint64 scheduleTime = Testing::ElapsedUs(start);
+
+                start = Testing::Clock::now();
+                for (uint32 i = 0; i < eventCount; i += 4)
+                    events[i]->ScheduleAbort();
+                uint64 cancelTime = Testing::ElapsedUs(start);
+
+                start = Testing::Clock::now();
+                for (uint32 i = 0; i < 600; ++i)
+                    processor.Update(100);
+                uint64 executeTime = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "EventProcessor: %u events, schedule " UI64FMTD " us, cancel " UI64FMTD " us, execute " UI64FMTD " us", eventCount, scheduleTime, cancelTime, executeTime);
+
+                ASSERT_INFO("%u events executed, expected %u", executed, eventCount - eventCount / 4);
+                TEST_ASSERT(executed == eventCount - eventCount / 4);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<EventSchedulingTestImpl>();
+    }
+};
+
+void AddSC_test_event_scheduling()
+{
+    new EventSchedulingTest();
+}
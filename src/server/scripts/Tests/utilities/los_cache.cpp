@@ -0,0 +1,94 @@
+#include "TestCase.h"
+#include "LineOfSightCache.h"
+#include "World.h"
+
+class LoSCacheTest : public TestCaseScript
+{
+public:
+    LoSCacheTest() : TestCaseScript("utilities los_cache") { }
+
+    class LoSCacheTestImpl : public TestCase
+    {
+    public:
+        LoSCacheTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // What GameObject::UpdateModelPosition does to the map cache for a transport moving by offset
+        static void MoveModel(LineOfSightCache& cache, G3D::AABox& bounds, G3D::Vector3 const& offset)
+        {
+            cache.InvalidateDynamic(bounds);                    // Map::RemoveGameObjectModel
+            bounds = G3D::AABox(bounds.low() + offset, bounds.high() + offset);
+            cache.InvalidateDynamic(bounds);                    // Map::InsertGameObjectModel
+        }
+
+        void Test() override
+        {
+            TEST_ASSERT(sWorld->getIntConfig(CONFIG_LOS_CACHE_TTL) > 0);
+
+            // a boat of 60x20 yards, sailing along x
+            G3D::AABox boat(G3D::Vector3(0.0f, 0.0f, 0.0f), G3D::Vector3(60.0f, 20.0f, 30.0f));
+
+            LineOfSightCache::Key const crossingBoat(G3D::Vector3(30.0f, -20.0f, 5.0f), G3D::Vector3(30.0f, 40.0f, 5.0f), 1, 0);
+            LineOfSightCache::Key const nearPath(G3D::Vector3(150.0f, -10.0f, 5.0f), G3D::Vector3(150.0f, 30.0f, 5.0f), 1, 0);
+            LineOfSightCache::Key const farAway(G3D::Vector3(1000.0f, 1000.0f, 5.0f), G3D::Vector3(1040.0f, 1010.0f, 5.0f), 1, 0);
+            LineOfSightCache::Key const otherSide(G3D::Vector3(30.0f, -400.0f, 5.0f), G3D::Vector3(60.0f, -380.0f, 5.0f), 1, 0);
+
+            SECTION("Moving transport keeps unrelated results", [&] {
+                LineOfSightCache cache;
+                cache.StoreDynamic(crossingBoat, false);
+                cache.StoreDynamic(farAway, true);
+                cache.StoreDynamic(otherSide, false);
+                cache.StoreStatic(crossingBoat, true);
+
+                for (uint32 tick = 0; tick < 50; ++tick)
+                    MoveModel(cache, boat, G3D::Vector3(0.5f, 0.0f, 0.0f));
+
+                TEST_ASSERT(cache.FindDynamic(crossingBoat) == LineOfSightCache::RESULT_UNKNOWN);
+                TEST_ASSERT(cache.FindDynamic(farAway) == LineOfSightCache::RESULT_CLEAR);
+                TEST_ASSERT(cache.FindDynamic(otherSide) == LineOfSightCache::RESULT_BLOCKED);
+                // static results don't depend on gameobjects
+                TEST_ASSERT(cache.FindStatic(crossingBoat) == LineOfSightCache::RESULT_CLEAR);
+            });
+
+            SECTION("Results stored after a move are kept until the next move reaches them", [&] {
+                LineOfSightCache cache;
+                MoveModel(cache, boat, G3D::Vector3(1.0f, 0.0f, 0.0f));
+                cache.StoreDynamic(crossingBoat, false);
+                cache.StoreDynamic(nearPath, true);
+                TEST_ASSERT(cache.FindDynamic(crossingBoat) == LineOfSightCache::RESULT_BLOCKED);
+                TEST_ASSERT(cache.FindDynamic(nearPath) == LineOfSightCache::RESULT_CLEAR);
+
+                // the boat sails into the segment ahead of it
+                for (uint32 tick = 0; tick < 100 && cache.FindDynamic(nearPath) != LineOfSightCache::RESULT_UNKNOWN; ++tick)
+                    MoveModel(cache, boat, G3D::Vector3(1.0f, 0.0f, 0.0f));
+
+                TEST_ASSERT(cache.FindDynamic(nearPath) == LineOfSightCache::RESULT_UNKNOWN);
+                TEST_ASSERT(boat.high().x >= 150.0f - LineOfSightCache::REGION_SIZE);
+            });
+
+            SECTION("Purge keeps valid results", [&] {
+                LineOfSightCache cache;
+                cache.StoreDynamic(crossingBoat, false);
+                cache.StoreDynamic(farAway, true);
+                MoveModel(cache, boat, G3D::Vector3(1.0f, 0.0f, 0.0f));
+                cache.Update(60 * IN_MILLISECONDS);
+
+                TEST_ASSERT(cache.FindDynamic(crossingBoat) == LineOfSightCache::RESULT_UNKNOWN);
+                TEST_ASSERT(cache.FindDynamic(farAway) == LineOfSightCache::RESULT_CLEAR);
+                // invalidation is still seen after the purge
+                cache.StoreDynamic(crossingBoat, true);
+                MoveModel(cache, boat, G3D::Vector3(1.0f, 0.0f, 0.0f));
+                TEST_ASSERT(cache.FindDynamic(crossingBoat) == LineOfSightCache::RESULT_UNKNOWN);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<LoSCacheTestImpl>();
+    }
+};
+
+void AddSC_test_los_cache()
+{
+    new LoSCacheTest();
+}
@@ -0,0 +1,259 @@
+#include "TestCase.h"
+#include "Map.h"
+#include "ModelIgnoreFlags.h"
+#include "ModelInstance.h"
+#include "RayPacket.h"
+#include "WorldModel.h"
+#include "test_utils.h"
+#include <random>
+
+class LoSRayPacketTest : public TestCaseScript
+{
+public:
+    LoSRayPacketTest() : TestCaseScript("utilities los_ray_packet") { }
+
+    class LoSRayPacketTestImpl : public TestCase
+    {
+    public:
+        LoSRayPacketTestImpl() : TestCase(STATUS_PASSING) { }
+
+        struct Segment
+        {
+            G3D::Vector3 start;
+            G3D::Vector3 end;
+        };
+
+        static float Random(std::mt19937& rng, float low, float high)
+        {
+            return std::uniform_real_distribution<float>(low, high)(rng);
+        }
+
+        static G3D::Vector3 RandomPoint(std::mt19937& rng, G3D::AABox const& box)
+        {
+            return G3D::Vector3(Random(rng, box.low().x, box.high().x), Random(rng, box.low().y, box.high().y), Random(rng, box.low().z, box.high().z));
+        }
+
+        // Random triangles of up to 6 yards wide spread in box, as one WMO group
+        static VMAP::GroupModel RandomGroup(std::mt19937& rng, G3D::AABox const& box, uint32 triangleCount, uint32 groupId)
+        {
+            std::vector<G3D::Vector3> vertices;
+            std::vector<VMAP::MeshTriangle> triangles;
+            G3D::AABox bound;
+            for (uint32 i = 0; i < triangleCount; ++i)
+            {
+                G3D::Vector3 center = RandomPoint(rng, box);
+                for (uint32 j = 0; j < 3; ++j)
+                {
+                    vertices.push_back(center + G3D::Vector3(Random(rng, -3.0f, 3.0f), Random(rng, -3.0f, 3.0f), Random(rng, -3.0f, 3.0f)));
+                    if (vertices.size() == 1)
+                        bound = G3D::AABox(vertices.back());
+                    else
+                        bound.merge(vertices.back());
+                }
+                triangles.emplace_back(3 * i, 3 * i + 1, 3 * i + 2);
+            }
+
+            VMAP::GroupModel group(0, groupId, bound);
+            group.setMeshData(vertices, triangles);
+            return group;
+        }
+
+        // Segments from and to random points of box, a few of them very short or of length 0
+        static std::vector<Segment> RandomSegments(std::mt19937& rng, G3D::AABox const& box, uint32 count)
+        {
+            std::vector<Segment> segments(count);
+            for (Segment& segment : segments)
+            {
+                segment.start = RandomPoint(rng, box);
+                switch (rng() % 20)
+                {
+                    case 0:
+                        segment.end = segment.start;
+                        break;
+                    case 1:
+                        segment.end = segment.start + G3D::Vector3(Random(rng, -0.5f, 0.5f), Random(rng, -0.5f, 0.5f), Random(rng, -0.5f, 0.5f));
+                        break;
+                    default:
+                        segment.end = RandomPoint(rng, box);
+                        break;
+                }
+            }
+            return segments;
+        }
+
+        // Runs the segments as packets of up to RayPacket::MAX_RAYS (the last one partially filled) through intersectPacket,
+        // and one by one through intersectRay, as StaticMapTree::isInLineOfSight does. Returns the number of different results.
+        template<class PacketFn, class RayFn>
+        static uint32 CountMismatches(std::vector<Segment> const& segments, PacketFn intersectPacket, RayFn intersectRay, uint32& hits)
+        {
+            uint32 mismatches = 0;
+            for (size_t first = 0; first < segments.size(); first += RayPacket::MAX_RAYS)
+            {
+                size_t const last = std::min(segments.size(), first + RayPacket::MAX_RAYS);
+                RayPacket packet;
+                RayPacket::Mask active = 0;
+                for (size_t i = first; i < last; ++i)
+                {
+                    float const distance = (segments[i].end - segments[i].start).magnitude();
+                    if (distance < 1e-10f)
+                        continue; // always in line of sight, never added to packets
+
+                    active |= RayPacket::Mask(1) << packet.size();
+                    packet.add(segments[i].start, (segments[i].end - segments[i].start) / distance, distance);
+                }
+
+                RayPacket::Mask packetHits = intersectPacket(packet, active);
+                uint32 ray = 0;
+                for (size_t i = first; i < last; ++i)
+                {
+                    float distance = (segments[i].end - segments[i].start).magnitude();
+                    bool singleHit = false;
+                    bool packetHit = false;
+                    if (distance >= 1e-10f)
+                    {
+                        G3D::Ray singleRay(segments[i].start, (segments[i].end - segments[i].start) / distance);
+                        singleHit = intersectRay(singleRay, distance);
+                        packetHit = (packetHits >> ray) & 1;
+                        ++ray;
+                    }
+
+                    if (singleHit)
+                        ++hits;
+                    if (singleHit != packetHit)
+                        ++mismatches;
+                }
+            }
+            return mismatches;
+        }
+
+        void Test() override
+        {
+            uint32 const rayCount = 16000;
+            std::mt19937 rng(36);
+
+            G3D::AABox const modelBox(G3D::Vector3(-40.0f, -40.0f, -20.0f), G3D::Vector3(40.0f, 40.0f, 20.0f));
+            G3D::AABox const rayBox(G3D::Vector3(-50.0f, -50.0f, -25.0f), G3D::Vector3(50.0f, 50.0f, 25.0f));
+
+            SECTION("Group model", [&] {
+                VMAP::GroupModel group = RandomGroup(rng, modelBox, 2000, 0);
+                std::vector<Segment> segments = RandomSegments(rng, rayBox, rayCount);
+
+                uint32 hits = 0;
+                uint32 mismatches = CountMismatches(segments,
+                    [&](RayPacket const& packet, RayPacket::Mask active) { return group.IntersectRayPacket(packet, active); },
+                    [&](G3D::Ray const& ray, float distance) { return group.IntersectRay(ray, distance, true); }, hits);
+
+                ASSERT_INFO("%u of %u rays have a different packet result, %u single ray hits", mismatches, rayCount, hits);
+                TEST_ASSERT(mismatches == 0);
+                // both blocked and clear rays were tested
+                TEST_ASSERT(hits > 0 && hits < rayCount);
+            });
+
+            // several groups, each with its own triangle tree under the group tree
+            VMAP::WorldModel model;
+            {
+                std::vector<VMAP::GroupModel> groups;
+                for (uint32 i = 0; i < 8; ++i)
+                {
+                    G3D::Vector3 corner = RandomPoint(rng, modelBox);
+                    G3D::AABox groupBox(corner.min(modelBox.high() - G3D::Vector3(20.0f, 20.0f, 10.0f)));
+                    groupBox.merge(groupBox.low() + G3D::Vector3(20.0f, 20.0f, 10.0f));
+                    groups.push_back(RandomGroup(rng, groupBox, 250, i));
+                }
+                model.setGroupModels(groups);
+            }
+
+            SECTION("World model", [&] {
+                std::vector<Segment> segments = RandomSegments(rng, rayBox, rayCount);
+
+                uint32 hits = 0;
+                uint32 mismatches = CountMismatches(segments,
+                    [&](RayPacket const& packet, RayPacket::Mask active) { return model.IntersectRayPacket(packet, active, VMAP::ModelIgnoreFlags::Nothing); },
+                    [&](G3D::Ray const& ray, float distance) { return model.IntersectRay(ray, distance, true, VMAP::ModelIgnoreFlags::Nothing); }, hits);
+
+                ASSERT_INFO("%u of %u rays have a different packet result, %u single ray hits", mismatches, rayCount, hits);
+                TEST_ASSERT(mismatches == 0);
+                TEST_ASSERT(hits > 0 && hits < rayCount);
+            });
+
+            SECTION("Rotated and scaled model instance", [&] {
+                VMAP::ModelSpawn spawn;
+                spawn.flags = VMAP::MOD_HAS_BOUND;
+                spawn.adtId = 0;
+                spawn.ID = 1;
+                spawn.iPos = G3D::Vector3(1000.0f, -500.0f, 80.0f);
+                spawn.iRot = G3D::Vector3(10.0f, 135.0f, -20.0f);   // degrees
+                spawn.iScale = 1.7f;
+                // world space bounds of the model box corners
+                G3D::Matrix3 const rotation = G3D::Matrix3::fromEulerAnglesZYX(G3D::pi() * spawn.iRot.y / 180.f, G3D::pi() * spawn.iRot.x / 180.f, G3D::pi() * spawn.iRot.z / 180.f);
+                for (int i = 0; i < 8; ++i)
+                {
+                    G3D::Vector3 corner = rotation * modelBox.corner(i) * spawn.iScale + spawn.iPos;
+                    if (i == 0)
+                        spawn.iBound = G3D::AABox(corner);
+                    else
+                        spawn.iBound.merge(corner);
+                }
+                VMAP::ModelInstance instance(spawn, &model);
+
+                G3D::AABox instanceRayBox(spawn.iBound.low() - G3D::Vector3(10.0f, 10.0f, 10.0f), spawn.iBound.high() + G3D::Vector3(10.0f, 10.0f, 10.0f));
+                std::vector<Segment> segments = RandomSegments(rng, instanceRayBox, rayCount);
+
+                uint32 hits = 0;
+                uint32 mismatches = CountMismatches(segments,
+                    [&](RayPacket const& packet, RayPacket::Mask active) { return instance.intersectRayPacket(packet, active, VMAP::ModelIgnoreFlags::Nothing); },
+                    [&](G3D::Ray const& ray, float distance) { return instance.intersectRay(ray, distance, true, VMAP::ModelIgnoreFlags::Nothing); }, hits);
+
+                ASSERT_INFO("%u of %u rays have a different packet result, %u single ray hits", mismatches, rayCount, hits);
+                TEST_ASSERT(mismatches == 0);
+                TEST_ASSERT(hits > 0 && hits < rayCount);
+            });
+
+            SECTION("Map line of sight", [&] {
+                // whatever vmaps and gameobjects the test map has, batched and single checks must agree
+                Position const& center = GetLocation();
+                G3D::AABox const mapBox(G3D::Vector3(center.GetPositionX() - 60.0f, center.GetPositionY() - 60.0f, center.GetPositionZ() - 5.0f),
+                    G3D::Vector3(center.GetPositionX() + 60.0f, center.GetPositionY() + 60.0f, center.GetPositionZ() + 20.0f));
+                std::vector<Segment> segments = RandomSegments(rng, mapBox, 2000);
+
+                std::vector<G3D::Vector3> starts, ends;
+                for (Segment const& segment : segments)
+                {
+                    starts.push_back(segment.start);
+                    ends.push_back(segment.end);
+                }
+
+                std::unique_ptr<bool[]> results(new bool[segments.size()]);
+                Testing::Clock::time_point start = Testing::Clock::now();
+                GetMap()->isInLineOfSight(starts.data(), ends.data(), segments.size(), results.get(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing);
+                uint64 const packetTime = Testing::ElapsedUs(start);
+
+                uint32 mismatches = 0;
+                start = Testing::Clock::now();
+                for (size_t i = 0; i < segments.size(); ++i)
+                {
+                    Segment const& segment = segments[i];
+                    bool inLoS = GetMap()->isInLineOfSight(segment.start.x, segment.start.y, segment.start.z, segment.end.x, segment.end.y, segment.end.z,
+                        PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing);
+                    if (inLoS != results[i])
+                        ++mismatches;
+                }
+                uint64 const singleTime = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "LoS ray packets: %u map segments in " UI64FMTD " us (single rays: " UI64FMTD " us)", uint32(segments.size()), packetTime, singleTime);
+                ASSERT_INFO("%u of %u map segments have a different batched result", mismatches, uint32(segments.size()));
+                TEST_ASSERT(mismatches == 0);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<LoSRayPacketTestImpl>();
+    }
+};
+
+void AddSC_test_los_ray_packet()
+{
+    new LoSRayPacketTest();
+}
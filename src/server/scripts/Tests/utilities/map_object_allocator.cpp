@@ -0,0 +1,146 @@
+#include "TestCase.h"
+#include "MapObjectAllocator.h"
+#include "SpellAuras.h"
+#include "test_utils.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <thread>
+
+class MapObjectAllocatorTest : public TestCaseScript
+{
+public:
+    MapObjectAllocatorTest() : TestCaseScript("utilities map_object_allocator") { }
+
+    class MapObjectAllocatorTestImpl : public TestCase
+    {
+    public:
+        MapObjectAllocatorTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // Aura churn: batches of objects freed in random order, as auras expire
+        template<class AllocateFn, class FreeFn>
+        static uint64 Churn(AllocateFn allocate, FreeFn free, uint32 batches, uint32 batchSize)
+        {
+            std::mt19937 rng(12345);
+            std::vector<void*> objects(batchSize);
+            Testing::Clock::time_point start = Testing::Clock::now();
+            for (uint32 batch = 0; batch < batches; ++batch)
+            {
+                for (void*& object : objects)
+                    object = allocate();
+                std::shuffle(objects.begin(), objects.end(), rng);
+                for (void* object : objects)
+                    free(object);
+            }
+            return Testing::ElapsedUs(start);
+        }
+
+        // The pools flag is process wide, maps keep allocating meanwhile. Restored even if a section fails.
+        struct PoolsEnabledScope
+        {
+            explicit PoolsEnabledScope(bool enabled) : Previous(MapObjectAllocator::IsEnabled()) { MapObjectAllocator::SetEnabled(enabled); }
+            ~PoolsEnabledScope() { MapObjectAllocator::SetEnabled(Previous); }
+
+            bool const Previous;
+        };
+
+        void Test() override
+        {
+            SECTION("Objects freed by another thread are reused", [&] {
+                PoolsEnabledScope pools(true);
+
+                // smaller than any DynamicObject, these slots are used by this test only
+                size_t const size = 40;
+                uint32 const count = 800;
+
+                std::vector<void*> objects(count);
+                for (void*& object : objects)
+                    object = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size);
+                std::set<void*> remoteFreed(objects.begin(), objects.end());
+
+                uint64 const remoteFreesBefore = MapObjectAllocator::GetStats()[MAP_OBJECT_POOL_DYNAMICOBJECT].RemoteFrees;
+                std::thread([&objects] {
+                    for (void* object : objects)
+                        MapObjectAllocator::Free(object);
+                }).join();
+                uint64 const remoteFrees = MapObjectAllocator::GetStats()[MAP_OBJECT_POOL_DYNAMICOBJECT].RemoteFrees - remoteFreesBefore;
+
+                uint32 reused = 0;
+                for (void*& object : objects)
+                {
+                    object = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size);
+                    reused += remoteFreed.count(object);
+                }
+                for (void* object : objects)
+                    MapObjectAllocator::Free(object);
+
+                ASSERT_INFO("%u remote frees counted, %u slots reused", uint32(remoteFrees), reused);
+                TEST_ASSERT(remoteFrees >= count);
+                TEST_ASSERT(reused > 0);
+            });
+
+            SECTION("Objects allocated with pools disabled", [&] {
+                // same slots as above, checked against the stats of this thread pools only
+                size_t const size = 40;
+                PoolsEnabledScope pools(true);
+                void* pooled = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size);
+                MapObjectPoolStats const before = MapObjectAllocator::GetThreadStats()[MAP_OBJECT_POOL_DYNAMICOBJECT];
+
+                void* unpooled;
+                {
+                    PoolsEnabledScope disabled(false);
+                    unpooled = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size);
+                }
+                MapObjectPoolStats const allocated = MapObjectAllocator::GetThreadStats()[MAP_OBJECT_POOL_DYNAMICOBJECT];
+
+                // goes back to the global allocator, not on the free list the next allocation pops
+                MapObjectAllocator::Free(unpooled);
+                MapObjectPoolStats const freed = MapObjectAllocator::GetThreadStats()[MAP_OBJECT_POOL_DYNAMICOBJECT];
+                void* next = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_DYNAMICOBJECT, size);
+                MapObjectAllocator::Free(next);
+                MapObjectAllocator::Free(pooled);
+
+                TEST_ASSERT(allocated.Allocations == before.Allocations);
+                TEST_ASSERT(allocated.Live == before.Live);
+                TEST_ASSERT(freed.Allocations == before.Allocations);
+                TEST_ASSERT(freed.Live == before.Live);
+                TEST_ASSERT(next != unpooled);
+            });
+
+            SECTION("Aura churn", [&] {
+                PoolsEnabledScope pools(true);
+
+                uint32 const batches = 1000;
+                uint32 const batchSize = 1000;
+
+                // Freed slots are reused by the next batches: the pool doesn't grow after the first one.
+                // Checked on the slots themselves, pool stats are summed over all threads and other maps allocate auras too.
+                std::set<void*> slots;
+                Churn([&slots] {
+                    void* object = MapObjectAllocator::Allocate(MAP_OBJECT_POOL_AURA_APPLICATION, sizeof(AuraApplication));
+                    slots.insert(object);
+                    return object;
+                }, [](void* object) { MapObjectAllocator::Free(object); }, 10, batchSize);
+                ASSERT_INFO("%u different slots used by 10 batches of %u objects", uint32(slots.size()), batchSize);
+                TEST_ASSERT(slots.size() == batchSize);
+
+                uint64 const poolTime = Churn([] { return MapObjectAllocator::Allocate(MAP_OBJECT_POOL_AURA_APPLICATION, sizeof(AuraApplication)); },
+                    [](void* object) { MapObjectAllocator::Free(object); }, batches, batchSize);
+                uint64 const globalTime = Churn([] { return ::operator new(sizeof(AuraApplication)); },
+                    [](void* object) { ::operator delete(object); }, batches, batchSize);
+
+                TC_LOG_INFO("test.unit_test", "Map object allocator: %u objects allocated and freed in " UI64FMTD " us (global allocator: " UI64FMTD " us)", batches * batchSize, poolTime, globalTime);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<MapObjectAllocatorTestImpl>();
+    }
+};
+
+void AddSC_test_map_object_allocator()
+{
+    new MapObjectAllocatorTest();
+}
@@ -0,0 +1,141 @@
+#include "TestCase.h"
+#include "SpellMgr.h"
+#include "World.h"
+#include "test_utils.h"
+#include <atomic>
+#include <map>
+#include <random>
+
+class SpellHotInfoTest : public TestCaseScript
+{
+public:
+    SpellHotInfoTest() : TestCaseScript("utilities spell_hot_info") { }
+
+    class SpellHotInfoTestImpl : public TestCase
+    {
+    public:
+        SpellHotInfoTestImpl() : TestCase(STATUS_PASSING) { }
+
+        // What cast validation (Spell::CheckCast), aura creation and proc checks read from the start of SpellInfo
+        static uint64 CastCheckSum(SpellInfo const* spellInfo)
+        {
+            uint64 sum = 0;
+            if (spellInfo->IsPassive())
+                sum += 1;
+            if (spellInfo->HasAttribute(SPELL_ATTR0_CASTABLE_WHILE_DEAD))
+                sum += 2;
+            if (spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS))
+                sum += 4;
+            if (spellInfo->HasAttribute(SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED))
+                sum += 8;
+            if (spellInfo->HasAttribute(SPELL_ATTR5_SKIP_CHECKCAST_LOS_CHECK))
+                sum += 16;
+            if (spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_BACK))
+                sum += 32;
+            sum += spellInfo->SchoolMask + spellInfo->DmgClass + spellInfo->ProcFlags + spellInfo->ProcChance;
+            return sum + uint32(spellInfo->GetDuration()) + uint32(spellInfo->GetMaxRange());
+        }
+
+        void Test() override
+        {
+            std::vector<uint32> spellIds;
+            for (uint32 i = 0; i < sSpellMgr->GetSpellInfoStoreSize(); ++i)
+                if (sSpellMgr->GetSpellInfo(i))
+                    spellIds.push_back(i);
+
+            TEST_ASSERT(!spellIds.empty());
+
+            SECTION("Hot fields layout", [&] {
+                TEST_ASSERT(alignof(SpellInfo) >= 64);
+
+                SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellIds.front());
+                char const* start = reinterpret_cast<char const*>(spellInfo);
+                TEST_ASSERT(uintptr_t(start) % 64 == 0);
+                // first line ends with the family, second one with the cast time entry
+                TEST_ASSERT(reinterpret_cast<char const*>(&spellInfo->SpellFamilyFlags + 1) - start <= 64);
+                TEST_ASSERT(reinterpret_cast<char const*>(&spellInfo->CastTimeEntry + 1) - start <= 128);
+            });
+
+            SECTION("Cast validation reads", [&] {
+                uint32 const lookups = 1000000;
+                std::mt19937 rng(12345);
+                std::vector<uint32> order(lookups);
+                for (uint32& spellId : order)
+                    spellId = spellIds[rng() % spellIds.size()];
+
+                uint64 sum = 0;
+                Testing::Clock::time_point start = Testing::Clock::now();
+                for (uint32 spellId : order)
+                    sum += CastCheckSum(sSpellMgr->GetSpellInfo(spellId));
+                uint64 const time = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "Spell hot fields: %u random cast checks in " UI64FMTD " us (sum " UI64FMTD ")", lookups, time, sum);
+                TEST_ASSERT(sum > 0);
+            });
+
+            // spells with a spell_proc entry and the values read from it
+            std::map<uint32, std::pair<uint32, float>> procEntries;
+            for (uint32 spellId : spellIds)
+                if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(spellId))
+                    procEntries[spellId] = std::make_pair(procEntry->ProcFlags, procEntry->Chance);
+
+            SECTION("Proc lookup", [&] {
+                // auras of a unit are a mix of spells with and without procs
+                uint32 const lookups = 1000000;
+                std::mt19937 rng(54321);
+                std::vector<uint32> order(lookups);
+                for (uint32& spellId : order)
+                    spellId = spellIds[rng() % spellIds.size()];
+
+                uint32 found = 0;
+                Testing::Clock::time_point start = Testing::Clock::now();
+                for (uint32 spellId : order)
+                    if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(spellId))
+                        found += procEntry->ProcFlags ? 1 : 0;
+                uint64 const time = Testing::ElapsedUs(start);
+
+                TC_LOG_INFO("test.unit_test", "Spell hot fields: %u proc lookups (%u spells with proc, %u found) in " UI64FMTD " us", lookups, uint32(procEntries.size()), found, time);
+            });
+
+            SECTION("Reload spell_proc", [&] {
+                // reload through the world thread like the .reload command, proc entries are reallocated
+                static std::atomic<bool> reloaded;
+                reloaded = false;
+                sWorld->QueueCliCommand(new CliCommandHolder(nullptr, "reload spell_proc", [](void*, char const*) { },
+                    [](void*, bool success) { reloaded = success; }));
+
+                for (uint32 i = 0; i < 100 && !reloaded; ++i)
+                    WaitNextUpdate();
+                TEST_ASSERT(reloaded);
+
+                uint32 mismatches = 0;
+                for (uint32 spellId : spellIds)
+                {
+                    SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(spellId);
+                    auto itr = procEntries.find(spellId);
+                    if (!procEntry || itr == procEntries.end())
+                    {
+                        if (procEntry || itr != procEntries.end())
+                            ++mismatches;
+                        continue;
+                    }
+
+                    if (procEntry->ProcFlags != itr->second.first || procEntry->Chance != itr->second.second)
+                        ++mismatches;
+                }
+                ASSERT_INFO("%u spells have a different proc entry after reload", mismatches);
+                TEST_ASSERT(mismatches == 0);
+            });
+        }
+    };
+
+    std::unique_ptr<TestCase> GetTest() const override
+    {
+        return std::make_unique<SpellHotInfoTestImpl>();
+    }
+};
+
+void AddSC_test_spell_hot_info()
+{
+    new SpellHotInfoTest();
+}
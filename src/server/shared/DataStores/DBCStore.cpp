@@ -18,7 +18,8 @@
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
 
-DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _dataTableEx(nullptr), _indexTableSize(0)
+DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _dataTableEx(nullptr), _indexTableSize(0),
+    _dataTableSize(0), _dataTableExSize(0), _inPlace(false)
 {
 }
 
@@ -26,27 +27,45 @@ DBCStorageBase::~DBCStorageBase()
 {
     delete[] _dataTable;
     delete[] _dataTableEx;
-    for (char* strings : _stringPool)
-        delete[] strings;
+}
+
+size_t DBCStorageBase::GetHeapSize() const
+{
+    return _indexTableSize * sizeof(char*) + _dataTableSize + _dataTableExSize;
+}
+
+size_t DBCStorageBase::GetMappedSize() const
+{
+    size_t size = 0;
+    for (std::unique_ptr<DBCFileLoader> const& file : _files)
+        size += file->GetMappedSize();
+    return size;
 }
 
 bool DBCStorageBase::Load(std::string const& path, char**& indexTable)
 {
     indexTable = nullptr;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = std::make_unique<DBCFileLoader>();
     // Check if load was sucessful, only then continue
-    if (!dbc.Load(path.c_str(), _fileFormat))
+    if (!dbc->Load(path.c_str(), _fileFormat))
         return false;
 
-    _fieldCount = dbc.GetCols();
+    _fieldCount = dbc->GetCols();
+    _inPlace = dbc->CanUseRecordsInPlace(_fileFormat);
 
-    // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    // load raw non-string data, or point to it in the file
+    _dataTable = dbc->AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    if (_dataTable)
+        _dataTableSize = size_t(dbc->GetNumRows()) * DBCFileLoader::GetFormatRecordSize(_fileFormat);
 
     // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    bool usedFile = _inPlace;
+    if (_dataTable && strchr(_fileFormat, FT_STRING))
+        usedFile = dbc->AutoProduceStrings(_fileFormat, _dataTable) || usedFile;
+
+    if (usedFile)
+        _files.push_back(std::move(dbc));
 
     // error in dbc file at loading if NULL
     return indexTable != nullptr;
@@ -58,19 +77,32 @@ bool DBCStorageBase::LoadStringsFrom(std::string const& path, char** indexTable)
     if (!indexTable)
         return false;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = std::make_unique<DBCFileLoader>();
     // Check if load was successful, only then continue
-    if (!dbc.Load(path.c_str(), _fileFormat))
+    if (!dbc->Load(path.c_str(), _fileFormat))
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    if (_dataTable && dbc->AutoProduceStrings(_fileFormat, _dataTable))
+        _files.push_back(std::move(dbc));
 
     return true;
 }
 
 void DBCStorageBase::LoadFromDB(std::string const& path, std::string const& dbFormat, std::string const& primaryKey, char**& indexTable)
 {
+    auto countEntries = [&]()
+    {
+        size_t count = 0;
+        for (uint32 i = 0; i < _indexTableSize; ++i)
+            if (indexTable[i])
+                ++count;
+        return count;
+    };
+
+    // rows are only added, never replaced
+    size_t const previousEntries = indexTable ? countEntries() : 0;
     _dataTableEx = DBCDatabaseLoader(path, dbFormat, primaryKey, _fileFormat).Load(_indexTableSize, indexTable);
+    if (_dataTableEx)
+        _dataTableExSize = (countEntries() - previousEntries) * DBCFileLoader::GetFormatRecordSize(_fileFormat);
 }
@@ -3,8 +3,11 @@
 
 #include "Common.h"
 #include "DBCStorageIterator.h"
+#include <memory>
 #include <vector>
 
+class DBCFileLoader;
+
 /// Interface class for common access
 class TC_SHARED_API DBCStorageBase
 {
@@ -14,6 +17,10 @@ public:
 
     char const* GetFormat() const { return _fileFormat; }
     uint32 GetFieldCount() const { return _fieldCount; }
+    // records used directly from the mapped file
+    bool IsInPlace() const { return _inPlace; }
+    size_t GetHeapSize() const;
+    size_t GetMappedSize() const;
 
     virtual bool Load(std::string const& path) = 0;
     virtual bool LoadStringsFrom(std::string const& path) = 0;
@@ -28,8 +35,12 @@ protected:
     char const* _fileFormat;
     char* _dataTable;
     char* _dataTableEx;
-    std::vector<char*> _stringPool;
+    // mapped files still referenced by the records or strings
+    std::vector<std::unique_ptr<DBCFileLoader>> _files;
     uint32 _indexTableSize;
+    size_t _dataTableSize;
+    size_t _dataTableExSize;
+    bool _inPlace;
 };
 
 template <class T>
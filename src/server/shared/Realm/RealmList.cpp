@@ -25,10 +25,18 @@
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
-RealmList::RealmList() : _updateInterval(0)
+RealmList::RealmList() : _generation(0), _updateInterval(0)
 {
 }
 
+static bool IsSameRealm(Realm const& left, Realm const& right)
+{
+    return left.Build == right.Build && left.Name == right.Name && left.Type == right.Type && left.Flags == right.Flags
+        && left.Timezone == right.Timezone && left.AllowedSecurityLevel == right.AllowedSecurityLevel && left.PopulationLevel == right.PopulationLevel
+        && left.Port == right.Port && *left.ExternalAddress == *right.ExternalAddress && *left.LocalAddress == *right.LocalAddress
+        && *left.LocalSubnetMask == *right.LocalSubnetMask;
+}
+
 RealmList::~RealmList()
 {
 }
@@ -93,6 +101,7 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto const& p : _realms)
         existingRealms[p.first] = p.second.Name;
 
+    RealmMap previousRealms = std::move(_realms);
     _realms.clear();
 
     // Circle through results and add them to the realm map
@@ -165,6 +174,13 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         TC_LOG_INFO("server.authserver", "Removed realm \"%s\".", itr->second.c_str());
 
+    bool changed = previousRealms.size() != _realms.size();
+    for (auto itr = _realms.begin(), previous = previousRealms.begin(); !changed && itr != _realms.end(); ++itr, ++previous)
+        changed = itr->first.Realm != previous->first.Realm || !IsSameRealm(itr->second, previous->second);
+
+    if (changed)
+        ++_generation;
+
     if (_updateInterval)
     {
         _updateTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
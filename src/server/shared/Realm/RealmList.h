@@ -57,6 +57,9 @@ public:
     RealmMap const& GetRealms() const { return _realms; }
     Realm const* GetRealm(RealmHandle const& id) const;
 
+    // Incremented every time UpdateRealms changes anything in the realm list, to invalidate data built from it
+    uint32 GetGeneration() const { return _generation; }
+
 private:
     RealmList();
 
@@ -66,6 +69,7 @@ private:
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
 
     RealmMap _realms;
+    uint32 _generation;
     uint32 _updateInterval;
     std::unique_ptr<boost::asio::deadline_timer> _updateTimer;
     std::unique_ptr<boost::asio::ip::tcp_resolver> _resolver;
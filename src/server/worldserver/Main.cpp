@@ -31,6 +31,7 @@
 #include "IoContext.h"
 #include "Resolver.h"
 #include "World.h"
+#include "LogsDatabaseBuffer.h"
 #include "MapManager.h"
 #include "OutdoorPvPMgr.h"
 #include "InstanceSaveMgr.h"
@@ -41,6 +42,7 @@
 #include "ScriptReloadMgr.h"
 #include "AppenderDB.h"
 #include "MySQLThreading.h"
+#include "SyncQueryTracker.h"
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
 #include <fstream>
 #include <execinfo.h>
@@ -320,6 +322,9 @@ extern int main(int argc, char **argv)
 
         ///- Clean database before leaving
         ClearOnlineAccounts();
+
+        ///- Write the logs still buffered
+        sLogsDatabaseBuffer->Flush();
     });
 
     // Launch CliRunnable thread
@@ -584,6 +589,7 @@ void WorldUpdateLoop()
 
         uint32 diff = GetMSTimeDiff(realPrevTime, realCurrTime);
 
+        SyncQueryTracker::BeginTick(SYNC_QUERY_THREAD_WORLD);
         sWorld->Update(diff);
         realPrevTime = realCurrTime;
 
@@ -11,6 +11,9 @@
 #include "DetourCommon.h"
 
 #include "MMapManager.h"
+#include "Timer.h"
+
+#include <algorithm>
 
 namespace MMAP
 {
@@ -18,6 +21,7 @@ namespace MMAP
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
         bool debugOutput, bool bigBaseUnit, int mapid, bool quick, const char* offMeshFilePath) :
         m_terrainBuilder     (NULL),
+        m_skipLiquid         (skipLiquid),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
         m_skipContinents     (skipContinents),
@@ -27,8 +31,10 @@ namespace MMAP
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
+        m_totalTilesSkipped  (0u),
         m_rcContext          (NULL),
         _cancelationToken    (false),
+        _pendingTiles        (0),
         m_quick(quick)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid, quick);
@@ -155,21 +161,32 @@ namespace MMAP
 
     void MapBuilder::WorkerThread()
     {
+        // vmap trees and their loaded tiles are not thread safe, each worker loads its own
+        TerrainBuilder terrainBuilder(m_skipLiquid, m_quick);
+
         while (1)
         {
-            uint32 mapId = 0;
+            TileWork work;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(work);
 
             if (_cancelationToken)
                 return;
 
-            buildMap(mapId);
+            processTile(work, terrainBuilder);
+
+            {
+                std::lock_guard<std::mutex> lock(_pendingLock);
+                --_pendingTiles;
+            }
+            _pendingCondition.notify_all();
         }
     }
+
     void MapBuilder::buildAllMaps(unsigned int threads)
     {
         printf("Using %u threads to extract mmaps\n", threads);
+        uint32 const startTime = GetMSTime();
 
         for (unsigned int i = 0; i < threads; ++i)
         {
@@ -181,21 +198,55 @@ namespace MMAP
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        // a few tiles ahead per worker is enough to keep them busy, more would only allocate navmeshes early
+        uint32 const maxPendingTiles = threads * 2;
+
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            if (shouldSkipMap(mapId))
+                continue;
+
+            if (!threads)
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                buildMap(mapId);
+                continue;
+            }
+
+            std::set<uint32>* tiles = it->m_tiles;
+            if (tiles->empty())
+                continue;
+
+            dtNavMesh* navMesh = NULL;
+            buildNavMesh(mapId, navMesh);
+            if (!navMesh)
+            {
+                printf("[Map %03i] Failed creating navmesh!\n", mapId);
+                m_totalTilesProcessed += tiles->size();
+                continue;
+            }
+
+            printf("[Map %03i] We have %u tiles.                          \n", mapId, (unsigned int)tiles->size());
+            MapBuildState* map = new MapBuildState(mapId, navMesh, uint32(tiles->size()));
+            map->m_startTime = GetMSTime();
+            for (std::set<uint32>::iterator tile = tiles->begin(); tile != tiles->end(); ++tile)
+            {
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(*tile, tileX, tileY);
+
+                {
+                    std::unique_lock<std::mutex> lock(_pendingLock);
+                    _pendingCondition.wait(lock, [&] { return _pendingTiles < maxPendingTiles; });
+                    ++_pendingTiles;
+                }
+
+                _queue.Push(TileWork(map, tileX, tileY));
             }
         }
 
-        while (!_queue.Empty())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            std::unique_lock<std::mutex> lock(_pendingLock);
+            _pendingCondition.wait(lock, [&] { return _pendingTiles == 0; });
         }
 
         _cancelationToken = true;
@@ -206,6 +257,53 @@ namespace MMAP
         {
             thread.join();
         }
+
+        printReport(GetMSTimeDiffToNow(startTime), std::max(threads, 1u));
+    }
+
+    /**************************************************************************/
+    void MapBuilder::processTile(TileWork const& work, TerrainBuilder& terrainBuilder)
+    {
+        MapBuildState* map = work.m_map;
+        if (!shouldSkipTile(map->m_mapId, work.m_tileX, work.m_tileY))
+            buildTile(map->m_mapId, work.m_tileX, work.m_tileY, map->m_navMesh, terrainBuilder);
+        else
+            ++m_totalTilesSkipped;
+
+        ++m_totalTilesProcessed;
+
+        if (--map->m_tilesLeft == 0)
+            finishMap(map);
+    }
+
+    void MapBuilder::finishMap(MapBuildState* map)
+    {
+        uint32 const buildTime = GetMSTimeDiffToNow(map->m_startTime);
+        printf("[Map %03i] Complete! (%.1f s)\n", map->m_mapId, buildTime / 1000.0f);
+
+        {
+            std::lock_guard<std::mutex> lock(_mapTimesLock);
+            _mapTimes.emplace_back(map->m_mapId, buildTime);
+        }
+
+        dtFreeNavMesh(map->m_navMesh);
+        delete map;
+    }
+
+    void MapBuilder::printReport(uint32 wallTime, unsigned int threads)
+    {
+        uint32 const skipped = m_totalTilesSkipped;
+        printf("\n%u tiles processed in %.1f s with %u threads: %u built, %u already up to date.\n",
+            uint32(m_totalTilesProcessed), wallTime / 1000.0f, threads, uint32(m_totalTilesProcessed) - skipped, skipped);
+
+        std::sort(_mapTimes.begin(), _mapTimes.end(), [](std::pair<uint32, uint32> const& a, std::pair<uint32, uint32> const& b)
+        {
+            return a.second > b.second;
+        });
+
+        printf("Slowest maps:\n");
+        for (size_t i = 0; i < _mapTimes.size() && i < 10; ++i)
+            printf("    [Map %03u] %8.1f s\n", _mapTimes[i].first, _mapTimes[i].second / 1000.0f);
     }
     /**************************************************************************/
     void MapBuilder::getGridBounds(uint32 mapID, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY) const
@@ -333,7 +431,7 @@ namespace MMAP
         getTileBounds(tileX, tileY, data.solidVerts.getCArray(), data.solidVerts.size() / 3, bmin, bmax);
 
         // build navmesh tile
-        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh, *m_terrainBuilder);
         fclose(file);
     }
 
@@ -348,7 +446,7 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh);
+        buildTile(mapID, tileX, tileY, navMesh, *m_terrainBuilder);
         dtFreeNavMesh(navMesh);
     }
 
@@ -371,6 +469,8 @@ namespace MMAP
 
             // now start building mmtiles for each tile
             printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
+            MapBuildState* map = new MapBuildState(mapID, navMesh, uint32(tiles->size()));
+            map->m_startTime = GetMSTime();
             for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
             {
                 uint32 tileX, tileY;
@@ -378,21 +478,16 @@ namespace MMAP
                 // unpack tile coords
                 StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-                if (!shouldSkipTile(mapID, tileX, tileY))
-                    buildTile(mapID, tileX, tileY, navMesh);
-
-                ++m_totalTilesProcessed;
-                
+                // the last tile frees map
+                processTile(TileWork(map, tileX, tileY), *m_terrainBuilder);
             }
-
-            dtFreeNavMesh(navMesh);
         }
-
-        printf("[Map %03i] Complete!\n", mapID);
+        else
+            printf("[Map %03i] Complete!\n", mapID);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TerrainBuilder& terrainBuilder)
     {
         printf("%u%% [Map %03i] Building tile [%02u,%02u]\n", percentageDone(m_totalTiles, m_totalTilesProcessed), mapID, tileX, tileY);
         printf("[Map %03i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
@@ -400,14 +495,14 @@ namespace MMAP
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        terrainBuilder.loadMap(mapID, tileX, tileY, meshData);
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
         TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        terrainBuilder.loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
@@ -429,11 +524,11 @@ namespace MMAP
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        terrainBuilder.loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
-        m_terrainBuilder->unloadVMap(mapID, tileY, tileX);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, terrainBuilder);
+        terrainBuilder.unloadVMap(mapID, tileY, tileX);
     }
 
     /**************************************************************************/
@@ -616,7 +711,7 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
-        dtNavMesh* navMesh)
+        dtNavMesh* navMesh, TerrainBuilder& terrainBuilder)
     {
         // console output
         char tileString[20];
@@ -928,13 +1023,19 @@ namespace MMAP
 
             dtTileRef tileRef = 0;
             printf("%s Adding tile to navmesh...\n", tileString);
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
-            if (!tileRef || dtResult != DT_SUCCESS)
             {
-                printf("%s Failed adding tile to navmesh!           \n", tileString);
-                break;
+                // the tile is only added to check it, we keep ownership of navData and remove it right away
+                std::lock_guard<std::mutex> lock(_navMeshLock);
+                dtStatus dtResult = navMesh->addTile(navData, navDataSize, 0, 0, &tileRef);
+                if (tileRef)
+                    navMesh->removeTile(tileRef, NULL, NULL);
+
+                if (!tileRef || dtResult != DT_SUCCESS)
+                {
+                    printf("%s Failed adding tile to navmesh!           \n", tileString);
+                    dtFree(navData);
+                    break;
+                }
             }
 
             // file output
@@ -946,7 +1047,7 @@ namespace MMAP
                 char message[1024];
                 sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, fileName);
                 perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
+                dtFree(navData);
                 break;
             }
 
@@ -954,7 +1055,7 @@ namespace MMAP
 
             // write header
             MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
+            header.usesLiquids = terrainBuilder.usesLiquids();
             header.size = uint32(navDataSize);
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
@@ -962,8 +1063,7 @@ namespace MMAP
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
-            // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
+            dtFree(navData);
         }
         while (0);
 
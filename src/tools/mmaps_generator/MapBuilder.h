@@ -25,6 +25,8 @@
 #include <map>
 #include <list>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -55,6 +57,28 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    // navmesh of a map being built, shared by the workers building its tiles. The last tile done frees it.
+    struct MapBuildState
+    {
+        MapBuildState(uint32 mapId, dtNavMesh* navMesh, uint32 tileCount) : m_mapId(mapId), m_navMesh(navMesh), m_tilesLeft(tileCount), m_startTime(0) {}
+
+        uint32 m_mapId;
+        dtNavMesh* m_navMesh;
+        std::atomic<uint32> m_tilesLeft;
+        uint32 m_startTime;
+    };
+
+    // work unit of buildAllMaps, one tile of one map
+    struct TileWork
+    {
+        TileWork() : m_map(NULL), m_tileX(0), m_tileY(0) {}
+        TileWork(MapBuildState* map, uint32 tileX, uint32 tileY) : m_map(map), m_tileX(tileX), m_tileY(tileY) {}
+
+        MapBuildState* m_map;
+        uint32 m_tileX;
+        uint32 m_tileY;
+    };
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -97,6 +121,7 @@ namespace MMAP
             void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+            // tiles of all maps are built by threads workers, biggest maps first
             void buildAllMaps(unsigned int threads);
 
             void WorkerThread();
@@ -111,7 +136,12 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TerrainBuilder& terrainBuilder);
+
+            // build (or skip if up to date) a tile of an allocated map, then release the map if it was the last one
+            void processTile(TileWork const& work, TerrainBuilder& terrainBuilder);
+            void finishMap(MapBuildState* map);
+            void printReport(uint32 wallTime, unsigned int threads);
 
             // move map building
             void buildMoveMapTile(uint32 mapID,
@@ -120,7 +150,8 @@ namespace MMAP
                 MeshData &meshData,
                 float bmin[3],
                 float bmax[3],
-                dtNavMesh* navMesh);
+                dtNavMesh* navMesh,
+                TerrainBuilder& terrainBuilder);
 
             void getTileBounds(uint32 tileX, uint32 tileY,
                 float* verts, int vertCount,
@@ -136,6 +167,8 @@ namespace MMAP
             TerrainBuilder* m_terrainBuilder;
             TileList m_tiles;
 
+            bool m_skipLiquid;
+
             bool m_debugOutput;
 
             const char* m_offMeshFilePath;
@@ -157,13 +190,27 @@ namespace MMAP
 
             std::atomic<uint32> m_totalTiles;
             std::atomic<uint32> m_totalTilesProcessed;
+            std::atomic<uint32> m_totalTilesSkipped;
 
             // build performance - not really used for now
             rcContext* m_rcContext;
 
             std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
+            ProducerConsumerQueue<TileWork> _queue;
             std::atomic<bool> _cancelationToken;
+
+            // dtNavMesh::addTile and removeTile are not thread safe. Tiles are only added to check them then removed
+            // under this lock, so no two tiles are ever in a navmesh together and their data is the same as a serial build.
+            std::mutex _navMeshLock;
+
+            // tiles queued or being built, the producer waits for room so only the maps in progress hold a navmesh
+            std::mutex _pendingLock;
+            std::condition_variable _pendingCondition;
+            uint32 _pendingTiles;
+
+            // build time of each map (mapId, ms)
+            std::mutex _mapTimesLock;
+            std::vector<std::pair<uint32, uint32>> _mapTimes;
     };
 }
 #endif
\ No newline at end of file
@@ -265,10 +265,8 @@ int main(int argc, char** argv)
         builder.buildMeshFromFile(file);
     else if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
-    else if (mapnum >= 0)
-        builder.buildMap(uint32(mapnum));
     else
-        builder.buildAllMaps(threads);
+        builder.buildAllMaps(threads); // only builds mapnum if set
 
     if (!silent)
         printf("Finished. MMAPS were built in %u ms!\n", GetMSTimeDiffToNow(start));
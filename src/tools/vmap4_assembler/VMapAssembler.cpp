@@ -18,6 +18,9 @@
 
 #include <string>
 #include <iostream>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
 
 #include "TileAssembler.h"
 #include "Banner.h"
@@ -28,10 +31,11 @@ int main(int argc, char* argv[])
 
     std::string src = "Buildings";
     std::string dest = "vmaps";
+    uint32 threads = std::thread::hardware_concurrency();
 
-    if (argc > 3)
+    if (argc > 4)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [threads]" << std::endl;
         return 1;
     }
     else
@@ -40,13 +44,15 @@ int main(int argc, char* argv[])
             src = argv[1];
         if (argc > 2)
             dest = argv[2];
+        if (argc > 3)
+            threads = uint32(std::max(1, atoi(argv[3])));
     }
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
 
-    if (!ta->convertWorld2())
+    if (!ta->convertWorld2(threads))
     {
         std::cout << "exit with errors" << std::endl;
         delete ta;